@@ -641,6 +641,26 @@ void ImageEffectDescriptor::addSupportedExtensions( const std::vector<std::strin
 	}
 }
 
+/** @brief Is the plugin a point operation ? */
+void ImageEffectDescriptor::setIsPointOperation( bool v )
+{
+	// only Tuttle support this property ( out of standard )
+	if( OFX::Private::gHostDescription.hostName == "TuttleOfx" )
+	{
+		_effectProps.propSetInt( kTuttleOfxImageEffectPropPointOperation, int(v) );
+	}
+}
+
+/** @brief Can the plugin output a view of an input image ? */
+void ImageEffectDescriptor::setSupportsInputView( bool v )
+{
+	// only Tuttle support this property ( out of standard )
+	if( OFX::Private::gHostDescription.hostName == "TuttleOfx" )
+	{
+		_effectProps.propSetInt( kTuttleOfxImageEffectPropSupportsInputView, int(v) );
+	}
+}
+
 /** @brief Is the plugin single instance only ? */
 void ImageEffectDescriptor::setSingleInstance( bool v )
 {
@@ -1399,6 +1419,13 @@ bool ImageEffect::isIdentity( const RenderArguments& args, Clip*& identityClip,
 	return false; // by default, we are not an identity operation
 }
 
+/** @brief client input view function, returns the clip, time and offset of the view
+*/
+bool ImageEffect::getInputView( const RenderArguments& args, Clip*& viewClip, double& viewTime, OfxPointI& offset, bool& flip )
+{
+	return false; // by default, the output needs to be rendered
+}
+
 /** @brief The get RoD action */
 bool ImageEffect::getRegionOfDefinition( const RegionOfDefinitionArguments& args, OfxRectD& rod )
 {
@@ -2061,6 +2088,34 @@ bool isIdentityAction( OfxImageEffectHandle handle, OFX::PropertySet inArgs, OFX
 	return false;
 }
 
+/** @brief Library side input view action, fetches relevant properties and calls the client code */
+bool getInputViewAction( OfxImageEffectHandle handle, OFX::PropertySet inArgs, OFX::PropertySet& outArgs )
+{
+	ImageEffect* effectInstance = retrieveImageEffectPointer( handle );
+	RenderArguments args;
+
+	// get the arguments
+	getRenderActionArguments( args, inArgs );
+
+	// and call the plugin client getInputView code
+	Clip* viewClip  = 0;
+	double viewTime = args.time;
+	OfxPointI offset = { 0, 0 };
+	bool flip = false;
+	bool v    = effectInstance->getInputView( args, viewClip, viewTime, offset, flip );
+
+	if( v && viewClip )
+	{
+		outArgs.propSetString( kOfxPropName, viewClip->name() );
+		outArgs.propSetDouble( kOfxPropTime, viewTime );
+		outArgs.propSetInt( kTuttleOfxImageEffectPropInputViewOffset, offset.x, 0 );
+		outArgs.propSetInt( kTuttleOfxImageEffectPropInputViewOffset, offset.y, 1 );
+		outArgs.propSetInt( kTuttleOfxImageEffectPropInputViewFlip, int(flip) );
+		return true;
+	}
+	return false;
+}
+
 /** @brief Library side get region of definition function */
 bool regionOfDefinitionAction( OfxImageEffectHandle handle, OFX::PropertySet inArgs, OFX::PropertySet& outArgs )
 {
@@ -2516,6 +2571,14 @@ OfxStatus mainEntryStr( const char*          actionRaw,
 			if( isIdentityAction( handle, inArgs, outArgs ) )
 			stat = kOfxStatOK;
 		}
+		else if( action == kTuttleOfxImageEffectActionGetInputView )
+		{
+			checkMainHandles( actionRaw, handleRaw, inArgsRaw, outArgsRaw, false, false, false );
+
+			// call the input view action, if the output is a view, return OK
+			if( getInputViewAction( handle, inArgs, outArgs ) )
+			stat = kOfxStatOK;
+		}
 		else if( action == kOfxImageEffectActionGetRegionOfDefinition )
 		{
 			checkMainHandles( actionRaw, handleRaw, inArgsRaw, outArgsRaw, false, false, false );
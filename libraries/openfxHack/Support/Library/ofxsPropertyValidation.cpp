@@ -382,6 +382,8 @@ static PropertyDescription gPluginDescriptorProps[] =
     PropertyDescription( kOfxImageEffectPluginPropFieldRenderTwiceAlways, OFX::eInt, 1, eDescDefault, 1, eDescFinished ),
     PropertyDescription( kOfxImageEffectPropSupportsMultipleClipDepths,   OFX::eInt, 1, eDescDefault, 0, eDescFinished ),
     PropertyDescription( kOfxImageEffectPropSupportsMultipleClipPARs,     OFX::eInt, 1, eDescDefault, 0, eDescFinished ),
+    PropertyDescription( kTuttleOfxImageEffectPropPointOperation,         OFX::eInt, 1, eDescDefault, 0, eDescFinished ),
+    PropertyDescription( kTuttleOfxImageEffectPropSupportsInputView,      OFX::eInt, 1, eDescDefault, 0, eDescFinished ),
 
     // Pointer props with defaults that can be checked against
     PropertyDescription( kOfxImageEffectPluginPropOverlayInteractV1,      OFX::ePointer, 1, eDescDefault, ( void* )( 0 ), eDescFinished ),
@@ -609,6 +611,25 @@ static PropertySetDescription gIsIdentityActionOutArgPropSet( kOfxImageEffectAct
                                                               gIsIdentityActionOutArgProps, sizeof( gIsIdentityActionOutArgProps ) / sizeof( PropertyDescription ),
                                                               NULLPTR );
 
+/** @brief kTuttleOfxImageEffectActionGetInputView property set, same in arguments as kOfxImageEffectActionIsIdentity */
+static PropertySetDescription gGetInputViewActionInArgPropSet( kTuttleOfxImageEffectActionGetInputView " in argument",
+                                                               gIsIdentityActionInArgProps, sizeof( gIsIdentityActionInArgProps ) / sizeof( PropertyDescription ),
+                                                               NULLPTR );
+
+/** @brief kTuttleOfxImageEffectActionGetInputView action's outargs properties */
+static PropertyDescription gGetInputViewActionOutArgProps[] =
+{
+    PropertyDescription( kOfxPropTime,                             OFX::eDouble, 1, eDescFinished ),
+    PropertyDescription( kOfxPropName,                             OFX::eString, 1, eDescFinished ),
+    PropertyDescription( kTuttleOfxImageEffectPropInputViewOffset, OFX::eInt,    2, eDescFinished ),
+    PropertyDescription( kTuttleOfxImageEffectPropInputViewFlip,   OFX::eInt,    1, eDescFinished ),
+};
+
+/** @brief kTuttleOfxImageEffectActionGetInputView property set */
+static PropertySetDescription gGetInputViewActionOutArgPropSet( kTuttleOfxImageEffectActionGetInputView " out argument",
+                                                                gGetInputViewActionOutArgProps, sizeof( gGetInputViewActionOutArgProps ) / sizeof( PropertyDescription ),
+                                                                NULLPTR );
+
 /** @brief kOfxImageEffectActionGetRegionOfDefinition action's inargs properties */
 static PropertyDescription gGetRegionOfDefinitionInArgProps[] =
 {
@@ -1132,6 +1153,11 @@ void validateActionArgumentsProperties( const std::string& action, PropertySet i
         gIsIdentityActionInArgPropSet.validate( inArgs );
         gIsIdentityActionOutArgPropSet.validate( outArgs );
     }
+    else if( action == kTuttleOfxImageEffectActionGetInputView )
+    {
+        gGetInputViewActionInArgPropSet.validate( inArgs );
+        gGetInputViewActionOutArgPropSet.validate( outArgs );
+    }
     else if( action == kOfxImageEffectActionRender )
     {
         gRenderActionInArgPropSet.validate( inArgs );
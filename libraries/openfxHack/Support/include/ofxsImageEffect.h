@@ -431,6 +431,12 @@ public:
     void addSupportedExtension( const std::string& extension );
     void addSupportedExtensions( const std::vector<std::string>& extensions );
 
+    /** @brief Is the plugin a point operation, rendering each pixel from the source pixel at the same position ? defaults to false */
+    void setIsPointOperation( bool v );
+
+    /** @brief Can the plugin output a view of an input image (see ImageEffect::getInputView) ? defaults to false */
+    void setSupportsInputView( bool v );
+
     /** @brief Is the plugin single instance only ? defaults to false */
     void setSingleInstance( bool v );
 
@@ -1050,6 +1056,15 @@ public:
      */
     virtual bool isIdentity( const RenderArguments& args, Clip*& identityClip, double& identityTime );
 
+    /** @brief client input view function, only called if the descriptor called setSupportsInputView
+     *
+     * If each output pixel is a pixel of an input clip, moved by an integer \em offset and possibly flipped
+     * vertically, this function should return true and set \em viewClip and \em viewTime. The output pixel (x, y)
+     * is the input pixel (x + offset.x, y + offset.y), or (x + offset.x, offset.y - y) if \em flip is true.
+     * The host may then use the input buffer as the output, without calling render.
+     */
+    virtual bool getInputView( const RenderArguments& args, Clip*& viewClip, double& viewTime, OfxPointI& offset, bool& flip );
+
     /** @brief The get RoD action.
      *
      * If the effect wants change the rod from the default value (which is the union of RoD's of all input clips)
@@ -0,0 +1,52 @@
+#ifndef _ofxInputView_h_
+#define _ofxInputView_h_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Indicates that the effect may implement kTuttleOfxImageEffectActionGetInputView (defaults to 0).
+ */
+#define kTuttleOfxImageEffectPropSupportsInputView "TuttleOfxImageEffectPropSupportsInputView"
+
+/**
+ * @brief Asks the effect if its output, for the given render arguments, is only a view of an input image.
+ *
+ * It's the case of crops, vertical flips and integer translations: each
+ * output pixel is a source pixel, with an integer offset and possibly a
+ * vertical flip. The host may then give to the output image the buffer
+ * of the source image instead of calling the render action.
+ *
+ * @param handle handle to the instance, cast to an \ref OfxImageEffectHandle
+ * @param inArgs has the same properties as the kOfxImageEffectActionIsIdentity in arguments
+ * @param outArgs has the following properties which the plugin can set
+ *    - \ref kOfxPropName the name of the input clip,
+ *    - \ref kOfxPropTime the time to use from the input clip (defaults to the time in inArgs),
+ *    - \ref kTuttleOfxImageEffectPropInputViewOffset,
+ *    - \ref kTuttleOfxImageEffectPropInputViewFlip.
+ *
+ * @returns
+ *    - \ref kOfxStatOK, the output is a view of the input clip, the host may not call the render action,
+ *    - \ref kOfxStatReplyDefault, the output needs to be rendered.
+ */
+#define kTuttleOfxImageEffectActionGetInputView "TuttleOfxImageEffectActionGetInputView"
+
+/**
+ * @brief Offset in pixels between the output and the input images (int X 2, defaults to 0,0).
+ *
+ * The output pixel (x, y) is the input pixel (x + offset.x, y + offset.y),
+ * or (x + offset.x, offset.y - y) with a vertical flip.
+ */
+#define kTuttleOfxImageEffectPropInputViewOffset "TuttleOfxImageEffectPropInputViewOffset"
+
+/**
+ * @brief Is the output a vertically flipped view of the input ? (int X 1, defaults to 0)
+ */
+#define kTuttleOfxImageEffectPropInputViewFlip "TuttleOfxImageEffectPropInputViewFlip"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
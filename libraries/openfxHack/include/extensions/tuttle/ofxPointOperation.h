@@ -0,0 +1,21 @@
+#ifndef _ofxPointOperation_h_
+#define _ofxPointOperation_h_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Indicates that the effect is a point operation (defaults to 0).
+ *
+ * Each output pixel only depends on the source pixel at the same position,
+ * so the effect can render in place: the host may give the same buffer
+ * to the source clip and to the output clip.
+ */
+#define kTuttleOfxImageEffectPropPointOperation "TuttleOfxImageEffectPropPointOperation"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
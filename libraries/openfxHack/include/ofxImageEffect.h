@@ -40,6 +40,8 @@
 #include "ofxMultiThread.h"
 #include "ofxInteract.h"
 #include "extensions/tuttle/ofxReadWrite.h"
+#include "extensions/tuttle/ofxPointOperation.h"
+#include "extensions/tuttle/ofxInputView.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -0,0 +1,284 @@
+#ifndef _TERRY_COLOR_LUT3D_HPP_
+#define _TERRY_COLOR_LUT3D_HPP_
+
+/**
+ * @file
+ * @brief 3D lut used to bake a color transformation (OCIO processor, CTL program...).
+ *
+ * The transformation is sampled once on a regular lattice, the input values
+ * being first mapped into [0,1] by a shaper (linear or log2), then the
+ * pixels are evaluated by tetrahedral interpolation in the lattice.
+ * Values outside of the shaper range are clamped.
+ */
+
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define TERRY_LUT3D_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace terry {
+namespace color {
+
+enum ELut3DShaper
+{
+	eLut3DShaperLinear = 0, ///< uniform between min and max
+	eLut3DShaperLog2        ///< uniform between log2(min+offset) and log2(max+offset)
+};
+
+/**
+ * @brief Mapping of an input value to a normalized lattice position, and back.
+ */
+struct lut3d_shaper_t
+{
+	ELut3DShaper type;
+	float min;    ///< smallest input value (log2 of the value for eLut3DShaperLog2)
+	float max;    ///< biggest input value (log2 of the value for eLut3DShaperLog2)
+	float offset; ///< added to the value before the log2
+
+	lut3d_shaper_t( const ELut3DShaper type_ = eLut3DShaperLinear, const float min_ = 0.0f, const float max_ = 1.0f, const float offset_ = 0.0f )
+	: type( type_ )
+	, min( min_ )
+	, max( max_ )
+	, offset( offset_ )
+	{}
+
+	/// normalized position in [0,1] of an input value
+	inline float operator()( const float value ) const
+	{
+		float v = value;
+		if( type == eLut3DShaperLog2 )
+		{
+			const float shifted = value + offset;
+			v = shifted > 0.0f ? std::log( shifted ) * 1.4426950408889634f : min;
+		}
+		const float t = ( v - min ) / ( max - min );
+		return t > 0.0f ? std::min( t, 1.0f ) : 0.0f; // also for NaN
+	}
+
+	/// input value at a normalized position
+	inline float inverse( const float t ) const
+	{
+		const float v = min + t * ( max - min );
+		if( type == eLut3DShaperLog2 )
+			return std::pow( 2.0f, v ) - offset;
+		return v;
+	}
+};
+
+/**
+ * @brief Weighted sum of the 4 vertices of a tetrahedron, on the rgb values of the nodes.
+ */
+template<std::size_t NodeSize>
+struct tetrahedron_sum
+{
+	static inline void apply( const float* p0, const float* p1, const float* p2, const float* p3,
+	                          const float w0, const float w1, const float w2, const float w3, float* out )
+	{
+		for( int c = 0; c < 3; ++c )
+			out[c] = w0 * p0[c] + w1 * p1[c] + w2 * p2[c] + w3 * p3[c];
+	}
+};
+
+#ifdef TERRY_LUT3D_SSE2
+/// a node of 4 floats is a single vector, out also receives the 4th value
+template<>
+struct tetrahedron_sum<4>
+{
+	static inline void apply( const float* p0, const float* p1, const float* p2, const float* p3,
+	                          const float w0, const float w1, const float w2, const float w3, float* out )
+	{
+		__m128 r = _mm_mul_ps( _mm_loadu_ps( p0 ), _mm_set1_ps( w0 ) );
+		r = _mm_add_ps( r, _mm_mul_ps( _mm_loadu_ps( p1 ), _mm_set1_ps( w1 ) ) );
+		r = _mm_add_ps( r, _mm_mul_ps( _mm_loadu_ps( p2 ), _mm_set1_ps( w2 ) ) );
+		r = _mm_add_ps( r, _mm_mul_ps( _mm_loadu_ps( p3 ), _mm_set1_ps( w3 ) ) );
+		_mm_storeu_ps( out, r );
+	}
+};
+#endif
+
+/**
+ * @brief Tetrahedral interpolation in a cell of a lattice of rgb nodes.
+ *
+ * @param[in]  p000        first node of the cell
+ * @param[in]  sr, sg, sb  distances (in floats) between two nodes on the red, green and blue axes
+ * @param[in]  fr, fg, fb  position in the cell, in [0,1]
+ * @param[out] out         rgb values (NodeSize values if NodeSize is 4)
+ */
+template<std::size_t NodeSize>
+inline void tetrahedral_interpolation( const float* p000, const std::size_t sr, const std::size_t sg, const std::size_t sb,
+                                       const float fr, const float fg, const float fb, float* out )
+{
+	const float* p111 = p000 + sr + sg + sb;
+
+	// 4 vertices of the tetrahedron containing the point, with their weights
+	const float* p1;
+	const float* p2;
+	float w0, w1, w2, w3;
+	if( fr >= fg )
+	{
+		if( fg >= fb )      // r > g > b
+		{
+			p1 = p000 + sr; p2 = p000 + sr + sg;
+			w0 = 1.0f - fr; w1 = fr - fg; w2 = fg - fb; w3 = fb;
+		}
+		else if( fr >= fb ) // r > b > g
+		{
+			p1 = p000 + sr; p2 = p000 + sr + sb;
+			w0 = 1.0f - fr; w1 = fr - fb; w2 = fb - fg; w3 = fg;
+		}
+		else                // b > r > g
+		{
+			p1 = p000 + sb; p2 = p000 + sr + sb;
+			w0 = 1.0f - fb; w1 = fb - fr; w2 = fr - fg; w3 = fg;
+		}
+	}
+	else
+	{
+		if( fb >= fg )      // b > g > r
+		{
+			p1 = p000 + sb; p2 = p000 + sg + sb;
+			w0 = 1.0f - fb; w1 = fb - fg; w2 = fg - fr; w3 = fr;
+		}
+		else if( fb >= fr ) // g > b > r
+		{
+			p1 = p000 + sg; p2 = p000 + sg + sb;
+			w0 = 1.0f - fg; w1 = fg - fb; w2 = fb - fr; w3 = fr;
+		}
+		else                // g > r > b
+		{
+			p1 = p000 + sg; p2 = p000 + sr + sg;
+			w0 = 1.0f - fg; w1 = fg - fr; w2 = fr - fb; w3 = fb;
+		}
+	}
+	tetrahedron_sum<NodeSize>::apply( p000, p1, p2, p111, w0, w1, w2, w3, out );
+}
+
+/**
+ * @brief Lattice of rgb values, with a shaper.
+ *
+ * Each node is stored on 4 floats (rgb and a padding value), so an
+ * interpolation step is a single vector operation.
+ * Red is the slowest axis and blue the fastest.
+ */
+class lut3d
+{
+public:
+	static const std::size_t kNodeSize = 4;
+
+public:
+	lut3d() : _size( 0 ) {}
+
+	/**
+	 * @brief Allocate a lattice of size^3 nodes, filled with the input values
+	 * of the nodes, to be transformed in place by the baked transformation
+	 * (see bake).
+	 */
+	void reset( const std::size_t size, const lut3d_shaper_t& shaper )
+	{
+		_size   = std::max( size, std::size_t( 2 ) );
+		_shaper = shaper;
+		_lattice.assign( _size * _size * _size * kNodeSize, 0.0f );
+
+		std::vector<float> values( _size );
+		for( std::size_t i = 0; i < _size; ++i )
+			values[i] = _shaper.inverse( float( i ) / ( _size - 1 ) );
+		float* node = &_lattice.front();
+		for( std::size_t r = 0; r < _size; ++r )
+			for( std::size_t g = 0; g < _size; ++g )
+				for( std::size_t b = 0; b < _size; ++b, node += kNodeSize )
+				{
+					node[0] = values[r];
+					node[1] = values[g];
+					node[2] = values[b];
+					node[3] = 0.0f;
+				}
+	}
+
+	/**
+	 * @brief Sample a transformation on the lattice.
+	 * @param[in] transform functor called as transform( float* nodes, std::size_t nbNodes ),
+	 *            transforming in place the rgb values of nbNodes nodes of kNodeSize floats.
+	 */
+	template<class Transform>
+	void bake( const std::size_t size, const lut3d_shaper_t& shaper, Transform transform )
+	{
+		reset( size, shaper );
+		transform( nodes(), nbNodes() );
+	}
+
+	bool empty() const { return _size == 0; }
+	std::size_t size() const { return _size; }
+	std::size_t nbNodes() const { return _size * _size * _size; }
+	float* nodes() { return &_lattice.front(); }
+	const float* nodes() const { return &_lattice.front(); }
+	const lut3d_shaper_t& shaper() const { return _shaper; }
+
+	/**
+	 * @brief Apply the lut on a line of interleaved float pixels.
+	 * The channels after the 3rd one are copied.
+	 * @param[out] dst may be equal to src
+	 */
+	void apply( const float* src, float* dst, const std::size_t nbPixels, const std::size_t nbChannels ) const
+	{
+		static const std::size_t kBatchSize = 64;
+		boost::uint32_t index[kBatchSize];
+		float fractions[kBatchSize][3];
+		float rgb[4];
+
+		for( std::size_t begin = 0; begin < nbPixels; begin += kBatchSize )
+		{
+			const std::size_t n = std::min( kBatchSize, nbPixels - begin );
+			const float* s = src + begin * nbChannels;
+			float* d = dst + begin * nbChannels;
+
+			// lattice cells of the batch
+			for( std::size_t i = 0; i < n; ++i )
+			{
+				boost::uint32_t cell[3];
+				for( int c = 0; c < 3; ++c )
+				{
+					const float p = _shaper( s[i * nbChannels + c] ) * ( _size - 1 );
+					cell[c] = std::min( static_cast<boost::uint32_t>( p ), static_cast<boost::uint32_t>( _size - 2 ) );
+					fractions[i][c] = p - cell[c];
+				}
+				index[i] = ( ( cell[0] * _size + cell[1] ) * _size + cell[2] ) * kNodeSize;
+			}
+
+			// interpolations
+			for( std::size_t i = 0; i < n; ++i )
+			{
+				interpolate( index[i], fractions[i], rgb );
+				for( int c = 0; c < 3; ++c )
+					d[i * nbChannels + c] = rgb[c];
+				if( s != d )
+					for( std::size_t c = 3; c < nbChannels; ++c )
+						d[i * nbChannels + c] = s[i * nbChannels + c];
+			}
+		}
+	}
+
+private:
+	/// tetrahedral interpolation in the cell starting at the node index
+	inline void interpolate( const std::size_t index, const float* f, float* out ) const
+	{
+		const std::size_t sg = _size * kNodeSize;
+		tetrahedral_interpolation<kNodeSize>( &_lattice[index], _size * sg, sg, kNodeSize, f[0], f[1], f[2], out );
+	}
+
+private:
+	std::size_t _size;           ///< number of nodes on each axis
+	lut3d_shaper_t _shaper;
+	std::vector<float> _lattice; ///< size^3 nodes of kNodeSize floats
+};
+
+}
+}
+
+#endif
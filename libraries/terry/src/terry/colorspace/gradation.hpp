@@ -398,7 +398,8 @@ namespace terry
               (_out._blackPoint - _out._whitePoint) * 0.002
                   / _out._gammaSensito);
           double gain = 1.0 / (1 - offset);
-          T fDst = (std::log10((fSrc + offset) / gain)
+          // inverse of Cineon to Lin
+          T fDst = (std::log10(fSrc / gain + offset)
               / (0.002 / _out._gammaSensito) + _out._whitePoint)/1023.0;
 
           return dst = channel_convert<Channel>(fDst);
@@ -0,0 +1,320 @@
+#ifndef _TERRY_FILTER_BOXBLUR_HPP_
+#define _TERRY_FILTER_BOXBLUR_HPP_
+
+#include "convolve.hpp"
+
+#include <terry/numeric/init.hpp>
+#include <terry/numeric/assign.hpp>
+
+#include <boost/gil/gil_config.hpp>
+#include <boost/gil/metafunctions.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/static_assert.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace terry {
+namespace filter {
+
+static const std::size_t kBoxBlurNbPasses = 4;
+
+namespace detail {
+
+/// kernel tag to use successive box filters instead of a correlation
+struct box_blur_tag {};
+
+}
+
+/**
+ * @brief Gaussian kernel approximated by successive box filters.
+ *
+ * Each box filter is computed with running sums, so the cost per pixel doesn't depend on the kernel size.
+ * It can be used with correlate_rows/correlate_cols/correlate_rows_cols like the other kernels
+ * (with float accumulation pixels).
+ */
+class box_blur_kernel
+{
+public:
+	typedef float value_type;
+	typedef detail::box_blur_tag is_fixed_size_t;
+
+public:
+	box_blur_kernel() {}
+	explicit box_blur_kernel( const std::vector<std::size_t>& radius ) : _radius( radius ) {}
+
+	/// radius of each box filter (a box of radius r has 2*r+1 values)
+	const std::vector<std::size_t>& radius() const { return _radius; }
+
+	std::size_t left_size() const { return std::accumulate( _radius.begin(), _radius.end(), std::size_t( 0 ) ); }
+	std::size_t right_size() const { return left_size(); }
+	std::size_t size() const { return _radius.empty() ? 0 : 2 * left_size() + 1; }
+
+private:
+	std::vector<std::size_t> _radius;
+};
+
+/// true if Kernel is a box_blur_kernel, which needs float accumulation pixels
+template<typename Kernel>
+struct is_box_blur_kernel : boost::is_same<typename Kernel::is_fixed_size_t, detail::box_blur_tag> {};
+
+/**
+ * @brief create the box filters approximating the gaussian kernel of buildGaussian1DKernel
+ * The box sizes are chosen to get the gaussian variance (W. Wells, "Efficient synthesis of
+ * Gaussian filters by cascaded uniform filters", 1986).
+ *
+ * Accuracy with the default 4 passes, for size >= 25 (standard deviation >= 5):
+ * the difference with the normalized gaussian kernel is below 5% of the kernel peak,
+ * and the sum of the absolute differences is below 5%, so on each axis the result differs
+ * from the gaussian blur by less than 5% of the image range.
+ * Errors increase for smaller sizes, where the gaussian kernel is small anyway.
+ *
+ * @param size same as buildGaussian1DKernel (variance of the gaussian)
+ */
+template<typename Scalar>
+box_blur_kernel buildBoxBlurKernel( const Scalar size, const std::size_t nbPasses = kBoxBlurNbPasses )
+{
+	if( size <= 0 || nbPasses == 0 )
+		return box_blur_kernel();
+
+	const double n = static_cast<double>( nbPasses );
+	// ideal box width, rounded to an odd value
+	const double idealWidth = std::sqrt( 12.0 * size / n + 1.0 );
+	std::size_t lowerWidth = static_cast<std::size_t>( idealWidth );
+	if( lowerWidth % 2 == 0 )
+		--lowerWidth;
+	lowerWidth = std::max( lowerWidth, std::size_t( 1 ) );
+	const double wl = static_cast<double>( lowerWidth );
+
+	// number of boxes of lowerWidth, the others use lowerWidth + 2
+	const double idealNbLower = ( 12.0 * size - n * wl * wl - 4.0 * n * wl - 3.0 * n ) / ( -4.0 * wl - 4.0 );
+	const std::size_t nbLower = static_cast<std::size_t>( std::min( n, std::max( 0.0, std::floor( idealNbLower + 0.5 ) ) ) );
+
+	std::vector<std::size_t> radius( nbPasses, lowerWidth / 2 + 1 );
+	std::fill_n( radius.begin(), nbLower, lowerWidth / 2 );
+	return box_blur_kernel( radius );
+}
+
+namespace detail {
+
+/**
+ * @brief Successive box filters along a line of elements, each element is made of width contiguous floats.
+ * Each pass is done in place: out[i] = mean( in[i], ..., in[i+2*r] ).
+ * @param[in,out] line nbElements + 2 * ker.left_size() elements, the result is in the nbElements first elements
+ * @param sums buffer of width values for the running sums
+ */
+inline void box_blur_line( float* line, const std::size_t nbElements, const std::size_t width,
+                           const std::vector<std::size_t>& radius, double* sums )
+{
+	std::size_t size = nbElements + 2 * std::accumulate( radius.begin(), radius.end(), std::size_t( 0 ) );
+	for( std::vector<std::size_t>::const_iterator r = radius.begin(); r != radius.end(); ++r )
+	{
+		if( *r == 0 )
+			continue;
+		const std::size_t window  = 2 * *r + 1;
+		const std::size_t outSize = size - 2 * *r;
+		const double norm = 1.0 / window;
+
+		std::fill_n( sums, width, 0.0 );
+		for( std::size_t k = 0; k < window; ++k )
+		{
+			const float* in = line + k * width;
+			for( std::size_t c = 0; c < width; ++c )
+				sums[c] += in[c];
+		}
+		for( std::size_t i = 0; i + 1 < outSize; ++i )
+		{
+			// out is the first value of the window, read it before writing
+			float* out = line + i * width;
+			const float* in = out + window * width;
+			for( std::size_t c = 0; c < width; ++c )
+			{
+				const double s = sums[c];
+				sums[c] = s + in[c] - out[c];
+				out[c] = static_cast<float>( s * norm );
+			}
+		}
+		float* out = line + ( outSize - 1 ) * width;
+		for( std::size_t c = 0; c < width; ++c )
+			out[c] = static_cast<float>( sums[c] * norm );
+		size = outSize;
+	}
+}
+
+/// source coordinate used for a coordinate outside of the source, -1 for a zero value
+template <typename Coord>
+GIL_FORCEINLINE
+Coord box_blur_source_coord( const Coord c, const Coord size, const convolve_boundary_option option )
+{
+	if( ( c >= 0 && c < size ) || option == convolve_option_extend_padded )
+		return c;
+	switch( option )
+	{
+		case convolve_option_extend_constant:
+			return std::min( std::max( c, Coord( 0 ) ), size - 1 );
+		case convolve_option_extend_mirror:
+			return mirror_coord( c, size );
+		default:
+			return -1;
+	}
+}
+
+/// compute the box blur along the rows of an image
+/// @param dst_tl topleft point of dst in src coordinates
+template <typename PixelAccum,typename SrcView,typename DstView>
+void box_blur_rows_imp( const SrcView& src, const box_blur_kernel& ker, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                        const convolve_boundary_option option )
+{
+	using namespace terry::numeric;
+	BOOST_STATIC_ASSERT(( is_float_pixel_accum<PixelAccum>::value ));
+
+	typedef typename SrcView::point_t::value_type coord_t;
+	typedef typename pixel_proxy<typename SrcView::value_type>::type PIXEL_SRC_REF;
+	typedef typename pixel_proxy<typename DstView::value_type>::type PIXEL_DST_REF;
+	static const std::size_t nbChannels = num_channels<PixelAccum>::value;
+
+	assert( dst_tl <= src.dimensions() );
+	if( dst.dimensions().x == 0 || dst.dimensions().y == 0 )
+		return;
+
+	const coord_t margin = boost::numeric_cast<coord_t>( ker.left_size() );
+	const coord_t width  = src.dimensions().x;
+	const coord_t first  = dst_tl.x - margin;
+	// outputs computed only from source values
+	const coord_t valid_begin = std::min( std::max( margin - dst_tl.x, coord_t( 0 ) ), dst.dimensions().x );
+	const coord_t valid_end   = std::max( std::min( width - margin - dst_tl.x, dst.dimensions().x ), valid_begin );
+	const bool    output_only = option == convolve_option_output_ignore || option == convolve_option_output_zero;
+
+	std::vector<PixelAccum> line( dst.dimensions().x + 2 * margin );
+	std::vector<double> sums( nbChannels );
+	PixelAccum acc_zero; pixel_zeros_t<PixelAccum>()( acc_zero );
+	typename DstView::value_type dst_zero; pixel_assigns_t<PixelAccum,PIXEL_DST_REF>()( acc_zero, dst_zero );
+
+	for( coord_t yy = 0; yy < dst.dimensions().y; ++yy )
+	{
+		const typename SrcView::x_iterator src_it = src.row_begin( yy + dst_tl.y );
+		for( coord_t i = 0; i < coord_t( line.size() ); ++i )
+		{
+			const coord_t x = box_blur_source_coord( first + i, width, option );
+			if( x < 0 )
+				line[i] = acc_zero;
+			else
+				pixel_assigns_t<PIXEL_SRC_REF,PixelAccum>()( src_it[x], line[i] );
+		}
+		box_blur_line( reinterpret_cast<float*>( &line.front() ), dst.dimensions().x, nbChannels, ker.radius(), &sums.front() );
+
+		typename DstView::x_iterator dst_it = dst.row_begin( yy );
+		if( ! output_only )
+		{
+			assign_pixels( &line.front(), &line.front() + dst.dimensions().x, dst_it );
+			continue;
+		}
+		if( option == convolve_option_output_zero )
+		{
+			std::fill_n( dst_it, valid_begin, dst_zero );
+			std::fill( dst_it + valid_end, dst_it + dst.dimensions().x, dst_zero );
+		}
+		assign_pixels( &line.front() + valid_begin, &line.front() + valid_end, dst_it + valid_begin );
+	}
+}
+
+/// compute the box blur along the columns of an image
+/// The image is processed by vertical strips, so the box filters run on contiguous rows of the strip.
+/// It works in place, as each strip is read before being written.
+/// @param dst_tl topleft point of dst in src coordinates
+template <typename PixelAccum,typename SrcView,typename DstView>
+void box_blur_cols_imp( const SrcView& src, const box_blur_kernel& ker, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                        const convolve_boundary_option option )
+{
+	using namespace terry::numeric;
+	BOOST_STATIC_ASSERT(( is_float_pixel_accum<PixelAccum>::value ));
+
+	typedef typename SrcView::point_t::value_type coord_t;
+	typedef typename pixel_proxy<typename DstView::value_type>::type PIXEL_DST_REF;
+	static const std::size_t nbChannels = num_channels<PixelAccum>::value;
+	static const coord_t strip_width = 64;
+
+	assert( dst_tl <= src.dimensions() );
+	if( dst.dimensions().x == 0 || dst.dimensions().y == 0 )
+		return;
+
+	const coord_t margin = boost::numeric_cast<coord_t>( ker.left_size() );
+	const coord_t height = src.dimensions().y;
+	const coord_t first  = dst_tl.y - margin;
+	const coord_t nb_rows = dst.dimensions().y + 2 * margin;
+	const bool    output_only = option == convolve_option_output_ignore || option == convolve_option_output_zero;
+
+	std::vector<PixelAccum> strip( nb_rows * strip_width );
+	std::vector<double> sums( strip_width * nbChannels );
+	PixelAccum acc_zero; pixel_zeros_t<PixelAccum>()( acc_zero );
+	typename DstView::value_type dst_zero; pixel_assigns_t<PixelAccum,PIXEL_DST_REF>()( acc_zero, dst_zero );
+
+	for( coord_t x0 = 0; x0 < dst.dimensions().x; x0 += strip_width )
+	{
+		const coord_t width = std::min( strip_width, dst.dimensions().x - x0 );
+		const coord_t src_x = dst_tl.x + x0;
+		for( coord_t k = 0; k < nb_rows; ++k )
+		{
+			PixelAccum* row = &strip[k * width];
+			const coord_t y = box_blur_source_coord( first + k, height, option );
+			if( y < 0 )
+				std::fill_n( row, width, acc_zero );
+			else
+				assign_pixels( src.x_at( src_x, y ), src.x_at( src_x, y ) + width, row );
+		}
+		box_blur_line( reinterpret_cast<float*>( &strip.front() ), dst.dimensions().y, width * nbChannels, ker.radius(), &sums.front() );
+
+		for( coord_t yy = 0; yy < dst.dimensions().y; ++yy )
+		{
+			const coord_t y = yy + dst_tl.y;
+			if( output_only && ( y - margin < 0 || y + margin >= height ) )
+			{
+				if( option == convolve_option_output_zero )
+					std::fill_n( dst.x_at( x0, yy ), width, dst_zero );
+				continue;
+			}
+			assign_pixels( &strip[yy * width], &strip[yy * width] + width, dst.x_at( x0, yy ) );
+		}
+	}
+}
+
+/// @ingroup ImageAlgorithms
+/// box blur along the rows of an image
+template <typename PixelAccum,typename SrcView,typename Kernel,typename DstView>
+GIL_FORCEINLINE
+void correlate_1d_imp( const SrcView& src, const Kernel& ker, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                   const convolve_boundary_option option, const boost::mpl::true_ rows, const box_blur_tag )
+{
+	box_blur_rows_imp<PixelAccum>( src, ker, dst, dst_tl, option );
+}
+
+/// @ingroup ImageAlgorithms
+/// box blur along the columns of an image
+template <typename PixelAccum,typename SrcView,typename Kernel,typename DstView>
+GIL_FORCEINLINE
+void correlate_1d_imp( const SrcView& src, const Kernel& ker, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                   const convolve_boundary_option option, const boost::mpl::false_ rows, const box_blur_tag )
+{
+	box_blur_cols_imp<PixelAccum>( src, ker, dst, dst_tl, option );
+}
+
+/// @ingroup ImageAlgorithms
+/// box blur kernels have no fixed-size version
+template <bool rows, typename PixelAccum,typename SrcView,typename Kernel,typename DstView>
+GIL_FORCEINLINE
+void correlate_1d_auto_imp( const SrcView& src, const Kernel& ker, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                          const convolve_boundary_option option, const box_blur_tag fixed )
+{
+	correlate_1d_imp<PixelAccum,SrcView,Kernel,DstView>( src, ker, dst, dst_tl, option, boost::mpl::bool_<rows>(), fixed );
+}
+
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,291 @@
+#ifndef _TERRY_FILTER_CONNECTEDCOMPONENTS_HPP_
+#define _TERRY_FILTER_CONNECTEDCOMPONENTS_HPP_
+
+#include <terry/math/Rect.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace terry {
+namespace filter {
+
+/**
+ * @brief Connected-component labelling of the pixels respecting a condition
+ * in a region of an image, with a union-find forest built by tiles.
+ *
+ * 1. label_tile: the tiles are labelled independently, the trees of a tile
+ *    only contain pixels of this tile, so the tiles can be labelled by different threads.
+ * 2. merge_tiles: the components are merged across the tile borders
+ *    (sequential, only the pixels on the borders are read).
+ * 3. label / is_marked: read only, can be called by different threads.
+ *
+ * A component is marked if one of its pixels respects the seed condition,
+ * so a hysteresis threshold keeps the marked components.
+ * The coordinates are the coordinates of the labelled view.
+ * The conditions are tested on the first channel, like flood_fill.
+ * Connexity is floodFill::Connexity4 or floodFill::Connexity8.
+ */
+class connected_components
+{
+public:
+	typedef boost::uint32_t Label;
+	static const Label kNoLabel = 0xFFFFFFFF; ///< pixel out of the components
+
+public:
+	connected_components()
+	: _region( 0, 0, 0, 0 )
+	, _tileSize( 1 )
+	, _nbTilesX( 0 )
+	, _nbTilesY( 0 )
+	{}
+
+	void reset( const Rect<std::ssize_t>& region, const std::ssize_t tileSize = 256 )
+	{
+		_region = region;
+		_tileSize = std::max( tileSize, std::ssize_t( 1 ) );
+		_nbTilesX = region.x2 > region.x1 ? ( region.x2 - region.x1 + _tileSize - 1 ) / _tileSize : 0;
+		_nbTilesY = region.y2 > region.y1 ? ( region.y2 - region.y1 + _tileSize - 1 ) / _tileSize : 0;
+		_parent.assign( nb_tiles() > 0 ? width() * height() : 0, static_cast<Label>( kNoLabel ) );
+		_marked.assign( _parent.size(), 0 );
+	}
+
+	const Rect<std::ssize_t>& region() const { return _region; }
+
+	std::size_t nb_tiles() const { return _nbTilesX * _nbTilesY; }
+
+	Rect<std::ssize_t> tile( const std::size_t i ) const
+	{
+		Rect<std::ssize_t> t;
+		t.x1 = _region.x1 + ( i % _nbTilesX ) * _tileSize;
+		t.y1 = _region.y1 + ( i / _nbTilesX ) * _tileSize;
+		t.x2 = std::min( t.x1 + _tileSize, _region.x2 );
+		t.y2 = std::min( t.y1 + _tileSize, _region.y2 );
+		return t;
+	}
+
+	/**
+	 * @brief Label the pixels of a tile respecting the condition,
+	 * connected inside the tile.
+	 */
+	template<class Connexity, class View, class Test, class SeedTest>
+	void label_tile( const std::size_t i, const View& view, const Test& test, const SeedTest& seedTest )
+	{
+		const Rect<std::ssize_t> t = tile( i );
+		for( std::ssize_t y = t.y1; y < t.y2; ++y )
+		{
+			typename View::x_iterator it = view.x_at( t.x1, y );
+			Label p = index( t.x1, y );
+			for( std::ssize_t x = t.x1; x < t.x2; ++x, ++it, ++p )
+			{
+				if( ! test( (*it)[0] ) )
+					continue;
+				_parent[p] = p;
+				_marked[p] = seedTest( (*it)[0] );
+				const Label up = p - width();
+				if( x > t.x1 )
+					join( p - 1, p );
+				if( y > t.y1 )
+				{
+					join( up, p );
+					if( Connexity::x && x > t.x1 )
+						join( up - 1, p );
+					if( Connexity::x && x + 1 < t.x2 )
+						join( up + 1, p );
+				}
+			}
+		}
+		// each pixel points to the root of its tile component
+		for( std::ssize_t y = t.y1; y < t.y2; ++y )
+		{
+			Label p = index( t.x1, y );
+			for( std::ssize_t x = t.x1; x < t.x2; ++x, ++p )
+			{
+				if( _parent[p] != kNoLabel )
+					_parent[p] = root( p );
+			}
+		}
+	}
+
+	/**
+	 * @brief Merge the components across the tile borders,
+	 * once all the tiles are labelled.
+	 */
+	template<class Connexity>
+	void merge_tiles()
+	{
+		_linked.clear();
+		// vertical borders
+		for( std::ssize_t tx = 1; tx < _nbTilesX; ++tx )
+		{
+			const std::ssize_t x = _region.x1 + tx * _tileSize;
+			for( std::ssize_t y = _region.y1; y < _region.y2; ++y )
+			{
+				const Label p = index( x, y );
+				if( _parent[p] == kNoLabel )
+					continue;
+				link( p - 1, p );
+				if( Connexity::x && y > _region.y1 )
+					link( p - 1 - width(), p );
+				if( Connexity::x && y + 1 < _region.y2 )
+					link( p - 1 + width(), p );
+			}
+		}
+		// horizontal borders
+		for( std::ssize_t ty = 1; ty < _nbTilesY; ++ty )
+		{
+			const std::ssize_t y = _region.y1 + ty * _tileSize;
+			for( std::ssize_t x = _region.x1; x < _region.x2; ++x )
+			{
+				const Label p = index( x, y );
+				if( _parent[p] == kNoLabel )
+					continue;
+				link( p - width(), p );
+				if( Connexity::x && x > _region.x1 )
+					link( p - width() - 1, p );
+				if( Connexity::x && x + 1 < _region.x2 )
+					link( p - width() + 1, p );
+			}
+		}
+		// the tile roots point to the final roots: two reads at most for each pixel
+		for( std::vector<Label>::const_iterator it = _linked.begin(); it != _linked.end(); ++it )
+			_parent[*it] = root( *it );
+		_linked.clear();
+	}
+
+	/// @return true if the pixel is in a component
+	bool is_inside( const std::ssize_t x, const std::ssize_t y ) const
+	{
+		return _parent[index( x, y )] != kNoLabel;
+	}
+
+	/// @return the label of the component of a pixel (index of its first pixel in the region), or kNoLabel
+	Label label( const std::ssize_t x, const std::ssize_t y ) const
+	{
+		const Label p = _parent[index( x, y )];
+		return p == kNoLabel ? kNoLabel : find( p );
+	}
+
+	/// @return true if the pixel is in a component containing a seed
+	bool is_marked( const std::ssize_t x, const std::ssize_t y ) const
+	{
+		const Label l = label( x, y );
+		return l != kNoLabel && _marked[l];
+	}
+
+	/**
+	 * @brief Set the pixels of the marked components of a window to value,
+	 * the other pixels are unchanged.
+	 * @param[in] window inside the region
+	 * @param[out] dstView view of the window (same size)
+	 */
+	template<class DView>
+	void fill_marked( const Rect<std::ssize_t>& window, const DView& dstView, const typename DView::value_type& value ) const
+	{
+		for( std::ssize_t y = window.y1; y < window.y2; ++y )
+		{
+			typename DView::x_iterator it = dstView.row_begin( y - window.y1 );
+			for( std::ssize_t x = window.x1; x < window.x2; ++x, ++it )
+			{
+				if( is_marked( x, y ) )
+					*it = value;
+			}
+		}
+	}
+
+private:
+	std::ssize_t width() const { return _region.x2 - _region.x1; }
+	std::ssize_t height() const { return _region.y2 - _region.y1; }
+
+	Label index( const std::ssize_t x, const std::ssize_t y ) const
+	{
+		return static_cast<Label>( ( y - _region.y1 ) * width() + ( x - _region.x1 ) );
+	}
+
+	/// root without modification of the forest
+	Label find( Label p ) const
+	{
+		while( _parent[p] != p )
+			p = _parent[p];
+		return p;
+	}
+
+	/// root with path compression
+	Label root( const Label p )
+	{
+		Label r = find( p );
+		for( Label q = p; _parent[q] != r; )
+		{
+			const Label next = _parent[q];
+			_parent[q] = r;
+			q = next;
+		}
+		return r;
+	}
+
+	/**
+	 * @brief Union of the components of two pixels, the root is the smallest index.
+	 * @return the root linked to the other one, or kNoLabel
+	 */
+	Label join( const Label a, const Label b )
+	{
+		if( _parent[a] == kNoLabel || _parent[b] == kNoLabel )
+			return kNoLabel;
+		Label ra = root( a );
+		Label rb = root( b );
+		if( ra == rb )
+			return kNoLabel;
+		if( rb < ra )
+			std::swap( ra, rb );
+		_parent[rb] = ra;
+		_marked[ra] |= _marked[rb];
+		return rb;
+	}
+
+	/// join across the tile borders
+	void link( const Label a, const Label b )
+	{
+		const Label linked = join( a, b );
+		if( linked != kNoLabel )
+			_linked.push_back( linked );
+	}
+
+private:
+	Rect<std::ssize_t> _region;
+	std::ssize_t _tileSize;
+	std::ssize_t _nbTilesX;
+	std::ssize_t _nbTilesY;
+	std::vector<Label> _parent; ///< union-find forest, one element per pixel of the region
+	std::vector<unsigned char> _marked; ///< valid for the roots
+	std::vector<Label> _linked; ///< roots linked by merge_tiles
+};
+
+/**
+ * @brief Hysteresis threshold: set the pixels respecting the soft condition
+ * connected with a pixel respecting the strong condition to value, in a region
+ * (same coordinates in both views).
+ * Same purpose as flood_fill, the tiles are labelled sequentially,
+ * a multi-threaded caller uses connected_components directly.
+ */
+template<class Connexity, class StrongTest, class SoftTest, class SView, class DView>
+void hysteresis_threshold( const SView& srcView, const DView& dstView,
+                           const Rect<std::ssize_t>& region,
+                           const StrongTest& strongTest, const SoftTest& softTest,
+                           const typename DView::value_type& value )
+{
+	connected_components components;
+	components.reset( region );
+	if( components.nb_tiles() == 0 )
+		return;
+	for( std::size_t i = 0; i < components.nb_tiles(); ++i )
+		components.label_tile<Connexity>( i, srcView, softTest, strongTest );
+	components.merge_tiles<Connexity>();
+	components.fill_marked( region, subimage_view( dstView, region.x1, region.y1, region.x2 - region.x1, region.y2 - region.y1 ), value );
+}
+
+}
+}
+
+#endif
@@ -17,6 +17,7 @@
 
 #include <cstddef>
 #include <cassert>
+#include <limits>
 #include <algorithm>
 #include <vector>
 #include <functional>
@@ -259,6 +260,7 @@ class correlator_n
 {
 private:
     std::size_t _size;
+    float_pixels_correlator<0,PixelAccum> _float_correlator;
 public:
     correlator_n(std::size_t size_in) : _size(size_in) {}
     template <typename SrcIterator,typename KernelIterator,typename DstIterator>
@@ -266,23 +268,174 @@ public:
     void operator()(SrcIterator src_begin,SrcIterator src_end,
                     KernelIterator ker_begin,
                     DstIterator dst_begin) {
+        correlate(src_begin,src_end,ker_begin,dst_begin,typename use_float_correlation<SrcIterator,PixelAccum>::type());
+    }
+private:
+    template <typename SrcIterator,typename KernelIterator,typename DstIterator>
+	GIL_FORCEINLINE
+    void correlate(SrcIterator src_begin,SrcIterator src_end,
+                   KernelIterator ker_begin,
+                   DstIterator dst_begin, const boost::mpl::false_ /*float*/) {
         correlate_pixels_n<PixelAccum>(src_begin,src_end,ker_begin,_size,dst_begin);
     }
+    template <typename SrcIterator,typename KernelIterator,typename DstIterator>
+	GIL_FORCEINLINE
+    void correlate(SrcIterator src_begin,SrcIterator src_end,
+                   KernelIterator ker_begin,
+                   DstIterator dst_begin, const boost::mpl::true_ /*float*/) {
+        _float_correlator(src_begin,src_end,ker_begin,_size,dst_begin);
+    }
 };
 
 template <std::size_t Size,typename PixelAccum>
 struct correlator_k
 {
+private:
+    float_pixels_correlator<Size,PixelAccum> _float_correlator;
 public:
     template <typename SrcIterator,typename KernelIterator,typename DstIterator>
 	GIL_FORCEINLINE
     void operator()(SrcIterator src_begin,SrcIterator src_end,
                     KernelIterator ker_begin,
                     DstIterator dst_begin){
+        correlate(src_begin,src_end,ker_begin,dst_begin,typename use_float_correlation<SrcIterator,PixelAccum>::type());
+    }
+private:
+    template <typename SrcIterator,typename KernelIterator,typename DstIterator>
+	GIL_FORCEINLINE
+    void correlate(SrcIterator src_begin,SrcIterator src_end,
+                   KernelIterator ker_begin,
+                   DstIterator dst_begin, const boost::mpl::false_ /*float*/) {
         correlate_pixels_k<Size,PixelAccum>(src_begin,src_end,ker_begin,dst_begin);
     }
+    template <typename SrcIterator,typename KernelIterator,typename DstIterator>
+	GIL_FORCEINLINE
+    void correlate(SrcIterator src_begin,SrcIterator src_end,
+                   KernelIterator ker_begin,
+                   DstIterator dst_begin, const boost::mpl::true_ /*float*/) {
+        _float_correlator(src_begin,src_end,ker_begin,Size,dst_begin);
+    }
 };
 
+/// symmetric reflection of a coordinate inside [0, size), same as the rows mirror option
+template <typename Coord>
+GIL_FORCEINLINE
+Coord mirror_coord( const Coord c, const Coord size )
+{
+	const Coord period = 2 * size;
+	Coord m = c % period;
+	if( m < 0 )
+		m += period;
+	return m < size ? m : period - 1 - m;
+}
+
+/// slot of a row in a rolling buffer of nb_rows rows
+template <typename Coord>
+GIL_FORCEINLINE
+std::size_t ring_slot( const Coord row, const std::size_t nb_rows )
+{
+	const Coord n = Coord( nb_rows );
+	return std::size_t( ( row % n + n ) % n );
+}
+
+/// compute the correlation of 1D kernel with the columns of an image of float accumulation pixels
+/// Instead of walking along each column, the image is processed by vertical strips:
+/// a rolling buffer keeps the ker.size() source rows of the strip needed by the current output row,
+/// so each output row is a weighted sum of contiguous lines (see detail::correlate_lines).
+/// It also works in place (src and dst views on the same image with dst_tl = 0) for kernels with
+/// right_size() <= left_size() + 1, as each source row is read before being overwritten.
+/// @param dst_tl topleft point of dst in src coordinates
+template <std::size_t Size,typename PixelAccum,typename SrcView,typename Kernel,typename DstView>
+void correlate_cols_float_imp( const SrcView& src, const Kernel& ker, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                               const convolve_boundary_option option )
+{
+	using namespace terry::numeric;
+
+	assert( dst_tl <= src.dimensions() );
+	assert( ker.size() != 0 );
+
+	typedef typename SrcView::point_t::value_type coord_t;
+	typedef typename pixel_proxy<typename DstView::value_type>::type PIXEL_DST_REF;
+	static const std::size_t nbChannels = num_channels<PixelAccum>::value;
+	// kernel rows of a strip stay in the cache
+	static const coord_t strip_width = 256;
+
+	if( dst.dimensions().x == 0 || dst.dimensions().y == 0 )
+		return;
+
+	const std::size_t ker_size = ker.size();
+	const coord_t left         = boost::numeric_cast<coord_t>( ker.left_size() );
+	const coord_t height       = src.dimensions().y;
+	const coord_t no_row       = std::numeric_limits<coord_t>::min();
+
+	std::vector<float> kernel( ker.begin(), ker.end() );
+	std::vector<PixelAccum> ring( ker_size * strip_width );
+	std::vector<coord_t> ring_rows( ker_size );
+	std::vector<const float*> lines( ker_size );
+	std::vector<PixelAccum> out( strip_width );
+
+	PixelAccum acc_zero; pixel_zeros_t<PixelAccum>()( acc_zero );
+	typename DstView::value_type dst_zero; pixel_assigns_t<PixelAccum,PIXEL_DST_REF>()( acc_zero, dst_zero );
+
+	for( coord_t x0 = 0; x0 < dst.dimensions().x; x0 += strip_width )
+	{
+		const coord_t width = std::min( strip_width, dst.dimensions().x - x0 );
+		const coord_t src_x = dst_tl.x + x0;
+		std::fill( ring_rows.begin(), ring_rows.end(), no_row );
+
+		for( coord_t yy = 0; yy < dst.dimensions().y; ++yy )
+		{
+			const coord_t first = yy + dst_tl.y - left;
+			if( ( option == convolve_option_output_ignore || option == convolve_option_output_zero ) &&
+			    ( first < 0 || first + coord_t( ker_size ) > height ) )
+			{
+				if( option == convolve_option_output_zero )
+					std::fill_n( dst.x_at( x0, yy ), width, dst_zero );
+				continue;
+			}
+			for( std::size_t k = 0; k < ker_size; ++k )
+			{
+				const coord_t row = first + coord_t( k );
+				const std::size_t slot = ring_slot( row, ker_size );
+				PixelAccum* line = &ring[slot * strip_width];
+				lines[k] = reinterpret_cast<const float*>( line );
+				if( ring_rows[slot] == row )
+					continue;
+				ring_rows[slot] = row;
+
+				// source row read for this virtual row
+				coord_t src_row = row;
+				if( ( row < 0 || row >= height ) && option != convolve_option_extend_padded )
+				{
+					switch( option )
+					{
+						case convolve_option_extend_constant:
+							src_row = std::min( std::max( row, coord_t( 0 ) ), height - 1 );
+							break;
+						case convolve_option_extend_mirror:
+							src_row = mirror_coord( row, height );
+							break;
+						default: // extend_zero
+							std::fill_n( line, width, acc_zero );
+							continue;
+					}
+					// the source row may already be overwritten when working in place, use the buffered copy
+					const std::size_t src_slot = ring_slot( src_row, ker_size );
+					if( ring_rows[src_slot] == src_row )
+					{
+						std::copy( &ring[src_slot * strip_width], &ring[src_slot * strip_width] + width, line );
+						continue;
+					}
+				}
+				assign_pixels( src.x_at( src_x, src_row ), src.x_at( src_x, src_row ) + width, line );
+			}
+			correlate_lines<Size>( &lines.front(), &kernel.front(), ker_size,
+			                       reinterpret_cast<float*>( &out.front() ), width * nbChannels );
+			assign_pixels( &out.front(), &out.front() + width, dst.x_at( x0, yy ) );
+		}
+	}
+}
+
 /// @ingroup ImageAlgorithms
 /// correlate a 1D variable-size kernel along the rows of an image
 template <typename PixelAccum,typename SrcView,typename Kernel,typename DstView>
@@ -303,6 +456,26 @@ void correlate_1d_imp( const SrcView& src, const Kernel& ker, const DstView& dst
 	correlate_rows_imp<PixelAccum>(src,ker,dst,dst_tl,option,detail::correlator_k<Kernel::static_size,PixelAccum>());
 }
 
+/// @ingroup ImageAlgorithms
+/// correlate a 1D kernel along the columns of an image, as rows of the transposed image
+template <std::size_t Size,typename PixelAccum,typename SrcView,typename Kernel,typename DstView,typename Fixed>
+GIL_FORCEINLINE
+void correlate_cols_1d_imp( const SrcView& src, const Kernel& ker, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                   const convolve_boundary_option option, const Fixed fixed, const boost::mpl::false_ /*float*/ )
+{
+	correlate_1d_imp<PixelAccum>( transposed_view(src), ker, transposed_view(dst), typename SrcView::point_t(dst_tl.y, dst_tl.x), option, boost::mpl::true_(), fixed );
+}
+
+/// @ingroup ImageAlgorithms
+/// correlate a 1D kernel along the columns of an image, with the vectorized float path
+template <std::size_t Size,typename PixelAccum,typename SrcView,typename Kernel,typename DstView,typename Fixed>
+GIL_FORCEINLINE
+void correlate_cols_1d_imp( const SrcView& src, const Kernel& ker, const DstView& dst, const typename SrcView::point_t& dst_tl,
+                   const convolve_boundary_option option, const Fixed /*fixed*/, const boost::mpl::true_ /*float*/ )
+{
+	correlate_cols_float_imp<Size,PixelAccum>( src, ker, dst, dst_tl, option );
+}
+
 /// @ingroup ImageAlgorithms
 /// correlate a 1D variable-size kernel along the columns of an image
 /// can be remove with "fixed" param as template argument
@@ -311,7 +484,7 @@ GIL_FORCEINLINE
 void correlate_1d_imp( const SrcView& src, const Kernel& ker, const DstView& dst, const typename SrcView::point_t& dst_tl,
                    const convolve_boundary_option option, const boost::mpl::false_ rows, const boost::mpl::false_ fixed )
 {
-	correlate_1d_imp<PixelAccum>( transposed_view(src), ker, transposed_view(dst), typename SrcView::point_t(dst_tl.y, dst_tl.x), option, boost::mpl::true_(), fixed );
+	correlate_cols_1d_imp<0,PixelAccum>( src, ker, dst, dst_tl, option, fixed, typename is_float_pixel_accum<PixelAccum>::type() );
 }
 
 /// @ingroup ImageAlgorithms
@@ -321,7 +494,7 @@ GIL_FORCEINLINE
 void correlate_1d_imp( const SrcView& src, const Kernel& ker, const DstView& dst, const typename SrcView::point_t& dst_tl,
                    const convolve_boundary_option option, const boost::mpl::false_ rows, const boost::mpl::true_ fixed )
 {
-	correlate_1d_imp<PixelAccum>( transposed_view(src), ker, transposed_view(dst), typename SrcView::point_t(dst_tl.y, dst_tl.x), option, boost::mpl::true_(), fixed );
+	correlate_cols_1d_imp<Kernel::static_size,PixelAccum>( src, ker, dst, dst_tl, option, fixed, typename is_float_pixel_accum<PixelAccum>::type() );
 }
 
 /// @ingroup ImageAlgorithms
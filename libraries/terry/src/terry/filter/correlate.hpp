@@ -2,12 +2,21 @@
 #define _TERRY_FILTER_CORRELATE_HPP_
 
 #include "detail/inner_product.hpp"
+#include "detail/correlate_lines.hpp"
 
 #include <terry/numeric/operations.hpp>
 #include <terry/numeric/assign.hpp>
 #include <terry/numeric/init.hpp>
 #include <terry/pixel_proxy.hpp>
 
+#include <boost/gil/channel.hpp>
+#include <boost/gil/metafunctions.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/mpl/and.hpp>
+
+#include <vector>
+
 
 namespace terry {
 namespace filter {
@@ -69,6 +78,67 @@ DstIterator correlate_pixels_k(
     return dst_begin;
 }
 
+/// @brief Accumulation pixels with 32 bits float channels use the vectorized correlations
+template <typename PixelAccum>
+struct is_float_pixel_accum : boost::is_same<typename channel_type<PixelAccum>::type, bits32f> {};
+
+/// @brief The rows correlation reads a buffer of accumulation pixels
+template <typename SrcIterator, typename PixelAccum>
+struct use_float_correlation : boost::mpl::and_< boost::is_same<SrcIterator, PixelAccum*>, is_float_pixel_accum<PixelAccum> > {};
+
+/**
+ * @brief 1D un-guarded correlation of float pixels.
+ * The buffer is seen as a line of floats, so all the channels are processed together by the vectorized core.
+ * Keeps its temporary buffers between the rows.
+ */
+template <std::size_t Size, typename PixelAccum>
+class float_pixels_correlator
+{
+	BOOST_STATIC_ASSERT(( sizeof( PixelAccum ) == num_channels<PixelAccum>::value * sizeof( float ) ));
+
+private:
+	std::vector<float>        _kernel;
+	std::vector<const float*> _lines;
+	std::vector<PixelAccum>   _row;
+
+public:
+	/// directly correlate into the destination
+	template <typename KernelIterator>
+	PixelAccum* operator()( const PixelAccum* src_begin, const PixelAccum* src_end,
+	                        KernelIterator ker_begin, const std::size_t ker_size, PixelAccum* dst_begin )
+	{
+		correlate( src_begin, src_end - src_begin, ker_begin, ker_size, dst_begin );
+		return dst_begin + ( src_end - src_begin );
+	}
+
+	/// correlate in a float row, then convert to the destination pixels
+	template <typename KernelIterator, typename DstIterator>
+	DstIterator operator()( const PixelAccum* src_begin, const PixelAccum* src_end,
+	                        KernelIterator ker_begin, const std::size_t ker_size, DstIterator dst_begin )
+	{
+		const std::size_t width = src_end - src_begin;
+		if( width == 0 )
+			return dst_begin;
+		_row.resize( width );
+		correlate( src_begin, width, ker_begin, ker_size, &_row.front() );
+		return terry::numeric::assign_pixels( &_row.front(), &_row.front() + width, dst_begin );
+	}
+
+private:
+	template <typename KernelIterator>
+	void correlate( const PixelAccum* src_begin, const std::size_t width,
+	                KernelIterator ker_begin, const std::size_t ker_size, PixelAccum* dst_begin )
+	{
+		static const std::size_t nbChannels = num_channels<PixelAccum>::value;
+		const std::size_t n = Size ? Size : ker_size;
+		_kernel.assign( ker_begin, ker_begin + n );
+		_lines.resize( n );
+		const float* src = reinterpret_cast<const float*>( src_begin );
+		for( std::size_t k = 0; k < n; ++k )
+			_lines[k] = src + k * nbChannels;
+		detail::correlate_lines<Size>( &_lines.front(), &_kernel.front(), n, reinterpret_cast<float*>( dst_begin ), width * nbChannels );
+	}
+};
 
 }
 }
@@ -0,0 +1,156 @@
+#ifndef _TERRY_FILTER_DETAIL_CORRELATE_LINES_HPP_
+#define _TERRY_FILTER_DETAIL_CORRELATE_LINES_HPP_
+
+/**
+ * @file
+ * @brief Vectorized core of the float correlations.
+ *
+ * Rows and columns correlations are both expressed as a weighted sum of lines:
+ * dst[i] = sum_k ker[k] * lines[k][i]
+ * - rows: lines[k] is the row shifted by k pixels, so all the channels are processed together,
+ * - columns: lines[k] is the k-th source row, so a whole row of columns is accumulated at once.
+ *
+ * The SSE2 version is selected at compile time, the AVX version is selected at runtime
+ * (with gcc and clang) when the processor supports it.
+ * The Size template parameter is the kernel size when it is known at compile time, 0 otherwise.
+ */
+
+#include <cstddef>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define TERRY_FILTER_SSE2
+#include <emmintrin.h>
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define TERRY_FILTER_AVX
+#include <immintrin.h>
+#endif
+#endif
+
+namespace terry {
+namespace filter {
+namespace detail {
+
+/// @return number of processed values
+template<std::size_t Size>
+inline std::size_t correlate_lines_scalar( const float* const* lines, const float* ker, const std::size_t kerSize,
+                                           float* dst, const std::size_t begin, const std::size_t end )
+{
+	const std::size_t n = Size ? Size : kerSize;
+	for( std::size_t i = begin; i < end; ++i )
+	{
+		float acc = 0.0f;
+		for( std::size_t k = 0; k < n; ++k )
+			acc += ker[k] * lines[k][i];
+		dst[i] = acc;
+	}
+	return end;
+}
+
+#ifdef TERRY_FILTER_SSE2
+
+template<std::size_t Size>
+inline std::size_t correlate_lines_sse2( const float* const* lines, const float* ker, const std::size_t kerSize,
+                                         float* dst, const std::size_t size )
+{
+	const std::size_t n = Size ? Size : kerSize;
+	std::size_t i = 0;
+	// two independent accumulators to hide the latency of the additions
+	for( ; i + 8 <= size; i += 8 )
+	{
+		__m128 acc0 = _mm_setzero_ps();
+		__m128 acc1 = _mm_setzero_ps();
+		for( std::size_t k = 0; k < n; ++k )
+		{
+			const __m128 w = _mm_set1_ps( ker[k] );
+			const float* line = lines[k] + i;
+			acc0 = _mm_add_ps( acc0, _mm_mul_ps( w, _mm_loadu_ps( line ) ) );
+			acc1 = _mm_add_ps( acc1, _mm_mul_ps( w, _mm_loadu_ps( line + 4 ) ) );
+		}
+		_mm_storeu_ps( dst + i, acc0 );
+		_mm_storeu_ps( dst + i + 4, acc1 );
+	}
+	for( ; i + 4 <= size; i += 4 )
+	{
+		__m128 acc = _mm_setzero_ps();
+		for( std::size_t k = 0; k < n; ++k )
+			acc = _mm_add_ps( acc, _mm_mul_ps( _mm_set1_ps( ker[k] ), _mm_loadu_ps( lines[k] + i ) ) );
+		_mm_storeu_ps( dst + i, acc );
+	}
+	return i;
+}
+
+#endif
+
+#ifdef TERRY_FILTER_AVX
+
+template<std::size_t Size>
+__attribute__(( target( "avx" ) ))
+inline std::size_t correlate_lines_avx( const float* const* lines, const float* ker, const std::size_t kerSize,
+                                        float* dst, const std::size_t size )
+{
+	const std::size_t n = Size ? Size : kerSize;
+	std::size_t i = 0;
+	for( ; i + 16 <= size; i += 16 )
+	{
+		__m256 acc0 = _mm256_setzero_ps();
+		__m256 acc1 = _mm256_setzero_ps();
+		for( std::size_t k = 0; k < n; ++k )
+		{
+			const __m256 w = _mm256_set1_ps( ker[k] );
+			const float* line = lines[k] + i;
+			acc0 = _mm256_add_ps( acc0, _mm256_mul_ps( w, _mm256_loadu_ps( line ) ) );
+			acc1 = _mm256_add_ps( acc1, _mm256_mul_ps( w, _mm256_loadu_ps( line + 8 ) ) );
+		}
+		_mm256_storeu_ps( dst + i, acc0 );
+		_mm256_storeu_ps( dst + i + 8, acc1 );
+	}
+	for( ; i + 8 <= size; i += 8 )
+	{
+		__m256 acc = _mm256_setzero_ps();
+		for( std::size_t k = 0; k < n; ++k )
+			acc = _mm256_add_ps( acc, _mm256_mul_ps( _mm256_set1_ps( ker[k] ), _mm256_loadu_ps( lines[k] + i ) ) );
+		_mm256_storeu_ps( dst + i, acc );
+	}
+	return i;
+}
+
+inline bool detect_avx()
+{
+	__builtin_cpu_init();
+	return __builtin_cpu_supports( "avx" );
+}
+
+inline bool cpu_supports_avx()
+{
+	static const bool avx = detect_avx();
+	return avx;
+}
+
+#endif
+
+/**
+ * @brief dst[i] = sum_k ker[k] * lines[k][i], for i in [0, size)
+ * @param[in] lines kerSize lines of at least size values
+ * @param[out] dst must not overlap the lines
+ */
+template<std::size_t Size>
+inline void correlate_lines( const float* const* lines, const float* ker, const std::size_t kerSize,
+                             float* dst, const std::size_t size )
+{
+	std::size_t done = 0;
+#if defined( TERRY_FILTER_AVX )
+	if( cpu_supports_avx() )
+		done = correlate_lines_avx<Size>( lines, ker, kerSize, dst, size );
+	else
+		done = correlate_lines_sse2<Size>( lines, ker, kerSize, dst, size );
+#elif defined( TERRY_FILTER_SSE2 )
+	done = correlate_lines_sse2<Size>( lines, ker, kerSize, dst, size );
+#endif
+	correlate_lines_scalar<Size>( lines, ker, kerSize, dst, done, size );
+}
+
+}
+}
+}
+
+#endif
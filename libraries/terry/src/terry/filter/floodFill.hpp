@@ -1,6 +1,8 @@
 #ifndef _TERRY_FILTER_FLOODFILL_HPP_
 #define _TERRY_FILTER_FLOODFILL_HPP_
 
+#include "connectedComponents.hpp"
+
 #include <terry/globals.hpp>
 #include <terry/draw/fill.hpp>
 #include <terry/basic_colors.hpp>
@@ -610,12 +612,12 @@ void applyFloodFill(
 	if( isConstantImage )
 		return;
 	
-	floodFill::flood_fill<floodFill::Connexity4, floodFill::IsUpper<Scalar>, floodFill::IsUpper<Scalar>, SView, DView, Allocator>(
-				srcView, getBounds<std::ptrdiff_t>(srcView),
-				dstView, getBounds<std::ptrdiff_t>(dstView),
-				rectangleReduce( getBounds<std::ptrdiff_t>(dstView), 1 ),
+	hysteresis_threshold<floodFill::Connexity4>(
+				srcView, dstView,
+				rectangleReduce( getBounds<std::ssize_t>(dstView), 1 ),
 				floodFill::IsUpper<Scalar>(upperThresR),
-				floodFill::IsUpper<Scalar>(lowerThresR)
+				floodFill::IsUpper<Scalar>(lowerThresR),
+				get_white<DPixel>()
 				);
 }
 
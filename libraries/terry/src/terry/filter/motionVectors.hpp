@@ -5,6 +5,7 @@
 #include <terry/filter/convolve.hpp>
 #include <terry/sampler/sampler.hpp>
 #include <terry/sampler/details.hpp>
+#include <terry/sampler/warp.hpp>
 #include <terry/point/operations.hpp>
 
 #include <boost/gil/utilities.hpp>
@@ -13,6 +14,7 @@
 #include <boost/mpl/if.hpp>
 #include <boost/type_traits/is_same.hpp>
 
+#include <algorithm>
 #include <cmath>
 
 namespace terry {
@@ -149,16 +151,9 @@ bool motionvectors_resample_pixels( const SrcView& srcView, const Rect<std::ssiz
 	BOOST_ASSERT( dstView.width() == dstRod.x2 - dstRod.x1 );
 	BOOST_ASSERT( dstView.height() == dstRod.y2 - dstRod.y1 );
 
-	typedef typename DstView::point_t Point2Integer;
 	typedef typename boost::gil::channel_type<VecView>::type::base_channel_t VecChannel;
 	typedef typename boost::gil::point2<VecChannel> VecPoint2;
 	typedef typename DstView::coord_t Coord;
-	typedef typename DstView::value_type DstPixel;
-
-	const point2<std::ssize_t> procWindowSize = procWindowRoW.size();
-	
-	DstPixel black;
-	color_convert( boost::gil::rgba32f_pixel_t( 0.0, 0.0, 0.0, 0.0 ), black );
 
 	// shift between the procWindow and the output clip RoD
 	// __________________________
@@ -184,44 +179,47 @@ bool motionvectors_resample_pixels( const SrcView& srcView, const Rect<std::ssiz
 	shiftProcWinVecRod.x2 = vecRod.x2 - procWindowRoW.x2;
 	shiftProcWinVecRod.y2 = vecRod.y2 - procWindowRoW.y2;
 
-	for( Coord y = procWindowRoW.y1; y < procWindowRoW.y2; ++y )
+	// the source coordinates of a band of rows are stored in a map,
+	// then resampled by the map kernel
+	terry::sampler::coordinates_map map;
+	for( Coord yBand = procWindowRoW.y1; yBand < procWindowRoW.y2; yBand += terry::sampler::kWarpTileSize )
 	{
-		const Coord yDst = y - dstRod.y1;
-		const Coord ySrc = y - srcRod.y1;
-		const Coord yVec = y - vecRod.y1;
-		typename DstView::x_iterator xit_dst  = dstView.x_at( shiftProcWinDstRod.x1, yDst );
-		typename VecView::x_iterator xit_xVec = xVecView.x_at( shiftProcWinVecRod.x1, yVec );
-		typename VecView::x_iterator xit_yVec = yVecView.x_at( shiftProcWinVecRod.x1, yVec );
-		for( Coord x = procWindowRoW.x1;
-		     x < procWindowRoW.x2;
-		     ++x, ++xit_dst, ++xit_xVec, ++xit_yVec )
+		const Coord yBandEnd = std::min( Coord( yBand + terry::sampler::kWarpTileSize ), Coord( procWindowRoW.y2 ) );
+		map.reset( Rect<std::ssize_t>( shiftProcWinDstRod.x1, yBand - dstRod.y1, procWindowRoW.x2 - dstRod.x1, yBandEnd - dstRod.y1 ) );
+		for( Coord y = yBand; y < yBandEnd; ++y )
 		{
-			const Coord xSrc = x - srcRod.x1;
-			const VecPoint2 pos( xSrc, ySrc );
-
-			VecPoint2 motion;
-			if( x < vecRod.x1 || x > vecRod.x2 ||
-			    y < vecRod.y1 || y > vecRod.y2 )
-			{
-				motion.x = 0;
-				motion.y = 0;
-			}
-			else
-			{
-				motion.x = boost::gil::get_color( *xit_xVec, boost::gil::gray_color_t() );
-				motion.y = boost::gil::get_color( *xit_yVec, boost::gil::gray_color_t() );
-			}
-
-			// compute the pixel value according to the resample method
-			if( !terry::sampler::sample( sampler, srcView, pos + motion, *xit_dst, outOfImageProcess ) )
+			const Coord ySrc = y - srcRod.y1;
+			const Coord yVec = y - vecRod.y1;
+			float* coordinates = map.row( y - dstRod.y1 );
+			typename VecView::x_iterator xit_xVec = xVecView.x_at( shiftProcWinVecRod.x1, yVec );
+			typename VecView::x_iterator xit_yVec = yVecView.x_at( shiftProcWinVecRod.x1, yVec );
+			for( Coord x = procWindowRoW.x1;
+			     x < procWindowRoW.x2;
+			     ++x, ++xit_xVec, ++xit_yVec, coordinates += 2 )
 			{
-				*xit_dst = black; // if it is outside of the source image
+				const Coord xSrc = x - srcRod.x1;
+				const VecPoint2 pos( xSrc, ySrc );
+
+				VecPoint2 motion;
+				if( x < vecRod.x1 || x > vecRod.x2 ||
+				    y < vecRod.y1 || y > vecRod.y2 )
+				{
+					motion.x = 0;
+					motion.y = 0;
+				}
+				else
+				{
+					motion.x = boost::gil::get_color( *xit_xVec, boost::gil::gray_color_t() );
+					motion.y = boost::gil::get_color( *xit_yVec, boost::gil::gray_color_t() );
+				}
+				coordinates[0] = pos.x + motion.x;
+				coordinates[1] = pos.y + motion.y;
 			}
 		}
 
-		// notify the end of the line to inform the progress
-		// and allows the host to abort
-		if( p.progressForward( procWindowSize.x ) )
+		// compute the pixel values according to the resample method,
+		// the progress is notified at the end of each line and allows the host to abort
+		if( terry::sampler::resample_pixels_map( srcView, dstView, map, map.region(), outOfImageProcess, p, sampler ) )
 			return true;
 	}
 	return false;
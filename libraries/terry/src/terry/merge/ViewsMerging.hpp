@@ -2,10 +2,17 @@
 #define _TERRY_VIEWS_MERGING_HPP_
 
 #include "MergeAbstractFunctor.hpp"
+#include "MergeFunctors.hpp"
+#include "detail/merge_lines.hpp"
 
 #include <boost/static_assert.hpp>
 #include <boost/gil/typedefs.hpp>
 #include <boost/gil/utilities.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <vector>
 
 namespace terry {
 
@@ -52,16 +59,91 @@ struct merger<merge_per_channel>
 	}
 
 };
-} // end namespace detail
+/// vectorized line operator of a merge functor
+template<class F>
+struct merge_line_operator { static const EMergeLineOperator value = eMergeLineNone; };
+template<class Pixel>
+struct merge_line_operator< FunctorOver<Pixel> > { static const EMergeLineOperator value = eMergeLineOver; };
+template<class Pixel>
+struct merge_line_operator< FunctorPlus<Pixel> > { static const EMergeLineOperator value = eMergeLinePlus; };
+template<class Pixel>
+struct merge_line_operator< FunctorMultiply<Pixel> > { static const EMergeLineOperator value = eMergeLineMultiply; };
+template<class Pixel>
+struct merge_line_operator< FunctorScreen<Pixel> > { static const EMergeLineOperator value = eMergeLineScreen; };
+template<class Pixel>
+struct merge_line_operator< FunctorIn<Pixel> > { static const EMergeLineOperator value = eMergeLineIn; };
+template<class Pixel>
+struct merge_line_operator< FunctorOut<Pixel> > { static const EMergeLineOperator value = eMergeLineOut; };
 
 /**
- * @defgroup ViewsMerging
- * @brief Merge two views by means of a given functor.
- **/
+ * @brief The vectorized lines are used for float and 16 bits interleaved views,
+ * with rgba pixels for the operators using alpha.
+ */
+template<class F, class View>
+struct use_merge_lines
+{
+	typedef typename boost::gil::channel_type<View>::type Channel;
+	static const EMergeLineOperator op = merge_line_operator<F>::value;
+	static const bool supported_channel = boost::is_same<Channel, boost::gil::bits32f>::value ||
+	                                      boost::is_same<Channel, boost::gil::bits16>::value;
+	static const bool interleaved = boost::is_pointer<typename View::x_iterator>::value;
+	static const bool alpha_last = boost::is_same<typename View::value_type::layout_t, boost::gil::rgba_layout_t>::value;
+	static const bool needs_alpha = op == eMergeLineOver || op == eMergeLineIn || op == eMergeLineOut;
+	typedef boost::mpl::bool_<( op != eMergeLineNone && supported_channel && interleaved && ( alpha_last || ! needs_alpha ) )> type;
+};
+
+template<class View>
+void merge_view_lines( const View& srcA, const View& srcB, const View& dst, const EMergeLineOperator op, boost::gil::bits32f )
+{
+	const std::size_t nc = boost::gil::num_channels<View>::value;
+	for( std::ptrdiff_t y = 0; y < dst.height(); ++y )
+	{
+		merge_line( op,
+			reinterpret_cast<const float*>( srcA.row_begin( y ) ),
+			reinterpret_cast<const float*>( srcB.row_begin( y ) ),
+			reinterpret_cast<float*>( dst.row_begin( y ) ),
+			dst.width(), nc );
+	}
+}
+
+/// 16 bits lines are normalized to float, the result is clamped
+template<class View>
+void merge_view_lines( const View& srcA, const View& srcB, const View& dst, const EMergeLineOperator op, boost::gil::bits16 )
+{
+	typedef boost::gil::bits16 Channel;
+	const std::size_t nc = boost::gil::num_channels<View>::value;
+	const std::size_t size = dst.width() * nc;
+	const float toFloat = 1.0f / 65535.0f;
+	std::vector<float> a( size );
+	std::vector<float> b( size );
+	for( std::ptrdiff_t y = 0; y < dst.height(); ++y )
+	{
+		const Channel* srcLineA = reinterpret_cast<const Channel*>( srcA.row_begin( y ) );
+		const Channel* srcLineB = reinterpret_cast<const Channel*>( srcB.row_begin( y ) );
+		Channel* dstLine = reinterpret_cast<Channel*>( dst.row_begin( y ) );
+		for( std::size_t i = 0; i < size; ++i )
+		{
+			a[i] = srcLineA[i] * toFloat;
+			b[i] = srcLineB[i] * toFloat;
+		}
+		merge_line( op, &a[0], &b[0], &a[0], dst.width(), nc );
+		for( std::size_t i = 0; i < size; ++i )
+			dstLine[i] = static_cast<Channel>( std::min( std::max( a[i], 0.0f ), 1.0f ) * 65535.0f + 0.5f );
+	}
+}
+
 template < class F, class View>
-void merge_views( const View& srcA, const View& srcB, View& dst, F fun )
+void merge_views_impl( const View& srcA, const View& srcB, const View& dst, F&, boost::mpl::true_ )
 {
-	detail::merger<typename F::operating_mode_t> merge_op;
+	if( dst.width() == 0 )
+		return;
+	merge_view_lines( srcA, srcB, dst, merge_line_operator<F>::value, typename boost::gil::channel_type<View>::type() );
+}
+
+template < class F, class View>
+void merge_views_impl( const View& srcA, const View& srcB, const View& dst, F& fun, boost::mpl::false_ )
+{
+	merger<typename F::operating_mode_t> merge_op;
 	// If merging functor needs alpha, check if destination contains alpha.
 	typedef typename contains_color< typename View::value_type, alpha_t>::type has_alpha_t;
 //	BOOST_STATIC_ASSERT(( boost::is_same<typename F::operating_mode_t, merge_per_channel_with_alpha>::value ? has_alpha_t::value : true ));
@@ -77,6 +159,21 @@ void merge_views( const View& srcA, const View& srcB, View& dst, F fun )
 	}
 }
 
+} // end namespace detail
+
+/**
+ * @defgroup ViewsMerging
+ * @brief Merge two views by means of a given functor.
+ *
+ * Over, plus, multiply, screen, in and out use vectorized lines on float
+ * and 16 bits views. The destination may be one of the sources.
+ **/
+template < class F, class View>
+void merge_views( const View& srcA, const View& srcB, const View& dst, F fun )
+{
+	detail::merge_views_impl( srcA, srcB, dst, fun, typename detail::use_merge_lines<F, View>::type() );
+}
+
 }
 
 #endif
@@ -0,0 +1,242 @@
+#ifndef _TERRY_MERGE_DETAIL_MERGE_LINES_HPP_
+#define _TERRY_MERGE_DETAIL_MERGE_LINES_HPP_
+
+/**
+ * @file
+ * @brief Vectorized core of the most common merge operators, on float lines.
+ *
+ * A line is a row of interleaved pixels, for the operators using alpha
+ * (over, in, out) the pixels are rgba with the alpha in last position.
+ * Lines where an input is fully opaque or fully transparent are resolved
+ * by a copy (premultiplied images).
+ * The SSE2 version is selected at compile time.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define TERRY_MERGE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace terry {
+namespace detail {
+
+enum EMergeLineOperator
+{
+	eMergeLineNone = -1,
+	eMergeLineOver,     ///< A+B(1-a)
+	eMergeLinePlus,     ///< A+B
+	eMergeLineMultiply, ///< AB, 0 if A < 0 and B < 0
+	eMergeLineScreen,   ///< A+B-AB
+	eMergeLineIn,       ///< Ab
+	eMergeLineOut       ///< A(1-b)
+};
+
+inline bool merge_line_needs_alpha( const EMergeLineOperator op )
+{
+	return op == eMergeLineOver || op == eMergeLineIn || op == eMergeLineOut;
+}
+
+/// all the values of the line are 0
+inline bool is_line_zero( const float* v, const std::size_t size )
+{
+	for( std::size_t i = 0; i < size; ++i )
+		if( v[i] != 0.0f )
+			return false;
+	return true;
+}
+
+/// all the alpha values (last channel) of the line are equal to value
+inline bool is_line_alpha( const float* v, const std::size_t nbPixels, const std::size_t nbChannels, const float value )
+{
+	const float* alpha = v + nbChannels - 1;
+	for( std::size_t i = 0; i < nbPixels; ++i, alpha += nbChannels )
+		if( *alpha != value )
+			return false;
+	return true;
+}
+
+inline void copy_line( const float* src, float* dst, const std::size_t size )
+{
+	if( src != dst )
+		std::memmove( dst, src, size * sizeof( float ) );
+}
+
+/// @return number of processed values
+inline std::size_t merge_line_scalar( const EMergeLineOperator op, const float* a, const float* b, float* dst,
+                                      const std::size_t begin, const std::size_t end, const std::size_t nbChannels )
+{
+	switch( op )
+	{
+		case eMergeLineOver:
+		case eMergeLineIn:
+		case eMergeLineOut:
+		{
+			for( std::size_t p = begin; p < end; p += nbChannels )
+			{
+				const float alphaA = a[p + nbChannels - 1];
+				const float alphaB = b[p + nbChannels - 1];
+				for( std::size_t c = p; c < p + nbChannels; ++c )
+				{
+					if( op == eMergeLineOver )
+						dst[c] = a[c] + b[c] * ( 1.0f - alphaA );
+					else if( op == eMergeLineIn )
+						dst[c] = a[c] * alphaB;
+					else
+						dst[c] = a[c] * ( 1.0f - alphaB );
+				}
+			}
+			break;
+		}
+		case eMergeLinePlus:
+			for( std::size_t i = begin; i < end; ++i )
+				dst[i] = a[i] + b[i];
+			break;
+		case eMergeLineMultiply:
+			for( std::size_t i = begin; i < end; ++i )
+				dst[i] = ( a[i] < 0.0f && b[i] < 0.0f ) ? 0.0f : a[i] * b[i];
+			break;
+		case eMergeLineScreen:
+			for( std::size_t i = begin; i < end; ++i )
+				dst[i] = a[i] + b[i] - a[i] * b[i];
+			break;
+		case eMergeLineNone:
+			break;
+	}
+	return end;
+}
+
+#ifdef TERRY_MERGE_SSE2
+
+/// @return number of processed values
+inline std::size_t merge_line_sse2( const EMergeLineOperator op, const float* a, const float* b, float* dst,
+                                    const std::size_t size, const std::size_t nbChannels )
+{
+	const __m128 one = _mm_set1_ps( 1.0f );
+	std::size_t i = 0;
+	if( merge_line_needs_alpha( op ) )
+	{
+		// one rgba pixel per register
+		if( nbChannels != 4 )
+			return 0;
+		for( ; i + 4 <= size; i += 4 )
+		{
+			const __m128 va = _mm_loadu_ps( a + i );
+			const __m128 vb = _mm_loadu_ps( b + i );
+			__m128 r;
+			if( op == eMergeLineOver )
+			{
+				const __m128 alphaA = _mm_shuffle_ps( va, va, _MM_SHUFFLE( 3, 3, 3, 3 ) );
+				r = _mm_add_ps( va, _mm_mul_ps( vb, _mm_sub_ps( one, alphaA ) ) );
+			}
+			else
+			{
+				const __m128 alphaB = _mm_shuffle_ps( vb, vb, _MM_SHUFFLE( 3, 3, 3, 3 ) );
+				r = _mm_mul_ps( va, op == eMergeLineIn ? alphaB : _mm_sub_ps( one, alphaB ) );
+			}
+			_mm_storeu_ps( dst + i, r );
+		}
+		return i;
+	}
+
+	const __m128 zero = _mm_setzero_ps();
+	for( ; i + 4 <= size; i += 4 )
+	{
+		const __m128 va = _mm_loadu_ps( a + i );
+		const __m128 vb = _mm_loadu_ps( b + i );
+		__m128 r;
+		switch( op )
+		{
+			case eMergeLinePlus:
+				r = _mm_add_ps( va, vb );
+				break;
+			case eMergeLineMultiply:
+			{
+				const __m128 bothNegative = _mm_and_ps( _mm_cmplt_ps( va, zero ), _mm_cmplt_ps( vb, zero ) );
+				r = _mm_andnot_ps( bothNegative, _mm_mul_ps( va, vb ) );
+				break;
+			}
+			case eMergeLineScreen:
+				r = _mm_sub_ps( _mm_add_ps( va, vb ), _mm_mul_ps( va, vb ) );
+				break;
+			default:
+				return i;
+		}
+		_mm_storeu_ps( dst + i, r );
+	}
+	return i;
+}
+
+#endif
+
+/**
+ * @brief Resolve the line by a copy if an input is fully opaque or fully transparent.
+ * @return true if the line is done
+ */
+inline bool merge_line_early_out( const EMergeLineOperator op, const float* a, const float* b, float* dst,
+                                  const std::size_t nbPixels, const std::size_t nbChannels )
+{
+	const std::size_t size = nbPixels * nbChannels;
+	switch( op )
+	{
+		case eMergeLineOver:
+			if( is_line_alpha( a, nbPixels, nbChannels, 1.0f ) || is_line_zero( b, size ) )
+			{
+				copy_line( a, dst, size );
+				return true;
+			}
+			if( is_line_zero( a, size ) )
+			{
+				copy_line( b, dst, size );
+				return true;
+			}
+			return false;
+		case eMergeLinePlus:
+			if( is_line_zero( b, size ) )
+			{
+				copy_line( a, dst, size );
+				return true;
+			}
+			if( is_line_zero( a, size ) )
+			{
+				copy_line( b, dst, size );
+				return true;
+			}
+			return false;
+		case eMergeLineIn:
+		case eMergeLineOut:
+			if( is_line_alpha( b, nbPixels, nbChannels, op == eMergeLineIn ? 1.0f : 0.0f ) )
+			{
+				copy_line( a, dst, size );
+				return true;
+			}
+			return false;
+		default:
+			return false;
+	}
+}
+
+/**
+ * @brief dst = op( a, b ) on a line of nbPixels interleaved pixels
+ * @param[out] dst may be one of the inputs
+ */
+inline void merge_line( const EMergeLineOperator op, const float* a, const float* b, float* dst,
+                        const std::size_t nbPixels, const std::size_t nbChannels )
+{
+	if( merge_line_early_out( op, a, b, dst, nbPixels, nbChannels ) )
+		return;
+	const std::size_t size = nbPixels * nbChannels;
+	std::size_t done = 0;
+#if defined( TERRY_MERGE_SSE2 )
+	done = merge_line_sse2( op, a, b, dst, size, nbChannels );
+#endif
+	merge_line_scalar( op, a, b, dst, done, size, nbChannels );
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef _TERRY_NUMERIC_STATISTICS_HPP_
+#define _TERRY_NUMERIC_STATISTICS_HPP_
+
+#include <terry/numeric/minmax.hpp>
+#include <terry/globals.hpp>
+
+#include <boost/gil/color_convert.hpp>
+#include <boost/gil/typedefs.hpp>
+
+#include <cmath>
+#include <cstddef>
+
+namespace terry {
+namespace numeric {
+
+/**
+ * @brief Central moments of a serie of values, computed in a single pass.
+ *
+ * Values are added one by one with the Welford update and two accumulators
+ * can be merged (Chan et al. for the variance, Pebay for the 3rd and 4th orders),
+ * so a serie can be split into parts accumulated in parallel.
+ */
+struct moments_accumulator_t
+{
+	std::size_t n;
+	double mean;
+	double m2; ///< sum of (x-mean)^2
+	double m3; ///< sum of (x-mean)^3
+	double m4; ///< sum of (x-mean)^4
+
+	moments_accumulator_t()
+	: n( 0 )
+	, mean( 0.0 )
+	, m2( 0.0 )
+	, m3( 0.0 )
+	, m4( 0.0 )
+	{}
+
+	GIL_FORCEINLINE
+	void operator()( const double x )
+	{
+		const double n1      = static_cast<double>( n );
+		++n;
+		const double nn      = static_cast<double>( n );
+		const double delta   = x - mean;
+		const double deltaN  = delta / nn;
+		const double deltaN2 = deltaN * deltaN;
+		const double term    = delta * deltaN * n1;
+
+		mean += deltaN;
+		m4   += term * deltaN2 * ( nn * nn - 3.0 * nn + 3.0 ) + 6.0 * deltaN2 * m2 - 4.0 * deltaN * m3;
+		m3   += term * deltaN * ( nn - 2.0 ) - 3.0 * deltaN * m2;
+		m2   += term;
+	}
+
+	void merge( const moments_accumulator_t& other )
+	{
+		if( other.n == 0 )
+			return;
+		if( n == 0 )
+		{
+			*this = other;
+			return;
+		}
+		const double na     = static_cast<double>( n );
+		const double nb     = static_cast<double>( other.n );
+		const double nn     = na + nb;
+		const double delta  = other.mean - mean;
+		const double delta2 = delta * delta;
+
+		const double newM4 = m4 + other.m4
+		                   + delta2 * delta2 * na * nb * ( na * na - na * nb + nb * nb ) / ( nn * nn * nn )
+		                   + 6.0 * delta2 * ( na * na * other.m2 + nb * nb * m2 ) / ( nn * nn )
+		                   + 4.0 * delta * ( na * other.m3 - nb * m3 ) / nn;
+		const double newM3 = m3 + other.m3
+		                   + delta2 * delta * na * nb * ( na - nb ) / ( nn * nn )
+		                   + 3.0 * delta * ( na * other.m2 - nb * m2 ) / nn;
+		m2   += other.m2 + delta2 * na * nb / nn;
+		m3    = newM3;
+		m4    = newM4;
+		mean += delta * nb / nn;
+		n    += other.n;
+	}
+
+	/// population variance
+	double variance() const { return n ? m2 / n : 0.0; }
+	double standard_deviation() const { return std::sqrt( variance() ); }
+	double skewness() const { return m2 > 0.0 ? std::sqrt( double( n ) ) * m3 / std::pow( m2, 1.5 ) : 0.0; }
+	/// excess kurtosis (0 for a normal distribution)
+	double kurtosis() const { return m2 > 0.0 ? n * m4 / ( m2 * m2 ) - 3.0 : 0.0; }
+};
+
+/**
+ * @brief Statistics of all the pixels of an image in a single pass:
+ * moments and extrema of each channel, pixels of minimum and maximum luminosity.
+ *
+ * It is used as a functor on each pixel, partial results are combined with merge.
+ */
+template<typename Pixel>
+struct pixel_statistics_t
+{
+	typedef typename channel_type<Pixel>::type Channel;
+	typedef pixel<Channel, gray_layout_t> PixelGray;
+	static const int nbChannels = num_channels<Pixel>::value;
+
+	bool empty;
+	moments_accumulator_t moments[nbChannels]; ///< indexed like Pixel::operator[]
+	Pixel channelMin;
+	Pixel channelMax;
+	Pixel luminosityMin;
+	Pixel luminosityMax;
+	Channel luminosityMinValue;
+	Channel luminosityMaxValue;
+
+	pixel_statistics_t()
+	: empty( true )
+	{}
+
+	GIL_FORCEINLINE
+	void operator()( const Pixel& p )
+	{
+		for( int c = 0; c < nbChannels; ++c )
+			moments[c]( static_cast<double>( p[c] ) );
+
+		PixelGray gray;
+		color_convert( p, gray );
+		const Channel luminosity = get_color( gray, gray_color_t() );
+		if( empty )
+		{
+			empty              = false;
+			channelMin         = p;
+			channelMax         = p;
+			luminosityMin      = p;
+			luminosityMax      = p;
+			luminosityMinValue = luminosity;
+			luminosityMaxValue = luminosity;
+			return;
+		}
+		pixel_assign_min_t<Pixel, Pixel>()( p, channelMin );
+		pixel_assign_max_t<Pixel, Pixel>()( p, channelMax );
+		if( luminosity < luminosityMinValue )
+		{
+			luminosityMin      = p;
+			luminosityMinValue = luminosity;
+		}
+		if( luminosity > luminosityMaxValue )
+		{
+			luminosityMax      = p;
+			luminosityMaxValue = luminosity;
+		}
+	}
+
+	void merge( const pixel_statistics_t& other )
+	{
+		if( other.empty )
+			return;
+		if( empty )
+		{
+			*this = other;
+			return;
+		}
+		for( int c = 0; c < nbChannels; ++c )
+			moments[c].merge( other.moments[c] );
+		pixel_assign_min_t<Pixel, Pixel>()( other.channelMin, channelMin );
+		pixel_assign_max_t<Pixel, Pixel>()( other.channelMax, channelMax );
+		if( other.luminosityMinValue < luminosityMinValue )
+		{
+			luminosityMin      = other.luminosityMin;
+			luminosityMinValue = other.luminosityMinValue;
+		}
+		if( other.luminosityMaxValue > luminosityMaxValue )
+		{
+			luminosityMax      = other.luminosityMax;
+			luminosityMaxValue = other.luminosityMaxValue;
+		}
+	}
+};
+
+/**
+ * @brief Average and standard deviation of each channel, in a single pass.
+ * Lighter than pixel_statistics_t when the extrema are not needed.
+ */
+template<typename Pixel>
+struct pixel_moments_t
+{
+	static const int nbChannels = num_channels<Pixel>::value;
+
+	moments_accumulator_t moments[nbChannels]; ///< indexed like Pixel::operator[]
+
+	GIL_FORCEINLINE
+	void operator()( const Pixel& p )
+	{
+		for( int c = 0; c < nbChannels; ++c )
+			moments[c]( static_cast<double>( p[c] ) );
+	}
+
+	void merge( const pixel_moments_t& other )
+	{
+		for( int c = 0; c < nbChannels; ++c )
+			moments[c].merge( other.moments[c] );
+	}
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef _TERRY_SAMPLER_COORDINATES_MAP_HPP_
+#define _TERRY_SAMPLER_COORDINATES_MAP_HPP_
+
+#include <terry/math/Rect.hpp>
+
+#include <boost/gil/utilities.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace terry {
+namespace sampler {
+
+/**
+ * @brief Source coordinates of each pixel of a region of the destination
+ * image (STMap), so a costly mapping function is evaluated once and reused.
+ *
+ * The coordinates are stored in float, interleaved (x, y), row by row.
+ * It models a mapping function: transform( map, dstPoint ) returns the source
+ * coordinates of a destination pixel inside the region.
+ * The mapping functions used by compute must be declared before this file is included.
+ */
+class coordinates_map
+{
+public:
+	coordinates_map()
+	: _region( 0, 0, 0, 0 )
+	{}
+
+	void reset( const Rect<std::ssize_t>& region )
+	{
+		_region = region;
+		_coordinates.assign( 2 * ( region.x2 - region.x1 ) * ( region.y2 - region.y1 ), 0.0f );
+	}
+
+	/**
+	 * @brief Evaluate the mapping function on the rows [y1, y2) of the region.
+	 * The rows can be computed by different threads.
+	 */
+	template<class MapFn>
+	void compute( const MapFn& dst_to_src, const std::ssize_t y1, const std::ssize_t y2 )
+	{
+		point2<std::ptrdiff_t> dst_p;
+		for( dst_p.y = y1; dst_p.y < y2; ++dst_p.y )
+		{
+			float* c = row( dst_p.y );
+			for( dst_p.x = _region.x1; dst_p.x < _region.x2; ++dst_p.x, c += 2 )
+				store( c, transform( dst_to_src, dst_p ) );
+		}
+	}
+
+	template<class MapFn>
+	void compute( const MapFn& dst_to_src )
+	{
+		compute( dst_to_src, _region.y1, _region.y2 );
+	}
+
+	const Rect<std::ssize_t>& region() const { return _region; }
+
+	bool contains( const Rect<std::ssize_t>& r ) const
+	{
+		return r.x1 >= _region.x1 && r.y1 >= _region.y1 && r.x2 <= _region.x2 && r.y2 <= _region.y2;
+	}
+
+	/// coordinates of the destination pixels (x, y) of a row, starting at _region.x1
+	float* row( const std::ptrdiff_t y ) { return &_coordinates[2 * ( y - _region.y1 ) * ( _region.x2 - _region.x1 )]; }
+	const float* row( const std::ptrdiff_t y ) const { return &_coordinates[2 * ( y - _region.y1 ) * ( _region.x2 - _region.x1 )]; }
+
+	point2<double> at( const std::ptrdiff_t x, const std::ptrdiff_t y ) const
+	{
+		const float* c = row( y ) + 2 * ( x - _region.x1 );
+		return point2<double>( c[0], c[1] );
+	}
+
+private:
+	template<typename F>
+	static void store( float* c, const point2<F>& src_p )
+	{
+		c[0] = static_cast<float>( src_p.x );
+		c[1] = static_cast<float>( src_p.y );
+	}
+
+private:
+	Rect<std::ssize_t> _region;      ///< destination pixels
+	std::vector<float> _coordinates; ///< 2 floats per pixel of the region
+};
+
+}
+
+/// in the namespace of the other mapping functions, so the resample functions find all of them
+template<typename F>
+inline point2<double> transform( const sampler::coordinates_map& map, const point2<F>& dst_p )
+{
+	return map.at( static_cast<std::ptrdiff_t>( dst_p.x ), static_cast<std::ptrdiff_t>( dst_p.y ) );
+}
+
+}
+
+#endif
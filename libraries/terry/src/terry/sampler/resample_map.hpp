@@ -0,0 +1,105 @@
+#ifndef _TERRY_SAMPLER_RESAMPLE_MAP_HPP_
+#define _TERRY_SAMPLER_RESAMPLE_MAP_HPP_
+
+#include <terry/math/Rect.hpp>
+
+#include <terry/sampler/coordinates_map.hpp>
+#include <terry/sampler/all.hpp>
+#include <terry/sampler/details.hpp>
+#include <terry/sampler/sampler.hpp>
+
+#include <cmath>
+#include <vector>
+
+
+namespace terry {
+namespace sampler {
+
+/**
+ * @brief Resample the source view through a coordinates map (see coordinates_map).
+ * @ingroup ImageAlgorithms
+ *
+ * Same result as resample_pixels_progress with the mapping function used to
+ * compute the map, but the pixels whose sampler window is inside the source
+ * image are processed by a direct kernel: the weights are computed once per
+ * pixel into preallocated buffers and the window is read row by row,
+ * without the per pixel allocations of the generic sample function.
+ * The pixels near the borders use the generic sample function, to keep the
+ * out of image process.
+ *
+ * @param[in] procWindow destination pixels to compute, inside the region of the map
+ * @return true if the process was aborted
+ */
+template<
+	typename Sampler, // Models SamplerConcept
+	typename SrcView, // Models RandomAccess2DImageViewConcept
+	typename DstView, // Models MutableRandomAccess2DImageViewConcept
+	typename Progress>
+bool resample_pixels_map(
+	const SrcView& src_view, const DstView& dst_view,
+	const coordinates_map& map, const terry::Rect<std::ssize_t>& procWindow,
+	const EParamFilterOutOfImage& outOfImageProcess,
+	Progress& p,
+	Sampler sampler = Sampler() )
+{
+	typedef typename SrcView::value_type                     SrcP;
+	typedef typename floating_pixel_from_view<SrcView>::type SrcC;
+	typedef typename boost::gil::bits64f                     Weight;
+
+	const std::ptrdiff_t windowSize = sampler._windowSize;
+	const std::ptrdiff_t middlePosition = ( windowSize - 1 ) / 2;
+	const std::ptrdiff_t srcWidth = src_view.width();
+	const std::ptrdiff_t srcHeight = src_view.height();
+	const terry::point2<std::ssize_t> procWindowSize = procWindow.size();
+
+	std::vector<Weight> xWeights( windowSize );
+	std::vector<Weight> yWeights( windowSize );
+
+	for( std::ptrdiff_t y = procWindow.y1; y < procWindow.y2; ++y )
+	{
+		typename DstView::x_iterator xit = dst_view.row_begin( y );
+		const float* coordinates = map.row( y ) + 2 * ( procWindow.x1 - map.region().x1 );
+		for( std::ptrdiff_t x = procWindow.x1; x < procWindow.x2; ++x, coordinates += 2 )
+		{
+			const double sx = coordinates[0];
+			const double sy = coordinates[1];
+			const double fx = std::floor( sx );
+			const double fy = std::floor( sy );
+			const std::ptrdiff_t x0 = static_cast<std::ptrdiff_t>( fx ) - middlePosition;
+			const std::ptrdiff_t y0 = static_cast<std::ptrdiff_t>( fy ) - middlePosition;
+
+			// window partially outside of the source (or invalid coordinates)
+			if( ! ( fx == fx && fy == fy ) ||
+			    x0 < 0 || y0 < 0 || x0 + windowSize > srcWidth || y0 + windowSize > srcHeight )
+			{
+				sample( sampler, src_view, point2<double>( sx, sy ), xit[x], outOfImageProcess );
+				continue;
+			}
+
+			for( std::ptrdiff_t i = 0; i < windowSize; ++i )
+			{
+				sampler( - ( sx - fx ) - middlePosition + i, xWeights[i] );
+				sampler( - ( sy - fy ) - middlePosition + i, yWeights[i] );
+			}
+
+			SrcC mp( 0 );
+			for( std::ptrdiff_t j = 0; j < windowSize; ++j )
+			{
+				typename SrcView::x_iterator sit = src_view.row_begin( y0 + j ) + x0;
+				SrcC xProcessed( 0 );
+				for( std::ptrdiff_t i = 0; i < windowSize; ++i )
+					details::add_dst_mul_src<SrcP, Weight, SrcC>()( sit[i], xWeights[i], xProcessed );
+				details::add_dst_mul_src<SrcC, Weight, SrcC>()( xProcessed, yWeights[j], mp );
+			}
+			color_convert( mp, xit[x] );
+		}
+		if( p.progressForward( procWindowSize.x ) )
+			return true;
+	}
+	return false;
+}
+
+}
+}
+
+#endif
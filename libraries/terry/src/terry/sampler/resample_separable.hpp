@@ -0,0 +1,280 @@
+#ifndef _TERRY_SAMPLER_RESAMPLE_SEPARABLE_HPP_
+#define _TERRY_SAMPLER_RESAMPLE_SEPARABLE_HPP_
+
+#include <terry/math/Rect.hpp>
+#include <terry/globals.hpp>
+#include <terry/basic_colors.hpp>
+#include <terry/geometry/affine.hpp>
+
+#include <terry/sampler/sampler.hpp>
+
+#include <boost/gil/gil_all.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace terry {
+namespace sampler {
+
+/**
+ * @brief Precomputed weights of a 1D resampling (polyphase filter bank).
+ *
+ * Each output position reads exactly _nbTaps contiguous input samples, starting at _first.
+ * Weights are normalized, the weight of the samples outside of the input
+ * (black or transparent) is stored apart in _borderWeights.
+ */
+struct separable_weights
+{
+	std::size_t                 _nbTaps;
+	std::vector<std::ptrdiff_t> _first;         ///< first input sample of each output
+	std::vector<float>          _weights;       ///< _nbTaps weights for each output
+	std::vector<float>          _borderWeights; ///< weight of the out of image color for each output
+};
+
+namespace details {
+
+/// periodic reflection of an index inside [0, size)
+inline std::ptrdiff_t mirror_index( const std::ptrdiff_t i, const std::ptrdiff_t size )
+{
+	const std::ptrdiff_t period = 2 * size;
+	std::ptrdiff_t m = i % period;
+	if( m < 0 )
+		m += period;
+	return m < size ? m : period - 1 - m;
+}
+
+}
+
+/**
+ * @brief Compute the resampling weights of an axis, for outputs in [outBegin, outEnd).
+ * The input coordinate of the output o is scale * o + offset.
+ * When downscaling, the filter is stretched to the output pixel size to avoid aliasing.
+ */
+template<typename Sampler>
+void compute_separable_weights( Sampler& sampler, const double scale, const double offset,
+                                const std::ptrdiff_t inSize, const std::ptrdiff_t outBegin, const std::ptrdiff_t outEnd,
+                                const EParamFilterOutOfImage outOfImageProcess, separable_weights& table )
+{
+	const double filterScale = std::max( std::abs( scale ), 1.0 );
+	const double radius      = sampler._windowSize * 0.5 * filterScale;
+	const std::ptrdiff_t nbOutputs = outEnd - outBegin;
+
+	table._nbTaps = std::min<std::ptrdiff_t>( std::floor( 2.0 * radius ) + 1, inSize );
+	table._first.assign( nbOutputs, 0 );
+	table._weights.assign( nbOutputs * table._nbTaps, 0.0f );
+	table._borderWeights.assign( nbOutputs, 0.0f );
+
+	std::vector<double> folded( inSize );
+	for( std::ptrdiff_t o = 0; o < nbOutputs; ++o )
+	{
+		const double center = scale * ( outBegin + o ) + offset;
+		const std::ptrdiff_t begin = std::ceil( center - radius );
+		const std::ptrdiff_t end   = std::floor( center + radius ) + 1;
+
+		std::ptrdiff_t minIndex = inSize;
+		std::ptrdiff_t maxIndex = -1;
+		double border = 0.0;
+		double sum    = 0.0;
+		for( std::ptrdiff_t i = begin; i < end; ++i )
+		{
+			RESAMPLING_CORE_TYPE weight = 0;
+			sampler( RESAMPLING_CORE_TYPE( ( i - center ) / filterScale ), weight );
+			sum += weight;
+
+			std::ptrdiff_t index = i;
+			if( i < 0 || i >= inSize )
+			{
+				switch( outOfImageProcess )
+				{
+					case eParamFilterOutBlack:
+					case eParamFilterOutTransparency:
+						border += weight;
+						continue;
+					case eParamFilterOutCopy:
+						index = std::min( std::max( i, std::ptrdiff_t( 0 ) ), inSize - 1 );
+						break;
+					case eParamFilterOutMirror:
+						index = details::mirror_index( i, inSize );
+						break;
+				}
+			}
+			minIndex = std::min( minIndex, index );
+			maxIndex = std::max( maxIndex, index );
+			folded[index] += weight;
+		}
+
+		const double norm = ( sum != 0.0 ) ? 1.0 / sum : 0.0;
+		table._borderWeights[o] = border * norm;
+		if( maxIndex < minIndex )
+			continue; // only out of image samples
+
+		// keep the whole footprint inside the input, so every output reads the same number of samples
+		const std::ptrdiff_t first = std::max( std::ptrdiff_t( 0 ), std::min( minIndex, inSize - std::ptrdiff_t( table._nbTaps ) ) );
+		table._first[o] = first;
+		float* weights = &table._weights[o * table._nbTaps];
+		for( std::ptrdiff_t index = minIndex; index <= maxIndex; ++index )
+		{
+			weights[index - first] = folded[index] * norm;
+			folded[index] = 0.0;
+		}
+	}
+}
+
+namespace details {
+
+/**
+ * @brief Horizontal pass on a row of interleaved float channels.
+ */
+template<int nbChannels>
+void resample_row_horizontal( const float* src, float* dst, const separable_weights& table, const float* border )
+{
+	const std::size_t nbTaps = table._nbTaps;
+	const std::size_t width  = table._first.size();
+	for( std::size_t x = 0; x < width; ++x, dst += nbChannels )
+	{
+		const float* weights = &table._weights[x * nbTaps];
+		const float* s       = src + table._first[x] * nbChannels;
+		float acc[nbChannels];
+		for( int c = 0; c < nbChannels; ++c )
+			acc[c] = table._borderWeights[x] * border[c];
+		for( std::size_t k = 0; k < nbTaps; ++k, s += nbChannels )
+		{
+			const float w = weights[k];
+			for( int c = 0; c < nbChannels; ++c )
+				acc[c] += w * s[c];
+		}
+		for( int c = 0; c < nbChannels; ++c )
+			dst[c] = acc[c];
+	}
+}
+
+/**
+ * @brief Vertical pass: weighted sum of full rows, the inner loop is contiguous.
+ */
+template<int nbChannels>
+void resample_rows_vertical( const float* const* rows, const float* weights, const std::size_t nbTaps,
+                             const float borderWeight, const float* border, float* dst, const std::size_t width,
+                             const bool clampValues )
+{
+	const std::size_t size = width * nbChannels;
+	for( std::size_t x = 0; x < width; ++x )
+		for( int c = 0; c < nbChannels; ++c )
+			dst[x * nbChannels + c] = borderWeight * border[c];
+	for( std::size_t k = 0; k < nbTaps; ++k )
+	{
+		const float  w   = weights[k];
+		const float* row = rows[k];
+		for( std::size_t i = 0; i < size; ++i )
+			dst[i] += w * row[i];
+	}
+	if( clampValues )
+	{
+		for( std::size_t i = 0; i < size; ++i )
+			dst[i] = std::min( 1.0f, std::max( 0.0f, dst[i] ) );
+	}
+}
+
+}
+
+template<typename T>
+inline bool is_axis_aligned( const matrix3x2<T>& mat )
+{
+	return mat.b == 0 && mat.c == 0;
+}
+
+/**
+ * @brief Resample an image with an axis-aligned transformation in two separable passes.
+ * @ingroup ImageAlgorithms
+ *
+ * Filter weights are computed once per output column and once per output row.
+ * Horizontally filtered rows are kept in a small rolling buffer of float rows,
+ * reused by consecutive output rows.
+ * Same result as resample_pixels_progress with the same sampler, except that
+ * the filter is stretched when downscaling.
+ *
+ * @param[in] dst_to_src axis-aligned transformation from the destination to the source coordinates
+ */
+template<
+	typename Sampler, // Models SamplerConcept
+	typename SrcView, // Models RandomAccess2DImageViewConcept
+	typename DstView, // Models MutableRandomAccess2DImageViewConcept
+	typename Progress>
+void resample_pixels_separable_progress(
+	const SrcView& src_view, const DstView& dst_view,
+	const matrix3x2<double>& dst_to_src, const terry::Rect<std::ssize_t>& procWindow,
+	const EParamFilterOutOfImage& outOfImageProcess,
+	Progress& p,
+	Sampler sampler = Sampler() )
+{
+	using namespace boost::gil;
+	typedef typename floating_pixel_from_view<SrcView>::type SrcC;
+	typedef typename channel_type<DstView>::type DstChannel;
+	typedef typename view_type_from_pixel<SrcC>::type FloatView;
+	BOOST_STATIC_ASSERT( ( boost::is_same<typename channel_type<SrcC>::type, bits32f>::value ) );
+	static const int nbChannels = num_channels<SrcView>::value;
+
+	BOOST_ASSERT( is_axis_aligned( dst_to_src ) );
+
+	const terry::point2<std::ssize_t> procWindowSize = procWindow.size();
+	if( procWindowSize.x <= 0 || procWindowSize.y <= 0 )
+		return;
+
+	separable_weights xTable;
+	separable_weights yTable;
+	compute_separable_weights( sampler, dst_to_src.a, dst_to_src.e, src_view.width(),  procWindow.x1, procWindow.x2, outOfImageProcess, xTable );
+	compute_separable_weights( sampler, dst_to_src.d, dst_to_src.f, src_view.height(), procWindow.y1, procWindow.y2, outOfImageProcess, yTable );
+
+	SrcC borderPixel( 0 );
+	if( outOfImageProcess == eParamFilterOutBlack )
+		borderPixel = get_black<SrcC>();
+	float border[nbChannels];
+	for( int c = 0; c < nbChannels; ++c )
+		border[c] = borderPixel[c];
+
+	const std::size_t srcRowSize = src_view.width() * nbChannels;
+	const std::size_t dstRowSize = procWindowSize.x * nbChannels;
+	const std::size_t nbRows     = yTable._nbTaps;
+
+	// rolling buffer of horizontally filtered rows, indexed by source row modulo nbRows
+	std::vector<float> srcRow( srcRowSize );
+	std::vector<float> cache( nbRows * dstRowSize );
+	std::vector<std::ptrdiff_t> cachedRow( nbRows, -1 );
+	std::vector<const float*> rows( nbRows );
+	std::vector<float> dstRow( dstRowSize );
+
+	const FloatView srcRowView = interleaved_view( src_view.width(), 1, reinterpret_cast<SrcC*>( &srcRow.front() ), srcRowSize * sizeof( float ) );
+	const FloatView dstRowView = interleaved_view( procWindowSize.x, 1, reinterpret_cast<SrcC*>( &dstRow.front() ), dstRowSize * sizeof( float ) );
+	const bool clampValues = ! boost::is_floating_point<DstChannel>::value;
+
+	for( std::ptrdiff_t y = 0; y < procWindowSize.y; ++y )
+	{
+		const std::ptrdiff_t first = yTable._first[y];
+		for( std::size_t k = 0; k < nbRows; ++k )
+		{
+			const std::ptrdiff_t srcY = first + k;
+			const std::size_t slot = srcY % nbRows;
+			float* cached = &cache[slot * dstRowSize];
+			if( cachedRow[slot] != srcY )
+			{
+				copy_and_convert_pixels( subimage_view( src_view, 0, srcY, src_view.width(), 1 ), srcRowView );
+				details::resample_row_horizontal<nbChannels>( &srcRow.front(), cached, xTable, border );
+				cachedRow[slot] = srcY;
+			}
+			rows[k] = cached;
+		}
+		details::resample_rows_vertical<nbChannels>( &rows.front(), &yTable._weights[y * nbRows], nbRows,
+		                                             yTable._borderWeights[y], border,
+		                                             &dstRow.front(), procWindowSize.x, clampValues );
+		copy_and_convert_pixels( dstRowView, subimage_view( dst_view, procWindow.x1, procWindow.y1 + y, procWindowSize.x, 1 ) );
+
+		if( p.progressForward( procWindowSize.x ) )
+			return;
+	}
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef _TERRY_SAMPLER_WARP_HPP_
+#define _TERRY_SAMPLER_WARP_HPP_
+
+#include <terry/math/Rect.hpp>
+
+#include <terry/sampler/coordinates_map.hpp>
+#include <terry/sampler/resample_map.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file
+ * @brief Warp engine shared by the geometric transformations.
+ *
+ * The mapping function is evaluated on a sparse grid, each cell of the grid
+ * is checked against the exact mapping and subdivided while the bilinear
+ * interpolation of its corners is not accurate enough. The coordinates of
+ * the other pixels are interpolated. The destination is processed by tiles,
+ * so the coordinates and the source footprint of a tile stay in cache.
+ *
+ * The mapping functions (transform overloads) must be declared before this
+ * file is included, or be found by argument dependent lookup.
+ */
+
+namespace terry {
+namespace sampler {
+
+static const std::ssize_t kWarpTileSize  = 64;   ///< destination pixels processed together
+static const std::ssize_t kWarpGridStep  = 16;   ///< distance between the nodes of the initial grid
+static const double       kWarpTolerance = 0.01; ///< in pixels, maximal error of the interpolated coordinates on the checked points
+
+namespace details {
+
+template<typename F>
+inline point2<double> warp_point( const point2<F>& p )
+{
+	return point2<double>( p.x, p.y );
+}
+
+template<class MapFn>
+inline point2<double> warp_evaluate( const MapFn& dst_to_src, const std::ptrdiff_t x, const std::ptrdiff_t y )
+{
+	return warp_point( transform( dst_to_src, point2<std::ptrdiff_t>( x, y ) ) );
+}
+
+inline point2<double> warp_lerp( const point2<double>& a, const point2<double>& b, const double t )
+{
+	return point2<double>( a.x + ( b.x - a.x ) * t, a.y + ( b.y - a.y ) * t );
+}
+
+/// false if a value is NaN
+inline bool warp_close( const point2<double>& a, const point2<double>& b, const double tolerance )
+{
+	return std::abs( a.x - b.x ) <= tolerance && std::abs( a.y - b.y ) <= tolerance;
+}
+
+inline void warp_store( coordinates_map& map, const std::ptrdiff_t x, const std::ptrdiff_t y, const point2<double>& p )
+{
+	float* c = map.row( y ) + 2 * ( x - map.region().x1 );
+	c[0] = static_cast<float>( p.x );
+	c[1] = static_cast<float>( p.y );
+}
+
+/**
+ * @brief Coordinates of the pixels of the cell [x1,x2]x[y1,y2] (corners included),
+ * from the exact coordinates of its corners (p11: x1,y1 ; p21: x2,y1 ; p12: x1,y2 ; p22: x2,y2).
+ */
+template<class MapFn>
+void warp_cell( coordinates_map& map, const MapFn& dst_to_src,
+                const std::ptrdiff_t x1, const std::ptrdiff_t y1, const std::ptrdiff_t x2, const std::ptrdiff_t y2,
+                const point2<double>& p11, const point2<double>& p21, const point2<double>& p12, const point2<double>& p22,
+                const double tolerance )
+{
+	const std::ptrdiff_t w = x2 - x1;
+	const std::ptrdiff_t h = y2 - y1;
+	if( w <= 1 || h <= 1 )
+	{
+		// nothing to interpolate
+		for( std::ptrdiff_t y = y1; y <= y2; ++y )
+			for( std::ptrdiff_t x = x1; x <= x2; ++x )
+				warp_store( map, x, y, warp_evaluate( dst_to_src, x, y ) );
+		return;
+	}
+
+	// check the interpolation on the middle of the edges and on the center
+	const std::ptrdiff_t mx = ( x1 + x2 ) / 2;
+	const std::ptrdiff_t my = ( y1 + y2 ) / 2;
+	const double tx = double( mx - x1 ) / w;
+	const double ty = double( my - y1 ) / h;
+	const point2<double> pm1 = warp_evaluate( dst_to_src, mx, y1 );
+	const point2<double> pm2 = warp_evaluate( dst_to_src, mx, y2 );
+	const point2<double> p1m = warp_evaluate( dst_to_src, x1, my );
+	const point2<double> p2m = warp_evaluate( dst_to_src, x2, my );
+	const point2<double> pmm = warp_evaluate( dst_to_src, mx, my );
+
+	if( ! ( warp_close( pm1, warp_lerp( p11, p21, tx ), tolerance ) &&
+	        warp_close( pm2, warp_lerp( p12, p22, tx ), tolerance ) &&
+	        warp_close( p1m, warp_lerp( p11, p12, ty ), tolerance ) &&
+	        warp_close( p2m, warp_lerp( p21, p22, ty ), tolerance ) &&
+	        warp_close( pmm, warp_lerp( warp_lerp( p11, p21, tx ), warp_lerp( p12, p22, tx ), ty ), tolerance ) ) )
+	{
+		warp_cell( map, dst_to_src, x1, y1, mx, my, p11, pm1, p1m, pmm, tolerance );
+		warp_cell( map, dst_to_src, mx, y1, x2, my, pm1, p21, pmm, p2m, tolerance );
+		warp_cell( map, dst_to_src, x1, my, mx, y2, p1m, pmm, p12, pm2, tolerance );
+		warp_cell( map, dst_to_src, mx, my, x2, y2, pmm, p2m, pm2, p22, tolerance );
+		return;
+	}
+
+	// bilinear interpolation of the corners
+	for( std::ptrdiff_t y = y1; y <= y2; ++y )
+	{
+		const double t = double( y - y1 ) / h;
+		const point2<double> left  = warp_lerp( p11, p12, t );
+		const point2<double> right = warp_lerp( p21, p22, t );
+		const point2<double> step( ( right.x - left.x ) / w, ( right.y - left.y ) / w );
+		float* c = map.row( y ) + 2 * ( x1 - map.region().x1 );
+		for( std::ptrdiff_t i = 0; i <= w; ++i, c += 2 )
+		{
+			c[0] = static_cast<float>( left.x + step.x * i );
+			c[1] = static_cast<float>( left.y + step.y * i );
+		}
+	}
+}
+
+}
+
+/**
+ * @brief Fill the coordinates of a region of the map from a sparse evaluation of the mapping function.
+ * @param[in] region destination pixels, inside the region of the map
+ * @param[in] tolerance maximal distance in pixels between the interpolated and the exact coordinates,
+ *            checked on the middles of the cells
+ */
+template<class MapFn>
+void warp_coordinates( coordinates_map& map, const MapFn& dst_to_src, const Rect<std::ssize_t>& region, const double tolerance = kWarpTolerance )
+{
+	if( region.x2 <= region.x1 || region.y2 <= region.y1 )
+		return;
+	// the cells share their edges, last row and column included
+	for( std::ptrdiff_t y1 = region.y1, y2; ; y1 = y2 )
+	{
+		y2 = std::min( y1 + kWarpGridStep, std::ptrdiff_t( region.y2 - 1 ) );
+		point2<double> p11 = details::warp_evaluate( dst_to_src, region.x1, y1 );
+		point2<double> p12 = details::warp_evaluate( dst_to_src, region.x1, y2 );
+		for( std::ptrdiff_t x1 = region.x1, x2; ; x1 = x2 )
+		{
+			x2 = std::min( x1 + kWarpGridStep, std::ptrdiff_t( region.x2 - 1 ) );
+			const point2<double> p21 = details::warp_evaluate( dst_to_src, x2, y1 );
+			const point2<double> p22 = details::warp_evaluate( dst_to_src, x2, y2 );
+			details::warp_cell( map, dst_to_src, x1, y1, x2, y2, p11, p21, p12, p22, tolerance );
+			if( x2 >= region.x2 - 1 )
+				break;
+			p11 = p21;
+			p12 = p22;
+		}
+		if( y2 >= region.y2 - 1 )
+			break;
+	}
+}
+
+/**
+ * @brief Set each pixel of the destination view as the result of the sampling
+ * of the source view at the transformed coordinates.
+ * @ingroup ImageAlgorithms
+ *
+ * Same interface as resample_pixels_progress, with the coordinates
+ * interpolated on a sparse grid (see warp_coordinates) and the
+ * resampling done by tiles with resample_pixels_map.
+ *
+ * @return true if the process was aborted
+ */
+template<
+	typename Sampler, // Models SamplerConcept
+	typename SrcView, // Models RandomAccess2DImageViewConcept
+	typename DstView, // Models MutableRandomAccess2DImageViewConcept
+	typename MapFn,   // Models MappingFunctionConcept
+	typename Progress>
+bool warp_pixels_progress(
+	const SrcView& src_view, const DstView& dst_view,
+	const MapFn& dst_to_src, const terry::Rect<std::ssize_t>& procWindow,
+	const EParamFilterOutOfImage& outOfImageProcess,
+	Progress& p,
+	Sampler sampler = Sampler(),
+	const double tolerance = kWarpTolerance )
+{
+	coordinates_map map;
+	for( std::ssize_t y = procWindow.y1; y < procWindow.y2; y += kWarpTileSize )
+	{
+		for( std::ssize_t x = procWindow.x1; x < procWindow.x2; x += kWarpTileSize )
+		{
+			const terry::Rect<std::ssize_t> tile( x, y, std::min( x + kWarpTileSize, procWindow.x2 ), std::min( y + kWarpTileSize, procWindow.y2 ) );
+			map.reset( tile );
+			warp_coordinates( map, dst_to_src, tile, tolerance );
+			if( resample_pixels_map( src_view, dst_view, map, tile, outOfImageProcess, p, sampler ) )
+				return true;
+		}
+	}
+	return false;
+}
+
+}
+}
+
+#endif
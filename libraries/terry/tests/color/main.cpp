@@ -0,0 +1,80 @@
+#include <terry/color/lut3d.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#define BOOST_TEST_MODULE terry_color_tests
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+using namespace terry::color;
+
+namespace {
+
+void smoothTransform( float* rgb )
+{
+	const float r = rgb[0], g = rgb[1], b = rgb[2];
+	rgb[0] = r * r;
+	rgb[1] = 0.5f * g + 0.3f * b;
+	rgb[2] = r * g;
+}
+
+struct SmoothTransform
+{
+	void operator()( float* nodes, const std::size_t nbNodes ) const
+	{
+		for( std::size_t i = 0; i < nbNodes; ++i )
+			smoothTransform( nodes + i * lut3d::kNodeSize );
+	}
+};
+
+struct Identity
+{
+	void operator()( float*, const std::size_t ) const {}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE( terry_color_tests_suite01 )
+
+BOOST_AUTO_TEST_CASE( lut3d_linear )
+{
+	lut3d lut;
+	lut.bake( 33, lut3d_shaper_t(), SmoothTransform() );
+
+	const std::size_t nbPixels = 1000;
+	std::vector<float> src( nbPixels * 4 );
+	for( std::size_t i = 0; i < src.size(); ++i )
+		src[i] = std::rand() / float( RAND_MAX );
+	std::vector<float> dst( src.size() );
+	lut.apply( &src.front(), &dst.front(), nbPixels, 4 );
+
+	for( std::size_t i = 0; i < nbPixels; ++i )
+	{
+		float expected[3] = { src[i * 4], src[i * 4 + 1], src[i * 4 + 2] };
+		smoothTransform( expected );
+		for( int c = 0; c < 3; ++c )
+			BOOST_CHECK_SMALL( dst[i * 4 + c] - expected[c], 1e-3f );
+		// alpha is copied
+		BOOST_CHECK_EQUAL( dst[i * 4 + 3], src[i * 4 + 3] );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( lut3d_log2_in_place )
+{
+	lut3d lut;
+	lut.bake( 17, lut3d_shaper_t( eLut3DShaperLog2, -8.0f, 8.0f ), Identity() );
+
+	// the nodes are exact, the values outside of the range are clamped
+	float values[] = { 1.0f, 0.25f, 16.0f,
+	                   0.0f, 1000.0f, -1.0f };
+	lut.apply( values, values, 2, 3 );
+	BOOST_CHECK_CLOSE( values[0], 1.0f, 1e-4f );
+	BOOST_CHECK_CLOSE( values[1], 0.25f, 1e-4f );
+	BOOST_CHECK_CLOSE( values[2], 16.0f, 1e-4f );
+	BOOST_CHECK_CLOSE( values[3], 1.0f / 256.0f, 1e-4f );
+	BOOST_CHECK_CLOSE( values[4], 256.0f, 1e-4f );
+	BOOST_CHECK_CLOSE( values[5], 1.0f / 256.0f, 1e-4f );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,97 @@
+#include <terry/globals.hpp>
+#include <terry/filter/boxBlur.hpp>
+#include <terry/filter/gaussianKernel.hpp>
+
+#include <boost/gil/image.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE( terry_filter_boxBlur )
+
+BOOST_AUTO_TEST_CASE( box_blur_kernel_variance )
+{
+	const double sizes[] = { 25.0, 100.0, 1000.0, 40000.0 };
+	for( std::size_t i = 0; i < 4; ++i )
+	{
+		const terry::filter::box_blur_kernel kernel = terry::filter::buildBoxBlurKernel( sizes[i] );
+		BOOST_CHECK_EQUAL( kernel.radius().size(), terry::filter::kBoxBlurNbPasses );
+
+		double variance = 0;
+		for( std::size_t p = 0; p < kernel.radius().size(); ++p )
+		{
+			const double width = 2.0 * kernel.radius()[p] + 1.0;
+			variance += ( width * width - 1.0 ) / 12.0;
+		}
+		BOOST_CHECK_CLOSE( variance, sizes[i], 5.0 );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( box_blur_gaussian_deviation )
+{
+	using namespace boost::gil;
+	// impulse response of the box filters against the normalized gaussian kernel
+	// (small epsilon: the whole gaussian, not the truncated one)
+	const double sizes[] = { 25.0, 100.0, 1000.0 };
+	for( std::size_t i = 0; i < 3; ++i )
+	{
+		const terry::filter::box_blur_kernel box = terry::filter::buildBoxBlurKernel( sizes[i] );
+		const terry::filter::kernel_1d<float> gaussian = terry::filter::buildGaussian1DKernel<float>( sizes[i], true, 1e-4 );
+		const std::ptrdiff_t center = std::max( box.left_size(), gaussian.left_size() );
+
+		gray32f_image_t impulse( 2 * center + 1, 1 );
+		fill_pixels( view( impulse ), gray32f_pixel_t( 0.0f ) );
+		view( impulse )( center, 0 ) = gray32f_pixel_t( 1.0f );
+		gray32f_image_t response( impulse.dimensions() );
+		terry::filter::correlate_rows<gray32f_pixel_t>( const_view( impulse ), box, view( response ), point2<std::ptrdiff_t>( 0, 0 ), terry::filter::convolve_option_extend_zero );
+
+		const std::ptrdiff_t gaussianBegin = center - gaussian.left_size();
+		const double peak = gaussian[gaussian.center()];
+		double maxDiff = 0;
+		double sumDiff = 0;
+		for( std::ptrdiff_t x = 0; x < 2 * center + 1; ++x )
+		{
+			const std::ptrdiff_t g = x - gaussianBegin;
+			const double expected = ( g >= 0 && g < std::ptrdiff_t( gaussian.size() ) ) ? gaussian[g] : 0.0;
+			const double diff = std::abs( view( response )( x, 0 )[0] - expected );
+			maxDiff = std::max( maxDiff, diff );
+			sumDiff += diff;
+		}
+		BOOST_CHECK_LT( maxDiff, 0.05 * peak );
+		BOOST_CHECK_LT( sumDiff, 0.05 );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( box_blur_rows_cols )
+{
+	using namespace boost::gil;
+	const terry::filter::box_blur_kernel kernel = terry::filter::buildBoxBlurKernel( 100.0 );
+
+	rgba32f_image_t src( 150, 90 );
+	for( int y = 0; y < src.height(); ++y )
+		for( int x = 0; x < src.width(); ++x )
+			view( src )( x, y ) = rgba32f_pixel_t( ( x / 10 ) % 2, ( y / 10 ) % 2, x * 0.01f, 1.0f );
+
+	// a constant image stays constant
+	rgba32f_image_t cols( src.dimensions() );
+	terry::filter::correlate_cols<rgba32f_pixel_t>( const_view( src ), kernel, view( cols ), point2<std::ptrdiff_t>( 0, 0 ), terry::filter::convolve_option_extend_mirror );
+	// columns and rows of the transposed image give the same result
+	rgba32f_image_t transposed( src.height(), src.width() );
+	terry::filter::correlate_rows<rgba32f_pixel_t>( transposed_view( const_view( src ) ), kernel, view( transposed ), point2<std::ptrdiff_t>( 0, 0 ), terry::filter::convolve_option_extend_mirror );
+
+	for( int y = 0; y < src.height(); ++y )
+	{
+		for( int x = 0; x < src.width(); ++x )
+		{
+			BOOST_CHECK_CLOSE( view( cols )( x, y )[3], 1.0f, 1e-3 );
+			for( int c = 0; c < 4; ++c )
+				BOOST_CHECK_CLOSE( view( cols )( x, y )[c] + 1.0f, view( transposed )( y, x )[c] + 1.0f, 1e-3 );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
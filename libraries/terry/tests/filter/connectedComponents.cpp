@@ -0,0 +1,168 @@
+#include <terry/globals.hpp>
+#include <terry/filter/floodFill.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+namespace {
+
+/**
+ * Label a random image by tiles and compare with a breadth-first search
+ * of each component on the whole region.
+ * @return number of pixels whose component or mark differs
+ */
+template<class Connexity>
+int compareWithBreadthFirstSearch( const int width, const int height, const std::ssize_t tileSize, const unsigned int seed )
+{
+	const float soft = 0.45f;
+	const float strong = 0.97f;
+	std::srand( seed );
+	terry::gray32f_image_t inImage( width, height );
+	terry::gray32f_view_t inView = boost::gil::view( inImage );
+	for( int y = 0; y < height; ++y )
+		for( int x = 0; x < width; ++x )
+			inView( x, y ) = terry::gray32f_pixel_t( ( std::rand() % 100 ) / 100.0f );
+
+	// the first and last rows and columns are out of the region
+	terry::filter::connected_components components;
+	components.reset( terry::Rect<std::ssize_t>( 1, 1, width - 1, height - 1 ), tileSize );
+	for( std::size_t i = 0; i < components.nb_tiles(); ++i )
+		components.label_tile<Connexity>( i, inView,
+			terry::filter::floodFill::IsUpper<float>( soft ),
+			terry::filter::floodFill::IsUpper<float>( strong ) );
+	components.merge_tiles<Connexity>();
+
+	// reference
+	std::vector<int> reference( width * height, -1 );
+	std::vector<bool> marked;
+	for( int y = 1; y < height - 1; ++y )
+	{
+		for( int x = 1; x < width - 1; ++x )
+		{
+			if( inView( x, y )[0] < soft || reference[y * width + x] >= 0 )
+				continue;
+			const int component = static_cast<int>( marked.size() );
+			bool mark = false;
+			std::queue<std::pair<int, int> > pixels;
+			pixels.push( std::make_pair( x, y ) );
+			reference[y * width + x] = component;
+			while( ! pixels.empty() )
+			{
+				const int px = pixels.front().first;
+				const int py = pixels.front().second;
+				pixels.pop();
+				mark = mark || inView( px, py )[0] >= strong;
+				for( int dy = -1; dy <= 1; ++dy )
+				{
+					for( int dx = -1; dx <= 1; ++dx )
+					{
+						if( ( dx == 0 && dy == 0 ) || ( ! Connexity::x && dx != 0 && dy != 0 ) )
+							continue;
+						const int nx = px + dx;
+						const int ny = py + dy;
+						if( nx < 1 || ny < 1 || nx >= width - 1 || ny >= height - 1 ||
+						    inView( nx, ny )[0] < soft || reference[ny * width + nx] >= 0 )
+							continue;
+						reference[ny * width + nx] = component;
+						pixels.push( std::make_pair( nx, ny ) );
+					}
+				}
+			}
+			marked.push_back( mark );
+		}
+	}
+
+	// same partition of the pixels: one label for each reference component and conversely
+	typedef terry::filter::connected_components::Label Label;
+	std::map<int, Label> labelOfComponent;
+	std::map<Label, int> componentOfLabel;
+	int errors = 0;
+	for( int y = 1; y < height - 1; ++y )
+	{
+		for( int x = 1; x < width - 1; ++x )
+		{
+			const int component = reference[y * width + x];
+			const Label label = components.label( x, y );
+			if( component < 0 )
+			{
+				if( label != terry::filter::connected_components::kNoLabel )
+					++errors;
+				continue;
+			}
+			if( ( labelOfComponent.count( component ) && labelOfComponent[component] != label ) ||
+			    ( componentOfLabel.count( label ) && componentOfLabel[label] != component ) ||
+			    components.is_marked( x, y ) != marked[component] )
+				++errors;
+			labelOfComponent[component] = label;
+			componentOfLabel[label] = component;
+		}
+	}
+	return errors;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( terry_filter_connectedComponents_tests_suite01 )
+
+BOOST_AUTO_TEST_CASE( connectedComponents )
+{
+	// a diagonal line crossing the tile borders, with a strong pixel at its end
+	terry::gray32f_image_t inImage( 10, 10 );
+	terry::gray32f_view_t inView = boost::gil::view( inImage );
+	boost::gil::fill_pixels( inView, terry::gray32f_pixel_t( 0.0f ) );
+	for( int i = 1; i < 9; ++i )
+		inView( i, i ) = terry::gray32f_pixel_t( 0.5f );
+	inView( 8, 8 ) = terry::gray32f_pixel_t( 1.0f );
+	inView( 1, 8 ) = terry::gray32f_pixel_t( 0.5f ); // alone
+
+	terry::filter::connected_components components;
+	components.reset( terry::Rect<std::ssize_t>( 1, 1, 9, 9 ), 3 );
+	for( std::size_t i = 0; i < components.nb_tiles(); ++i )
+		components.label_tile<terry::filter::floodFill::Connexity8>( i, inView,
+			terry::filter::floodFill::IsUpper<float>( 0.25f ),
+			terry::filter::floodFill::IsUpper<float>( 0.75f ) );
+	components.merge_tiles<terry::filter::floodFill::Connexity8>();
+
+	BOOST_CHECK_EQUAL( components.label( 1, 1 ), components.label( 8, 8 ) );
+	BOOST_CHECK( components.is_marked( 1, 1 ) );
+	BOOST_CHECK( components.is_inside( 1, 8 ) );
+	BOOST_CHECK( ! components.is_marked( 1, 8 ) );
+	BOOST_CHECK( ! components.is_inside( 2, 1 ) );
+
+	// with 4 connections, the pixels of the diagonal are not connected
+	components.reset( terry::Rect<std::ssize_t>( 1, 1, 9, 9 ), 3 );
+	for( std::size_t i = 0; i < components.nb_tiles(); ++i )
+		components.label_tile<terry::filter::floodFill::Connexity4>( i, inView,
+			terry::filter::floodFill::IsUpper<float>( 0.25f ),
+			terry::filter::floodFill::IsUpper<float>( 0.75f ) );
+	components.merge_tiles<terry::filter::floodFill::Connexity4>();
+
+	BOOST_CHECK( components.label( 1, 1 ) != components.label( 2, 2 ) );
+	BOOST_CHECK( ! components.is_marked( 7, 7 ) );
+	BOOST_CHECK( components.is_marked( 8, 8 ) );
+}
+
+BOOST_AUTO_TEST_CASE( connectedComponents_breadthFirstSearch )
+{
+	const std::ssize_t tileSizes[] = { 1, 2, 3, 7, 16, 64, 256 };
+	for( unsigned int seed = 0; seed < 20; ++seed )
+	{
+		for( std::size_t i = 0; i < sizeof( tileSizes ) / sizeof( tileSizes[0] ); ++i )
+		{
+			BOOST_CHECK_EQUAL( compareWithBreadthFirstSearch<terry::filter::floodFill::Connexity4>( 37 + seed, 29 + 2 * seed, tileSizes[i], seed ), 0 );
+			BOOST_CHECK_EQUAL( compareWithBreadthFirstSearch<terry::filter::floodFill::Connexity8>( 37 + seed, 29 + 2 * seed, tileSizes[i], seed + 100 ), 0 );
+		}
+	}
+	// regions of a single pixel, and tiles bigger than the region
+	BOOST_CHECK_EQUAL( compareWithBreadthFirstSearch<terry::filter::floodFill::Connexity8>( 3, 3, 4, 1 ), 0 );
+	BOOST_CHECK_EQUAL( compareWithBreadthFirstSearch<terry::filter::floodFill::Connexity4>( 3, 3, 1, 1 ), 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,62 @@
+#include <terry/globals.hpp>
+#include <terry/filter/convolve.hpp>
+
+#include <boost/gil/image.hpp>
+
+#include <iostream>
+
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE( terry_filter_convolve )
+
+namespace {
+
+/// correlate the columns with the vectorized float path and with the generic path (on the transposed image)
+template<class Kernel>
+void checkCorrelateCols( const Kernel& kernel, const terry::filter::convolve_boundary_option option )
+{
+	using namespace boost::gil;
+	rgba32f_image_t src( 301, 37 );
+	for( int y = 0; y < src.height(); ++y )
+		for( int x = 0; x < src.width(); ++x )
+			view( src )( x, y ) = rgba32f_pixel_t( x * 0.01f, y * 0.1f, ( x * y ) % 7, 1.0f );
+
+	rgba32f_image_t cols( src.dimensions() );
+	terry::filter::correlate_cols<rgba32f_pixel_t>( const_view( src ), kernel, view( cols ), point2<std::ptrdiff_t>( 0, 0 ), option );
+
+	rgba32f_image_t transposed( src.height(), src.width() );
+	terry::filter::correlate_rows<rgba32f_pixel_t>( transposed_view( const_view( src ) ), kernel, view( transposed ), point2<std::ptrdiff_t>( 0, 0 ), option );
+
+	// in place
+	rgba32f_image_t inplace( src );
+	terry::filter::correlate_cols<rgba32f_pixel_t>( const_view( inplace ), kernel, view( inplace ), point2<std::ptrdiff_t>( 0, 0 ), option );
+
+	for( int y = 0; y < src.height(); ++y )
+	{
+		for( int x = 0; x < src.width(); ++x )
+		{
+			for( int c = 0; c < 4; ++c )
+			{
+				BOOST_CHECK_CLOSE( view( cols )( x, y )[c] + 1.0f, view( transposed )( y, x )[c] + 1.0f, 1e-3 );
+				BOOST_CHECK_CLOSE( view( inplace )( x, y )[c] + 1.0f, view( transposed )( y, x )[c] + 1.0f, 1e-3 );
+			}
+		}
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( correlate_cols_float )
+{
+	static const float values[] = { 0.1f, 0.2f, 0.4f, 0.2f, 0.1f };
+	const terry::filter::kernel_1d<float> kernel( values, 5, 2 );
+	const terry::filter::kernel_1d_fixed<float, 5> kernelFixed( values, 2 );
+
+	checkCorrelateCols( kernel, terry::filter::convolve_option_extend_zero );
+	checkCorrelateCols( kernel, terry::filter::convolve_option_extend_constant );
+	checkCorrelateCols( kernel, terry::filter::convolve_option_extend_mirror );
+	checkCorrelateCols( kernelFixed, terry::filter::convolve_option_extend_mirror );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
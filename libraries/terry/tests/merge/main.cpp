@@ -0,0 +1,102 @@
+#include <terry/globals.hpp>
+#include <terry/merge/ViewsMerging.hpp>
+#include <terry/merge/MergeFunctors.hpp>
+
+#include <boost/gil/gil_all.hpp>
+
+#include <cstdlib>
+
+#define BOOST_TEST_MODULE terry_merge_tests
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+using namespace boost::gil;
+
+namespace {
+
+void fillRandom( const rgba32f_view_t& view, const int phase )
+{
+	for( std::ptrdiff_t y = 0; y < view.height(); ++y )
+	{
+		rgba32f_view_t::x_iterator it = view.row_begin( y );
+		for( std::ptrdiff_t x = 0; x < view.width(); ++x, ++it )
+		{
+			// premultiplied pixels, with some opaque and transparent rows
+			const int row = ( y + phase ) % 3;
+			const float alpha = ( row == 0 ) ? 1.0f : ( row == 1 ? 0.0f : std::rand() / float( RAND_MAX ) );
+			for( int c = 0; c < 3; ++c )
+				( *it )[c] = alpha * ( std::rand() / float( RAND_MAX ) * 2.0f - 0.5f );
+			( *it )[3] = alpha;
+		}
+	}
+}
+
+/// vectorized merge compared to the per pixel functor
+template<template<typename> class Functor>
+void checkMerge()
+{
+	typedef rgba32f_pixel_t Pixel;
+	rgba32f_image_t a( 37, 11 );
+	rgba32f_image_t b( 37, 11 );
+	rgba32f_image_t dst( 37, 11 );
+	// rows of A and B are shifted, to mix the cases
+	fillRandom( view( a ), 0 );
+	fillRandom( view( b ), 1 );
+
+	terry::merge_views( view( a ), view( b ), view( dst ), Functor<Pixel>() );
+
+	Functor<Pixel> functor;
+	for( std::ptrdiff_t y = 0; y < a.height(); ++y )
+	{
+		for( std::ptrdiff_t x = 0; x < a.width(); ++x )
+		{
+			Pixel expected;
+			terry::detail::merger<typename Functor<Pixel>::operating_mode_t>()( const_view( a )( x, y ), const_view( b )( x, y ), expected, functor );
+			for( int c = 0; c < 4; ++c )
+				BOOST_CHECK_CLOSE( float( const_view( dst )( x, y )[c] ) + 1.0f, float( expected[c] ) + 1.0f, 1e-4 );
+		}
+	}
+
+	// in place, dst is B
+	rgba32f_image_t inPlace( b );
+	terry::merge_views( view( a ), view( inPlace ), view( inPlace ), Functor<Pixel>() );
+	for( std::ptrdiff_t y = 0; y < a.height(); ++y )
+		for( std::ptrdiff_t x = 0; x < a.width(); ++x )
+			for( int c = 0; c < 4; ++c )
+				BOOST_CHECK_EQUAL( float( const_view( inPlace )( x, y )[c] ), float( const_view( dst )( x, y )[c] ) );
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( terry_merge_tests_suite01 )
+
+BOOST_AUTO_TEST_CASE( over )
+{
+	checkMerge<terry::FunctorOver>();
+}
+
+BOOST_AUTO_TEST_CASE( plus )
+{
+	checkMerge<terry::FunctorPlus>();
+}
+
+BOOST_AUTO_TEST_CASE( multiply )
+{
+	checkMerge<terry::FunctorMultiply>();
+}
+
+BOOST_AUTO_TEST_CASE( screen )
+{
+	checkMerge<terry::FunctorScreen>();
+}
+
+BOOST_AUTO_TEST_CASE( in )
+{
+	checkMerge<terry::FunctorIn>();
+}
+
+BOOST_AUTO_TEST_CASE( out )
+{
+	checkMerge<terry::FunctorOut>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
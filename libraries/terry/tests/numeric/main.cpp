@@ -0,0 +1,87 @@
+#include <terry/globals.hpp>
+#include <terry/numeric/statistics.hpp>
+
+#include <boost/gil/gil_all.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#define BOOST_TEST_MODULE terry_numeric_tests
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test;
+using namespace boost::gil;
+
+BOOST_AUTO_TEST_SUITE( terry_numeric_tests_suite01 )
+
+BOOST_AUTO_TEST_CASE( moments )
+{
+	std::vector<double> values;
+	for( int i = 0; i < 10007; ++i )
+		values.push_back( std::pow( std::rand() / double( RAND_MAX ), 3 ) * 100.0 + 5.0 );
+
+	// two pass reference
+	double sum = 0.0;
+	for( std::size_t i = 0; i < values.size(); ++i )
+		sum += values[i];
+	const double mean = sum / values.size();
+	double s2 = 0.0, s3 = 0.0, s4 = 0.0;
+	for( std::size_t i = 0; i < values.size(); ++i )
+	{
+		const double d = values[i] - mean;
+		s2 += d * d;
+		s3 += d * d * d;
+		s4 += d * d * d * d;
+	}
+	const double n        = values.size();
+	const double variance = s2 / n;
+	const double skewness = ( s3 / n ) / std::pow( variance, 1.5 );
+	const double kurtosis = ( s4 / n ) / ( variance * variance ) - 3.0;
+
+	// single pass, and split in parts merged together
+	terry::numeric::moments_accumulator_t all;
+	terry::numeric::moments_accumulator_t parts[7];
+	for( std::size_t i = 0; i < values.size(); ++i )
+	{
+		all( values[i] );
+		parts[( i * 7 ) / values.size()]( values[i] );
+	}
+	terry::numeric::moments_accumulator_t merged;
+	for( int i = 0; i < 7; ++i )
+		merged.merge( parts[i] );
+
+	BOOST_CHECK_EQUAL( merged.n, values.size() );
+	BOOST_CHECK_CLOSE( all.mean, mean, 1e-9 );
+	BOOST_CHECK_CLOSE( all.variance(), variance, 1e-9 );
+	BOOST_CHECK_CLOSE( all.skewness(), skewness, 1e-7 );
+	BOOST_CHECK_CLOSE( all.kurtosis(), kurtosis, 1e-6 );
+	BOOST_CHECK_CLOSE( merged.mean, mean, 1e-9 );
+	BOOST_CHECK_CLOSE( merged.variance(), variance, 1e-9 );
+	BOOST_CHECK_CLOSE( merged.skewness(), skewness, 1e-7 );
+	BOOST_CHECK_CLOSE( merged.kurtosis(), kurtosis, 1e-6 );
+}
+
+BOOST_AUTO_TEST_CASE( pixel_statistics )
+{
+	typedef rgba32f_pixel_t Pixel;
+	terry::numeric::pixel_statistics_t<Pixel> first;
+	terry::numeric::pixel_statistics_t<Pixel> second;
+	terry::numeric::pixel_statistics_t<Pixel> empty;
+
+	first( Pixel( 0.5f, 0.2f, 0.1f, 1.0f ) );
+	first( Pixel( 0.1f, 0.9f, 0.3f, 1.0f ) );
+	second( Pixel( 0.0f, 0.0f, 0.05f, 0.0f ) );
+	second( Pixel( 1.0f, 1.0f, 1.0f, 1.0f ) );
+
+	first.merge( empty );
+	first.merge( second );
+
+	BOOST_CHECK_EQUAL( first.moments[0].n, 4u );
+	BOOST_CHECK_CLOSE( first.moments[0].mean, 0.4, 1e-4 );
+	BOOST_CHECK_EQUAL( float( first.channelMin[2] ), 0.05f );
+	BOOST_CHECK_EQUAL( float( first.channelMax[1] ), 1.0f );
+	BOOST_CHECK_EQUAL( float( first.luminosityMin[3] ), 0.0f );
+	BOOST_CHECK_EQUAL( float( first.luminosityMax[0] ), 1.0f );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,136 @@
+#include <terry/sampler/all.hpp>
+#include <terry/sampler/resample_separable.hpp>
+#include <terry/sampler/resample_progress.hpp>
+#include <terry/sampler/warp.hpp>
+
+#include <iostream>
+
+#define BOOST_TEST_MODULE terry_sampler_tests
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::unit_test;
+using namespace terry::sampler;
+
+namespace {
+
+/// barrel distortion around the point (100, 80)
+struct radial_mapping
+{
+	double _k;
+};
+
+template<typename F>
+terry::point2<double> transform( const radial_mapping& m, const terry::point2<F>& p )
+{
+	const double x = ( p.x - 100.0 ) / 150.0;
+	const double y = ( p.y - 80.0 ) / 150.0;
+	const double s = 1.0 + m._k * ( x * x + y * y );
+	return terry::point2<double>( x * s * 150.0 + 100.0, y * s * 150.0 + 80.0 );
+}
+
+struct NoProgress
+{
+	bool progressForward( const int ) { return false; }
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE( terry_sampler_separable_suite01 )
+
+BOOST_AUTO_TEST_CASE( weights_identity )
+{
+	bilinear_sampler sampler;
+	separable_weights table;
+	compute_separable_weights( sampler, 1.0, 0.0, 16, 0, 16, eParamFilterOutCopy, table );
+
+	for( std::size_t o = 0; o < 16; ++o )
+	{
+		float sum = 0;
+		for( std::size_t k = 0; k < table._nbTaps; ++k )
+		{
+			const float w = table._weights[o * table._nbTaps + k];
+			sum += w;
+			if( table._first[o] + std::ptrdiff_t( k ) == std::ptrdiff_t( o ) )
+				BOOST_CHECK_CLOSE( w, 1.0f, 1e-4 );
+			else
+				BOOST_CHECK_SMALL( w, 1e-6f );
+		}
+		BOOST_CHECK_CLOSE( sum, 1.0f, 1e-4 );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( weights_downscale_inside_image )
+{
+	lanczos3_sampler sampler;
+	separable_weights table;
+	// 4K to HD: the filter is stretched to 2 input pixels
+	compute_separable_weights( sampler, 2.0, 0.5, 3840, 0, 1920, eParamFilterOutBlack, table );
+
+	BOOST_CHECK_EQUAL( table._nbTaps, 13u );
+	for( std::size_t o = 0; o < 1920; ++o )
+	{
+		BOOST_CHECK( table._first[o] >= 0 );
+		BOOST_CHECK( table._first[o] + table._nbTaps <= 3840 );
+		float sum = table._borderWeights[o];
+		for( std::size_t k = 0; k < table._nbTaps; ++k )
+			sum += table._weights[o * table._nbTaps + k];
+		BOOST_CHECK_CLOSE( sum, 1.0f, 1e-3 );
+	}
+	// only the borders use the out of image color
+	BOOST_CHECK( table._borderWeights[0] != 0.0f );
+	BOOST_CHECK_EQUAL( table._borderWeights[960], 0.0f );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( terry_sampler_warp_suite01 )
+
+BOOST_AUTO_TEST_CASE( warp_coordinates_tolerance )
+{
+	const radial_mapping mapping = { 0.3 };
+	const terry::Rect<std::ssize_t> regions[] = {
+		terry::Rect<std::ssize_t>( 0, 0, 200, 160 ),
+		terry::Rect<std::ssize_t>( 5, 7, 6, 8 ),   // single pixel
+		terry::Rect<std::ssize_t>( 5, 7, 6, 70 ) }; // single column
+
+	for( std::size_t r = 0; r < 3; ++r )
+	{
+		coordinates_map exact, sparse;
+		exact.reset( regions[r] );
+		sparse.reset( regions[r] );
+		exact.compute( mapping );
+		warp_coordinates( sparse, mapping, regions[r] );
+		for( std::ptrdiff_t y = regions[r].y1; y < regions[r].y2; ++y )
+		{
+			for( std::ptrdiff_t x = regions[r].x1; x < regions[r].x2; ++x )
+			{
+				BOOST_CHECK_SMALL( exact.at( x, y ).x - sparse.at( x, y ).x, 2.0 * kWarpTolerance );
+				BOOST_CHECK_SMALL( exact.at( x, y ).y - sparse.at( x, y ).y, 2.0 * kWarpTolerance );
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( resample_map_same_as_generic )
+{
+	const radial_mapping mapping = { 0.1 };
+	terry::rgba32f_image_t src( 200, 160 ), generic( 200, 160 ), mapped( 200, 160 );
+	for( std::ptrdiff_t y = 0; y < 160; ++y )
+		for( std::ptrdiff_t x = 0; x < 200; ++x )
+			terry::view( src )( x, y ) = terry::rgba32f_pixel_t( x * 0.01f, y * 0.02f, std::sin( x * y * 0.01f ), 1.0f );
+
+	const terry::Rect<std::ssize_t> window( 0, 0, 200, 160 );
+	coordinates_map map;
+	map.reset( window );
+	map.compute( mapping );
+	NoProgress progress;
+	resample_pixels_progress( terry::view( src ), terry::view( generic ), mapping, window, eParamFilterOutBlack, progress, bicubic_sampler() );
+	resample_pixels_map( terry::view( src ), terry::view( mapped ), map, window, eParamFilterOutBlack, progress, bicubic_sampler() );
+
+	for( std::ptrdiff_t y = 0; y < 160; ++y )
+		for( std::ptrdiff_t x = 0; x < 200; ++x )
+			for( int c = 0; c < 4; ++c )
+				BOOST_CHECK_SMALL( terry::view( generic )( x, y )[c] - terry::view( mapped )( x, y )[c], 1e-3f );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -21,6 +21,8 @@
 #include <tuttle/host/ofx/attribute/OfxhClip.hpp>
 #include <tuttle/host/ofx/attribute/OfxhParam.hpp>
 
+#include <tuttle/common/math/rectOp.hpp>
+
 #ifndef TUTTLE_PRODUCTION
 // to output all nodes as png for debug
 //#define TUTTLE_DEBUG_OUTPUT_ALL_NODES
@@ -48,6 +50,7 @@ ImageEffectNode::ImageEffectNode( tuttle::host::ofx::imageEffect::OfxhImageEffec
 				  tuttle::host::ofx::imageEffect::OfxhImageEffectNodeDescriptor& desc,
 				  const std::string&                                             context )
 	: tuttle::host::ofx::imageEffect::OfxhImageEffectNode( plugin, desc, context, false )
+	, _constantOutputHash( 0 )
 {
 	populate();
 	//	createInstanceAction();
@@ -56,6 +59,7 @@ ImageEffectNode::ImageEffectNode( tuttle::host::ofx::imageEffect::OfxhImageEffec
 ImageEffectNode::ImageEffectNode( const ImageEffectNode& other )
 	: INode( other )
 	, tuttle::host::ofx::imageEffect::OfxhImageEffectNode( other )
+	, _constantOutputHash( 0 )
 {
 	populate();
 	copyAttributesValues( other ); // values need to be setted before the createInstanceAction !
@@ -774,6 +778,7 @@ void ImageEffectNode::setup3()
 void ImageEffectNode::beginSequence( graph::ProcessVertexData& vData )
 {
 	//TUTTLE_TLOG( TUTTLE_INFO, "begin: " << getName() );
+	_constantOutputImage.reset();
 	beginSequenceRenderAction(
 			vData._renderTimeRange.min,
 			vData._renderTimeRange.max,
@@ -899,6 +904,7 @@ void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
 	}
 	
 	TUTTLE_TLOG( TUTTLE_INFO, "[Node Process] Acquire needed output clip images" );
+	bool needsRender = true;
 	BOOST_FOREACH( ClipImageMap::value_type& i, _clipImages )
 	{
 		attribute::ClipImage& clip = dynamic_cast<attribute::ClipImage&>( *( i.second ) );
@@ -912,7 +918,32 @@ void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
 					attribute::Image::eImageOrientationFromBottomToTop,
 					0 )
 				);
-			imageCache->setPoolData( core().getMemoryPool().allocate( imageCache->getMemorySize() ) );
+			// a crop, a vertical flip or an integer translation uses the buffer of its source
+			if( setInputView( vData, renderWindow, *imageCache ) )
+			{
+				TUTTLE_TLOG( TUTTLE_INFO, "[Node Process] Output is a view of the input image" );
+				needsRender = false;
+			}
+			// a generator with the same parameters produces the same image
+			else if( setConstantOutput( vData, renderWindow, *imageCache ) )
+			{
+				TUTTLE_TLOG( TUTTLE_INFO, "[Node Process] Output is the image of a previous frame" );
+				needsRender = false;
+			}
+			else
+			{
+				// a point operation renders into the buffer of its source if nobody else needs it
+				memory::CACHE_ELEMENT inPlaceImage( getInPlaceSourceImage( vData, *imageCache ) );
+				if( inPlaceImage.get() )
+				{
+					TUTTLE_TLOG( TUTTLE_INFO, "[Node Process] Render in place into " << inPlaceImage->getFullName() );
+					imageCache->setPoolData( inPlaceImage->getPoolData() );
+				}
+				else
+				{
+					imageCache->setPoolData( core().getMemoryPool().allocate( imageCache->getMemorySize() ) );
+				}
+			}
 			memoryCache.put( clip.getClipIdentifier(), vData._time, imageCache );
 			
 			allNeededDatas.push_back( imageCache );
@@ -939,12 +970,24 @@ void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
 //		}
 	}
 
-	TUTTLE_TLOG( TUTTLE_INFO, "[Node Process] Plugin Render Action" );
+	if( needsRender )
+	{
+		TUTTLE_TLOG( TUTTLE_INFO, "[Node Process] Plugin Render Action" );
+
+		renderAction( vData._time,
+					  vData._apiImageEffect._field,
+					  renderWindow,
+					  vData._nodeData->_renderScale );
 
-	renderAction( vData._time,
-				  vData._apiImageEffect._field,
-				  renderWindow,
-				  vData._nodeData->_renderScale );
+		if( isConstantOutput( vData ) )
+		{
+			// keep the output for the next frames, nobody can modify it in place
+			_constantOutputImage = memoryCache.get( getOutputClip().getClipIdentifier(), vData._time );
+			_constantOutputImage->setPoolDataShared();
+			_constantOutputHash = getConstantOutputHash( vData );
+			_constantOutputWindow = renderWindow;
+		}
+	}
 	
 	debugOutputImage( vData._time );
 
@@ -1010,6 +1053,117 @@ void ImageEffectNode::process( graph::ProcessVertexAtTimeData& vData )
 }
 
 
+/**
+ * @brief Source image whose buffer can be reused as output buffer.
+ *
+ * Consecutive point operations render one after the other into the same
+ * buffer, instead of allocating and filling a new frame for each node.
+ * @return an empty element if the node needs its own output buffer
+ */
+memory::CACHE_ELEMENT ImageEffectNode::getInPlaceSourceImage( const graph::ProcessVertexAtTimeData& vData, const attribute::Image& outputImage ) const
+{
+	memory::CACHE_ELEMENT noImage;
+	if( ! isPointOperation() || vData._inEdges.size() != 1 )
+		return noImage;
+
+	const graph::ProcessEdgeAtTime* inEdge = vData._inEdges.begin()->second;
+	if( inEdge->getOutTime() != vData._time )
+		return noImage;
+
+	const attribute::ClipImage& clip = getClip( inEdge->getInAttrName() );
+	if( ! clip.isConnected() )
+		return noImage;
+	// the buffers of the final nodes are returned to the user
+	if( clip.getConnectedClip().getNode().getData( vData._time )._isFinalNode )
+		return noImage;
+
+	memory::CACHE_ELEMENT sourceImage( core().getMemoryCache().get( clip.getClipIdentifier(), vData._time ) );
+	if( sourceImage.get() == NULL )
+		return noImage;
+	// the buffer is also read through a view
+	if( sourceImage->isPoolDataShared() )
+		return noImage;
+	// this node is the last user of the source buffer
+	if( sourceImage->getReferenceCount( ofx::imageEffect::OfxhImage::eReferenceOwnerHost ) != 1 )
+		return noImage;
+
+	// same memory layout
+	const OfxRectI sourceBounds = sourceImage->getBounds();
+	const OfxRectI outputBounds = outputImage.getBounds();
+	if( sourceImage->getBitDepth() != outputImage.getBitDepth() ||
+	    sourceImage->getComponentsType() != outputImage.getComponentsType() ||
+	    sourceImage->getRowBytes() != outputImage.getRowBytes() ||
+	    sourceImage->getMemorySize() != outputImage.getMemorySize() ||
+	    sourceBounds.x1 != outputBounds.x1 || sourceBounds.y1 != outputBounds.y1 ||
+	    sourceBounds.x2 != outputBounds.x2 || sourceBounds.y2 != outputBounds.y2 )
+		return noImage;
+
+	return sourceImage;
+}
+
+bool ImageEffectNode::setInputView( const graph::ProcessVertexAtTimeData& vData, const OfxRectI& renderWindow, attribute::Image& outputImage ) const
+{
+	// the buffers of the final nodes are returned to the user, so they are rendered
+	if( ! supportsInputView() || vData._isFinalNode )
+		return false;
+
+	OfxTime time = vData._time;
+	std::string clipName;
+	OfxPointI offset = { 0, 0 };
+	bool flip = false;
+	if( ! getInputViewAction( time, vData._apiImageEffect._field, renderWindow, vData._nodeData->_renderScale, clipName, offset, flip ) )
+		return false;
+
+	graph::ProcessVertexAtTimeData::ProcessEdgeAtTimeByClipName::const_iterator it = vData._inEdges.find( clipName );
+	if( it == vData._inEdges.end() || it->second->getOutTime() != time )
+		return false;
+
+	const attribute::ClipImage& clip = getClip( clipName );
+	memory::CACHE_ELEMENT sourceImage( core().getMemoryCache().get( clip.getClipIdentifier(), time ) );
+	if( sourceImage.get() == NULL ||
+	    sourceImage->getBitDepth() != outputImage.getBitDepth() ||
+	    sourceImage->getComponentsType() != outputImage.getComponentsType() )
+		return false;
+
+	return outputImage.setPoolDataView( *sourceImage, offset, flip );
+}
+
+bool ImageEffectNode::isConstantOutput( const graph::ProcessVertexAtTimeData& vData ) const
+{
+	// the buffers of the final nodes are returned to the user
+	return ! isFrameVarying() && vData._inEdges.empty() && ! vData._isFinalNode;
+}
+
+std::size_t ImageEffectNode::getConstantOutputHash( const graph::ProcessVertexAtTimeData& vData ) const
+{
+	// the local hash doesn't depend on the time if the node is not frame varying
+	std::size_t seed = getLocalHashAtTime( vData._time );
+	boost::hash_combine( seed, vData._nodeData->_renderScale.x );
+	boost::hash_combine( seed, vData._nodeData->_renderScale.y );
+	boost::hash_combine( seed, vData._apiImageEffect._field );
+	return seed;
+}
+
+bool ImageEffectNode::setConstantOutput( const graph::ProcessVertexAtTimeData& vData, const OfxRectI& renderWindow, attribute::Image& outputImage )
+{
+	if( ! _constantOutputImage.get() || ! isConstantOutput( vData ) )
+		return false;
+	// only the render window of the kept image contains rendered pixels,
+	// a larger render window is rendered and replaces the kept image
+	if( ! rectangleAContainsB( _constantOutputWindow, renderWindow ) )
+		return false;
+	if( _constantOutputHash != getConstantOutputHash( vData ) ||
+	    _constantOutputImage->getBitDepth() != outputImage.getBitDepth() ||
+	    _constantOutputImage->getComponentsType() != outputImage.getComponentsType() )
+	{
+		_constantOutputImage.reset();
+		return false;
+	}
+	// the render window may be a part of the previous one
+	const OfxPointI noOffset = { 0, 0 };
+	return outputImage.setPoolDataView( *_constantOutputImage, noOffset, false );
+}
+
 void ImageEffectNode::postProcess( graph::ProcessVertexAtTimeData& vData )
 {
 //	TUTTLE_TLOG( TUTTLE_INFO, "postProcess: " << getName() );
@@ -1019,6 +1173,7 @@ void ImageEffectNode::postProcess( graph::ProcessVertexAtTimeData& vData )
 void ImageEffectNode::endSequence( graph::ProcessVertexData& vData )
 {
 //	TUTTLE_TLOG( TUTTLE_INFO, "end: " << getName() );
+	_constantOutputImage.reset();
 	endSequenceRenderAction( vData._renderTimeRange.min,
 			 vData._renderTimeRange.max,
 			 vData._step,
@@ -7,6 +7,7 @@
 #include <tuttle/host/attribute/ClipImage.hpp>
 #include <tuttle/host/graph/ProcessVertexData.hpp>
 #include <tuttle/host/graph/ProcessVertexAtTimeData.hpp>
+#include <tuttle/host/memory/IMemoryCache.hpp>
 
 #include <tuttle/host/ofx/OfxhImageEffectNode.hpp>
 
@@ -261,6 +262,12 @@ public:
 private:
 	void checkClipsConnections() const;
 
+	memory::CACHE_ELEMENT getInPlaceSourceImage( const graph::ProcessVertexAtTimeData& vData, const attribute::Image& outputImage ) const;
+	bool setInputView( const graph::ProcessVertexAtTimeData& vData, const OfxRectI& renderWindow, attribute::Image& outputImage ) const;
+	bool isConstantOutput( const graph::ProcessVertexAtTimeData& vData ) const;
+	std::size_t getConstantOutputHash( const graph::ProcessVertexAtTimeData& vData ) const;
+	bool setConstantOutput( const graph::ProcessVertexAtTimeData& vData, const OfxRectI& renderWindow, attribute::Image& outputImage );
+
 	void initComponents();
 	void initInputClipsPixelAspectRatio();
 	void initPixelAspectRatio();
@@ -271,6 +278,12 @@ private:
 	void maximizeBitDepthFromWritesToReads();
 	void coutBitDepthConnections() const;
 	void validBitDepthConnections() const;
+
+private:
+	/// last output of a node without input and not frame varying, reused by the next frames while the hash doesn't change
+	memory::CACHE_ELEMENT _constantOutputImage;
+	std::size_t _constantOutputHash;
+	OfxRectI _constantOutputWindow; ///< render window of _constantOutputImage, the only rendered pixels
 };
 
 }
@@ -26,6 +26,8 @@ Image::Image( ClipImage& clip, const OfxTime time, const OfxRectD& bounds, const
 	, _rowAbsDistanceBytes( 0 )
 	, _orientation( orientation )
 	, _fullname( clip.getFullName() )
+	, _dataOffset( 0 )
+	, _poolDataShared( false )
 {
 	// Set rod in canonical & pixel coord.
 	const double par = clip.getPixelAspectRatio();
@@ -66,19 +68,57 @@ Image::~Image()
 	//TUTTLE_TLOG_VAR( TUTTLE_TRACE, getFullName() );
 }
 
+bool Image::setPoolDataView( Image& source, const OfxPointI& offset, const bool flip )
+{
+	const OfxRectI sourceBounds = source.getBounds();
+	const int height = _bounds.y2 - _bounds.y1;
+
+	// region of this image in the source
+	const int x1 = _bounds.x1 + offset.x;
+	const int x2 = _bounds.x2 + offset.x;
+	const int y1 = flip ? offset.y - _bounds.y2 + 1 : _bounds.y1 + offset.y;
+	const int y2 = y1 + height;
+	if( _pixelBytes != source._pixelBytes ||
+	    x1 < sourceBounds.x1 || x2 > sourceBounds.x2 ||
+	    y1 < sourceBounds.y1 || y2 > sourceBounds.y2 )
+		return false;
+
+	// a vertical flip reads the source rows in the other order
+	if( flip )
+		_orientation = source.getOrientation() == eImageOrientationFromBottomToTop ? eImageOrientationFromTopToBottom : eImageOrientationFromBottomToTop;
+	else
+		_orientation = source.getOrientation();
+
+	// first row in memory, in the coordinates of this image then of the source
+	const int firstRow = _orientation == eImageOrientationFromBottomToTop ? _bounds.y1 : _bounds.y2 - 1;
+	const int sourceRow = flip ? offset.y - firstRow : firstRow + offset.y;
+	const int sourceMemoryRow = source.getOrientation() == eImageOrientationFromBottomToTop ? sourceRow - sourceBounds.y1 : sourceBounds.y2 - 1 - sourceRow;
+
+	_rowAbsDistanceBytes = source.getRowAbsDistanceBytes();
+	_memorySize = std::size_t( _rowAbsDistanceBytes ) * height;
+	_data = source._data;
+	_dataOffset = source._dataOffset + std::ptrdiff_t( sourceMemoryRow ) * _rowAbsDistanceBytes + std::ptrdiff_t( x1 - sourceBounds.x1 ) * _pixelBytes;
+	_poolDataShared = true;
+	source._poolDataShared = true;
+
+	setIntProperty( kOfxImagePropRowBytes, getOrientedRowDistanceBytes( eImageOrientationFromBottomToTop ) );
+	setPointerProperty( kOfxImagePropData, getOrientedPixelData( eImageOrientationFromBottomToTop ) );
+	return true;
+}
+
 boost::uint8_t* Image::getPixelData()
 {
-	return reinterpret_cast<boost::uint8_t*>( _data->data() );
+	return reinterpret_cast<boost::uint8_t*>( _data->data() ) + _dataOffset;
 }
 
 void* Image::getVoidPixelData()
 {
-	return reinterpret_cast<void*>( _data->data() );
+	return reinterpret_cast<void*>( getPixelData() );
 }
 
 char* Image::getCharPixelData()
 {
-	return reinterpret_cast<char*>( _data->data() );
+	return reinterpret_cast<char*>( getPixelData() );
 }
 
 boost::uint8_t* Image::getOrientedPixelData( const EImageOrientation orientation )
@@ -39,6 +39,8 @@ protected:
 	EImageOrientation _orientation;
 	std::string _fullname;
 	memory::IPoolDataPtr _data; ///< where we are keeping our image data
+	std::ptrdiff_t _dataOffset; ///< position of the first row in _data, not null for a view of another image
+	bool _poolDataShared; ///< _data is also used by a view of this image, or this image is a view
 
 public:
 	Image( ClipImage& clip, const OfxTime time, const OfxRectD& bounds, const EImageOrientation orientation, const int rowDistanceBytes );
@@ -48,8 +50,22 @@ public:
 	void setPoolData( const memory::IPoolDataPtr& pData )
 	{
 		_data = pData;
+		_dataOffset = 0;
 		setPointerProperty( kOfxImagePropData, getOrientedPixelData( eImageOrientationFromBottomToTop ) ); // OpenFX standard use BottomToTop
 	}
+	const memory::IPoolDataPtr& getPoolData() const { return _data; }
+
+	/**
+	 * @brief Use the buffer of the source image, without copy.
+	 * The pixel (x, y) of this image is the pixel (x + offset.x, y + offset.y)
+	 * of the source, or (x + offset.x, offset.y - y) with a vertical flip,
+	 * which is only a change of orientation.
+	 * @return false if this image is not inside the source image (nothing is done)
+	 */
+	bool setPoolDataView( Image& source, const OfxPointI& offset, const bool flip );
+	/// the buffer is used by several images, it can't be modified in place
+	bool isPoolDataShared() const { return _poolDataShared; }
+	void setPoolDataShared() { _poolDataShared = true; }
 #endif
 	
 	std::string getFullName() const { return _fullname; }
@@ -1164,6 +1164,58 @@ bool OfxhImageEffectNode::isIdentityAction( OfxTime&           time,
 	return status == kOfxStatOK;
 }
 
+bool OfxhImageEffectNode::getInputViewAction( OfxTime&           time,
+					      const std::string& field,
+					      const OfxRectI&    renderWindow,
+					      OfxPointD          renderScale,
+					      std::string&       clip,
+					      OfxPointI&         offset,
+					      bool&              flip ) const OFX_EXCEPTION_SPEC
+{
+	static property::OfxhPropSpec inStuff[] = {
+		{ kOfxPropTime, property::ePropTypeDouble, 1, true, "0" },
+		{ kOfxImageEffectPropFieldToRender, property::ePropTypeString, 1, true, "" },
+		{ kOfxImageEffectPropRenderWindow, property::ePropTypeInt, 4, true, "0" },
+		{ kOfxImageEffectPropRenderScale, property::ePropTypeDouble, 2, true, "0" },
+		{ 0 }
+	};
+
+	static property::OfxhPropSpec outStuff[] = {
+		{ kOfxPropTime, property::ePropTypeDouble, 1, false, "0.0" },
+		{ kOfxPropName, property::ePropTypeString, 1, false, "" },
+		{ kTuttleOfxImageEffectPropInputViewOffset, property::ePropTypeInt, 2, false, "0" },
+		{ kTuttleOfxImageEffectPropInputViewFlip, property::ePropTypeInt, 1, false, "0" },
+		{ 0 }
+	};
+
+	property::OfxhSet inArgs( inStuff );
+
+	inArgs.setStringProperty( kOfxImageEffectPropFieldToRender, field );
+	inArgs.setDoubleProperty( kOfxPropTime, time );
+	inArgs.setIntPropertyN( kOfxImageEffectPropRenderWindow, &renderWindow.x1, 4 );
+	inArgs.setDoublePropertyN( kOfxImageEffectPropRenderScale, &renderScale.x, 2 );
+
+	property::OfxhSet outArgs( outStuff );
+
+	outArgs.setDoubleProperty( kOfxPropTime, time );
+
+	OfxStatus status = mainEntry( kTuttleOfxImageEffectActionGetInputView,
+				      this->getHandle(),
+				      &inArgs,
+				      &outArgs );
+
+	if( status != kOfxStatOK && status != kOfxStatReplyDefault )
+		BOOST_THROW_EXCEPTION( OfxhException( status ) );
+
+	time     = outArgs.getDoubleProperty( kOfxPropTime );
+	clip     = outArgs.getStringProperty( kOfxPropName );
+	offset.x = outArgs.getIntProperty( kTuttleOfxImageEffectPropInputViewOffset, 0 );
+	offset.y = outArgs.getIntProperty( kTuttleOfxImageEffectPropInputViewOffset, 1 );
+	flip     = outArgs.getIntProperty( kTuttleOfxImageEffectPropInputViewFlip ) != 0;
+
+	return status == kOfxStatOK;
+}
+
 /**
  * Get whether the component is a supported 'chromatic' component (RGBA or alpha) in
  * the base API.
@@ -382,6 +382,15 @@ public:
 	                               OfxPointD          renderScale,
 	                               std::string&       clip ) const OFX_EXCEPTION_SPEC;
 
+	// is the output a view of an input image
+	virtual bool getInputViewAction( OfxTime&           time,
+	                                 const std::string& field,
+	                                 const OfxRectI&    renderWindow,
+	                                 OfxPointD          renderScale,
+	                                 std::string&       clip,
+	                                 OfxPointI&         offset,
+	                                 bool&              flip ) const OFX_EXCEPTION_SPEC;
+
 	// time domain
 	virtual bool getTimeDomainAction( OfxRangeD& range ) const OFX_EXCEPTION_SPEC;
 
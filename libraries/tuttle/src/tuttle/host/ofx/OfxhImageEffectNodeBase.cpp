@@ -150,6 +150,20 @@ bool OfxhImageEffectNodeBase::temporalAccess() const
 	return _properties.getIntProperty( kOfxImageEffectPropTemporalClipAccess ) != 0;
 }
 
+/// is this effect a point operation, which can render in place
+
+bool OfxhImageEffectNodeBase::isPointOperation() const
+{
+	return _properties.getIntProperty( kTuttleOfxImageEffectPropPointOperation ) != 0;
+}
+
+/// can this effect output a view of an input image
+
+bool OfxhImageEffectNodeBase::supportsInputView() const
+{
+	return _properties.getIntProperty( kTuttleOfxImageEffectPropSupportsInputView ) != 0;
+}
+
 /// is the given RGBA/A pixel depth supported by the effect
 
 bool OfxhImageEffectNodeBase::isBitDepthSupported( const std::string& s ) const
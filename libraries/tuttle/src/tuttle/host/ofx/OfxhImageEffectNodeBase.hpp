@@ -92,6 +92,12 @@ public:
 	/// does this effect need random temporal access
 	bool temporalAccess() const;
 
+	/// is this effect a point operation, which can render in place
+	bool isPointOperation() const;
+
+	/// can this effect output a view of an input image
+	bool supportsInputView() const;
+
 	/// is the given bit depth supported by the effect
 	bool isBitDepthSupported( const std::string& s ) const;
 
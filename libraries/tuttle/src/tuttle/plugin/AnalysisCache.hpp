@@ -0,0 +1,77 @@
+#ifndef _TUTTLE_PLUGIN_ANALYSISCACHE_HPP_
+#define _TUTTLE_PLUGIN_ANALYSISCACHE_HPP_
+
+#include <ofxCore.h>
+#include <ofxsMultiThread.h>
+
+#include <boost/any.hpp>
+
+#include <cstddef>
+#include <map>
+#include <utility>
+
+namespace tuttle {
+namespace plugin {
+
+/**
+ * @brief Results of the analysis of input images, reused by the next renders
+ * of the same frame (tiles, several outputs, seeking back).
+ *
+ * A result is identified by the time and a hash of everything else the
+ * analysis depends on (render scale, region, analysis parameters, pixel type).
+ * The plugin can't know when the upstream nodes change, so it clears the cache
+ * at each beginSequenceRender, and when a parameter or a clip is changed by the user.
+ */
+class AnalysisCache
+{
+public:
+	typedef std::pair<OfxTime, std::size_t> Key;
+
+public:
+	AnalysisCache()
+		: _mutex( 0 )
+	{}
+
+	/// @return true if a result of type T was found
+	template<class T>
+	bool get( const OfxTime time, const std::size_t hash, T& result )
+	{
+		OFX::MultiThread::AutoMutex lock( _mutex );
+		std::map<Key, boost::any>::const_iterator it = _results.find( Key( time, hash ) );
+		if( it == _results.end() )
+			return false;
+		const T* value = boost::any_cast<T>( &it->second );
+		if( ! value )
+			return false;
+		result = *value;
+		return true;
+	}
+
+	template<class T>
+	void set( const OfxTime time, const std::size_t hash, const T& result )
+	{
+		OFX::MultiThread::AutoMutex lock( _mutex );
+		_results[Key( time, hash )] = result;
+	}
+
+	std::size_t size()
+	{
+		OFX::MultiThread::AutoMutex lock( _mutex );
+		return _results.size();
+	}
+
+	void clear()
+	{
+		OFX::MultiThread::AutoMutex lock( _mutex );
+		_results.clear();
+	}
+
+private:
+	OFX::MultiThread::Mutex _mutex;
+	std::map<Key, boost::any> _results;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,216 @@
+#ifndef _TUTTLE_PLUGIN_COLORHISTOGRAMS_HPP_
+#define _TUTTLE_PLUGIN_COLORHISTOGRAMS_HPP_
+
+#include "ParallelReduction.hpp"
+
+#include <ofxCore.h>
+#include <ofxsMultiThread.h>
+
+#include <boost/gil/gil_all.hpp>
+#include <boost/gil/extension/color/hsl.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+
+/**
+ * @brief Histograms of the RGBA and HSL channels of an image, nbSteps bins
+ * per channel for the values in [0, 1] (the other values are ignored).
+ *
+ * It's an accumulator of reducePixelsParallel: each thread fills its own
+ * bins, merged at the end. The pixels can be removed as well as added, so
+ * the histograms of a selection are updated with the pixels whose selection
+ * changed, see updateSelectionHistograms.
+ */
+class ColorHistograms
+{
+public:
+	typedef long Number;
+
+	enum EChannel
+	{
+		eChannelRed = 0,
+		eChannelGreen,
+		eChannelBlue,
+		eChannelAlpha,
+		eChannelHue,
+		eChannelSaturation,
+		eChannelLightness,
+		eNbChannels
+	};
+
+	/// maximal number of pixels read to compute the histograms of a full image
+	static const std::size_t kMaxPixels = 1024 * 1024;
+
+public:
+	/**
+	 * @param weight count of each pixel added by operator(), the number of
+	 * pixels represented by a pixel of a subsampled image
+	 */
+	ColorHistograms( const std::size_t nbSteps = 0, const Number weight = 1 )
+		: _nbSteps( nbSteps )
+		, _weight( weight )
+		, _bins( eNbChannels * nbSteps, 0 )
+	{}
+
+	std::size_t getNbSteps() const { return _nbSteps; }
+
+	/// bins of a channel, [begin, begin + nbSteps)
+	std::vector<Number>::const_iterator getChannel( const EChannel channel ) const
+	{
+		return _bins.begin() + channel * _nbSteps;
+	}
+
+	template<class Pixel>
+	void operator()( const Pixel& p )
+	{
+		add( p, _weight );
+	}
+
+	/// @param weight negative to remove the pixel
+	template<class Pixel>
+	void add( const Pixel& p, const Number weight )
+	{
+		using namespace boost::gil;
+		rgba32f_pixel_t rgba;
+		hsl32f_pixel_t hsl;
+		color_convert( p, rgba );
+		color_convert( rgba, hsl );
+
+		addValue( eChannelRed, rgba[0], weight );
+		addValue( eChannelGreen, rgba[1], weight );
+		addValue( eChannelBlue, rgba[2], weight );
+		addValue( eChannelAlpha, rgba[3], weight );
+		addValue( eChannelHue, hsl[0], weight );
+		addValue( eChannelSaturation, hsl[1], weight );
+		addValue( eChannelLightness, hsl[2], weight );
+	}
+
+	void merge( const ColorHistograms& other )
+	{
+		for( std::size_t i = 0; i < _bins.size(); ++i )
+			_bins[i] += other._bins[i];
+	}
+
+	/// step between the pixels read to compute the histograms of a full image
+	static std::ptrdiff_t getSubsampling( const std::ptrdiff_t width, const std::ptrdiff_t height )
+	{
+		const double ratio = double( width ) * double( height ) / kMaxPixels;
+		return ratio > 1.0 ? static_cast<std::ptrdiff_t>( std::ceil( std::sqrt( ratio ) ) ) : 1;
+	}
+
+private:
+	void addValue( const EChannel channel, const float value, const Number weight )
+	{
+		if( value >= 0 && value <= 1 )
+			_bins[channel * _nbSteps + static_cast<std::size_t>( value * ( _nbSteps - 1 ) + 0.5f )] += weight;
+	}
+
+private:
+	std::size_t _nbSteps;
+	Number _weight;
+	std::vector<Number> _bins; ///< eNbChannels x nbSteps
+};
+
+/**
+ * @brief Histograms of a view, computed by the SMP threads on at most
+ * ColorHistograms::kMaxPixels pixels.
+ *
+ * Each pixel read counts for all the pixels of its subsampling cell, so the
+ * result stays comparable with the full resolution histograms of a selection.
+ * @return false if the process was aborted
+ */
+template<class View>
+bool computeColorHistograms( const View& view, const std::size_t nbSteps, ColorHistograms& histograms )
+{
+	const std::ptrdiff_t step = ColorHistograms::getSubsampling( view.width(), view.height() );
+	histograms = ColorHistograms( nbSteps, step * step );
+	return reducePixelsParallel( boost::gil::subsampled_view( view, step, step ), histograms );
+}
+
+/**
+ * @brief Update the histograms of a selection with the pixels whose
+ * selection state changed in a region of the view, with the SMP threads.
+ *
+ * The selection masks have one byte per pixel of the view, row by row
+ * (0: not selected). The pixels selected in mask and not in previous are
+ * added, the others removed, and previous is updated with mask. Without
+ * previous mask, the histograms of the selected pixels are added.
+ */
+template<class View>
+class SelectionHistogramsUpdate : public OFX::MultiThread::Processor
+{
+public:
+	SelectionHistogramsUpdate( const View& view, const unsigned char* mask, unsigned char* previous, const OfxRectI& region, ColorHistograms& histograms )
+		: _view( view )
+		, _mask( mask )
+		, _previous( previous )
+		, _region( region )
+		, _histograms( histograms )
+		, _nbThreads( std::max( OFX::MultiThread::getNumCPUs(), 1u ) )
+		, _partials( _nbThreads, ColorHistograms( histograms.getNbSteps() ) )
+	{}
+
+	void process()
+	{
+		if( _region.x2 <= _region.x1 || _region.y2 <= _region.y1 )
+			return;
+		multiThread( _nbThreads );
+		for( std::size_t i = 0; i < _partials.size(); ++i )
+			_histograms.merge( _partials[i] );
+	}
+
+	void multiThreadFunction( const unsigned int threadId, const unsigned int nThreads )
+	{
+		if( threadId >= _nbThreads )
+			return;
+		const std::ptrdiff_t h  = _region.y2 - _region.y1;
+		const std::ptrdiff_t y1 = _region.y1 + threadId * h / nThreads;
+		const std::ptrdiff_t y2 = _region.y1 + ( threadId + 1 ) * h / nThreads;
+		const std::ptrdiff_t width = _view.width();
+		ColorHistograms& partial = _partials[threadId];
+		for( std::ptrdiff_t y = y1; y < y2; ++y )
+		{
+			typename View::x_iterator it = _view.row_begin( y ) + _region.x1;
+			const unsigned char* mask = _mask + y * width + _region.x1;
+			unsigned char* previous = _previous ? _previous + y * width + _region.x1 : NULL;
+			for( std::ptrdiff_t x = _region.x1; x < _region.x2; ++x, ++it, ++mask )
+			{
+				const bool selected = *mask != 0;
+				const bool wasSelected = previous && *previous != 0;
+				if( selected != wasSelected )
+					partial.add( *it, selected ? 1 : -1 );
+				if( previous )
+					*previous++ = *mask;
+			}
+		}
+	}
+
+private:
+	View _view;
+	const unsigned char* _mask;
+	unsigned char* _previous;
+	const OfxRectI _region;
+	ColorHistograms& _histograms;
+	const unsigned int _nbThreads;
+	std::vector<ColorHistograms> _partials; ///< one per thread
+};
+
+/**
+ * @brief Update the histograms of a selection, see SelectionHistogramsUpdate.
+ */
+template<class View>
+void updateSelectionHistograms( const View& view, const unsigned char* mask, unsigned char* previous, const OfxRectI& region, ColorHistograms& histograms )
+{
+	SelectionHistogramsUpdate<View> update( view, mask, previous, region, histograms );
+	update.process();
+}
+
+}
+}
+
+#endif
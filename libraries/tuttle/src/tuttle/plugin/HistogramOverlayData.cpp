@@ -0,0 +1,467 @@
+#include "HistogramOverlayData.hpp"
+
+#include "global.hpp"
+#include "ImageGilProcessor.hpp"
+
+#include <boost/functional/hash.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include <algorithm>
+
+namespace tuttle {
+namespace plugin {
+
+/**
+ * Create a new empty data structure from scratch (data is null)
+ * @param size : size of the current source clip (width*height) 
+ */
+HistogramOverlayData::HistogramOverlayData( const OfxPointI& size, const int nbSteps, const int nbStepsCurvesFromSelection)
+: _currentTime( 0 )
+, _vNbStep( nbSteps )
+, _vNbStepCurveFromSelection( nbStepsCurvesFromSelection )
+, _isComputing( false )
+, _isDataInvalid( true )
+, _size( size )
+{
+	clearAll( size );
+}
+
+/**
+ * Copy histograms into a HistogramBufferData and correct it for display
+ * @param data HistogramBufferData to fill up
+ * @param histograms computed histograms
+ */
+void HistogramOverlayData::computeHistogramBufferData( HistogramBufferData& data, const ColorHistograms& histograms ) const
+{
+	const std::size_t nbSteps = histograms.getNbSteps();
+	data._step = nbSteps;
+	//RGB
+	data._bufferRed.assign( histograms.getChannel( ColorHistograms::eChannelRed ), histograms.getChannel( ColorHistograms::eChannelRed ) + nbSteps );
+	data._bufferGreen.assign( histograms.getChannel( ColorHistograms::eChannelGreen ), histograms.getChannel( ColorHistograms::eChannelGreen ) + nbSteps );
+	data._bufferBlue.assign( histograms.getChannel( ColorHistograms::eChannelBlue ), histograms.getChannel( ColorHistograms::eChannelBlue ) + nbSteps );
+	//HSL
+	data._bufferHue.assign( histograms.getChannel( ColorHistograms::eChannelHue ), histograms.getChannel( ColorHistograms::eChannelHue ) + nbSteps );
+	data._bufferSaturation.assign( histograms.getChannel( ColorHistograms::eChannelSaturation ), histograms.getChannel( ColorHistograms::eChannelSaturation ) + nbSteps );
+	data._bufferLightness.assign( histograms.getChannel( ColorHistograms::eChannelLightness ), histograms.getChannel( ColorHistograms::eChannelLightness ) + nbSteps );
+	//Alpha
+	data._bufferAlpha.assign( histograms.getChannel( ColorHistograms::eChannelAlpha ), histograms.getChannel( ColorHistograms::eChannelAlpha ) + nbSteps );
+	
+	this->correctHistogramBufferData(data);				//correct Histogram data to make up for discretization (average)
+}
+
+/**
+ * Add/remove the pixels whose selection changed to the selection histograms (instead of the full selection)
+ * @param srcView view of the source clip
+ */
+void HistogramOverlayData::updateSelectionData( const SView& srcView )
+{
+	BOOST_ASSERT( _imgBool.shape()[0] == std::size_t(_size.y) );
+	BOOST_ASSERT( _imgBool.shape()[1] == std::size_t(_size.x) );
+	BOOST_ASSERT( srcView.width()  == std::size_t(_size.x) );
+	BOOST_ASSERT( srcView.height() == std::size_t(_size.y) );
+	
+	updateSelectionHistograms( srcView, _imgBool.data(), _imgBoolComputed.data(), _selectionModified, _selectionHistograms );
+	_selectionModified.x1 = _selectionModified.y1 = _selectionModified.x2 = _selectionModified.y2 = 0;
+	
+	this->computeHistogramBufferData( _selectionData, _selectionHistograms );
+	this->computeAverages();
+}
+
+/**
+ * @brief Set each values of the vector to null
+ * @param v vector to reset
+ * @param numberOfStep number of step (size of the vector)
+ */
+void HistogramOverlayData::resetVectortoZero( HistogramVector& v, const std::size_t numberOfStep ) const
+{
+	v.assign(numberOfStep,0);
+}
+
+/**
+ * @brief Set each values of the vector to null
+ * @param toReset HistogramBufferdata instance to reset
+ */
+void HistogramOverlayData::resetHistogramBufferData( HistogramBufferData& toReset ) const
+{
+	//Alpha
+	this->resetVectortoZero(toReset._bufferAlpha,toReset._step);				//alpha
+	//RGB
+	this->resetVectortoZero(toReset._bufferRed,toReset._step);					//R
+	this->resetVectortoZero(toReset._bufferGreen,toReset._step);				//G
+	this->resetVectortoZero(toReset._bufferBlue,toReset._step);					//B
+	//HLS
+	this->resetVectortoZero(toReset._bufferHue,toReset._step);					//H
+	this->resetVectortoZero(toReset._bufferLightness,toReset._step);			//S
+	this->resetVectortoZero(toReset._bufferSaturation,toReset._step);			//L
+}
+
+/**
+ * Correct the HistogramBufferData buffers wrong value with an average
+ * @param toCorrect HistogramBufferData to correct
+ */
+void HistogramOverlayData::correctHistogramBufferData(HistogramBufferData& toCorrect) const
+{
+	//RGB
+	this->correctVector(toCorrect._bufferRed);									//R
+	this->correctVector(toCorrect._bufferGreen);								//G
+	this->correctVector(toCorrect._bufferBlue);									//B
+	//HSL
+	this->correctVector(toCorrect._bufferHue);									//H
+	this->correctVector(toCorrect._bufferSaturation);							//S
+	this->correctVector(toCorrect._bufferLightness);							//L
+	
+}
+
+/**
+ * Replace vector null values by average (better for histogram display) 
+ * @param v vector to modify
+ */
+void HistogramOverlayData::correctVector( HistogramVector& v ) const
+{
+	for(unsigned int i=1; i<v.size()-1;++i)
+	{
+		if(v.at(i) < 0.05)
+			v.at(i) = (HistogramVector::value_type)((v.at(i-1)+v.at(i+1))/2.0);//basic average
+	}
+}
+
+/**
+ * Compute average bars for display
+ */
+void HistogramOverlayData::computeAverages()
+{
+	//RGB
+	this->_averageData._averageRed = computeAnAverage(this->_selectionData._bufferRed);				//R
+	this->_averageData._averageBlue = computeAnAverage(this->_selectionData._bufferBlue);			//G
+	this->_averageData._averageGreen = computeAnAverage(this->_selectionData._bufferGreen);			//B
+	//HSL
+	this->_averageData._averageHue = computeAnAverage(this->_selectionData._bufferHue);					//H
+	this->_averageData._averageSaturation = computeAnAverage(this->_selectionData._bufferSaturation);	//S
+	this->_averageData._averageLightness = computeAnAverage(this->_selectionData._bufferLightness);		//L
+}
+
+/**
+ * Compute a specific channel average
+ * @param selection_v vector which contain the selection histogram
+ * @return 
+ */
+int HistogramOverlayData::computeAnAverage( const HistogramVector& selection_v ) const
+{
+	int av = 0;
+	int size = 0;
+	for( std::size_t i=0; i < selection_v.size(); ++i)
+	{
+		if(selection_v.at(i)!=0)
+		{
+			av+=selection_v.at(i)*i;
+			size+=selection_v.at(i);
+		}
+	}
+	if(size != 0) //avoid 0 division
+		av /=size;
+	return av; //basic average
+}
+
+/**
+ * Compute full data (averages,histograms buffer and selection buffer)
+ * @param clipSrc	source of the plugin
+ * @param time	current time
+ * @param renderScale	current renderScale
+ */
+void HistogramOverlayData::computeFullData( OFX::Clip* clipSrc, const OfxTime time, const OfxPointD& renderScale, const bool selectionOnly )
+{
+	_isComputing = true;
+	resetHistogramData();
+	resetHistogramSelectionData();
+	
+	SView srcView;
+	boost::scoped_ptr<OFX::Image> src( fetchSourceView( clipSrc, time, renderScale, srcView ) );	//scoped pointer of current source clip
+	if( !src.get() )
+	{
+		_isComputing = false;
+		return;
+	}
+	
+	//Compute histogram buffer (reuse the histograms of a source image already seen)
+	//without identifier, the host can't tell us if the source image at this time has changed
+	const std::string srcIdentifier = src->getUniqueIdentifier();
+	std::size_t hash = boost::hash_value( srcIdentifier );
+	boost::hash_combine( hash, renderScale.x );
+	boost::hash_combine( hash, renderScale.y );
+	boost::hash_combine( hash, _size.x );
+	boost::hash_combine( hash, _size.y );
+	boost::hash_combine( hash, _vNbStep );
+	if( srcIdentifier.empty() || ! _histogramsCache.get( time, hash, _histograms ) )
+	{
+		computeColorHistograms( srcView, _vNbStep, _histograms );
+		if( ! srcIdentifier.empty() )
+		{
+			if( _histogramsCache.size() >= kMaxCachedHistograms )
+				_histogramsCache.clear();
+			_histogramsCache.set( time, hash, _histograms );
+		}
+	}
+	this->computeHistogramBufferData( _data, _histograms );
+	
+	//Compute selection histogram buffer (all of the selected pixels)
+	_selectionHistograms = ColorHistograms( _vNbStep );
+	std::fill( _imgBoolComputed.data(), _imgBoolComputed.data() + _imgBoolComputed.num_elements(), 0 );
+	_selectionModified.x1 = 0;
+	_selectionModified.y1 = 0;
+	_selectionModified.x2 = _size.x;
+	_selectionModified.y2 = _size.y;
+	this->updateSelectionData( srcView );
+	_isComputing = false;
+	
+	_currentTime = time;
+}
+
+/**
+ * Update selection data (averages and selection buffer) with the pixels selected or unselected since the last computation
+ * @param clipSrc	source of the plugin
+ * @param time	current time
+ * @param renderScale	current renderScale
+ */
+void HistogramOverlayData::computeSelectionData( OFX::Clip* clipSrc, const OfxTime time, const OfxPointD& renderScale )
+{
+	_isComputing = true;
+	
+	SView srcView;
+	boost::scoped_ptr<OFX::Image> src( fetchSourceView( clipSrc, time, renderScale, srcView ) );	//scoped pointer of current source clip
+	if( src.get() )
+	{
+		this->updateSelectionData( srcView );
+	}
+	_isComputing = false;
+}
+
+/**
+ * Fetch the source clip and check it
+ * @param clipSrc	source of the plugin
+ * @param time	current time
+ * @param renderScale	current renderScale
+ * @param[out] srcView	view of the source image
+ * @return source image (NULL if the source isn't accessible)
+ */
+OFX::Image* HistogramOverlayData::fetchSourceView( OFX::Clip* clipSrc, const OfxTime time, const OfxPointD& renderScale, SView& srcView )
+{
+	if( ! clipSrc->isConnected() )
+	{	
+		return NULL;
+	}
+	
+	boost::scoped_ptr<OFX::Image> src( clipSrc->fetchImage(time, clipSrc->getCanonicalRod(time)) );	//scoped pointer of current source clip
+	
+	// Compatibility tests
+	if( !src.get() ) // source isn't accessible
+	{
+		std::cout << "src is not accessible" << std::endl;
+		return NULL;
+	}
+	
+	if( src->getRowDistanceBytes() == 0 )//if source is wrong
+	{
+		BOOST_THROW_EXCEPTION( exception::WrongRowBytes() );
+	}
+	OfxRectI srcPixelRod = clipSrc->getPixelRod( time, renderScale ); //get current RoD
+	if( (clipSrc->getPixelDepth() != OFX::eBitDepthFloat) ||
+		(!clipSrc->getPixelComponents()) )
+	{
+		BOOST_THROW_EXCEPTION( exception::Unsupported()	<< exception::user() + "Can't compute histogram data with the actual input clip format." );
+	}
+	
+	if( srcPixelRod != src->getBounds() )
+	{
+		// the host does bad things !
+		// remove overlay... but do not crash.
+		TUTTLE_LOG_WARNING( "Image RoD and image bounds are not the same (rod=" << srcPixelRod << " , bounds:" << src->getBounds() << ")." );
+		return NULL;
+	}
+	
+	// Compute if source is OK
+	srcView = tuttle::plugin::getGilView<SView>( src.get(), srcPixelRod, eImageOrientationIndependant );	// get current view from source clip
+	
+	OfxPointI imgSize;
+	imgSize.x = srcView.width();
+	imgSize.y = srcView.height();
+	
+	if( isImageSizeModified( imgSize ) )
+	{
+		clearAll( imgSize );
+	}
+	return src.release();
+}
+
+/**
+ * Reset the data (all values to 0)
+ * @param size size of the current source clip
+ */
+void HistogramOverlayData::resetHistogramData()
+{
+	// Reset Histogram buffers
+	this->_data._step = _vNbStep;
+	this->resetHistogramBufferData(this->_data);
+}
+
+/**
+ * Reset the data (all values to 0)
+ * @param size size of the current source clip
+ */
+void HistogramOverlayData::resetCurvesFromSelectionData()
+{
+	// Reset Histogram buffers
+	this->_curveFromSelection._step = _vNbStepCurveFromSelection;
+	this->resetHistogramBufferData(this->_curveFromSelection);
+}
+
+/**
+ * Reset the data (all values to 0)
+ * @param size size of the current source clip
+ */
+void HistogramOverlayData::resetHistogramSelectionData()
+{
+	//Reset Histogram selection buffers
+	this->_selectionData._step = _vNbStep;
+	this->resetHistogramBufferData(this->_selectionData);
+}
+
+void HistogramOverlayData::removeSelection()
+{
+	//allocate and initialize bool img tab 2D
+	HistogramSelectionMask::extent_gen extents;
+	_imgBool.resize(extents[_size.y][_size.x]);
+	_imgBoolComputed.resize(extents[_size.y][_size.x]);
+	std::fill( _imgBool.data(), _imgBool.data() + _imgBool.num_elements(), 0 );
+	std::fill( _imgBoolComputed.data(), _imgBoolComputed.data() + _imgBoolComputed.num_elements(), 0 );
+	
+	_selectionHistograms = ColorHistograms( _vNbStep );
+	_selectionModified.x1 = _selectionModified.y1 = _selectionModified.x2 = _selectionModified.y2 = 0;
+}
+
+/**
+ * Select or unselect a pixel
+ * @param x	x in the source clip (from the left)
+ * @param y	y in the source clip (from the bottom)
+ * @param selected	new state of the pixel
+ */
+void HistogramOverlayData::setSelected( const int x, const int y, const bool selected )
+{
+	OfxRectI pixel;
+	pixel.x1 = x;
+	pixel.y1 = y;
+	pixel.x2 = x + 1;
+	pixel.y2 = y + 1;
+	setSelected( pixel, selected );
+}
+
+/**
+ * Select or unselect a region
+ * @param region	region in the source clip (clamped to the source clip)
+ * @param selected	new state of the pixels
+ */
+void HistogramOverlayData::setSelected( const OfxRectI& region, const bool selected )
+{
+	const int x1 = std::max( region.x1, 0 );
+	const int y1 = std::max( region.y1, 0 );
+	const int x2 = std::min( region.x2, static_cast<int>( _imgBool.shape()[1] ) );
+	const int y2 = std::min( region.y2, static_cast<int>( _imgBool.shape()[0] ) );
+	if( x1 >= x2 || y1 >= y2 )
+		return;
+	
+	for( int y = y1; y < y2; ++y )
+	{
+		std::fill( &_imgBool[y][x1], &_imgBool[y][x1] + ( x2 - x1 ), selected ? 255 : 0 );
+	}
+	
+	//extend modified region
+	if( isSelectionModified() )
+	{
+		_selectionModified.x1 = std::min( _selectionModified.x1, x1 );
+		_selectionModified.y1 = std::min( _selectionModified.y1, y1 );
+		_selectionModified.x2 = std::max( _selectionModified.x2, x2 );
+		_selectionModified.y2 = std::max( _selectionModified.y2, y2 );
+	}
+	else
+	{
+		_selectionModified.x1 = x1;
+		_selectionModified.y1 = y1;
+		_selectionModified.x2 = x2;
+		_selectionModified.y2 = y2;
+	}
+}
+
+/**
+ * Selection checker (is there pixels selected or unselected since the last computation)
+ */
+bool HistogramOverlayData::isSelectionModified() const
+{
+	return _selectionModified.x1 < _selectionModified.x2 &&
+		_selectionModified.y1 < _selectionModified.y2;
+}
+
+/**
+ * Set all of averages to 0
+ */
+void HistogramOverlayData::resetAverages()
+{
+	//reset average
+	this->_averageData._averageRed = 0;			//R
+	this->_averageData._averageGreen = 0;		//G
+	this->_averageData._averageBlue = 0;		//B
+	this->_averageData._averageHue = 0;			//H
+	this->_averageData._averageSaturation = 0;	//S
+	this->_averageData._averageLightness = 0;	//L
+}
+
+/**
+ * Check size (verify that imgBool always has the good size
+ */
+bool HistogramOverlayData::isImageSizeModified( const OfxPointI& imgSize ) const
+{	
+	return( _size.x != imgSize.x ||
+		_size.y != imgSize.y );
+}
+
+/**
+ * Current time checker
+ */
+bool HistogramOverlayData::isCurrentTimeModified(const OfxTime time) const
+{
+		return( _currentTime != time );
+}	
+
+/**
+ * Compute only curve from selection data (averages,histograms buffer and selection buffer)
+ * @param clipSrc	source of the plugin
+ * @param time	current time
+ * @param renderScale	current renderScale
+ */
+void HistogramOverlayData::computeCurveFromSelectionData( OFX::Clip* clipSrc, const OfxTime time, const OfxPointD& renderScale)
+{
+	_isComputing = true;
+
+	resetCurvesFromSelectionData();
+	
+	SView srcView;
+	boost::scoped_ptr<OFX::Image> src( fetchSourceView( clipSrc, _currentTime, renderScale, srcView ) );	//scoped pointer of current source clip
+	if( !src.get() )
+	{
+		_isComputing = false;
+		return;
+	}
+	
+	//Compute histogram buffer (all of the selected pixels)
+	OfxRectI region;
+	region.x1 = 0;
+	region.y1 = 0;
+	region.x2 = _size.x;
+	region.y2 = _size.y;
+	ColorHistograms curveHistograms( _vNbStepCurveFromSelection );
+	updateSelectionHistograms( srcView, _imgBool.data(), NULL, region, curveHistograms );
+	
+	this->computeHistogramBufferData( _curveFromSelection, curveHistograms );	//correct Histogram data to make up for discretization (average)
+	_isComputing = false;
+}
+
+}
+}
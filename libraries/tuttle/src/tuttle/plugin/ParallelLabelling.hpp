@@ -0,0 +1,102 @@
+#ifndef _TUTTLE_PLUGIN_PARALLELLABELLING_HPP_
+#define _TUTTLE_PLUGIN_PARALLELLABELLING_HPP_
+
+#include "IProgress.hpp"
+#include "NoProgress.hpp"
+
+#include <terry/filter/connectedComponents.hpp>
+
+#include <ofxsMultiThread.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+
+/**
+ * @brief Connected-component labelling of a view with the SMP threads of the host.
+ *
+ * The threads label the tiles of the components (tile threadId, then
+ * threadId + nThreads...), the tile borders are then merged by the calling thread.
+ * The conditions are tested on the first channel of the view.
+ * Each thread stops on its own progress result (the abort of the host
+ * is seen by all the threads), so the threads don't share any flag.
+ */
+template<class Connexity, class View, class Test, class SeedTest>
+class ParallelLabelling : public OFX::MultiThread::Processor
+{
+public:
+	ParallelLabelling( terry::filter::connected_components& components, const View& view, const Test& test, const SeedTest& seedTest, IProgress& progress )
+		: _components( components )
+		, _view( view )
+		, _test( test )
+		, _seedTest( seedTest )
+		, _progress( progress )
+	{}
+
+	/// @return false if the process was aborted
+	bool process()
+	{
+		const std::size_t nbTiles = _components.nb_tiles();
+		if( nbTiles == 0 )
+			return true;
+		const unsigned int nbThreads = static_cast<unsigned int>( std::min<std::size_t>( std::max( OFX::MultiThread::getNumCPUs(), 1u ), nbTiles ) );
+		_aborted.assign( nbThreads, 0 );
+		multiThread( nbThreads );
+		if( std::find( _aborted.begin(), _aborted.end(), 1 ) != _aborted.end() )
+			return false;
+		_components.merge_tiles<Connexity>();
+		return true;
+	}
+
+	void multiThreadFunction( const unsigned int threadId, const unsigned int nThreads )
+	{
+		if( threadId >= _aborted.size() )
+			return;
+		for( std::size_t i = threadId; i < _components.nb_tiles(); i += nThreads )
+		{
+			_components.label_tile<Connexity>( i, _view, _test, _seedTest );
+			const terry::Rect<std::ssize_t> tile = _components.tile( i );
+			if( _progress.progressForward( ( tile.x2 - tile.x1 ) * ( tile.y2 - tile.y1 ) ) )
+			{
+				_aborted[threadId] = 1;
+				break;
+			}
+		}
+	}
+
+private:
+	terry::filter::connected_components& _components;
+	View _view;
+	const Test _test;
+	const SeedTest _seedTest;
+	IProgress& _progress;
+	std::vector<char> _aborted; ///< one per thread, written by its thread only
+};
+
+/**
+ * @brief Label the pixels of a view respecting test, in the region of components,
+ * with the SMP threads, see ParallelLabelling.
+ * @param[in, out] components reset with the region to label
+ * @return false if the process was aborted
+ */
+template<class Connexity, class View, class Test, class SeedTest>
+bool labelPixelsParallel( terry::filter::connected_components& components, const View& view, const Test& test, const SeedTest& seedTest, IProgress& progress )
+{
+	ParallelLabelling<Connexity, View, Test, SeedTest> labelling( components, view, test, seedTest, progress );
+	return labelling.process();
+}
+
+template<class Connexity, class View, class Test, class SeedTest>
+bool labelPixelsParallel( terry::filter::connected_components& components, const View& view, const Test& test, const SeedTest& seedTest )
+{
+	NoProgress progress;
+	return labelPixelsParallel<Connexity>( components, view, test, seedTest, progress );
+}
+
+}
+}
+
+#endif
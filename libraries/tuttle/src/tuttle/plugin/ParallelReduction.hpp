@@ -0,0 +1,120 @@
+#ifndef _TUTTLE_PLUGIN_PARALLELREDUCTION_HPP_
+#define _TUTTLE_PLUGIN_PARALLELREDUCTION_HPP_
+
+#include "IProgress.hpp"
+#include "NoProgress.hpp"
+
+#include <ofxsMultiThread.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+
+/**
+ * @brief Accumulate all the pixels of a view with the SMP threads of the host.
+ *
+ * Each thread accumulates a band of rows into its own copy of the initial
+ * accumulator, the partial results are then merged in the order of the bands,
+ * so the result doesn't depend on the scheduling of the threads.
+ *
+ * Accumulator models: operator()( pixel ), merge( const Accumulator& ).
+ * The initial accumulator is copied for each thread, so it must not change
+ * the result when merged several times (empty moments, extrema initialized
+ * with a pixel of the view...).
+ * Each thread stops on its own progress result (the abort of the host
+ * is seen by all the threads), so the threads don't share any flag.
+ */
+template<class View, class Accumulator>
+class ParallelReduction : public OFX::MultiThread::Processor
+{
+public:
+	ParallelReduction( const View& view, const Accumulator& init, IProgress& progress )
+		: _view( view )
+		, _progress( progress )
+		, _nbThreads( std::max( OFX::MultiThread::getNumCPUs(), 1u ) )
+		, _partials( _nbThreads, init )
+		, _used( _nbThreads, false )
+		, _aborted( _nbThreads, false )
+	{}
+
+	/**
+	 * @param[out] result merge of the partial results, unchanged if the view is empty
+	 * @return false if the process was aborted
+	 */
+	bool process( Accumulator& result )
+	{
+		if( _view.height() > 0 && _view.width() > 0 )
+			multiThread( _nbThreads );
+		bool first = true;
+		for( std::size_t i = 0; i < _partials.size(); ++i )
+		{
+			if( ! _used[i] )
+				continue;
+			if( first )
+				result = _partials[i];
+			else
+				result.merge( _partials[i] );
+			first = false;
+		}
+		return std::find( _aborted.begin(), _aborted.end(), 1 ) == _aborted.end();
+	}
+
+	void multiThreadFunction( const unsigned int threadId, const unsigned int nThreads )
+	{
+		if( threadId >= _nbThreads )
+			return;
+		const std::ptrdiff_t h  = _view.height();
+		const std::ptrdiff_t y1 = threadId * h / nThreads;
+		const std::ptrdiff_t y2 = ( threadId + 1 ) * h / nThreads;
+		if( y1 >= y2 )
+			return;
+		Accumulator& acc = _partials[threadId];
+		for( std::ptrdiff_t y = y1; y < y2; ++y )
+		{
+			typename View::x_iterator it = _view.row_begin( y );
+			for( std::ptrdiff_t x = 0; x < _view.width(); ++x, ++it )
+				acc( *it );
+			if( _progress.progressForward( _view.width() ) )
+			{
+				_aborted[threadId] = true;
+				break;
+			}
+		}
+		_used[threadId] = true;
+	}
+
+private:
+	View _view;
+	IProgress& _progress;
+	const unsigned int _nbThreads;
+	std::vector<Accumulator> _partials; ///< one per thread
+	std::vector<char> _used;
+	std::vector<char> _aborted; ///< one per thread, written by its thread only
+};
+
+/**
+ * @brief Parallel reduction of a view, see ParallelReduction.
+ * @param[in, out] acc initial accumulator, replaced by the result
+ * @return false if the process was aborted
+ */
+template<class View, class Accumulator>
+bool reducePixelsParallel( const View& view, Accumulator& acc, IProgress& progress )
+{
+	ParallelReduction<View, Accumulator> reduction( view, acc, progress );
+	return reduction.process( acc );
+}
+
+template<class View, class Accumulator>
+bool reducePixelsParallel( const View& view, Accumulator& acc )
+{
+	NoProgress progress;
+	return reducePixelsParallel( view, acc, progress );
+}
+
+}
+}
+
+#endif
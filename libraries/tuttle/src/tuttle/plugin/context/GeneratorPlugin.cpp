@@ -133,7 +133,7 @@ void GeneratorPlugin::changedParam( const OFX::InstanceChangedArgs& args, const
 
 void GeneratorPlugin::getClipPreferences( OFX::ClipPreferencesSetter& clipPreferences )
 {
-	clipPreferences.setOutputFrameVarying( true );
+	clipPreferences.setOutputFrameVarying( varyOnTime() );
 
 	switch( getExplicitConversion() )
 	{
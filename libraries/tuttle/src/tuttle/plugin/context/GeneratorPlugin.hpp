@@ -49,6 +49,9 @@ public:
 protected:
 	void updateVisibleTools();
 
+	/// the output only depends on the parameters by default, so the host can reuse it for the other frames
+	virtual inline bool varyOnTime() const { return false; }
+
 public:
 	OFX::Clip*              _clipSrc;  ///< Input image clip
 	OFX::Clip*              _clipDst;  ///< Destination image clip
@@ -0,0 +1,107 @@
+#include <boost/test/unit_test.hpp>
+
+#include <tuttle/host/Graph.hpp>
+#include <tuttle/host/attribute/Image.hpp>
+
+#include <boost/foreach.hpp>
+
+#include <cstring>
+#include <list>
+#include <string>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+
+namespace {
+
+/// @return the number of different rows of two images with the same bounds
+int countDifferentRows( attribute::Image& a, attribute::Image& b )
+{
+	const OfxRectI bounds = a.getBounds();
+	const int height = bounds.y2 - bounds.y1;
+	const std::size_t rowSize = ( bounds.x2 - bounds.x1 ) * a.getNbComponents() * a.getBitDepthMemorySize();
+	const boost::uint8_t* rowA = a.getOrientedPixelData( attribute::Image::eImageOrientationFromBottomToTop );
+	const boost::uint8_t* rowB = b.getOrientedPixelData( attribute::Image::eImageOrientationFromBottomToTop );
+	const int distanceA = a.getOrientedRowDistanceBytes( attribute::Image::eImageOrientationFromBottomToTop );
+	const int distanceB = b.getOrientedRowDistanceBytes( attribute::Image::eImageOrientationFromBottomToTop );
+	int differentRows = 0;
+	for( int y = 0; y < height; ++y, rowA += distanceA, rowB += distanceB )
+	{
+		if( std::memcmp( rowA, rowB, rowSize ) != 0 )
+			++differentRows;
+	}
+	return differentRows;
+}
+
+/// 32 bits float image varying in both directions, the same for all frames
+Graph::Node& createSource( Graph& g )
+{
+	Graph::Node& source = g.createNode( "tuttle.colorwheel" );
+	source.getParam( "type" ).setValue( 2 ); // rainbow
+	source.getParam( "explicitConversion" ).setValue( 3 ); // 32f
+	source.getParam( "mode" ).setValue( 1 ); // size
+	source.getParam( "specificRatio" ).setValue( false );
+	source.getParam( "size" ).setValue( 64, 48 );
+	return source;
+}
+
+Graph::Node& createCrop( Graph& g, const int x1, const int y1, const int x2, const int y2 )
+{
+	Graph::Node& crop = g.createNode( "tuttle.crop" );
+	crop.getParam( "mode" ).setValue( 0 ); // crop
+	crop.getParam( "x1" ).setValue( x1 );
+	crop.getParam( "y1" ).setValue( y1 );
+	crop.getParam( "x2" ).setValue( x2 );
+	crop.getParam( "y2" ).setValue( y2 );
+	return crop;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( tuttle_graph_constantOutput )
+
+BOOST_AUTO_TEST_CASE( constantOutput_regionsOfInterest )
+{
+	TUTTLE_LOG_INFO( "--> CONSTANT GENERATOR WITH DIFFERENT REGIONS OF INTEREST" );
+	// source -> cropSmall                (frame t, small region)
+	//        -> timeshift -> cropFull    (frame t+1, whole image)
+	// the source is requested at each frame with both regions of interest:
+	// an image kept for the small region doesn't contain the whole image,
+	// so the whole image is rendered, and the small region reuses it after that.
+	Graph g;
+	Graph::Node& source = createSource( g );
+	Graph::Node& cropSmall = createCrop( g, 8, 8, 40, 32 );
+	Graph::Node& timeshift = g.createNode( "tuttle.timeshift" );
+	Graph::Node& cropFull = createCrop( g, 0, 0, 64, 48 );
+	timeshift.getParam( "offset" ).setValue( -1.0 );
+	g.connect( source, cropSmall );
+	g.connect( source, timeshift );
+	g.connect( timeshift, cropFull );
+
+	std::list<std::string> outputs;
+	outputs.push_back( cropSmall.getName() );
+	outputs.push_back( cropFull.getName() );
+
+	static const int kLastFrame = 3;
+	memory::MemoryCache sequenceCache;
+	BOOST_REQUIRE( g.compute( sequenceCache, outputs, ComputeOptions( 0, kLastFrame ) ) );
+
+	// reference: each output of each frame in its own sequence, so the source is rendered once
+	for( int time = 0; time <= kLastFrame; ++time )
+	{
+		TUTTLE_LOG_INFO( "frame " << time );
+		BOOST_FOREACH( const std::string& output, outputs )
+		{
+			memory::MemoryCache referenceCache;
+			BOOST_REQUIRE( g.compute( referenceCache, output, ComputeOptions( time ) ) );
+			memory::CACHE_ELEMENT image = sequenceCache.get( output, time );
+			memory::CACHE_ELEMENT reference = referenceCache.get( output, time );
+			BOOST_REQUIRE( image.get() != NULL );
+			BOOST_REQUIRE( reference.get() != NULL );
+			BOOST_CHECK_EQUAL( countDifferentRows( *image, *reference ), 0 );
+		}
+	}
+	TUTTLE_LOG_INFO( "----------------- DONE -----------------" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,138 @@
+#include <boost/test/unit_test.hpp>
+
+#include <tuttle/host/Graph.hpp>
+#include <tuttle/host/Core.hpp>
+#include <tuttle/host/attribute/Image.hpp>
+
+#include <cstring>
+#include <list>
+#include <string>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+
+namespace {
+
+/// @return the number of different rows of two images with the same bounds
+int countDifferentRows( attribute::Image& a, attribute::Image& b )
+{
+	const OfxRectI bounds = a.getBounds();
+	const int height = bounds.y2 - bounds.y1;
+	const std::size_t rowSize = ( bounds.x2 - bounds.x1 ) * a.getNbComponents() * a.getBitDepthMemorySize();
+	const boost::uint8_t* rowA = a.getOrientedPixelData( attribute::Image::eImageOrientationFromBottomToTop );
+	const boost::uint8_t* rowB = b.getOrientedPixelData( attribute::Image::eImageOrientationFromBottomToTop );
+	const int distanceA = a.getOrientedRowDistanceBytes( attribute::Image::eImageOrientationFromBottomToTop );
+	const int distanceB = b.getOrientedRowDistanceBytes( attribute::Image::eImageOrientationFromBottomToTop );
+	int differentRows = 0;
+	for( int y = 0; y < height; ++y, rowA += distanceA, rowB += distanceB )
+	{
+		if( std::memcmp( rowA, rowB, rowSize ) != 0 )
+			++differentRows;
+	}
+	return differentRows;
+}
+
+/// 32 bits float image varying in both directions, kept by the generator as a shared buffer
+Graph::Node& createSource( Graph& g )
+{
+	Graph::Node& source = g.createNode( "tuttle.colorwheel" );
+	source.getParam( "type" ).setValue( 2 ); // rainbow
+	source.getParam( "explicitConversion" ).setValue( 3 ); // 32f
+	source.getParam( "mode" ).setValue( 1 ); // size
+	source.getParam( "specificRatio" ).setValue( false );
+	source.getParam( "size" ).setValue( 64, 48 );
+	return source;
+}
+
+/**
+ * Compute the graph and count the buffers allocated in the memory pool.
+ * The unused buffers of the pool are dropped first, so each image
+ * rendered into its own buffer allocates a new one.
+ */
+std::size_t computeBuffers( Graph& g, const std::list<std::string>& outputs, memory::MemoryCache& cache )
+{
+	memory::IMemoryPool& pool = core().getMemoryPool();
+	pool.clear();
+	const std::size_t usedBefore = pool.getUsedMemorySize();
+	BOOST_REQUIRE( g.compute( cache, outputs ) );
+
+	memory::CACHE_ELEMENT image = cache.get( outputs.back(), 0 );
+	BOOST_REQUIRE( image.get() != NULL );
+	return ( pool.getAllocatedMemorySize() - usedBefore ) / image->getMemorySize();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( tuttle_graph_inPlace )
+
+BOOST_AUTO_TEST_CASE( inPlace_chain )
+{
+	TUTTLE_LOG_INFO( "--> IN PLACE CHAIN OF POINT OPERATIONS" );
+	// source -> invert1 -> invert2 -> invert3
+	Graph g;
+	Graph::Node& source = createSource( g );
+	Graph::Node& invert1 = g.createNode( "tuttle.invert" );
+	Graph::Node& invert2 = g.createNode( "tuttle.invert" );
+	Graph::Node& invert3 = g.createNode( "tuttle.invert" );
+	g.connect( source, invert1 );
+	g.connect( invert1, invert2 );
+	g.connect( invert2, invert3 );
+
+	// invert2 and invert3 are the only users of the buffers of their sources:
+	// the source buffer of invert1 is kept by the generator for the next frames,
+	// invert1 has its own buffer, reused by invert2 and invert3
+	std::list<std::string> chainOutputs;
+	chainOutputs.push_back( invert3.getName() );
+	memory::MemoryCache chainCache;
+	BOOST_CHECK_EQUAL( computeBuffers( g, chainOutputs, chainCache ), 2u );
+
+	// the buffers of the final nodes are returned to the user, so they are not reused
+	std::list<std::string> finalOutputs;
+	finalOutputs.push_back( invert1.getName() );
+	finalOutputs.push_back( invert2.getName() );
+	finalOutputs.push_back( invert3.getName() );
+	memory::MemoryCache finalCache;
+	BOOST_CHECK_EQUAL( computeBuffers( g, finalOutputs, finalCache ), 4u );
+
+	BOOST_CHECK_EQUAL( countDifferentRows( *chainCache.get( invert3.getName(), 0 ), *finalCache.get( invert3.getName(), 0 ) ), 0 );
+	TUTTLE_LOG_INFO( "----------------- DONE -----------------" );
+}
+
+BOOST_AUTO_TEST_CASE( inPlace_sharedSource )
+{
+	TUTTLE_LOG_INFO( "--> IN PLACE WITH A SHARED SOURCE" );
+	// source -> invert1 -> invert2
+	//                   -> invert3
+	Graph g;
+	Graph::Node& source = createSource( g );
+	Graph::Node& invert1 = g.createNode( "tuttle.invert" );
+	Graph::Node& invert2 = g.createNode( "tuttle.invert" );
+	Graph::Node& invert3 = g.createNode( "tuttle.invert" );
+	g.connect( source, invert1 );
+	g.connect( invert1, invert2 );
+	g.connect( invert1, invert3 );
+
+	// the first rendered of invert2 and invert3 shares the buffer of invert1
+	// with the other one, so it is rendered into a copy,
+	// the last one is the only user left and reuses the buffer
+	std::list<std::string> branchOutputs;
+	branchOutputs.push_back( invert2.getName() );
+	branchOutputs.push_back( invert3.getName() );
+	memory::MemoryCache branchCache;
+	BOOST_CHECK_EQUAL( computeBuffers( g, branchOutputs, branchCache ), 3u );
+
+	// reference without in place rendering
+	std::list<std::string> finalOutputs( branchOutputs );
+	finalOutputs.push_back( source.getName() );
+	finalOutputs.push_back( invert1.getName() );
+	memory::MemoryCache finalCache;
+	BOOST_CHECK_EQUAL( computeBuffers( g, finalOutputs, finalCache ), 4u );
+
+	// if the first one was rendered into the buffer of invert1, the other one would invert it twice
+	memory::CACHE_ELEMENT reference = finalCache.get( invert2.getName(), 0 );
+	BOOST_CHECK_EQUAL( countDifferentRows( *branchCache.get( invert2.getName(), 0 ), *reference ), 0 );
+	BOOST_CHECK_EQUAL( countDifferentRows( *branchCache.get( invert3.getName(), 0 ), *reference ), 0 );
+	TUTTLE_LOG_INFO( "----------------- DONE -----------------" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
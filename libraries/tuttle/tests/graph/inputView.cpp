@@ -0,0 +1,166 @@
+#include <boost/test/unit_test.hpp>
+
+#include <tuttle/host/Graph.hpp>
+#include <tuttle/host/attribute/Image.hpp>
+
+#include <cstring>
+#include <list>
+#include <string>
+#include <vector>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+
+namespace {
+
+/**
+ * @return the number of different rows of two images with the same bounds,
+ * or the number of rows of a if the bounds are different
+ */
+int countDifferentRows( attribute::Image& a, attribute::Image& b )
+{
+	const OfxRectI boundsA = a.getBounds();
+	const OfxRectI boundsB = b.getBounds();
+	const int height = boundsA.y2 - boundsA.y1;
+	if( boundsA.x1 != boundsB.x1 || boundsA.y1 != boundsB.y1 ||
+	    boundsA.x2 != boundsB.x2 || boundsA.y2 != boundsB.y2 ||
+	    a.getBitDepth() != b.getBitDepth() || a.getComponentsType() != b.getComponentsType() )
+		return height;
+
+	const std::size_t rowSize = ( boundsA.x2 - boundsA.x1 ) * a.getNbComponents() * a.getBitDepthMemorySize();
+	// the images may have different orientations
+	const boost::uint8_t* rowA = a.getOrientedPixelData( attribute::Image::eImageOrientationFromBottomToTop );
+	const boost::uint8_t* rowB = b.getOrientedPixelData( attribute::Image::eImageOrientationFromBottomToTop );
+	const int distanceA = a.getOrientedRowDistanceBytes( attribute::Image::eImageOrientationFromBottomToTop );
+	const int distanceB = b.getOrientedRowDistanceBytes( attribute::Image::eImageOrientationFromBottomToTop );
+	int differentRows = 0;
+	for( int y = 0; y < height; ++y, rowA += distanceA, rowB += distanceB )
+	{
+		if( std::memcmp( rowA, rowB, rowSize ) != 0 )
+			++differentRows;
+	}
+	return differentRows;
+}
+
+/**
+ * Connect an invert node (a point operation) after the last view node
+ * and compute the graph twice:
+ * - the view nodes are not final nodes, so their outputs are views
+ *   of the source buffer (Image::setPoolDataView),
+ * - the view nodes are final nodes, so they are rendered.
+ * The results of the invert must be the same.
+ * The source is a final node of both graphs: if the invert was rendered
+ * in place into the shared buffer of the views, the source would be modified.
+ */
+void checkInputView( Graph& g, Graph::Node& source, const std::vector<Graph::Node*>& viewNodes )
+{
+	Graph::Node& invert = g.createNode( "tuttle.invert" );
+	g.connect( *viewNodes.back(), invert );
+
+	std::list<std::string> viewOutputs;
+	viewOutputs.push_back( source.getName() );
+	viewOutputs.push_back( invert.getName() );
+	memory::MemoryCache viewCache;
+	BOOST_REQUIRE( g.compute( viewCache, viewOutputs ) );
+
+	std::list<std::string> renderOutputs( viewOutputs );
+	for( std::vector<Graph::Node*>::const_iterator it = viewNodes.begin(); it != viewNodes.end(); ++it )
+		renderOutputs.push_back( ( *it )->getName() );
+	memory::MemoryCache renderCache;
+	BOOST_REQUIRE( g.compute( renderCache, renderOutputs ) );
+
+	memory::CACHE_ELEMENT viewInvert = viewCache.get( invert.getName(), 0 );
+	memory::CACHE_ELEMENT renderInvert = renderCache.get( invert.getName(), 0 );
+	BOOST_REQUIRE( viewInvert.get() != NULL );
+	BOOST_REQUIRE( renderInvert.get() != NULL );
+	BOOST_CHECK_EQUAL( countDifferentRows( *viewInvert, *renderInvert ), 0 );
+
+	// in place rendering is refused for the shared buffers
+	memory::CACHE_ELEMENT viewSource = viewCache.get( source.getName(), 0 );
+	memory::CACHE_ELEMENT renderSource = renderCache.get( source.getName(), 0 );
+	BOOST_REQUIRE( viewSource.get() != NULL );
+	BOOST_REQUIRE( renderSource.get() != NULL );
+	BOOST_CHECK_EQUAL( countDifferentRows( *viewSource, *renderSource ), 0 );
+}
+
+/// 32 bits float image varying in both directions
+Graph::Node& createSource( Graph& g )
+{
+	Graph::Node& source = g.createNode( "tuttle.colorwheel" );
+	source.getParam( "type" ).setValue( 2 ); // rainbow
+	source.getParam( "explicitConversion" ).setValue( 3 ); // 32f
+	source.getParam( "mode" ).setValue( 1 ); // size
+	source.getParam( "specificRatio" ).setValue( false );
+	source.getParam( "size" ).setValue( 64, 48 );
+	return source;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( tuttle_graph_inputView )
+
+BOOST_AUTO_TEST_CASE( inputView_crop )
+{
+	TUTTLE_LOG_INFO( "--> INPUT VIEW CROP" );
+	Graph g;
+	Graph::Node& source = createSource( g );
+	Graph::Node& crop = g.createNode( "tuttle.crop" );
+	crop.getParam( "mode" ).setValue( 0 ); // crop
+	// same row size as the source, the invert could use the buffer of the view
+	crop.getParam( "x1" ).setValue( 0 );
+	crop.getParam( "y1" ).setValue( 8 );
+	crop.getParam( "x2" ).setValue( 64 );
+	crop.getParam( "y2" ).setValue( 40 );
+	g.connect( source, crop );
+
+	checkInputView( g, source, std::vector<Graph::Node*>( 1, &crop ) );
+	TUTTLE_LOG_INFO( "----------------- DONE -----------------" );
+}
+
+BOOST_AUTO_TEST_CASE( inputView_flip )
+{
+	TUTTLE_LOG_INFO( "--> INPUT VIEW FLIP" );
+	Graph g;
+	Graph::Node& source = createSource( g );
+	Graph::Node& flip = g.createNode( "tuttle.flip" );
+	flip.getParam( "flip" ).setValue( true );
+	g.connect( source, flip );
+
+	checkInputView( g, source, std::vector<Graph::Node*>( 1, &flip ) );
+	TUTTLE_LOG_INFO( "----------------- DONE -----------------" );
+}
+
+BOOST_AUTO_TEST_CASE( inputView_flip_topToBottom )
+{
+	TUTTLE_LOG_INFO( "--> INPUT VIEW FLIP OF A FLIP" );
+	// the source of the second flip is a view from top to bottom
+	Graph g;
+	Graph::Node& source = createSource( g );
+	Graph::Node& flip1 = g.createNode( "tuttle.flip" );
+	Graph::Node& flip2 = g.createNode( "tuttle.flip" );
+	flip1.getParam( "flip" ).setValue( true );
+	flip2.getParam( "flip" ).setValue( true );
+	g.connect( source, flip1 );
+	g.connect( flip1, flip2 );
+
+	std::vector<Graph::Node*> viewNodes;
+	viewNodes.push_back( &flip1 );
+	viewNodes.push_back( &flip2 );
+	checkInputView( g, source, viewNodes );
+	TUTTLE_LOG_INFO( "----------------- DONE -----------------" );
+}
+
+BOOST_AUTO_TEST_CASE( inputView_translation )
+{
+	TUTTLE_LOG_INFO( "--> INPUT VIEW INTEGER TRANSLATION" );
+	Graph g;
+	Graph::Node& source = createSource( g );
+	Graph::Node& move = g.createNode( "tuttle.move2d" );
+	move.getParam( "Translation" ).setValue( 5.0, -3.0 );
+	g.connect( source, move );
+
+	checkInputView( g, source, std::vector<Graph::Node*>( 1, &move ) );
+	TUTTLE_LOG_INFO( "----------------- DONE -----------------" );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
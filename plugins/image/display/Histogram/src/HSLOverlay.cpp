@@ -150,7 +150,7 @@ ESelectedChannelHSL HSLOverlay::getOnlyChannelSelectedHSL() const
  * Get overlay data from plugin
  * @return 
  */
-OverlayData& HSLOverlay::getOverlayData()
+HistogramOverlayData& HSLOverlay::getOverlayData()
 {
 	return _plugin->getOverlayData();
 }
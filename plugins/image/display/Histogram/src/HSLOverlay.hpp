@@ -49,7 +49,7 @@ public:
 	ESelectedChannelHSL getOnlyChannelSelectedHSL()const;
 	
 	/*get overlay data*/
-	OverlayData& getOverlayData();
+	HistogramOverlayData& getOverlayData();
 	
 	/*Display grid*/
 	void displayGrid(float height, float width);
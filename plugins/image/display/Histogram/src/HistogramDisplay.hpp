@@ -2,7 +2,7 @@
 #define	HISTOGRAMDISPLAY_HPP
 
 #include "HistogramDefinitions.hpp"
-#include "OverlayData.hpp"
+#include <tuttle/plugin/HistogramOverlayData.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -732,6 +732,7 @@ void HistogramPlugin::changedClip( const OFX::InstanceChangedArgs& args, const s
 	{
 		if( this->hasOverlayData( ) )
 		{
+			this->getOverlayData().clearCache();
 			this->getOverlayData()._isDataInvalid = true;
 			this->redrawOverlays();
 		}
@@ -778,7 +779,7 @@ void HistogramPlugin::addRefOverlayData( )
 	if( _overlayDataCount == 0 )
 	{
 		const OfxPointI imgSize = this->_clipSrc->getPixelRodSize( 0 ); ///@todo set the correct time !
-		_overlayData.reset( new OverlayData( imgSize, this->_paramNbStepSelection->getValue( ),this->_paramSelectionFromCurve->getValue()) );
+		_overlayData.reset( new HistogramOverlayData( imgSize, this->_paramNbStepSelection->getValue( ),this->_paramSelectionFromCurve->getValue()) );
 	}
 	++_overlayDataCount;
 }
@@ -797,12 +798,12 @@ bool HistogramPlugin::hasOverlayData( ) const
 	return _overlayDataCount != 0;
 }
 
-OverlayData& HistogramPlugin::getOverlayData( )
+HistogramOverlayData& HistogramPlugin::getOverlayData( )
 {
 	return *_overlayData.get( );
 }
 
-const OverlayData& HistogramPlugin::getOverlayData( ) const
+const HistogramOverlayData& HistogramPlugin::getOverlayData( ) const
 {
 	return *_overlayData.get( );
 }
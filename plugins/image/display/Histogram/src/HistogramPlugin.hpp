@@ -1,7 +1,7 @@
 #ifndef _TUTTLE_PLUGIN_HISTOGRAM_PLUGIN_HPP_
 #define _TUTTLE_PLUGIN_HISTOGRAM_PLUGIN_HPP_
 
-#include "OverlayData.hpp"
+#include <tuttle/plugin/HistogramOverlayData.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -85,7 +85,7 @@ public:
 	bool _isRendering;							//is plugin rendering ? (if rendering don't modify data)
 	
 	/*Overlay data parameters*/
-	boost::scoped_ptr<OverlayData> _overlayData;	//scoped pointer points the overlay data (or NULL)
+	boost::scoped_ptr<HistogramOverlayData> _overlayData;	//scoped pointer points the overlay data (or NULL)
 	std::size_t _overlayDataCount;					//count (class calling scoped pointer)
 	
 	
@@ -105,8 +105,8 @@ public:
 	void addRefOverlayData();					//add reference to overlay data
 	void releaseOverlayData();					//release reference to overlay data
 	bool hasOverlayData() const;				//is there overlay data ?
-	OverlayData& getOverlayData();				//getter/setter
-	const OverlayData& getOverlayData() const;	//const getter
+	HistogramOverlayData& getOverlayData();				//getter/setter
+	const HistogramOverlayData& getOverlayData() const;	//const getter
 };
 
 }
@@ -150,7 +150,7 @@ ESelectedChannelRGB RGBOverlay::getOnlyChannelSelectedRGB() const
  * Get overlay data from plugin
  * @return 
  */
-OverlayData& RGBOverlay::getOverlayData()
+HistogramOverlayData& RGBOverlay::getOverlayData()
 {
 	return _plugin->getOverlayData();
 }
@@ -53,7 +53,7 @@ public:
 	void displayGrid(float height, float width);
 	
 	/*get overlay data*/
-	OverlayData& getOverlayData();
+	HistogramOverlayData& getOverlayData();
 };
 
 }
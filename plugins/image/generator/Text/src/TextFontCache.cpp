@@ -0,0 +1,187 @@
+#include "TextFontCache.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#ifndef __WINDOWS__
+#include <fontconfig/fontconfig.h>
+#endif
+
+namespace tuttle {
+namespace plugin {
+namespace text {
+
+namespace {
+
+/// character and face, as expected by terry::make_kerning
+struct KerningGlyph
+{
+	char ch;
+	FT_Face face;
+};
+
+}
+
+TextFont::TextFont( FT_Face face )
+	: _face( face )
+{}
+
+TextFont::~TextFont()
+{
+	FT_Done_Face( _face );
+}
+
+TextFontCache::TextFontCache()
+	: _mutex( 0 )
+	, _library( NULL )
+{
+	FT_Init_FreeType( &_library );
+}
+
+TextFontCache::~TextFontCache()
+{
+	_fonts.clear();
+	FT_Done_FreeType( _library );
+}
+
+#ifndef __WINDOWS__
+std::string TextFontCache::getFontFile( const int font, const bool bold, const bool italic )
+{
+	const std::string key = boost::lexical_cast<std::string>( font ) + ( bold ? "b" : "" ) + ( italic ? "i" : "" );
+	OFX::MultiThread::AutoMutex lock( _mutex );
+	std::map<std::string, std::string>::const_iterator it = _fontFiles.find( key );
+	if( it != _fontFiles.end() )
+		return it->second;
+
+	FcInit();
+
+	std::string fontFile = "";
+
+	FcConfig  *config = FcInitLoadConfigAndFonts();
+	FcPattern *p      = FcPatternBuild( NULL,
+	                                    FC_WEIGHT, FcTypeInteger, FC_WEIGHT_BOLD,
+	                                    FC_SLANT, FcTypeInteger, FC_SLANT_ITALIC,
+	                                    NULL );
+	FcObjectSet *os = FcObjectSetBuild( FC_FAMILY, NULL );
+	FcFontSet   *fs = FcFontList( config, p, os );
+	FcPatternDestroy( p );
+	FcObjectSetDestroy( os );
+
+	if( fs && font >= 0 && font < fs->nfont )
+	{
+		FcChar8* family = FcNameUnparse( fs->fonts[font] );
+
+		const int weight = bold   ? FC_WEIGHT_BOLD  : FC_WEIGHT_MEDIUM;
+		const int slant  = italic ? FC_SLANT_ITALIC : FC_SLANT_ROMAN;
+
+		p = FcPatternBuild( NULL,
+		                    FC_FAMILY, FcTypeString, family,
+		                    FC_WEIGHT, FcTypeInteger, weight,
+		                    FC_SLANT, FcTypeInteger, slant,
+		                    NULL );
+		FcResult result;
+		FcPattern* match = FcFontMatch( 0, p, &result );
+		FcChar8* file;
+		if( match && FcPatternGetString( match, FC_FILE, 0, &file ) == FcResultMatch )
+			fontFile = (char*) file;
+		if( match )
+			FcPatternDestroy( match );
+		FcPatternDestroy( p );
+		free( family );
+	}
+	if( fs )
+		FcFontSetDestroy( fs );
+	FcConfigDestroy( config );
+
+	_fontFiles[key] = fontFile;
+	return fontFile;
+}
+#endif
+
+TextFontCache::TextFontPtr TextFontCache::getFont( const std::string& fontFile, const int sizeX, const int sizeY )
+{
+	const std::string key = fontFile + "@" + boost::lexical_cast<std::string>( sizeX ) + "x" + boost::lexical_cast<std::string>( sizeY );
+	OFX::MultiThread::AutoMutex lock( _mutex );
+	std::map<std::string, TextFontPtr>::const_iterator it = _fonts.find( key );
+	if( it != _fonts.end() )
+		return it->second;
+
+	FT_Face face;
+	if( ! _library || FT_New_Face( _library, fontFile.c_str(), 0, &face ) )
+		return TextFontPtr();
+	FT_Set_Pixel_Sizes( face, sizeX, sizeY );
+
+	// release the fonts only used by the cache (an animated size creates a font per frame)
+	if( _fonts.size() >= kMaxUnusedFonts )
+	{
+		for( std::map<std::string, TextFontPtr>::iterator f = _fonts.begin(); f != _fonts.end(); )
+		{
+			if( f->second.unique() )
+				_fonts.erase( f++ );
+			else
+				++f;
+		}
+	}
+
+	TextFontPtr font( new TextFont( face ) );
+	_fonts[key] = font;
+	return font;
+}
+
+void TextFontCache::getGlyphs( TextFont& font, const std::string& text, std::vector<const TextGlyph*>& glyphs, std::vector<int>& kerning )
+{
+	OFX::MultiThread::AutoMutex lock( _mutex );
+	glyphs.clear();
+	kerning.clear();
+	glyphs.reserve( text.size() );
+	kerning.reserve( text.size() );
+
+	terry::make_kerning makeKerning;
+	for( std::string::const_iterator ch = text.begin(); ch != text.end(); ++ch )
+	{
+		std::map<char, TextGlyph>::const_iterator it = font._glyphs.find( *ch );
+		glyphs.push_back( it != font._glyphs.end() ? &it->second : &rasterise( font, *ch ) );
+
+		const KerningGlyph kerningGlyph = { *ch, font._face };
+		kerning.push_back( makeKerning( kerningGlyph ) );
+	}
+}
+
+const TextGlyph& TextFontCache::rasterise( TextFont& font, const char ch )
+{
+	TextGlyph& glyph = font._glyphs[ch];
+	FT_GlyphSlot slot = font._face->glyph;
+
+	FT_Load_Glyph( font._face, FT_Get_Char_Index( font._face, ch ), FT_LOAD_DEFAULT );
+	glyph._ch      = ch;
+	glyph._metrics = slot->metrics;
+	FT_Render_Glyph( slot, FT_RENDER_MODE_NORMAL );
+
+	glyph._advance = slot->advance.x >> 6;
+	glyph._width   = glyph._metrics.width >> 6;
+	glyph._height  = glyph._metrics.height >> 6;
+	glyph._coverage.assign( glyph._width * glyph._height, 0 );
+
+	// the bitmap rows may be padded
+	const int width  = std::min( glyph._width, int( slot->bitmap.width ) );
+	const int height = std::min( glyph._height, int( slot->bitmap.rows ) );
+	for( int y = 0; y < height; ++y )
+	{
+		std::memcpy( &glyph._coverage[y * glyph._width], slot->bitmap.buffer + y * slot->bitmap.pitch, width );
+	}
+	return glyph;
+}
+
+TextFontCache& getTextFontCache()
+{
+	// never destroyed: the host suites may be released before the static objects
+	static TextFontCache* cache = new TextFontCache();
+	return *cache;
+}
+
+}
+}
+}
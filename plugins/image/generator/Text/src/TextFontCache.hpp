@@ -0,0 +1,159 @@
+#ifndef _TUTTLE_PLUGIN_TEXT_FONTCACHE_HPP_
+#define _TUTTLE_PLUGIN_TEXT_FONTCACHE_HPP_
+
+#include <terry/freetype/freegil.hpp>
+
+#include <ofxsMultiThread.h>
+
+#include <boost/gil/gil_all.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+namespace text {
+
+/**
+ * @brief Rasterised glyph: its metrics and its coverage mask.
+ */
+struct TextGlyph
+{
+	char _ch;
+	FT_Glyph_Metrics _metrics;
+	int _advance;                        ///< horizontal advance in pixels
+	int _width;                          ///< in pixels, from the metrics
+	int _height;                         ///< in pixels, from the metrics
+	std::vector<unsigned char> _coverage; ///< _width x _height, without padding
+};
+
+/**
+ * @brief A font face at a pixel size, with the glyphs already rasterised.
+ */
+class TextFont
+{
+	friend class TextFontCache;
+
+public:
+	TextFont( FT_Face face );
+	~TextFont();
+
+	FT_Face getFace() const { return _face; }
+
+private:
+	FT_Face _face;
+	std::map<char, TextGlyph> _glyphs; ///< the elements of a std::map are never moved
+};
+
+/**
+ * @brief Font faces and rasterised glyphs shared by all the Text instances
+ * of the process, so a frame only rasterises the characters never seen
+ * before with this font and size (timecodes, frame numbers...).
+ *
+ * FreeType is not thread safe, all the FreeType calls are done with the
+ * mutex locked. The glyphs are immutable once rasterised.
+ */
+class TextFontCache
+{
+public:
+	typedef boost::shared_ptr<TextFont> TextFontPtr;
+
+	/// maximal number of unused fonts kept (one per font file and size)
+	static const std::size_t kMaxUnusedFonts = 16;
+
+public:
+	TextFontCache();
+	~TextFontCache();
+
+#ifndef __WINDOWS__
+	/// font file of the fontconfig font list index, with a style
+	std::string getFontFile( const int font, const bool bold, const bool italic );
+#endif
+
+	/// @return an empty pointer if the font can't be loaded
+	TextFontPtr getFont( const std::string& fontFile, const int sizeX, const int sizeY );
+
+	/**
+	 * @brief Glyphs of a text, rasterised if needed.
+	 * @param[out] glyphs one per character, valid while font is kept
+	 * @param[out] kerning one per character
+	 */
+	void getGlyphs( TextFont& font, const std::string& text, std::vector<const TextGlyph*>& glyphs, std::vector<int>& kerning );
+
+private:
+	const TextGlyph& rasterise( TextFont& font, const char ch );
+
+private:
+	OFX::MultiThread::Mutex _mutex;
+	FT_Library _library;
+	std::map<std::string, TextFontPtr> _fonts; ///< by font file and size
+#ifndef __WINDOWS__
+	std::map<std::string, std::string> _fontFiles; ///< by fontconfig index and style
+#endif
+};
+
+/// the cache of the process
+TextFontCache& getTextFontCache();
+
+/**
+ * @brief Blend the coverage masks of the glyphs into a view, same placement as terry::render_glyph.
+ */
+template <typename View>
+class render_cached_glyph
+{
+public:
+	typedef typename View::value_type Pixel;
+	typedef terry::Rect<std::ptrdiff_t> rect_t;
+	typedef boost::gil::point2<std::ptrdiff_t> point_t;
+
+private:
+	const View& _outView;
+	const Pixel _color;
+	const double _letterSpacing;
+	const rect_t _roi;
+	int _x;
+
+public:
+	render_cached_glyph( const View& outView, const Pixel& color, const double letterSpacing, const rect_t roi )
+		: _outView( outView )
+		, _color( color )
+		, _letterSpacing( letterSpacing )
+		, _roi( roi )
+		, _x( 0 )
+		{}
+
+	void operator()( const TextGlyph* glyph, int kerning = 0 )
+	{
+		using namespace boost::gil;
+		_x += kerning;
+
+		const int y = _outView.height() - ( glyph->_metrics.horiBearingY >> 6 );
+		const rect_t glyphRod( _x, y, _x + glyph->_width, y + glyph->_height );
+		const rect_t glyphRoi = rectanglesIntersection( glyphRod, _roi );
+		const point_t glyphRegionSize = glyphRoi.size();
+
+		if( glyphRegionSize.x > 0 &&
+		    glyphRegionSize.y > 0 )
+		{
+			const rect_t glyphLocalRoi = translateRegion( glyphRoi, - glyphRod.x1, - glyphRod.y1 );
+
+			gray8c_view_t glyphView = interleaved_view( glyph->_width, glyph->_height, reinterpret_cast<const gray8_pixel_t*>( &glyph->_coverage.front() ), glyph->_width );
+			gray8c_view_t glyphViewRoi = subimage_view( glyphView, glyphLocalRoi );
+			View outViewRoi = subimage_view( _outView, glyphRoi );
+
+			terry::copy_and_convert_alpha_blended_pixels( color_converted_view<gray32f_pixel_t>( glyphViewRoi ), _color, outViewRoi );
+		}
+
+		_x += glyph->_advance;
+		_x += _letterSpacing;
+	}
+};
+
+}
+}
+}
+
+#endif
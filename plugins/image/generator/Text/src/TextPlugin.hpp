@@ -48,6 +48,10 @@ public:
 	
 	void render( const OFX::RenderArguments& args );
 
+protected:
+	/// an expression can use the time
+	bool varyOnTime() const { return _paramIsExpression->getValue(); }
+
 private:
 	template< class View >
 	void render( const OFX::RenderArguments& args );
@@ -20,16 +20,11 @@
 #include <boost/gil/gil_all.hpp>
 
 #include <boost/filesystem.hpp>
-#include <boost/ptr_container/ptr_inserter.hpp>
 
 #include <sstream>
 #include <string>
 #include <iostream>
 
-#ifndef __WINDOWS__
-#include <fontconfig/fontconfig.h>
-#endif
-
 namespace tuttle {
 namespace plugin {
 namespace text {
@@ -120,22 +115,13 @@ void TextProcess<View, Functor>::setup( const OFX::RenderArguments& args )
 //		Py_Finalize();
 	}
 	
-	//Step 1. Create terry image
-	//Step 2. Initialize freetype
-	//Step 3. Make Glyphs Array
-	//Step 4. Make Metrics Array
-	//Step 5. Make Kerning Array
-	//Step 6. Get Coordinates (x,y)
-	//Step 7. Render Glyphs on GIL View
-	//Step 8. Save GIL Image
-
-	//Step 1. Create terry image -----------
+	//Step 1. Get the font from the cache of the process
+	//Step 2. Get the rasterised glyphs, only the new characters are rasterised
+	//Step 3. Get Coordinates (x,y)
+	//Step 4. Blend Glyphs on GIL View
 
-	//Step 2. Initialize freetype ---------------
-	FT_Library library;
-	FT_Init_FreeType( &library );
-
-	FT_Face face;
+	//Step 1. Get the font from the cache of the process -----------
+	TextFontCache& fontCache = getTextFontCache();
 
 #ifdef __WINDOWS__
 	if( !boost::filesystem::exists(_params._font) || boost::filesystem::is_directory(_params._font) )
@@ -144,58 +130,35 @@ void TextProcess<View, Functor>::setup( const OFX::RenderArguments& args )
 							<< exception::user("Text: Error in Font Path.")
 							<< exception::filename(_params._font));
 	}
-	FT_New_Face( library, _params._font.c_str(), 0, &face );
+	const std::string fontFile = _params._font;
 #else
-	FcInit();
-	
-	std::string fontFile = "";
-	
-	FcChar8 *file;
-	FcResult result;
-	FcConfig *config = FcInitLoadConfigAndFonts();
-	FcPattern *p = FcPatternBuild(	NULL,
-									FC_WEIGHT, FcTypeInteger, FC_WEIGHT_BOLD,
-									FC_SLANT, FcTypeInteger, FC_SLANT_ITALIC,
-									NULL);
-	
-	FcObjectSet *os = FcObjectSetBuild( FC_FAMILY, NULL );
-	FcFontSet   *fs = FcFontList( config, p, os );
-	
-	fontFile = (char*) FcNameUnparse( fs->fonts[_params._font] );
-	
-	int weight = ( _params._bold   == 1) ? FC_WEIGHT_BOLD  : FC_WEIGHT_MEDIUM;
-	int slant  = ( _params._italic == 1) ? FC_SLANT_ITALIC : FC_SLANT_ROMAN;
-	
-	p  = FcPatternBuild( NULL, 
-						 FC_FAMILY, FcTypeString, fontFile.c_str(),
-						 FC_WEIGHT, FcTypeInteger, weight, 
-						 FC_SLANT, FcTypeInteger, slant, 
-						 NULL);	
-	
-	FcPatternGetString( FcFontMatch( 0, p, &result ), FC_FAMILY, 0, &file );
-	FcPatternGetString( FcFontMatch( 0, p, &result ), FC_FILE, 0, &file );
-	fontFile = (char*) file;
-	
-	FT_New_Face( library, fontFile.c_str(), 0, &face );
+	const std::string fontFile = fontCache.getFontFile( _params._font, _params._bold, _params._italic );
 #endif
-	
-	FT_Set_Pixel_Sizes( face, _params._fontX, _params._fontY );	
 
-	//Step 3. Make Glyphs Array ------------------
+	_font = fontCache.getFont( fontFile, _params._fontX, _params._fontY );
+	if( ! _font )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+							<< exception::user("Text: Unable to load the font.")
+							<< exception::filename(fontFile));
+	}
+
+	//Step 2. Get the rasterised glyphs ------------------
 	rgba32f_pixel_t rgba32f_foregroundColor( _params._fontColor.r,
 											 _params._fontColor.g,
 											 _params._fontColor.b,
 											 _params._fontColor.a );
 	color_convert( rgba32f_foregroundColor, _foregroundColor );
-	std::transform( _text.begin(), _text.end(), boost::ptr_container::ptr_back_inserter( _glyphs ), make_glyph( face ) );
-
-	//Step 4. Make Metrics Array --------------------
-	std::transform( _glyphs.begin(), _glyphs.end(), std::back_inserter( _metrics ), terry::make_metric() );
+	fontCache.getGlyphs( *_font, _text, _glyphs, _kerning );
 
-	//Step 5. Make Kerning Array ----------------
-	std::transform( _glyphs.begin(), _glyphs.end(), std::back_inserter( _kerning ), terry::make_kerning() );
+	_metrics.clear();
+	_metrics.reserve( _glyphs.size() );
+	for( std::vector<const TextGlyph*>::const_iterator it = _glyphs.begin(); it != _glyphs.end(); ++it )
+	{
+		_metrics.push_back( (*it)->_metrics );
+	}
 
-	//Step 6. Get Coordinates (x,y) ----------------
+	//Step 3. Get Coordinates (x,y) ----------------
 	_textSize.x   = std::for_each( _metrics.begin(), _metrics.end(), _kerning.begin(), terry::make_width() );
 	_textSize.y   = std::for_each( _metrics.begin(), _metrics.end(), terry::make_height() );
 
@@ -274,7 +237,7 @@ void TextProcess<View, Functor>::multiThreadProcessImages( const OfxRectI& procW
 		merge_views( this->_dstView, _srcView, this->_dstView, Functor() );
 	}
 	
-	//Step 7. Render Glyphs ------------------------
+	//Step 4. Blend Glyphs ------------------------
 	// if outside dstRod
 	// ...
 	// else
@@ -294,7 +257,7 @@ void TextProcess<View, Functor>::multiThreadProcessImages( const OfxRectI& procW
 	View tmpDstViewForGlyphs = subimage_view( _dstViewForGlyphs, _textCorner.x, _textCorner.y, _textSize.x, _textSize.y);
 	
 	std::for_each( _glyphs.begin(), _glyphs.end(), _kerning.begin(),
-	               render_glyph<View>( tmpDstViewForGlyphs, _foregroundColor, _params._letterSpacing, Rect<std::ptrdiff_t>(textLocalRoi) )
+	               render_cached_glyph<View>( tmpDstViewForGlyphs, _foregroundColor, _params._letterSpacing, Rect<std::ptrdiff_t>(textLocalRoi) )
 	               );
 }
 
@@ -28,6 +28,8 @@ LibAVVideoReader::LibAVVideoReader()
 	, _width( 0 )
 	, _height( 0 )
 	, _aspect( 1.0 )
+	, _bitRate( 0 )
+	, _threadCount( 0 )
 	, _offsetTime( true )
 	, _lastSearchPos( -1 )
 	, _lastDecodedPos( -1 )
@@ -188,6 +190,20 @@ bool LibAVVideoReader::read( const int frame )
 		av_free_packet( &_pkt );
 	}
 
+	// With frame threading, the last pictures are still in the decoder
+	// at the end of the stream, so flush them with empty packets.
+	if( !hasPicture && hasFrameThreading() )
+	{
+		for( int i = 0; i < getVideoStream()->codec->thread_count && !hasPicture; ++i )
+		{
+			av_init_packet( &_pkt );
+			_pkt.data = NULL;
+			_pkt.size = 0;
+			_pkt.stream_index = _videoIdx[_currVideoIdx];
+			hasPicture = decodeImage( frameNumber );
+		}
+	}
+
 	_lastDecodedFrame = frameNumber;
 
 	return true;
@@ -196,6 +212,7 @@ bool LibAVVideoReader::read( const int frame )
 bool LibAVVideoReader::setupStreamInfo()
 {
 	_currVideoIdx = -1;
+	_videoIdx.clear();
 	for( std::size_t i = 0; i < _avFormatOptions->nb_streams; ++i )
 	{
 		AVCodecContext* codecContext = _avFormatOptions->streams[i]->codec;
@@ -322,6 +339,13 @@ void LibAVVideoReader::openVideoCodec()
 	{
 		AVCodecContext* codecContext = stream->codec;
 		_videoCodec = avcodec_find_decoder( codecContext->codec_id );
+		if( _videoCodec )
+		{
+			// frame threading gives the best throughput on intra-only codecs (ProRes, DNxHD...),
+			// codecs without frame threading support use slice threading.
+			codecContext->thread_count = _threadCount;
+			codecContext->thread_type  = FF_THREAD_FRAME | FF_THREAD_SLICE;
+		}
 		if( _videoCodec == NULL || avcodec_open2( codecContext, _videoCodec, NULL ) < 0 )
 		{
 			_currVideoIdx = -1;
@@ -350,6 +374,27 @@ boost::int64_t LibAVVideoReader::getTimeStamp( int pos ) const
 	return timestamp;
 }
 
+int LibAVVideoReader::timestampToPosition( const boost::int64_t timestamp ) const
+{
+	double pts = 0;
+	if( timestamp != (int64_t)AV_NOPTS_VALUE )
+	{
+		pts = av_q2d( _avFormatOptions->streams[_videoIdx[_currVideoIdx]]->time_base ) * timestamp;
+	}
+	int pos = int(pts * fps() + 0.5f);
+	if( _avFormatOptions->start_time != (int64_t)AV_NOPTS_VALUE )
+		pos -= int(_avFormatOptions->start_time * fps() / AV_TIME_BASE);
+	return pos;
+}
+
+bool LibAVVideoReader::hasFrameThreading()
+{
+	AVStream* stream = getVideoStream();
+	return stream && stream->codec &&
+		( stream->codec->active_thread_type & FF_THREAD_FRAME ) &&
+		stream->codec->thread_count > 1;
+}
+
 bool LibAVVideoReader::seek( const std::size_t pos )
 {
 	boost::int64_t offset = getTimeStamp( pos );
@@ -403,8 +448,11 @@ bool LibAVVideoReader::decodeImage( const int frame )
 		return false;
 
 	AVCodecContext* codecContext = stream->codec;
-	if( curPos >= frame )
+	const bool frameThreading = hasFrameThreading();
+	if( curPos >= frame || frameThreading )
 	{
+		// with frame threading, all packets need to go through the decoder,
+		// the picture we get back may come from a previous packet.
 		#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT( 52, 21, 0 )
 		avcodec_decode_video2( codecContext, _avFrame, &hasPicture, &_pkt );
 		#else
@@ -425,7 +473,19 @@ bool LibAVVideoReader::decodeImage( const int frame )
 		return false;
 	}
 
-	_lastDecodedPos = _lastSearchPos;
+	if( frameThreading )
+	{
+		const int picturePos = timestampToPosition( _avFrame->pkt_dts );
+		if( picturePos < frame )
+		{
+			return false;
+		}
+		_lastDecodedPos = picturePos;
+	}
+	else
+	{
+		_lastDecodedPos = _lastSearchPos;
+	}
 
 	AVPicture output;
 	avpicture_fill( &output, &_data[0], PIX_FMT_RGB24, _width, _height );
@@ -26,6 +26,20 @@ public:
 	void close();
 	bool read( const int frame );
 
+	/**
+	 * @brief Number of threads used by the decoder (frame and slice threading).
+	 * Needs to be set before opening the file, 0 lets libav choose.
+	 */
+	void setThreadCount( const int threadCount )
+	{
+		_threadCount = threadCount;
+	}
+
+	int getThreadCount() const
+	{
+		return _threadCount;
+	}
+
 private:
 	bool setupStreamInfo();
 
@@ -54,6 +68,15 @@ private:
 	 * @param the number of the current frame
 	 */
 	bool decodeImage( const int frame );
+	/**
+	 * @brief Convert a stream timestamp into a frame position.
+	 */
+	int timestampToPosition( const boost::int64_t timestamp ) const;
+	/**
+	 * @brief Is the opened decoder running with frame threading,
+	 * so returning pictures with a delay of some packets.
+	 */
+	bool hasFrameThreading();
 
 public:
 	int width() const
@@ -169,6 +192,7 @@ public: // private:
 	int _height;
 	double _aspect;
 	int _bitRate;
+	int _threadCount;
 	std::vector<unsigned char> _data;
 	bool _offsetTime;
 	int _lastSearchPos;
@@ -41,6 +41,7 @@ LibAVVideoWriter::LibAVVideoWriter()
 	, _height            ( 0 )
 	, _aspectRatio       ( 1 )
 	, _out_pixelFormat   ( PIX_FMT_YUV420P )
+	, _threadCount       ( 0 )
 	, _fps               ( 25.0f )
 	, _formatName        ( "" )
 	, _videoCodecName    ( "" )
@@ -265,6 +266,8 @@ bool LibAVVideoWriter::finishInit()
 		TUTTLE_LOG_ERROR( "avWriter: auto-selecting " << av_get_pix_fmt_name(_out_pixelFormat) );
 	}
 	_stream->codec->pix_fmt     = _out_pixelFormat;
+	_stream->codec->thread_count = _threadCount;
+	_stream->codec->thread_type  = FF_THREAD_FRAME | FF_THREAD_SLICE;
 	
 	if( !strcmp( _avFormatOptions->oformat->name, "mp4" ) || !strcmp( _avFormatOptions->oformat->name, "mov" ) || !strcmp( _avFormatOptions->oformat->name, "3gp" ) || !strcmp( _avFormatOptions->oformat->name, "flv" ) )
 		_stream->codec->flags |= CODEC_FLAG_GLOBAL_HEADER;
@@ -430,6 +433,7 @@ void LibAVVideoWriter::finish()
 	
 	int ret = 0;
 
+	// the encoder keeps the delayed frames (B-frames, frame threading) until it is flushed
 	for( _hasFrame = 1; _hasFrame; )
 	{
 		TUTTLE_TLOG( TUTTLE_TRACE, "encode last frames ..." );
@@ -443,30 +447,43 @@ void LibAVVideoWriter::finish()
 		ret = avcodec_encode_video2( _stream->codec, &pkt, NULL, &_hasFrame );
 		if( ret < 0 )
 		{
-			TUTTLE_LOG_ERROR( "avWriter: error writing packet to file" );
-			TUTTLE_LOG_ERROR( getErrorStr(ret) );
+			TUTTLE_LOG_ERROR( "avWriter: error encoding the last frames" );
 			break;
 		}
 		
 		if( _hasFrame )
 		{
-			TUTTLE_LOG_ERROR( "write packet" );
 			ret = av_interleaved_write_frame( _avFormatOptions, &pkt );
-			if ( ret < 0 )
+			av_free_packet( &pkt );
+			if( ret < 0 )
 			{
-				BOOST_THROW_EXCEPTION( exception::File()
-					<< exception::user( "avWriter: error writing packet to file" ) );
+				TUTTLE_LOG_ERROR( "avWriter: error writing packet to file" );
+				break;
 			}
-			av_free_packet( &pkt );
 		}
 	}
 	
-	av_write_trailer( _avFormatOptions );
+	if( ret >= 0 )
+		ret = av_write_trailer( _avFormatOptions );
 	avcodec_close( _stream->codec );
 	if( !( _avFormatOptions->oformat->flags & AVFMT_NOFILE ) )
+	{
+		// the packets are buffered, the write errors are only known once they are flushed
+		avio_flush( _avFormatOptions->pb );
+		if( ret >= 0 && _avFormatOptions->pb->error < 0 )
+			ret = _avFormatOptions->pb->error;
 		avio_close( _avFormatOptions->pb );
+	}
 	freeFormat();
+	_statusCode = eWriterStatusIgnoreFinish;
 	
+	if( ret < 0 )
+	{
+		TUTTLE_LOG_ERROR( getErrorStr( ret ) );
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "avWriter: unable to write the end of the file." )
+			<< exception::filename( getFilename() ) );
+	}
 }
 
 void LibAVVideoWriter::freeFormat()
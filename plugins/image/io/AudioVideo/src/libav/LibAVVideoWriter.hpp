@@ -37,6 +37,10 @@ public:
 	int  start( );
 	bool finishInit();
 	int  execute( boost::uint8_t* const in_buffer, const int in_width, const int height, const PixelFormat in_fmt = PIX_FMT_RGB24 );
+	/**
+	 * @brief Flush the encoder and close the file.
+	 * @throw exception::File if the end of the file can't be written
+	 */
 	void finish();
 
 private:
@@ -103,6 +107,20 @@ public:
 	{
 		return _out_pixelFormat;
 	}
+
+	/**
+	 * @brief Number of threads used by the encoder, 0 lets libav choose.
+	 * Needs to be set before finishInit().
+	 */
+	void setThreadCount( const int threadCount )
+	{
+		_threadCount = threadCount;
+	}
+
+	int getThreadCount() const
+	{
+		return _threadCount;
+	}
 	
 	const std::string& getFormat() const
 	{
@@ -240,6 +258,7 @@ private:
 	int                            _height;
 	double                         _aspectRatio;
 	PixelFormat                    _out_pixelFormat;
+	int                            _threadCount;
 	
 	double                          _fps;
 	std::string                    _formatName;
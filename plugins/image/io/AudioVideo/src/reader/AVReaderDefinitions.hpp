@@ -21,6 +21,8 @@ static const std::string kParamMetaDetailledGroup        = "metaDetailledGroup";
 static const std::string kParamUseCustomSAR = "useCustomSAR";
 static const std::string kParamCustomSAR = "customSAR";
 
+static const std::string kParamThreadCount = "threadCount";
+
 }
 }
 }
@@ -28,6 +28,7 @@ AVReaderPlugin::AVReaderPlugin( OfxImageEffectHandle handle )
 	_paramBitDepth = fetchChoiceParam( kTuttlePluginBitDepth );
 	_paramUseCustomSAR = fetchBooleanParam( kParamUseCustomSAR );
 	_paramCustomSAR = fetchDoubleParam( kParamCustomSAR );
+	_paramThreadCount = fetchIntParam( kParamThreadCount );
 
 	updateVisibleTools();
 }
@@ -59,6 +60,7 @@ bool AVReaderPlugin::ensureVideoIsOpen()
 	// if we have not already tried
 	if( !_errorInFile )
 	{
+		_reader.setThreadCount( _paramThreadCount->getValue() );
 		_errorInFile = !_reader.open( _paramFilepath->getValue() );
 	}
 	return !_errorInFile;
@@ -71,6 +73,12 @@ void AVReaderPlugin::changedParam( const OFX::InstanceChangedArgs& args, const s
 	{
 		_errorInFile = false;
 	}
+	else if( paramName == kParamThreadCount )
+	{
+		// the decoder threads are setup when opening the codec
+		_reader.close();
+		_errorInFile = false;
+	}
 	else if( paramName == kParamUseCustomSAR )
 	{
 		const bool useCustomSAR = _paramUseCustomSAR->getValue();
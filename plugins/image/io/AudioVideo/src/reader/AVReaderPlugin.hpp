@@ -49,6 +49,7 @@ public:
 	OFX::StringParam*  _paramFilepath;     ///< video filepath
 	OFX::BooleanParam* _paramUseCustomSAR; ///< Keep sample aspect ratio
 	OFX::DoubleParam*  _paramCustomSAR;    ///< Custom SAR to use
+	OFX::IntParam*     _paramThreadCount;  ///< Number of decoding threads
 
 	bool               _errorInFile;
 	bool               _initReader;
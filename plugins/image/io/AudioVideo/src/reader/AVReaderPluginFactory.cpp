@@ -10,6 +10,9 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/classification.hpp>
 
+#include <ofxsMultiThread.h>
+
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -133,6 +136,16 @@ void AVReaderPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
 	customSAR->setLabel( "Custom SAR" );
 	customSAR->setDefault( 1.0 );
 	customSAR->setHint( "Choose a custom value to override the file SAR (Storage Aspect Ratio)." );
+
+	OFX::IntParamDescriptor* threadCount = desc.defineIntParam( kParamThreadCount );
+	threadCount->setLabel( "Decoding Threads" );
+	threadCount->setDefault( OFX::MultiThread::getNumCPUs() );
+	threadCount->setRange( 0, std::numeric_limits<int>::max() );
+	threadCount->setDisplayRange( 0, 32 );
+	threadCount->setHint( "Number of threads used to decode the video (frame and slice threading).\n"
+		"0: let libav choose.\n"
+		"Overrides the libav 'threads' option." );
+	threadCount->setParent( videoGroup );
 }
 
 /**
@@ -73,6 +73,8 @@ enum EParamFilter
 	eParamFilterSpline
 };
 
+static const std::string kParamThreadCount           = "threadCount";
+
 }
 }
 }
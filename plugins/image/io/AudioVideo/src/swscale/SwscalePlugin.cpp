@@ -65,6 +65,8 @@ SwscalePlugin::SwscalePlugin( OfxImageEffectHandle handle )
 	_paramSizeKeepRatio   = fetchBooleanParam  ( kParamSizeKeepRatio );
 
 	_paramFilter          = fetchChoiceParam   ( kParamFilter );
+
+	_paramThreadCount     = fetchIntParam      ( kParamThreadCount );
 	
 	updateVisibleTools();
 }
@@ -85,6 +87,7 @@ SwscaleProcessParams SwscalePlugin::getProcessParams( const OfxPointD& renderSca
 	
 	params._filter = static_cast<EParamFilter>( _paramFilter-> getValue() );
 	params._sws_filter = filterParamToSwscaleFlag( params._filter );
+	params._threadCount = _paramThreadCount->getValue();
 	
 	return params;
 }
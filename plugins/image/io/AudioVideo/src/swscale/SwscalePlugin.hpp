@@ -14,6 +14,7 @@ struct SwscaleProcessParams
 {
 	EParamFilter _filter;
 	int _sws_filter;
+	int _threadCount;
 };
 
 /**
@@ -59,6 +60,8 @@ public:
 	
 	OFX::ChoiceParam*       _paramFilter;
 
+	OFX::IntParam*          _paramThreadCount;
+
 };
 
 }
@@ -4,6 +4,8 @@
 
 #include <tuttle/plugin/context/SamplerPluginFactory.hpp>
 
+#include <ofxsMultiThread.h>
+
 #include <limits>
 
 
@@ -143,6 +145,14 @@ void SwscalePluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
 	filter->appendOption( kParamFilterLanczos );
 	filter->appendOption( kParamFilterSpline );
 	filter->setDefault( eParamFilterBicubic );
+
+	OFX::IntParamDescriptor* threadCount = desc.defineIntParam( kParamThreadCount );
+	threadCount->setLabel( "Threads" );
+	threadCount->setDefault( OFX::MultiThread::getNumCPUs() );
+	threadCount->setRange( 0, std::numeric_limits<int>::max() );
+	threadCount->setDisplayRange( 0, 32 );
+	threadCount->setHint( "Number of threads used to scale the image, each thread processes a slice of rows.\n"
+		"0: use all host threads." );
 }
 
 /**
@@ -1,22 +1,27 @@
 #include "SwscaleProcess.hpp"
 
+#include <boost/math/common_factor_rt.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 namespace tuttle {
 namespace plugin {
 namespace swscale {
 
+/// Minimal number of source rows scaled on each side of a slice (per downscale factor).
+/// It covers the vertical support of all swscale filters.
+static const int kSliceMarginRows = 16;
+
 SwscaleProcess::SwscaleProcess( SwscalePlugin &effect )
 : ImageFilterProcessor( effect, eImageOrientationFromTopToBottom )
 , _plugin( effect )
-, _context( NULL )
-{
-	this->setNoMultiThreading();
-}
-
-
-void SwscaleProcess::setup( const OFX::RenderArguments& args )
+, _pixelFormat( PIX_FMT_NONE )
+, _srcRowsStep( 1 )
+, _dstRowsStep( 1 )
+, _marginSteps( 0 )
 {
-	ImageFilterProcessor::setup( args );
-	_params = _plugin.getProcessParams( args.renderScale );
 }
 
 PixelFormat ofxPixelComponentToSwsPixelFormat( const OFX::EPixelComponent component, const OFX::EBitDepth bitDepth )
@@ -70,42 +75,53 @@ PixelFormat ofxPixelComponentToSwsPixelFormat( const OFX::EPixelComponent compon
 	return PIX_FMT_NONE;
 }
 
-/**
- * @brief Function called by rendering thread each time a process must be done.
- * @param[in] procWindowRoW  Processing window
- */
-void SwscaleProcess::multiThreadProcessImages( const OfxRectI& procWindow )
+void SwscaleProcess::setup( const OFX::RenderArguments& args )
 {
-	OFX::EPixelComponent component = this->_src->getPixelComponents();
-	OFX::EBitDepth bitDepth = this->_src->getPixelDepth();
-	PixelFormat pixFmt = ofxPixelComponentToSwsPixelFormat( component, bitDepth );
+	ImageFilterProcessor::setup( args );
+	_params = _plugin.getProcessParams( args.renderScale );
 
-	if( pixFmt == PIX_FMT_NONE )
+	_pixelFormat = ofxPixelComponentToSwsPixelFormat( this->_src->getPixelComponents(), this->_src->getPixelDepth() );
+	if( _pixelFormat == PIX_FMT_NONE )
 	{
 		BOOST_THROW_EXCEPTION( exception::BitDepthMismatch()
 			<< exception::user( "SwScale: unsupported bit depth / channel input." ) );
 	}
-	
-	_context = sws_getCachedContext( _context,
-			this->_src->getBoundsSize().x, this->_src->getBoundsSize().y,
-			pixFmt,
-			this->_dst->getBoundsSize().x, this->_dst->getBoundsSize().y,
-			pixFmt,
-			_params._sws_filter,
-			NULL, NULL, NULL );
-	if ( !_context )
+
+	_srcSize = this->_src->getBoundsSize();
+	_dstSize = this->_dst->getBoundsSize();
+
+	// source and destination rows coincide every gcd( srcHeight, dstHeight ) rows
+	const int commonRows = boost::math::gcd( _srcSize.y, _dstSize.y );
+	_srcRowsStep = _srcSize.y / commonRows;
+	_dstRowsStep = _dstSize.y / commonRows;
+
+	const int srcMarginRows = kSliceMarginRows * std::max( 1, _srcSize.y / _dstSize.y );
+	_marginSteps = ( srcMarginRows + _srcRowsStep - 1 ) / _srcRowsStep;
+
+	if( _dstRowsStep * 2 > _dstSize.y )
 	{
-		BOOST_THROW_EXCEPTION( exception::Failed()
-			<< exception::user( "swscale: Could not get swscale context." ) );
+		// can't cut the image in multiple slices
+		this->setNoMultiThreading();
 	}
+	else
+	{
+		this->setNbThreads( _params._threadCount );
+	}
+}
 
-	// set filtering mode
-	// @todo: sws set filtermode( _params._sws_filter )
-
-	// for tile support... (currently disabled)
-//	void* srcPtr = this->_src->getPixelAddress( procWindow.x1, procWindow.y1 );
-//	void* dstPtr = this->_dst->getPixelAddress( procWindow.x1, procWindow.y1 );
+int SwscaleProcess::alignSliceRow( const int row ) const
+{
+	if( row >= _dstSize.y )
+		return _dstSize.y;
+	return ( row / _dstRowsStep ) * _dstRowsStep;
+}
 
+/**
+ * @brief Function called by rendering thread each time a process must be done.
+ * @param[in] procWindowRoW  Processing window
+ */
+void SwscaleProcess::multiThreadProcessImages( const OfxRectI& procWindow )
+{
 	// for simple buffer access
 	uint8_t* srcPtr = (uint8_t*)this->_src->getPixelData();
 	uint8_t* dstPtr = (uint8_t*)this->_dst->getPixelData();
@@ -120,20 +136,59 @@ void SwscaleProcess::multiThreadProcessImages( const OfxRectI& procWindow )
 
 	int srcStride = this->_src->getRowDistanceBytes();
 	int dstStride = this->_dst->getRowDistanceBytes();
-	int ret = sws_scale( _context, &srcPtr, &srcStride, 0,
-			this->_src->getBoundsSize().y, &dstPtr, &dstStride );
+
+	// rows of the slice in the destination buffer
+	const int dstBoundsY1 = this->_dst->getBounds().y1;
+	const int y1 = alignSliceRow( procWindow.y1 - dstBoundsY1 );
+	const int y2 = alignSliceRow( procWindow.y2 - dstBoundsY1 );
+	if( y1 >= y2 )
+		return;
+
+	// rows scaled by this thread, with margins
+	const int marginRows = _marginSteps * _dstRowsStep;
+	const int dstY1 = std::max( 0, y1 - marginRows );
+	const int dstY2 = std::min( _dstSize.y, y2 + marginRows );
+	const int srcY1 = ( dstY1 / _dstRowsStep ) * _srcRowsStep;
+	const int srcY2 = ( dstY2 / _dstRowsStep ) * _srcRowsStep;
+
+	struct SwsContext* context = sws_getContext(
+			_srcSize.x, srcY2 - srcY1,
+			_pixelFormat,
+			_dstSize.x, dstY2 - dstY1,
+			_pixelFormat,
+			_params._sws_filter,
+			NULL, NULL, NULL );
+	if ( !context )
+	{
+		BOOST_THROW_EXCEPTION( exception::Failed()
+			<< exception::user( "swscale: Could not get swscale context." ) );
+	}
+
+	// margins are scaled into a temporary buffer, they belong to other threads
+	const bool hasMargins = ( dstY1 != y1 || dstY2 != y2 );
+	std::vector<uint8_t> sliceBuffer;
+	uint8_t* srcSlicePtr = srcPtr + srcY1 * srcStride;
+	uint8_t* dstSlicePtr = dstPtr + y1 * dstStride;
+	if( hasMargins )
+	{
+		sliceBuffer.resize( ( dstY2 - dstY1 ) * dstStride );
+		dstSlicePtr = &sliceBuffer[0];
+	}
+
+	const int ret = sws_scale( context, &srcSlicePtr, &srcStride, 0,
+			srcY2 - srcY1, &dstSlicePtr, &dstStride );
+	sws_freeContext( context );
 	if ( ret < 0 )
 		BOOST_THROW_EXCEPTION( exception::Failed()
 			<< exception::user( "swscale: Scaling failed." )
 			<< exception::dev( ret ) );
-}
 
-void SwscaleProcess::postProcess()
-{
-	sws_freeContext( _context );
+	if( hasMargins )
+	{
+		std::memcpy( dstPtr + y1 * dstStride, &sliceBuffer[( y1 - dstY1 ) * dstStride], ( y2 - y1 ) * dstStride );
+	}
 }
 
-
 }
 }
 }
@@ -12,13 +12,22 @@ namespace swscale {
 /**
  * @brief Swscale process
  *
+ * Each thread scales a slice of rows with its own swscale context.
+ * Slices start on rows where the source and destination grids coincide,
+ * and are scaled with some extra rows around them, so the result is the
+ * same as scaling the full image at once.
  */
 class SwscaleProcess : public ImageFilterProcessor
 {
 protected:
 	SwscalePlugin&       _plugin; ///< Rendering plugin
 	SwscaleProcessParams _params; ///< parameters
-	struct SwsContext*   _context;
+	PixelFormat          _pixelFormat;
+	OfxPointI            _srcSize;
+	OfxPointI            _dstSize;
+	int                  _srcRowsStep;  ///< number of source rows between two aligned slice borders
+	int                  _dstRowsStep;  ///< number of destination rows between two aligned slice borders
+	int                  _marginSteps;  ///< number of rows steps scaled around each slice
 
 public:
 	SwscaleProcess( SwscalePlugin& effect );
@@ -26,8 +35,9 @@ public:
 	void setup( const OFX::RenderArguments& args );
 
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
-	
-	void postProcess();
+
+private:
+	int alignSliceRow( const int row ) const;
 };
 
 }
@@ -37,6 +37,7 @@ static const std::string kParamAudioPreset               = "audioPreset";
 static const std::string kParamUseCustomFps              = "useCustomFps";
 static const std::string kParamCustomFps                 = "customFps";
 static const std::string kParamVideoCodecPixelFmt        = "videoPixelFormat";
+static const std::string kParamThreadCount               = "threadCount";
 
 }
 }
@@ -184,6 +184,7 @@ AVWriterPlugin::AVWriterPlugin( OfxImageEffectHandle handle )
 	_paramCustomFps        = fetchDoubleParam( kParamCustomFps );
 	
 	_paramVideoPixelFormat = fetchChoiceParam( kParamVideoCodecPixelFmt );
+	_paramThreadCount      = fetchIntParam( kParamThreadCount );
 	
 	std::string formatName = _writer.getFormatsShort( ).at(_paramFormat->getValue() );
 	disableAVOptionsForCodecOrFormat( _writer.getFormatPrivOpts(), formatName );
@@ -206,6 +207,7 @@ AVProcessParams AVWriterPlugin::getProcessParams()
 	params._videoCodec                     = _paramVideoCodec        ->getValue();
 	params._audioCodec                     = _paramAudioCodec        ->getValue();
 	params._videoPixelFormat               = static_cast<PixelFormat>( _paramVideoPixelFormat->getValue() );
+	params._threadCount                    = _paramThreadCount       ->getValue();
 	
 	_writer.setVideoCodec( params._videoCodec );
 
@@ -362,6 +364,7 @@ void AVWriterPlugin::beginSequenceRender( const OFX::BeginSequenceRenderArgument
 	}
 	_writer.setAspectRatio ( _clipSrc->getPixelAspectRatio() );
 	_writer.setPixelFormat ( params._videoPixelFormat );
+	_writer.setThreadCount ( params._threadCount );
 }
 
 /**
@@ -419,8 +422,9 @@ void AVWriterPlugin::render( const OFX::RenderArguments& args )
 
 void AVWriterPlugin::endSequenceRender( const OFX::EndSequenceRenderArguments& args )
 {
-	_writer.finish();
+	// the next sequence reopens the file, even if the end of this one can't be written
 	_initWriter = false;
+	_writer.finish();
 }
 
 }
@@ -28,6 +28,7 @@ struct AVProcessParams
 	int         _audioPreset; ///< video configuration (based on the video codec)
 	
 	PixelFormat _videoPixelFormat; /// videoPixelFormat
+	int         _threadCount;      ///< Number of encoding threads
 };
 
 /**
@@ -66,6 +67,7 @@ public:
 	OFX::BooleanParam*  _paramUseCustomFps;
 	OFX::DoubleParam*   _paramCustomFps;
 	OFX::ChoiceParam*   _paramVideoPixelFormat;
+	OFX::IntParam*      _paramThreadCount;
 	
 	LibAVVideoWriter    _writer;
 	bool                _initWriter;
@@ -16,6 +16,9 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/classification.hpp>
 
+#include <ofxsMultiThread.h>
+
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -254,6 +257,16 @@ void AVWriterPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
 	}
 	videoCodecPixelFmt->setParent( videoGroup );
 	
+	OFX::IntParamDescriptor* threadCount = desc.defineIntParam( kParamThreadCount );
+	threadCount->setLabel( "Encoding Threads" );
+	threadCount->setDefault( OFX::MultiThread::getNumCPUs() );
+	threadCount->setRange( 0, std::numeric_limits<int>::max() );
+	threadCount->setDisplayRange( 0, 32 );
+	threadCount->setHint( "Number of threads used to encode the video (frame and slice threading).\n"
+		"0: let libav choose.\n"
+		"Overrides the libav 'threads' option." );
+	threadCount->setParent( videoGroup );
+	
 	AVCodecContext* avCodecContext;
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT( 53, 8, 0 )
 	avCodecContext = avcodec_alloc_context();
@@ -0,0 +1,35 @@
+#define BOOST_TEST_MODULE plugin_AudioVideo
+#include <tuttle/test/main.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <tuttle/host/Graph.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+namespace bfs = boost::filesystem;
+
+BOOST_AUTO_TEST_SUITE( plugin_AudioVideo_writer )
+
+BOOST_AUTO_TEST_CASE( process_writer_flush_error )
+{
+	TUTTLE_LOG_INFO( "******** PROCESS WRITER tuttle.avwriter FLUSH ERROR ********" );
+	// the writes to /dev/full fail (no space left on device),
+	// the packets of a small image are only written when the file is closed
+	if( ! bfs::exists( "/dev/full" ) )
+		return;
+
+	Graph g;
+	Graph::Node& constant = g.createNode( "tuttle.constant" );
+	Graph::Node& writer   = g.createNode( "tuttle.avwriter" );
+	constant.getParam( "width" ).setValue( 64 );
+	constant.getParam( "height" ).setValue( 48 );
+	writer.getParam( "filename" ).setValue( "/dev/full" );
+	g.connect( constant, writer );
+
+	BOOST_REQUIRE_THROW( g.compute( writer ), boost::exception );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
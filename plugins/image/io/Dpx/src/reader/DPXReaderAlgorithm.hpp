@@ -0,0 +1,201 @@
+#ifndef _TUTTLE_PLUGIN_DPXREADER_ALGORITHM_HPP_
+#define _TUTTLE_PLUGIN_DPXREADER_ALGORITHM_HPP_
+
+#ifndef __SSSE3__
+#include <emmintrin.h>
+#else
+// SSSE3
+#include <tmmintrin.h>
+#endif
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace reader {
+
+/**
+ * @brief Packing of 10 bits RGB pixels filled in 32 bits words.
+ * Method A puts the 2 padding bits at the end of the word (LSB),
+ * method B puts them at the beginning (MSB).
+ */
+enum EDpxFilledMethod
+{
+	eDpxFilledMethodA = 1,
+	eDpxFilledMethodB = 2
+};
+
+namespace detail {
+
+inline boost::uint32_t swapWord( const boost::uint32_t word )
+{
+	return ( word >> 24 ) | ( ( word >> 8 ) & 0x0000ff00 ) | ( ( word << 8 ) & 0x00ff0000 ) | ( word << 24 );
+}
+
+inline __m128i swapWords( const __m128i words )
+{
+#ifdef __SSSE3__
+	const __m128i mask = _mm_set_epi8( 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3 );
+	return _mm_shuffle_epi8( words, mask );
+#else
+	// swap bytes inside 16 bits, then swap the 16 bits halves
+	const __m128i swapped16 = _mm_or_si128( _mm_slli_epi16( words, 8 ), _mm_srli_epi16( words, 8 ) );
+	return _mm_shufflehi_epi16( _mm_shufflelo_epi16( swapped16, _MM_SHUFFLE( 2, 3, 0, 1 ) ), _MM_SHUFFLE( 2, 3, 0, 1 ) );
+#endif
+}
+
+/**
+ * @brief Extract the 3 channels of 4 words, each channel value in a 32 bits lane.
+ */
+inline void extract10Bits( const __m128i words, const __m128i shiftR, const __m128i shiftG, const __m128i shiftB,
+                           __m128i& r, __m128i& g, __m128i& b )
+{
+	const __m128i mask = _mm_set1_epi32( 0x3ff );
+	r = _mm_and_si128( _mm_srl_epi32( words, shiftR ), mask );
+	g = _mm_and_si128( _mm_srl_epi32( words, shiftG ), mask );
+	b = _mm_and_si128( _mm_srl_epi32( words, shiftB ), mask );
+}
+
+inline boost::uint8_t  convert10Bits( const boost::uint32_t v, const boost::uint8_t* )  { return static_cast<boost::uint8_t>( v >> 2 ); }
+inline boost::uint16_t convert10Bits( const boost::uint32_t v, const boost::uint16_t* ) { return static_cast<boost::uint16_t>( ( v << 6 ) | ( v >> 4 ) ); }
+inline float           convert10Bits( const boost::uint32_t v, const float* )           { return v * ( 1.0f / 1023.0f ); }
+
+inline boost::uint8_t  channelMax( const boost::uint8_t* )  { return 0xff; }
+inline boost::uint16_t channelMax( const boost::uint16_t* ) { return 0xffff; }
+inline float           channelMax( const float* )           { return 1.0f; }
+
+/**
+ * @brief Scalar version, used for the end of rows.
+ */
+template<typename Channel, int nbComponents>
+void unpackFilled10BitsPixels( const boost::uint32_t* src, Channel* dst, const std::size_t nbPixels, const int padding, const bool swapEndian )
+{
+	for( std::size_t i = 0; i < nbPixels; ++i )
+	{
+		const boost::uint32_t word = swapEndian ? swapWord( src[i] ) : src[i];
+		dst[0] = convert10Bits( ( word >> ( 20 + padding ) ) & 0x3ff, dst );
+		dst[1] = convert10Bits( ( word >> ( 10 + padding ) ) & 0x3ff, dst );
+		dst[2] = convert10Bits( ( word >> padding ) & 0x3ff, dst );
+		if( nbComponents == 4 )
+			dst[3] = channelMax( dst );
+		dst += nbComponents;
+	}
+}
+
+inline void storeUnpacked( const __m128i r, const __m128i g, const __m128i b, boost::uint8_t* dst, const int nbComponents )
+{
+	const __m128i pixels = _mm_or_si128( _mm_or_si128( _mm_srli_epi32( r, 2 ),
+	                                                   _mm_slli_epi32( _mm_srli_epi32( g, 2 ), 8 ) ),
+	                                     _mm_slli_epi32( _mm_srli_epi32( b, 2 ), 16 ) );
+	if( nbComponents == 4 )
+	{
+		_mm_storeu_si128( (__m128i*)dst, _mm_or_si128( pixels, _mm_set1_epi32( (int)0xff000000 ) ) );
+		return;
+	}
+	boost::uint32_t tmp[4];
+	_mm_storeu_si128( (__m128i*)tmp, pixels );
+	for( int i = 0; i < 4; ++i, dst += 3 )
+	{
+		dst[0] = static_cast<boost::uint8_t>( tmp[i] );
+		dst[1] = static_cast<boost::uint8_t>( tmp[i] >> 8 );
+		dst[2] = static_cast<boost::uint8_t>( tmp[i] >> 16 );
+	}
+}
+
+inline __m128i expand10To16Bits( const __m128i v )
+{
+	return _mm_or_si128( _mm_slli_epi32( v, 6 ), _mm_srli_epi32( v, 4 ) );
+}
+
+inline void storeUnpacked( const __m128i r, const __m128i g, const __m128i b, boost::uint16_t* dst, const int nbComponents )
+{
+	const __m128i rg = _mm_or_si128( expand10To16Bits( r ), _mm_slli_epi32( expand10To16Bits( g ), 16 ) );
+	if( nbComponents == 4 )
+	{
+		const __m128i ba = _mm_or_si128( expand10To16Bits( b ), _mm_set1_epi32( (int)0xffff0000 ) );
+		_mm_storeu_si128( (__m128i*)dst,     _mm_unpacklo_epi32( rg, ba ) );
+		_mm_storeu_si128( (__m128i*)dst + 1, _mm_unpackhi_epi32( rg, ba ) );
+		return;
+	}
+	boost::uint32_t tmpRG[4];
+	boost::uint32_t tmpB[4];
+	_mm_storeu_si128( (__m128i*)tmpRG, rg );
+	_mm_storeu_si128( (__m128i*)tmpB, expand10To16Bits( b ) );
+	for( int i = 0; i < 4; ++i, dst += 3 )
+	{
+		dst[0] = static_cast<boost::uint16_t>( tmpRG[i] );
+		dst[1] = static_cast<boost::uint16_t>( tmpRG[i] >> 16 );
+		dst[2] = static_cast<boost::uint16_t>( tmpB[i] );
+	}
+}
+
+inline void storeUnpacked( const __m128i r, const __m128i g, const __m128i b, float* dst, const int nbComponents )
+{
+	const __m128 scale = _mm_set1_ps( 1.0f / 1023.0f );
+	__m128 vr = _mm_mul_ps( _mm_cvtepi32_ps( r ), scale );
+	__m128 vg = _mm_mul_ps( _mm_cvtepi32_ps( g ), scale );
+	__m128 vb = _mm_mul_ps( _mm_cvtepi32_ps( b ), scale );
+	__m128 va = _mm_set1_ps( 1.0f );
+	// rows of the transposed matrix are RGBA pixels
+	_MM_TRANSPOSE4_PS( vr, vg, vb, va );
+	if( nbComponents == 4 )
+	{
+		_mm_storeu_ps( dst,      vr );
+		_mm_storeu_ps( dst + 4,  vg );
+		_mm_storeu_ps( dst + 8,  vb );
+		_mm_storeu_ps( dst + 12, va );
+		return;
+	}
+	// each store overlaps the red channel of the next pixel, which is rewritten just after,
+	// the last pixel is stored with a scalar copy to stay inside the row.
+	_mm_storeu_ps( dst,     vr );
+	_mm_storeu_ps( dst + 3, vg );
+	_mm_storeu_ps( dst + 6, vb );
+	float last[4];
+	_mm_storeu_ps( last, va );
+	dst[9]  = last[0];
+	dst[10] = last[1];
+	dst[11] = last[2];
+}
+
+}
+
+/**
+ * @brief Unpack a row of 10 bits RGB pixels filled in 32 bits words (DPX packing method A or B)
+ * directly into an interleaved RGB or RGBA row of 8 bits, 16 bits or float channels.
+ * The alpha channel, if any, is filled with the channel maximum.
+ *
+ * @param[in] src 32 bits words of the row, one word per pixel
+ * @param[out] dst first channel of the output row
+ * @param[in] swapEndian words are stored in the opposite endianness of the host
+ */
+template<typename Channel, int nbComponents>
+void unpackFilled10BitsRow( const boost::uint32_t* src, Channel* dst, const std::size_t width, const EDpxFilledMethod method, const bool swapEndian )
+{
+	const int padding = ( method == eDpxFilledMethodA ) ? 2 : 0;
+	const __m128i shiftR = _mm_cvtsi32_si128( 20 + padding );
+	const __m128i shiftG = _mm_cvtsi32_si128( 10 + padding );
+	const __m128i shiftB = _mm_cvtsi32_si128( padding );
+
+	std::size_t x = 0;
+	for( ; x + 4 <= width; x += 4 )
+	{
+		__m128i words = _mm_loadu_si128( (const __m128i*)( src + x ) );
+		if( swapEndian )
+			words = detail::swapWords( words );
+		__m128i r, g, b;
+		detail::extract10Bits( words, shiftR, shiftG, shiftB, r, g, b );
+		detail::storeUnpacked( r, g, b, dst + x * nbComponents, nbComponents );
+	}
+	detail::unpackFilled10BitsPixels<Channel, nbComponents>( src + x, dst + x * nbComponents, width - x, padding, swapEndian );
+}
+
+}
+}
+}
+}
+
+#endif
@@ -2,17 +2,44 @@
 #include "DPXReaderProcess.hpp"
 #include "DPXReaderDefinitions.hpp"
 
+#include <libdpx/DPX.h>
+
 #include <boost/gil/gil_all.hpp>
 #include <boost/filesystem.hpp>
 
+#include <sstream>
+
 namespace tuttle {
 namespace plugin {
 namespace dpx {
 namespace reader {
 
-using namespace boost::filesystem;
-using namespace tuttle::io;
 using namespace boost::gil;
+namespace bfs = boost::filesystem;
+
+namespace {
+
+::dpx::Header readHeader( const std::string& filename )
+{
+	if( ! bfs::exists( filename ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::FileNotExist()
+			<< exception::user( "Dpx: Unable to open file" )
+			<< exception::filename( filename ) );
+	}
+	InStream stream;
+	::dpx::Header header;
+	if( ! stream.Open( filename.c_str() ) || ! header.Read( &stream ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Dpx: Unable to read the header" )
+			<< exception::filename( filename ) );
+	}
+	stream.Close();
+	return header;
+}
+
+}
 
 DPXReaderPlugin::DPXReaderPlugin( OfxImageEffectHandle handle )
 	: ReaderPlugin( handle )
@@ -32,11 +59,27 @@ void DPXReaderPlugin::changedParam( const OFX::InstanceChangedArgs& args, const
 	ReaderPlugin::changedParam( args, paramName );
 	if( paramName == kParamDisplayHeader )
 	{
-		tuttle::io::DpxImage dpxImg;
-		dpxImg.readHeader( getAbsoluteFilenameAt( args.time ) );
+		const ::dpx::Header header = readHeader( getAbsoluteFilenameAt( args.time ) );
 		std::ostringstream headerStr;
 		headerStr << "DPX HEADER:" << std::endl;
-		headerStr << dpxImg.getHeader();
+		char version[9];
+		header.Version( version );
+		headerStr << "version: " << version << std::endl;
+		headerStr << "size: " << header.Width() << "x" << header.Height() << std::endl;
+		headerStr << "orientation: " << int( header.ImageOrientation() ) << std::endl;
+		headerStr << "byte swap: " << header.RequiresByteSwap() << std::endl;
+		for( int i = 0; i < header.ImageElementCount(); ++i )
+		{
+			headerStr << "element " << i << ":" << std::endl;
+			headerStr << "  descriptor: " << int( header.ImageDescriptor( i ) ) << std::endl;
+			headerStr << "  bit depth: " << int( header.BitDepth( i ) ) << std::endl;
+			headerStr << "  packing: " << int( header.ImagePacking( i ) ) << std::endl;
+			headerStr << "  encoding: " << int( header.ImageEncoding( i ) ) << std::endl;
+			headerStr << "  transfer: " << int( header.Transfer( i ) ) << std::endl;
+			headerStr << "  colorimetric: " << int( header.Colorimetric( i ) ) << std::endl;
+			headerStr << "  data offset: " << header.DataOffset( i ) << std::endl;
+			headerStr << "  end of line padding: " << header.EndOfLinePadding( i ) << std::endl;
+		}
 
 		TUTTLE_TLOG( TUTTLE_INFO, headerStr.str() );
 
@@ -48,45 +91,33 @@ void DPXReaderPlugin::changedParam( const OFX::InstanceChangedArgs& args, const
 
 bool DPXReaderPlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod )
 {
-	tuttle::io::DpxImage dpxImg;
+	const ::dpx::Header header = readHeader( getAbsoluteFilenameAt( args.time ) );
 
-	dpxImg.readHeader( getAbsoluteFilenameAt( args.time ) );
 	rod.x1 = 0;
-	rod.x2 = dpxImg.width() * this->_clipDst->getPixelAspectRatio();
+	rod.x2 = header.Width() * this->_clipDst->getPixelAspectRatio();
 	rod.y1 = 0;
-	rod.y2 = dpxImg.height();
+	rod.y2 = header.Height();
 	return true;
 }
 
 void DPXReaderPlugin::getClipPreferences( OFX::ClipPreferencesSetter& clipPreferences )
 {
 	ReaderPlugin::getClipPreferences( clipPreferences );
-	const std::string filename( getAbsoluteFirstFilename() );
+	const ::dpx::Header header = readHeader( getAbsoluteFirstFilename() );
 
-	DpxImage dpxImg;
-	dpxImg.readHeader( filename );
-
-	if( getExplicitConversion() == eParamReaderExplicitConversionAuto )
+	if( getExplicitBitDepthConversion() == eParamReaderBitDepthAuto )
 	{
 		OFX::EBitDepth bd = OFX::eBitDepthNone;
-		switch( dpxImg.componentsType() )
+		switch( header.BitDepth( 0 ) )
 		{
-			case DpxImage::eCompTypeR8G8B8:
-			case DpxImage::eCompTypeR8G8B8A8:
-			case DpxImage::eCompTypeA8B8G8R8:
+			case 8:
 			{
 				bd = OFX::eBitDepthUByte;
 				break;
 			}
-			case DpxImage::eCompTypeR10G10B10:
-			case DpxImage::eCompTypeR10G10B10A10:
-			case DpxImage::eCompTypeA10B10G10R10:
-			case DpxImage::eCompTypeR12G12B12:
-			case DpxImage::eCompTypeR12G12B12A12:
-			case DpxImage::eCompTypeA12B12G12R12:
-			case DpxImage::eCompTypeR16G16B16:
-			case DpxImage::eCompTypeR16G16B16A16:
-			case DpxImage::eCompTypeA16B16G16R16:
+			case 10:
+			case 12:
+			case 16:
 			{
 				bd = OFX::eBitDepthUShort;
 				break;
@@ -97,19 +128,14 @@ void DPXReaderPlugin::getClipPreferences( OFX::ClipPreferencesSetter& clipPrefer
 
 		clipPreferences.setClipBitDepth( *_clipDst, bd );
 	}
-	switch( dpxImg.components() )
+	// the process only renders RGB and RGBA
+	switch( header.ImageElementComponentCount( 0 ) )
 	{
 		case 3:
 		{
 			clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGB );
 			break;
 		}
-
-		case 4:
-		{
-			clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGBA );
-			break;
-		}
 		default:
 		{
 			clipPreferences.setClipComponents( *this->_clipDst, OFX::ePixelComponentRGBA );
@@ -119,6 +145,7 @@ void DPXReaderPlugin::getClipPreferences( OFX::ClipPreferencesSetter& clipPrefer
 
 	clipPreferences.setPixelAspectRatio( *this->_clipDst, 1.0 );
 }
+
 /**
  * @brief The overridden render function
  * @param[in]   args     Rendering parameters
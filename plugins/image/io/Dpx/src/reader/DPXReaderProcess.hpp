@@ -1,13 +1,18 @@
 #ifndef _TUTTLE_PLUGIN_DPX_READER_PROCESS_HPP_
 #define _TUTTLE_PLUGIN_DPX_READER_PROCESS_HPP_
 
+#include "DPXReaderAlgorithm.hpp"
+
+#include <libdpx/DPX.h>
+
 #include <tuttle/plugin/ImageGilProcessor.hpp>
+#include <tuttle/plugin/memory/OfxAllocator.hpp>
 
 #include <ofxsImageEffect.h>
 #include <ofxsMultiThread.h>
 #include <boost/gil/gil_all.hpp>
-#include <boost/scoped_ptr.hpp>
-#include <boost/filesystem/fstream.hpp>
+
+#include <vector>
 
 namespace tuttle {
 namespace plugin {
@@ -16,31 +21,52 @@ namespace reader {
 
 /**
  * @brief Base class to read dpx files
+ *
+ * The image element is read by libdpx in setup. The 10 bits RGB filled words
+ * are kept as they are in the file and unpacked in parallel into the output
+ * view, the other layouts are converted by libdpx into 8 bits, 16 bits or
+ * float components, then converted in parallel into the output view.
  */
 template<class View>
 class DPXReaderProcess : public ImageGilProcessor<View>
 {
 public:
 	DPXReaderProcess( DPXReaderPlugin& instance );
-	~DPXReaderProcess();
 
 	void setup( const OFX::RenderArguments& args );
 
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
 
-	// Read dpx image
-	View& readImage( View& dst );
-
 protected:
-	template<class T, class DST_V>
-	void bitStreamToView( DST_V& dst, const int nc, const int channelSize );
+	/// Read the rows of 32 bits words of the 10 bits RGB filled element, without conversion
+	void readFilled10Bits( InStream& stream );
+
+	/// Read the element converted by libdpx
+	void readElement( ::dpx::Reader& reader );
+
+	/// Unpack the rows of 10 bits RGB filled words of a window of the output view
+	void unpackFilled10Bits( const OfxRectI& procWindowOutput );
+
+	/// Convert the rows read by libdpx of a window of the output view, for each channel type
+	template<class Layout>
+	void convertElement( const OfxRectI& procWindowOutput );
+
+	/// Convert the rows read by libdpx of a window of the output view
+	template<class FileView>
+	void convertRows( const OfxRectI& procWindowOutput );
 
 protected:
 	DPXReaderPlugin&    _plugin;        ///< Rendering plugin
 	DPXReaderProcessParams _params;
-	
-	tuttle::io::DpxImage _dpxImage;
 
+	typedef std::vector<char, OfxAllocator<char> > DataVector;
+	::dpx::Header   _header;
+	DataVector      _data;           ///< element data, as in the file (filled 10 bits) or converted by libdpx
+	::dpx::DataSize _dataSize;       ///< channel type of _data converted by libdpx
+	std::size_t     _rowBytes;       ///< row size in _data
+	bool            _filled10Bits;   ///< _data contains 10 bits RGB filled words
+	bool            _swapEndian;     ///< the words of _data are in the opposite endianness of the host
+	EDpxFilledMethod _filledMethod;
 };
 
 }
@@ -1,5 +1,6 @@
 #include "DPXReaderPlugin.hpp"
 #include "DPXReaderDefinitions.hpp"
+#include "DPXReaderAlgorithm.hpp"
 
 #include <terry/globals.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
@@ -8,369 +9,258 @@
 #include <ofxsImageEffect.h>
 #include <ofxsMultiThread.h>
 
-#include <terry/typedefs.hpp>
 #include <boost/gil/gil_all.hpp>
-#include <boost/gil/packed_pixel.hpp>
-
-#include <boost/integer.hpp>  // for boost::uint_t
 #include <boost/cstdint.hpp>
-#include <boost/mpl/vector.hpp>
-#include <boost/scoped_ptr.hpp>
-#include <boost/filesystem/fstream.hpp>
 
 namespace tuttle {
 namespace plugin {
 namespace dpx {
 namespace reader {
 
-namespace bfs = boost::filesystem;
+using namespace boost::gil;
+
+namespace detail {
+
+/// 10 bits RGB filled words, the layout unpacked in parallel without libdpx
+inline bool isFilled10BitsRGB( const ::dpx::Header& header )
+{
+	return header.ImageDescriptor( 0 ) == ::dpx::kRGB &&
+	       header.BitDepth( 0 ) == 10 &&
+	       ( header.ImagePacking( 0 ) == ::dpx::kFilledMethodA || header.ImagePacking( 0 ) == ::dpx::kFilledMethodB ) &&
+	       header.ImageEncoding( 0 ) == ::dpx::kNone;
+}
+
+/// Channel type of the components converted by libdpx
+inline ::dpx::DataSize elementDataSize( const ::dpx::Header& header )
+{
+	switch( header.BitDepth( 0 ) )
+	{
+		case 8:
+			return ::dpx::kByte;
+		case 32:
+		case 64:
+			// libdpx doesn't normalize integer components into floats
+			return ::dpx::kFloat;
+	}
+	// 10, 12 and 16 bits are scaled to 16 bits
+	return ::dpx::kWord;
+}
+
+inline std::size_t dataSizeBytes( const ::dpx::DataSize size )
+{
+	switch( size )
+	{
+		case ::dpx::kByte: return 1;
+		case ::dpx::kWord: return 2;
+		case ::dpx::kInt: return 4;
+		case ::dpx::kFloat: return 4;
+		case ::dpx::kDouble: return 8;
+	}
+	return 0;
+}
+
+template<int nbComponents>
+void unpackFilled10BitsGilRow( const boost::uint32_t* src, bits8* dst, const std::size_t width, const EDpxFilledMethod method, const bool swapEndian )
+{
+	unpackFilled10BitsRow<boost::uint8_t, nbComponents>( src, reinterpret_cast<boost::uint8_t*>( dst ), width, method, swapEndian );
+}
+
+template<int nbComponents>
+void unpackFilled10BitsGilRow( const boost::uint32_t* src, bits16* dst, const std::size_t width, const EDpxFilledMethod method, const bool swapEndian )
+{
+	unpackFilled10BitsRow<boost::uint16_t, nbComponents>( src, reinterpret_cast<boost::uint16_t*>( dst ), width, method, swapEndian );
+}
+
+template<int nbComponents>
+void unpackFilled10BitsGilRow( const boost::uint32_t* src, bits32f* dst, const std::size_t width, const EDpxFilledMethod method, const bool swapEndian )
+{
+	unpackFilled10BitsRow<float, nbComponents>( src, reinterpret_cast<float*>( dst ), width, method, swapEndian );
+}
+
+}
 
 template<class View>
 DPXReaderProcess<View>::DPXReaderProcess( DPXReaderPlugin& instance )
 	: ImageGilProcessor<View>( instance, eImageOrientationFromTopToBottom )
 	, _plugin( instance )
+	, _dataSize( ::dpx::kWord )
+	, _rowBytes( 0 )
+	, _filled10Bits( false )
+	, _swapEndian( false )
+	, _filledMethod( eDpxFilledMethodA )
 {
-	this->setNoMultiThreading();
 }
 
-template<class View>
-DPXReaderProcess<View>::~DPXReaderProcess()
-{}
-
 template<class View>
 void DPXReaderProcess<View>::setup( const OFX::RenderArguments& args )
 {
-	using namespace boost::gil;
 	ImageGilProcessor<View>::setup( args );
 	_params = _plugin.getProcessParams( args.time );
+
+	InStream stream;
+	if( ! stream.Open( _params._filepath.c_str() ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::FileNotExist()
+			<< exception::user( "Dpx: Unable to open file" )
+			<< exception::filename( _params._filepath ) );
+	}
+	::dpx::Reader reader;
+	reader.SetInStream( &stream );
+	if( ! reader.ReadHeader() )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Dpx: Unable to read the header" )
+			<< exception::filename( _params._filepath ) );
+	}
+	_header = reader.header;
+
+	if( std::ptrdiff_t( _header.Width() ) != this->_dstView.width() ||
+	    std::ptrdiff_t( _header.Height() ) != this->_dstView.height() )
+	{
+		BOOST_THROW_EXCEPTION( exception::Unsupported()
+			<< exception::user( "Dpx: the file size doesn't match the output image (render scale is not supported)." )
+			<< exception::filename( _params._filepath ) );
+	}
+
+	_filled10Bits = detail::isFilled10BitsRGB( _header );
+	if( _filled10Bits )
+		readFilled10Bits( stream );
+	else
+		readElement( reader );
+	stream.Close();
 }
 
-/**
- * @brief Function called by rendering thread each time a process must be done.
- * @param[in] procWindowRoW  Processing window in RoW
- */
 template<class View>
-void DPXReaderProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
+void DPXReaderProcess<View>::readFilled10Bits( InStream& stream )
 {
-	using namespace boost::gil;
-	readImage( this->_dstView );
+	const std::size_t width = _header.Width();
+	const std::size_t height = _header.Height();
+	_rowBytes = width * sizeof( boost::uint32_t ) + _header.EndOfLinePadding( 0 );
+	// the padding of the last row may be missing at the end of the file
+	const std::size_t dataBytes = _rowBytes * ( height - 1 ) + width * sizeof( boost::uint32_t );
+	_data.resize( dataBytes );
+
+	if( ! stream.Seek( _header.DataOffset( 0 ), InStream::kStart ) ||
+	    stream.ReadDirect( &_data.front(), dataBytes ) != dataBytes )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Dpx: Unable to read the image data" )
+			<< exception::filename( _params._filepath ) );
+	}
+	// the words are swapped by the unpacking, in parallel
+	_swapEndian = _header.RequiresByteSwap();
+	_filledMethod = static_cast<EDpxFilledMethod>( _header.ImagePacking( 0 ) );
 }
 
 template<class View>
-View& DPXReaderProcess<View>::readImage( View& dst )
+void DPXReaderProcess<View>::readElement( ::dpx::Reader& reader )
 {
-	using namespace boost;
-	using namespace mpl;
-	using namespace boost::gil;
-
-	_dpxImage.read( _params._filepath, true );
+	_dataSize = detail::elementDataSize( _header );
+	_rowBytes = std::size_t( _header.Width() ) * _header.ImageElementComponentCount( 0 ) * detail::dataSizeBytes( _dataSize );
+	_data.resize( _rowBytes * _header.Height() );
 
-	switch( _dpxImage.componentsType() )
+	if( ! reader.ReadImage( &_data.front(), _dataSize, _header.ImageDescriptor( 0 ) ) )
 	{
-		case tuttle::io::DpxImage::eCompTypeR8G8B8:
-		{
-			// Tests passed: fill, non fill, big endian, little endian
-			rgb8c_view_t src = interleaved_view( _dpxImage.width(), _dpxImage.height(),
-							     (const rgb8_pixel_t*)( _dpxImage.data() ),
-							     _dpxImage.width() * 3 );
-			copy_and_convert_pixels( src, dst );
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeR8G8B8A8:
-		{
-			// Tests passed: fill, non fill, big endian, little endian
-			rgba8c_view_t src = interleaved_view( _dpxImage.width(), _dpxImage.height(),
-							      (const rgba8_pixel_t*)( _dpxImage.data() ),
-							      _dpxImage.width() * 4 );
-
-			copy_and_convert_pixels( src, dst );
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeA8B8G8R8:
-		{
-			// Untested (need images samples), quite sure it is working
-			abgr8c_view_t src = interleaved_view( _dpxImage.width(), _dpxImage.height(),
-							      (const abgr8_pixel_t*)( _dpxImage.data() ),
-							      _dpxImage.width() * 4 );
-
-			copy_and_convert_pixels( src, dst );
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeR10G10B10:
-		{
-			// Tests passed: fill, non fill, big endian, little endian
-			// Interpret pixels according to its bit packing
-			switch( _dpxImage.packing() )
-			{
-				// bit stream
-				case 0:
-				{
-					rgb16_image_t img( dst.width(), dst.height() );
-					rgb16_view_t vw( view( img ) );
-					bitStreamToView<rgb10_stream_ptr_t>( vw, 3, 10 );
-					copy_and_convert_pixels( vw, dst );
-					break;
-				}
-				default:
-				{
-					int width               = _dpxImage.width();
-					int height              = _dpxImage.height();
-					gray32_view_t src = interleaved_view( width, height,
-										    ( gray32_pixel_t* )( _dpxImage.rawData() ),
-										    width * sizeof( uint32_t ) );
-
-					rgb16_image_t img16( width, height );
-					rgb16_view_t vw16( view( img16 ) );
-					for( typename gray32_view_t::y_coord_t y = 0; y < height; ++y )
-					{
-						typename gray32_view_t::x_iterator sit = src.row_begin( y );
-						typename rgb16_view_t::x_iterator  dit = vw16.row_begin( y );
-						for( typename gray32_view_t::x_coord_t x = 0; x < width; ++x )
-						{
-							uint32_t pixel = (uint32_t) *sit;
-
-							short red   = ( ( pixel & 0xffc00000 ) >> 22 );
-							short green = ( ( pixel & 0x003ff000 ) >> 12 );
-							short blue  = ( ( pixel & 0x00000ffc ) >>  2 );
-
-							get_color( *dit, red_t()   ) = red ;
-							get_color( *dit, green_t() ) = green ;
-							get_color( *dit, blue_t()  ) = blue ;
-
-							++sit;
-							++dit;
-						}
-					}
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Dpx: Unable to read the image data" )
+			<< exception::filename( _params._filepath ) );
+	}
+}
 
-					copy_and_convert_pixels( vw16, dst );
-					break;
-				}
-			}
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeR10G10B10A10:
-		{
-			// Tests passed: fill with big endian or little endian
-			// Tests failed: non fill
-			// Interpret pixels according to its bit packing
-			switch( _dpxImage.packing() )
-			{
-				// bit stream
-				case 0:
-				{
-					rgba16_image_t img( dst.width(), dst.height() );
-					rgba16_view_t vw( view( img ) );
-					bitStreamToView<rgba10_stream_ptr_t>( vw, 4, 10 );
-					copy_and_convert_pixels( vw, dst );
-					break;
-				}
-				default:
-				{
-					BOOST_THROW_EXCEPTION( exception::Failed()
-						<< exception::dev() + "Unsupported dpx file format (RGBA10 byte packed). " );
-				}
-			}
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeA10B10G10R10:
-		{
-			// Untested (need images samples), quite sure it is not working :(
-			// Interpret pixels according to its bit packing
-			switch( _dpxImage.packing() )
-			{
-				// bit stream
-				case 0:
-				{
-					rgba16_image_t img( dst.width(), dst.height() );
-					rgba16_view_t vw( view( img ) );
-					bitStreamToView<abgr10_stream_ptr_t>( vw, 4, 10 );
-					copy_and_convert_pixels( vw, dst );
-					break;
-				}
-				case 1:
-				case 2:
-				{
-					BOOST_THROW_EXCEPTION( exception::Failed()
-						<< exception::dev() + "Unsupported dpx file format (ABGR10 byte packed). " );
-				}
-			}
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeR12G12B12:
-		{
-			// Tests failed: all (sick) !
-			// Probable bug in gil...
-			// Interpret pixels according to its bit packing
-			switch( _dpxImage.packing() )
-			{
-				// bit stream
-				case 0:
-				{
-					rgb16_image_t img( dst.width(), dst.height() );
-					rgb16_view_t vw( view( img ) );
-					bitStreamToView<rgb12_stream_ptr_t>( vw, 3, 12 );
-					copy_and_convert_pixels( vw, dst );
-					break;
-				}
-				default:
-				{
-					int width               = _dpxImage.width();
-					int height              = _dpxImage.height();
-					rgb12_packed_view_t src = interleaved_view( width, height,
-										    ( rgb12_packed_pixel_t* )( _dpxImage.data() ),
-										    _dpxImage.width() * 6 );
-					// This is temporary but needed because of a probable bug in gil
-					// Should be using copy_and_convert_pixels
-					rgb16_image_t img16( width, height );
-					rgb16_view_t vw16( view( img16 ) );
-					for( typename rgb12_packed_view_t::y_coord_t y = 0; y < height; ++y )
-					{
-						typename rgb12_packed_view_t::x_iterator sit = src.row_begin( y );
-						typename rgb16_view_t::x_iterator dit        = vw16.row_begin( y );
-						for( typename rgb12_packed_view_t::x_coord_t x = 0; x < width; ++x )
-						{
-							color_convert( *sit, *dit );
-							++sit;
-							++dit;
-						}
-					}
-					copy_and_convert_pixels( vw16, dst );
-					break;
+/**
+ * @brief Function called by rendering thread each time a process must be done.
+ * @param[in] procWindowRoW  Processing window in RoW
+ */
+template<class View>
+void DPXReaderProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
+{
+	const OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
 
-				}
-			}
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeR12G12B12A12:
-		{
-			// Tests passed: fill big endian or little endian, non fill little endian or big endian
-			// Interpret pixels according to its bit packing
-			switch( _dpxImage.packing() )
-			{
-				// bit stream
-				case 0:
-				{
-					rgba16_image_t img( dst.width(), dst.height() );
-					rgba16_view_t vw( view( img ) );
-					bitStreamToView<rgba12_stream_ptr_t>( vw, 4, 12 );
-					copy_and_convert_pixels( vw, dst );
-					break;
-				}
-				default:
-				{
-					BOOST_THROW_EXCEPTION( exception::Failed()
-						<< exception::dev() + "Unsupported dpx file format (RGBA12 byte packed). " );
-					rgba12_packed_view_t vw = interleaved_view( _dpxImage.width(), _dpxImage.height(),
-										    ( rgba12_packed_pixel_t* )( _dpxImage.data() ),
-										    _dpxImage.width() * sizeof( uint64_t ) );
+	if( _filled10Bits )
+	{
+		unpackFilled10Bits( procWindowOutput );
+		return;
+	}
 
-					//copy_and_convert_pixels( vw, dst );
-					break;
-				}
-			}
+	switch( _header.ImageDescriptor( 0 ) )
+	{
+		case ::dpx::kRed:
+		case ::dpx::kGreen:
+		case ::dpx::kBlue:
+		case ::dpx::kAlpha:
+		case ::dpx::kLuma:
+			convertElement<gray_layout_t>( procWindowOutput );
+			return;
+		case ::dpx::kRGB:
+			convertElement<rgb_layout_t>( procWindowOutput );
+			return;
+		case ::dpx::kRGBA:
+			convertElement<rgba_layout_t>( procWindowOutput );
+			return;
+		case ::dpx::kABGR:
+			convertElement<abgr_layout_t>( procWindowOutput );
+			return;
+		default:
 			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeA12B12G12R12:
-		{
-			// Untested
-			// Interpret pixels according to its bit packing
-			switch( _dpxImage.packing() )
-			{
-				// bit stream
-				case 0:
-				{
-					rgba16_image_t img( dst.width(), dst.height() );
-					rgba16_view_t vw( view( img ) );
-					bitStreamToView<abgr12_stream_ptr_t>( vw, 4, 12 );
-					copy_and_convert_pixels( vw, dst );
-					break;
-				}
-				default:
-				{
-					BOOST_THROW_EXCEPTION( exception::Failed()
-						<< exception::dev() + "Unsupported dpx file format (ABGR12 byte packed). " );
-/*
-					abgr12_packed_view_t vw = interleaved_view( _dpxImage.width(), _dpxImage.height(),
-										    ( abgr12_packed_pixel_t* )( _dpxImage.data() ),
-										    _dpxImage.width() * sizeof( uint64_t ) );
+	}
+	BOOST_THROW_EXCEPTION( exception::ImageFormat()
+		<< exception::user() + "Dpx: unsupported image descriptor (" + int( _header.ImageDescriptor( 0 ) ) + ")."
+		<< exception::filename( _params._filepath ) );
+}
 
-					//copy_and_convert_pixels( vw, dst );*/
-					break;
-				}
-			}
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeR16G16B16:
-		{
-			/// @todo: bug here.
-			//TUTTLE_LOG_INFOS;
-			//TUTTLE_LOG_VAR( TUTTLE_INFO, _dpxImage.width() );
-			//TUTTLE_LOG_VAR( TUTTLE_INFO, _dpxImage.height() );
-			//TUTTLE_LOG_VAR( TUTTLE_INFO, sizeof( rgb16_pixel_t ) );
-			// Tests passed: fill, non fill, big endian, little endian
-			rgb16c_view_t src = interleaved_view( _dpxImage.width(), _dpxImage.height(),
-							      (const rgb16_pixel_t*)( _dpxImage.data() ),
-							      _dpxImage.width() * sizeof( rgb16_pixel_t ) );
-			copy_and_convert_pixels( src, dst );
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeR16G16B16A16:
-		{
-			// Tests passed: fill, non fill, big endian, little endian
-			rgba16c_view_t src = interleaved_view( _dpxImage.width(), _dpxImage.height(),
-												   (const rgba16_pixel_t*)( _dpxImage.data() ),
-												   _dpxImage.width() * sizeof( uint64_t ) );
+template<class View>
+void DPXReaderProcess<View>::unpackFilled10Bits( const OfxRectI& procWindowOutput )
+{
+	const std::size_t width = procWindowOutput.x2 - procWindowOutput.x1;
 
-			copy_and_convert_pixels( src, dst );
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeA16B16G16R16:
-		{
-			// Untested (need images samples), quite sure it is working
-			abgr16c_view_t src = interleaved_view( _dpxImage.width(), _dpxImage.height(),
-												   (const abgr16_pixel_t*)( _dpxImage.data() ),
-												   _dpxImage.width() * sizeof( uint64_t ) );
+	for( int y = procWindowOutput.y1; y < procWindowOutput.y2; ++y )
+	{
+		const boost::uint32_t* src = reinterpret_cast<const boost::uint32_t*>( &_data[y * _rowBytes] ) + procWindowOutput.x1;
+		detail::unpackFilled10BitsGilRow<num_channels<View>::value>( src, &( *this->_dstView.row_begin( y ) )[0] + procWindowOutput.x1 * num_channels<View>::value,
+		                                                             width, _filledMethod, _swapEndian );
+		if( this->progressForward( width ) )
+			return;
+	}
+}
 
-			copy_and_convert_pixels( src, dst );
-			break;
-		}
-		case tuttle::io::DpxImage::eCompTypeUnknown:
-		{
-			BOOST_THROW_EXCEPTION( exception::Failed()
-				<< exception::dev() + "Unrecognized image type, bit depth is " + _dpxImage.getHeader().bitSize() + ", component type is: " + _dpxImage.getHeader().descriptor() + ".\n"
-						    + "DPX HEADER:\n"
-						    + _dpxImage.getHeader() );
+template<class View>
+template<class Layout>
+void DPXReaderProcess<View>::convertElement( const OfxRectI& procWindowOutput )
+{
+	switch( _dataSize )
+	{
+		case ::dpx::kByte:
+			convertRows<typename view_type<bits8, Layout>::type>( procWindowOutput );
+			return;
+		case ::dpx::kWord:
+			convertRows<typename view_type<bits16, Layout>::type>( procWindowOutput );
+			return;
+		case ::dpx::kFloat:
+			convertRows<typename view_type<bits32f, Layout>::type>( procWindowOutput );
+			return;
+		default:
 			break;
-		}
 	}
-
-	return dst;
+	BOOST_THROW_EXCEPTION( exception::ImageFormat()
+		<< exception::user( "Dpx: unsupported bit depth" )
+		<< exception::filename( _params._filepath ) );
 }
 
 template<class View>
-template<class T, class DST_V>
-void DPXReaderProcess<View>::bitStreamToView( DST_V& dst, const int nc, const int channelSize )
+template<class FileView>
+void DPXReaderProcess<View>::convertRows( const OfxRectI& procWindowOutput )
 {
-	boost::uint8_t* pData = _dpxImage.data();
+	typedef typename FileView::value_type FilePixel;
+	const std::ptrdiff_t width = procWindowOutput.x2 - procWindowOutput.x1;
 
-	typedef unsigned char byte_t;
-	int width             = _dpxImage.width();
-	int height            = _dpxImage.height();
-	int scanline_in_bits  = width * nc * channelSize;
-	int scanline_in_bytes = scanline_in_bits / 8;
-	scanline_in_bytes += ( scanline_in_bits % 8 != 0 ) ? 1 : 0;
-	T p( pData, 0 );
-
-	for( typename DST_V::y_coord_t y = 0; y < height; ++y )
+	for( int y = procWindowOutput.y1; y < procWindowOutput.y2; ++y )
 	{
-		typename DST_V::x_iterator it = dst.row_begin( y );
-
-		for( typename DST_V::x_coord_t x = 0; x < width; ++x )
-		{
-			color_convert( *p, *it );
-			++p;
-			++it;
-		}
+		const FileView srcRow = interleaved_view( width, 1,
+		                                          reinterpret_cast<FilePixel*>( &_data[y * _rowBytes] ) + procWindowOutput.x1,
+		                                          width * sizeof( FilePixel ) );
+		copy_and_convert_pixels( srcRow, subimage_view( this->_dstView, procWindowOutput.x1, y, width, 1 ) );
+		if( this->progressForward( width ) )
+			return;
 	}
 }
 
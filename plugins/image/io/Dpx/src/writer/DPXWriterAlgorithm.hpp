@@ -11,6 +11,10 @@
 #endif
 
 #include <tuttle/plugin/memory/OfxAllocator.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
 #include <vector>
 
 using namespace boost::gil;
@@ -269,6 +273,86 @@ void convertRGBAToABGR( DataVector& dataVec, size_t width, size_t height, int pi
 	}
 }
 
+namespace tuttle {
+namespace plugin {
+namespace dpx {
+namespace writer {
+
+/**
+ * @brief Swap the bytes of 16 bits words in place.
+ */
+inline void swapEndian16( boost::uint16_t* it, const std::size_t size )
+{
+	std::size_t i = 0;
+	for( ; i + 8 <= size; i += 8 )
+	{
+		const __m128i words = _mm_loadu_si128( (const __m128i*)( it + i ) );
+		_mm_storeu_si128( (__m128i*)( it + i ), _mm_or_si128( _mm_slli_epi16( words, 8 ), _mm_srli_epi16( words, 8 ) ) );
+	}
+	for( ; i < size; ++i )
+		it[i] = static_cast<boost::uint16_t>( ( it[i] >> 8 ) | ( it[i] << 8 ) );
+}
+
+/**
+ * @brief Swap the bytes of 32 bits words in place.
+ */
+inline void swapEndian32( boost::uint32_t* it, const std::size_t size )
+{
+	std::size_t i = 0;
+	for( ; i + 4 <= size; i += 4 )
+	{
+		__m128i words = _mm_loadu_si128( (const __m128i*)( it + i ) );
+#ifdef __SSSE3__
+		words = _mm_shuffle_epi8( words, _mm_set_epi8( 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3 ) );
+#else
+		// swap bytes inside 16 bits, then swap the 16 bits halves
+		words = _mm_or_si128( _mm_slli_epi16( words, 8 ), _mm_srli_epi16( words, 8 ) );
+		words = _mm_shufflehi_epi16( _mm_shufflelo_epi16( words, _MM_SHUFFLE( 2, 3, 0, 1 ) ), _MM_SHUFFLE( 2, 3, 0, 1 ) );
+#endif
+		_mm_storeu_si128( (__m128i*)( it + i ), words );
+	}
+	for( ; i < size; ++i )
+		it[i] = ( it[i] >> 24 ) | ( ( it[i] >> 8 ) & 0x0000ff00 ) | ( ( it[i] << 8 ) & 0x00ff0000 ) | ( it[i] << 24 );
+}
+
+/**
+ * @brief Pack a row of 16 bits components into 32 bits words filled with 3 components of 10 bits,
+ * like libdpx does for packing methods A and B (the last word of the row is completed with zeros).
+ *
+ * @param[in] nbValues number of components in the row
+ * @param[in] methodShift 2 for method A (padding bits in LSB), 0 for method B
+ * @param[in] reverse store the first component in the MSB (datum swap)
+ * @return number of words written
+ */
+inline std::size_t packFilled10BitsRow( const boost::uint16_t* src, boost::uint32_t* dst, const std::size_t nbValues, const int methodShift, const bool reverse )
+{
+	const int shift0 = ( reverse ? 20 : 0 ) + methodShift;
+	const int shift1 = 10 + methodShift;
+	const int shift2 = ( reverse ? 0 : 20 ) + methodShift;
+	boost::uint32_t* const dstBegin = dst;
+
+	std::size_t i = 0;
+	for( ; i + 3 <= nbValues; i += 3, ++dst )
+	{
+		*dst = ( boost::uint32_t( src[i]     >> 6 ) << shift0 ) |
+		       ( boost::uint32_t( src[i + 1] >> 6 ) << shift1 ) |
+		       ( boost::uint32_t( src[i + 2] >> 6 ) << shift2 );
+	}
+	if( i < nbValues )
+	{
+		boost::uint32_t word = boost::uint32_t( src[i] >> 6 ) << shift0;
+		if( i + 1 < nbValues )
+			word |= boost::uint32_t( src[i + 1] >> 6 ) << shift1;
+		*dst++ = word;
+	}
+	return dst - dstBegin;
+}
+
+}
+}
+}
+}
+
 void selectChannelInRGB()
 {
 
@@ -6,9 +6,12 @@
 #include <terry/globals.hpp>
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
 #include <tuttle/plugin/exceptions.hpp>
+#include <tuttle/plugin/memory/OfxAllocator.hpp>
 
 #include <boost/scoped_ptr.hpp>
 
+#include <vector>
+
 namespace tuttle {
 namespace plugin {
 namespace dpx {
@@ -25,12 +28,28 @@ protected:
 	DPXWriterPlugin&       _plugin;        ///< Rendering plugin
 	DPXWriterProcessParams _params;
 
+	typedef std::vector<char, OfxAllocator<char> > DataVector;
+	DataVector      _data;             ///< converted pixels, filled in parallel
+	DataVector      _packedData;       ///< 10 bits components filled in 32 bits words, filled in parallel
+	::dpx::DataSize _dataSize;         ///< channel type of _data
+	std::size_t     _nbComponents;     ///< 0 if the descriptor is not supported
+	std::size_t     _rowBytes;         ///< row size in _data
+	std::size_t     _packedRowBytes;   ///< row size in _packedData
+	bool            _writeThrough;     ///< rows are packed and swapped in parallel, libdpx only writes them
+
 	void setup( const OFX::RenderArguments& args );
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+	void postProcess();
 	
 private:
+	void convertRows( const View& src, const std::ptrdiff_t y );
+
 	template<class WPixel>
-	void writeImage( ::dpx::Writer& writer, View& src, ::dpx::DataSize& dataSize, size_t pixelSize );
+	void convertRows( const View& src, const std::ptrdiff_t y );
+
+	void packRows( const std::ptrdiff_t y, const std::ptrdiff_t nbRows );
+
+	void writeImage();
 
 public:
 	DPXWriterProcess( DPXWriterPlugin& instance );
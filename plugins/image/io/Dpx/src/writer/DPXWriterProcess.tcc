@@ -8,6 +8,7 @@
 #include <tuttle/plugin/memory/OfxAllocator.hpp>
 
 #include <boost/exception/errinfo_file_name.hpp>
+#include <boost/exception/diagnostic_information.hpp>
 #include <boost/assert.hpp>
 
 #include <boost/gil/gil_all.hpp>
@@ -30,8 +31,12 @@ template<class View>
 DPXWriterProcess<View>::DPXWriterProcess( DPXWriterPlugin& instance )
 	: ImageGilFilterProcessor<View>( instance, eImageOrientationFromTopToBottom )
 	, _plugin( instance )
+	, _dataSize( ::dpx::kByte )
+	, _nbComponents( 0 )
+	, _rowBytes( 0 )
+	, _packedRowBytes( 0 )
+	, _writeThrough( false )
 {
-	this->setNoMultiThreading();
 }
 
 template<class View>
@@ -40,133 +45,156 @@ void DPXWriterProcess<View>::setup( const OFX::RenderArguments& args )
 	using namespace boost::gil;
 	ImageGilFilterProcessor<View>::setup( args );
 	_params = _plugin.getProcessParams( args.time );
-}
-
-/**
- * @brief Function called by rendering thread each time a process must be done.
- * @param[in] procWindowRoW  Processing window in RoW
- */
-template<class View>
-void DPXWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
-{
-	using namespace boost::gil;
-	OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
-	OfxPointI procWindowSize  = {
-		procWindowRoW.x2 - procWindowRoW.x1,
-		procWindowRoW.y2 - procWindowRoW.y1
-	};
-
-	View src = subimage_view( this->_srcView, procWindowOutput.x1, procWindowOutput.y1,
-				   procWindowSize.x,
-				   procWindowSize.y );
-
-	::dpx::Writer   writer;
-	::dpx::DataSize dataSize = ::dpx::kByte;
-
-	OutStream       stream;
-
-	if( ! stream.Open( _params._filepath.c_str() ) )
-	{
-		BOOST_THROW_EXCEPTION( exception::File()
-			<< exception::user( "Dpx: Unable to open output file" ) );
-	}
-
-	writer.SetOutStream( &stream );
-	writer.Start();
-	writer.SetFileInfo( _params._filepath.c_str(), 0, "TuttleOFX DPX Writer", _params._project.c_str(), _params._copyright.c_str(), ~0, _params._swapEndian );
-	writer.SetImageInfo( procWindowSize.x, procWindowSize.y );
-
-#ifndef TUTTLE_PRODUCTION
-	writer.header.SetImageOrientation( _params._orientation );
-#endif
 
+	std::size_t channelSize = 1;
 	switch ( _params._bitDepth )
 	{
 		case eTuttlePluginBitDepth8:
-			dataSize = ::dpx::kByte;
+			_dataSize = ::dpx::kByte;
+			channelSize = 1;
 			break;
 		case eTuttlePluginBitDepth10:
 		case eTuttlePluginBitDepth12:
 		case eTuttlePluginBitDepth16:
-			dataSize = ::dpx::kWord;
+			_dataSize = ::dpx::kWord;
+			channelSize = 2;
 			break;
 		case eTuttlePluginBitDepth32:
 		case eTuttlePluginBitDepth64:
-			dataSize = ::dpx::kFloat;
+			_dataSize = ::dpx::kFloat;
+			channelSize = 4;
 			break;
 	}
 
-
-	writer.SetElement( 0,
-			_params._descriptor,
-			_params._iBitDepth,
-			_params._transfer,
-			_params._colorimetric,
-			_params._packed,
-			_params._encoding );
-
-	
-	if( ! writer.WriteHeader() )
-	{
-		BOOST_THROW_EXCEPTION( exception::Data()
-			<< exception::user( "Dpx: Unable to write data (DPX Header)" ) );
-	}
-
-	//TUTTLE_LOG_VAR( TUTTLE_INFO, _params._descriptor);
 	switch( _params._descriptor )
 	{
 		case ::dpx::kUserDefinedDescriptor:
+		case ::dpx::kAlpha:
 			BOOST_THROW_EXCEPTION( exception::ImageFormat()
 								<< exception::user( "Dpx: Unable to write user defined" ) );
 			break;
-		case ::dpx::kRed:
+		case ::dpx::kLuma:
+			_nbComponents = 1;
 			break;
-		case ::dpx::kGreen:
+		case ::dpx::kRGB:
+			_nbComponents = 3;
 			break;
-		case ::dpx::kBlue:
+		case ::dpx::kRGBA:
+		case ::dpx::kABGR:
+			_nbComponents = 4;
 			break;
-		case ::dpx::kAlpha:
-			BOOST_THROW_EXCEPTION( exception::ImageFormat()
-								<< exception::user( "Dpx: Unable to write user defined" ) );
+		default:
+			// not supported, only the header is written
+			_nbComponents = 0;
 			break;
+	}
+
+	const std::size_t width  = this->_srcView.width();
+	const std::size_t height = this->_srcView.height();
+	_rowBytes = width * _nbComponents * channelSize;
+	_data.resize( _rowBytes * height );
+
+	// libdpx writes the data untouched if there is no packing to do,
+	// so we can also do the 10 bits and 12 bits filled packing and the endian swap on our side.
+	const bool filled = ( _params._packed != ::dpx::kPacked );
+	_writeThrough = _nbComponents != 0 &&
+	                _params._encoding == ::dpx::kNone &&
+	                ( _params._iBitDepth == 8 ||
+	                  _params._iBitDepth == 16 ||
+	                  _params._iBitDepth == 32 ||
+	                  ( filled && ( _params._iBitDepth == 10 || _params._iBitDepth == 12 ) ) );
+
+	_packedRowBytes = 0;
+	_packedData.clear();
+	if( _writeThrough && _params._iBitDepth == 10 )
+	{
+		_packedRowBytes = ( ( width * _nbComponents + 2 ) / 3 ) * sizeof( boost::uint32_t );
+		_packedData.resize( _packedRowBytes * height );
+	}
+}
+
+/**
+ * @brief Function called by rendering thread each time a process must be done.
+ * Converts and packs the rows of the processing window,
+ * the file is written once all rows are ready.
+ * @param[in] procWindowRoW  Processing window in RoW
+ */
+template<class View>
+void DPXWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
+{
+	using namespace boost::gil;
+	if( _nbComponents == 0 )
+		return;
+
+	const OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
+	const std::ptrdiff_t nbRows = procWindowRoW.y2 - procWindowRoW.y1;
+
+	const View src = subimage_view( this->_srcView, 0, procWindowOutput.y1, this->_srcView.width(), nbRows );
+
+	convertRows( src, procWindowOutput.y1 );
+	if( _writeThrough )
+		packRows( procWindowOutput.y1, nbRows );
+}
+
+template<class View>
+void DPXWriterProcess<View>::postProcess()
+{
+	try
+	{
+		writeImage();
+	}
+	catch( exception::Common& e )
+	{
+		e << exception::filename( _params._filepath );
+		throw;
+	}
+	catch(... )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Dpx: Unable to write image" )
+			<< exception::dev( boost::current_exception_diagnostic_information() )
+			<< exception::filename( _params._filepath ) );
+	}
+	ImageGilFilterProcessor<View>::postProcess();
+}
+
+template<class View>
+void DPXWriterProcess<View>::convertRows( const View& src, const std::ptrdiff_t y )
+{
+	using namespace boost::gil;
+	switch( _params._descriptor )
+	{
 		case ::dpx::kLuma:
 			switch ( _params._bitDepth )
 			{
 				case eTuttlePluginBitDepth8:
-					writeImage<gray8_pixel_t>( writer, src, dataSize, 1 );
+					convertRows<gray8_pixel_t>( src, y );
 					break;
 				case eTuttlePluginBitDepth10:
 				case eTuttlePluginBitDepth12:
 				case eTuttlePluginBitDepth16:
-					writeImage<gray16_pixel_t>( writer, src, dataSize, 2 );
+					convertRows<gray16_pixel_t>( src, y );
 					break;
 				case eTuttlePluginBitDepth32:
 				case eTuttlePluginBitDepth64:
-					writeImage<gray32f_pixel_t>( writer, src, dataSize, 4 );
+					convertRows<gray32f_pixel_t>( src, y );
 					break;
 			}
 			break;
-			break;
-		case ::dpx::kColorDifference:
-			break;
-		case ::dpx::kDepth:
-			break;
-		case ::dpx::kCompositeVideo:
-			break;
 		case ::dpx::kRGB:
 			switch ( _params._bitDepth )
 			{
 				case eTuttlePluginBitDepth8:
-					writeImage<rgb8_pixel_t>( writer, src, dataSize, 3 );
+					convertRows<rgb8_pixel_t>( src, y );
 					break;
 				case eTuttlePluginBitDepth10:
 				case eTuttlePluginBitDepth12:
 				case eTuttlePluginBitDepth16:
-					writeImage<rgb16_pixel_t>( writer, src, dataSize, 6 );
+					convertRows<rgb16_pixel_t>( src, y );
 					break;
 				case eTuttlePluginBitDepth32:
 				case eTuttlePluginBitDepth64:
-					writeImage<rgb32f_pixel_t>( writer, src, dataSize, 12 );
+					convertRows<rgb32f_pixel_t>( src, y );
 					break;
 			}
 			break;
@@ -174,16 +202,16 @@ void DPXWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 			switch ( _params._bitDepth )
 			{
 				case eTuttlePluginBitDepth8:
-					writeImage<rgba8_pixel_t>( writer, src, dataSize, 4 );
+					convertRows<rgba8_pixel_t>( src, y );
 					break;
 				case eTuttlePluginBitDepth10:
 				case eTuttlePluginBitDepth12:
 				case eTuttlePluginBitDepth16:
-					writeImage<rgba16_pixel_t>( writer, src, dataSize, 8 );
+					convertRows<rgba16_pixel_t>( src, y );
 					break;
 				case eTuttlePluginBitDepth32:
 				case eTuttlePluginBitDepth64:
-					writeImage<rgba32f_pixel_t>( writer, src, dataSize, 16 );
+					convertRows<rgba32f_pixel_t>( src, y );
 					break;
 			}
 			break;
@@ -191,86 +219,154 @@ void DPXWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 			switch ( _params._bitDepth )
 			{
 				case eTuttlePluginBitDepth8:
-					writeImage<abgr8_pixel_t>( writer, src, dataSize, 4 );
+					convertRows<abgr8_pixel_t>( src, y );
 					break;
 				case eTuttlePluginBitDepth10:
 				case eTuttlePluginBitDepth12:
 				case eTuttlePluginBitDepth16:
-					writeImage<abgr16_pixel_t>( writer, src, dataSize, 8 );
+					convertRows<abgr16_pixel_t>( src, y );
 					break;
 				case eTuttlePluginBitDepth32:
 				case eTuttlePluginBitDepth64:
-					writeImage<abgr32f_pixel_t>( writer, src, dataSize, 16 );
+					convertRows<abgr32f_pixel_t>( src, y );
 					break;
 			}
 			break;
-		case ::dpx::kCbYCrY:
+		default:
 			break;
-		case ::dpx::kCbYACrYA:
-			break;
-		case ::dpx::kCbYCr:
-			break;
-		case ::dpx::kCbYCrA:
-			break;
-		case ::dpx::kUserDefined2Comp:
-			break;
-		case ::dpx::kUserDefined3Comp:
-			break;
-		case ::dpx::kUserDefined4Comp:
-			break;
-		case ::dpx::kUserDefined5Comp:
+	}
+}
+
+/**
+ * @brief Convert rows into the staging buffer, starting at row @p y.
+ */
+template<class View>
+template<class WPixel>
+void DPXWriterProcess<View>::convertRows( const View& src, const std::ptrdiff_t y )
+{
+	using namespace terry;
+	typedef typename view_type_from_pixel<WPixel>::type WView; // interleaved view
+	WView rows = interleaved_view( src.width(), src.height(), reinterpret_cast<WPixel*>( &_data[y * _rowBytes] ), _rowBytes );
+	copy_and_convert_pixels( src, rows );
+}
+
+/**
+ * @brief Pack and swap converted rows the way libdpx would, starting at row @p y.
+ */
+template<class View>
+void DPXWriterProcess<View>::packRows( const std::ptrdiff_t y, const std::ptrdiff_t nbRows )
+{
+	const std::size_t nbValues = this->_srcView.width() * _nbComponents;
+	char* rows = &_data[y * _rowBytes];
+	const std::size_t nbRowsValues = nbValues * nbRows;
+
+	switch( _params._iBitDepth )
+	{
+		case 10:
+		{
+			const int methodShift = ( _params._packed == ::dpx::kFilledMethodA ) ? 2 : 0;
+			// libdpx stores the RGB components in reverse order (datum swap)
+			const bool reverse = ( _params._descriptor == ::dpx::kRGB );
+			for( std::ptrdiff_t row = 0; row < nbRows; ++row )
+			{
+				const boost::uint16_t* src = reinterpret_cast<const boost::uint16_t*>( rows + row * _rowBytes );
+				boost::uint32_t* dst = reinterpret_cast<boost::uint32_t*>( &_packedData[( y + row ) * _packedRowBytes] );
+				const std::size_t nbWords = packFilled10BitsRow( src, dst, nbValues, methodShift, reverse );
+				if( _params._swapEndian )
+					swapEndian32( dst, nbWords );
+			}
 			break;
-		case ::dpx::kUserDefined6Comp:
+		}
+		case 12:
+		{
+			boost::uint16_t* values = reinterpret_cast<boost::uint16_t*>( rows );
+			if( _params._packed == ::dpx::kFilledMethodB )
+			{
+				// shift 4 MSB down, method A keeps the 12 bits in the MSB of the 16 bits words
+				for( std::size_t i = 0; i < nbRowsValues; ++i )
+					values[i] >>= 4;
+			}
+			if( _params._swapEndian )
+				swapEndian16( values, nbRowsValues );
 			break;
-		case ::dpx::kUserDefined7Comp:
+		}
+		case 16:
+			if( _params._swapEndian )
+				swapEndian16( reinterpret_cast<boost::uint16_t*>( rows ), nbRowsValues );
 			break;
-		case ::dpx::kUserDefined8Comp:
+		case 32:
+			if( _params._swapEndian )
+				swapEndian32( reinterpret_cast<boost::uint32_t*>( rows ), nbRowsValues );
 			break;
-		case ::dpx::kUndefinedDescriptor:
+		default:
 			break;
 	}
-	
-	if( ! writer.Finish() )
-	{
-		BOOST_THROW_EXCEPTION( exception::Data()
-			<< exception::user( "Dpx: Unable to write data (DPX finish)" ) );
-	}
-	
-	stream.Close();
 }
 
 template<class View>
-template<class WPixel>
-void DPXWriterProcess<View>::writeImage( ::dpx::Writer& writer, View& src, ::dpx::DataSize& dataSize, size_t pixelSize )
+void DPXWriterProcess<View>::writeImage()
 {
-	using namespace terry;
-	typedef image<WPixel, false> image_t; // interleaved image
-	typedef typename image_t::view_t view_t;
-	image_t img( src.width(), src.height() );
-	view_t  dvw( view( img ) );
-	copy_and_convert_pixels( src, dvw );
-	
-	typedef std::vector<char, OfxAllocator<char> > DataVector;
-	const size_t rowBytesToCopy = src.width() * pixelSize;
-
-	DataVector data( rowBytesToCopy * src.height() );
-	char* dataPtrIt = &data.front();
-
-	for( int y = 0; y < src.height(); y++ )
+	::dpx::Writer   writer;
+	OutStream       stream;
+
+	if( ! stream.Open( _params._filepath.c_str() ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Dpx: Unable to open output file" ) );
+	}
+
+	writer.SetOutStream( &stream );
+	writer.Start();
+	writer.SetFileInfo( _params._filepath.c_str(), 0, "TuttleOFX DPX Writer", _params._project.c_str(), _params._copyright.c_str(), ~0, _params._swapEndian );
+	writer.SetImageInfo( this->_srcView.width(), this->_srcView.height() );
+
+#ifndef TUTTLE_PRODUCTION
+	writer.header.SetImageOrientation( _params._orientation );
+#endif
+
+	writer.SetElement( 0,
+			_params._descriptor,
+			_params._iBitDepth,
+			_params._transfer,
+			_params._colorimetric,
+			_params._packed,
+			_params._encoding );
+
+	if( ! writer.WriteHeader() )
 	{
-		void* dataSrcPtr = reinterpret_cast<void*>( &dvw(0,y)[0] );
-		memcpy( dataPtrIt, dataSrcPtr, rowBytesToCopy );
+		BOOST_THROW_EXCEPTION( exception::Data()
+			<< exception::user( "Dpx: Unable to write data (DPX Header)" ) );
+	}
 
-		dataPtrIt += rowBytesToCopy;
+	if( _nbComponents != 0 )
+	{
+		bool status = false;
+		if( _writeThrough )
+		{
+			DataVector& fileData = _packedData.empty() ? _data : _packedData;
+			status = writer.WriteElement( 0, &fileData.front(), static_cast<long>( fileData.size() ) );
+			writer.header.SetImageOffset( writer.header.DataOffset( 0 ) );
+		}
+		else
+		{
+			// rle or bit stream packing: let libdpx pack the data
+			status = writer.WriteElement( 0, &_data.front(), _dataSize );
+		}
+		if( ! status )
+		{
+			BOOST_THROW_EXCEPTION( exception::Data()
+				<< exception::user( "Dpx: Unable to write data (DPX User Data)" ) );
+		}
 	}
 
-	if( ! writer.WriteElement( 0, &data.front(), dataSize ) )
+	if( ! writer.Finish() )
 	{
 		BOOST_THROW_EXCEPTION( exception::Data()
-			<< exception::user( "Dpx: Unable to write data (DPX User Data)" ) );
+			<< exception::user( "Dpx: Unable to write data (DPX finish)" ) );
 	}
-}
 
+	stream.Close();
+}
 
 }
 }
@@ -4,19 +4,130 @@
 #include <boost/test/unit_test.hpp>
 
 #include <tuttle/host/Graph.hpp>
+#include <tuttle/host/attribute/Image.hpp>
 
 #include <boost/preprocessor/stringize.hpp>
 
+#include <boost/filesystem/operations.hpp>
 #include <boost/timer.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+#include <cmath>
+#include <list>
+#include <string>
+
 using namespace boost::unit_test;
 using namespace tuttle::host;
+namespace bfs = boost::filesystem;
 
 BOOST_AUTO_TEST_SUITE( plugin_Dpx_reader )
 std::string pluginName = "tuttle.dpxreader";
 std::string filename = "dpx/flowers-1920x1080-RGB-10.dpx";
-//#include <tuttle/test/io/reader.hpp>
+#include <tuttle/test/io/reader.hpp>
+BOOST_AUTO_TEST_SUITE_END()
+
+
+BOOST_AUTO_TEST_SUITE( plugin_Dpx_reader_filled10Bits )
+
+/**
+ * Write a 32 bits float image into a 10 bits RGB filled dpx file
+ * and read it back, at the same bit depth.
+ * The width is not a multiple of the 4 pixels unpacked together.
+ * @param packed 1: method A, 2: method B
+ * @param swapEndian write the file in the opposite endianness of the host
+ */
+void checkFilled10BitsRoundTrip( const int packed, const bool swapEndian )
+{
+	const std::string filename = ( bfs::temp_directory_path() / bfs::unique_path( "tuttle-dpx-%%%%-%%%%.dpx" ) ).string();
+	const int width = 37;
+	const int height = 12;
+
+	Graph gWrite;
+	Graph::Node& source = gWrite.createNode( "tuttle.colorwheel" );
+	Graph::Node& writer = gWrite.createNode( "tuttle.dpxwriter" );
+	source.getParam( "type" ).setValue( 2 ); // rainbow
+	source.getParam( "explicitConversion" ).setValue( 3 ); // 32f
+	source.getParam( "mode" ).setValue( 1 ); // size
+	source.getParam( "specificRatio" ).setValue( false );
+	source.getParam( "size" ).setValue( width, height );
+	writer.getParam( "filename" ).setValue( filename );
+	writer.getParam( "bitDepth" ).setValue( 1 ); // 10 bits
+	writer.getParam( "channel" ).setValue( 9 ); // rgb
+	writer.getParam( "packed" ).setValue( packed );
+	writer.getParam( "swapendian" ).setValue( swapEndian );
+	gWrite.connect( source, writer );
+
+	std::list<std::string> outputs;
+	outputs.push_back( source.getName() );
+	outputs.push_back( writer.getName() );
+	memory::MemoryCache writeCache;
+	BOOST_REQUIRE( gWrite.compute( writeCache, outputs ) );
+
+	Graph gRead;
+	Graph::Node& reader = gRead.createNode( "tuttle.dpxreader" );
+	reader.getParam( "filename" ).setValue( filename );
+	reader.getParam( "bitDepth" ).setValue( 3 ); // 32f
+	memory::MemoryCache readCache;
+	BOOST_REQUIRE( gRead.compute( readCache, reader ) );
+
+	boost::system::error_code error;
+	bfs::remove( filename, error );
+
+	memory::CACHE_ELEMENT sourceImg = writeCache.get( source.getName(), 0 );
+	memory::CACHE_ELEMENT readImg = readCache.get( reader.getName(), 0 );
+	BOOST_REQUIRE( sourceImg.get() != NULL );
+	BOOST_REQUIRE( readImg.get() != NULL );
+	BOOST_REQUIRE_EQUAL( readImg->getBounds().x2 - readImg->getBounds().x1, width );
+	BOOST_REQUIRE_EQUAL( readImg->getBounds().y2 - readImg->getBounds().y1, height );
+	BOOST_REQUIRE_EQUAL( readImg->getNbComponents(), 3 );
+
+	const int sourceComponents = sourceImg->getNbComponents();
+	const boost::uint8_t* sourceRow = sourceImg->getOrientedPixelData( attribute::Image::eImageOrientationFromBottomToTop );
+	const boost::uint8_t* readRow = readImg->getOrientedPixelData( attribute::Image::eImageOrientationFromBottomToTop );
+	const int sourceDistance = sourceImg->getOrientedRowDistanceBytes( attribute::Image::eImageOrientationFromBottomToTop );
+	const int readDistance = readImg->getOrientedRowDistanceBytes( attribute::Image::eImageOrientationFromBottomToTop );
+	int differentComponents = 0;
+	for( int y = 0; y < height; ++y, sourceRow += sourceDistance, readRow += readDistance )
+	{
+		const float* sourcePixel = reinterpret_cast<const float*>( sourceRow );
+		const float* readPixel = reinterpret_cast<const float*>( readRow );
+		for( int x = 0; x < width; ++x, sourcePixel += sourceComponents, readPixel += 3 )
+		{
+			for( int c = 0; c < 3; ++c )
+			{
+				// 10 bits quantization
+				if( std::abs( sourcePixel[c] - readPixel[c] ) > 1.5f / 1023.0f )
+					++differentComponents;
+			}
+		}
+	}
+	BOOST_CHECK_EQUAL( differentComponents, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( process_reader_methodA_nativeEndian )
+{
+	TUTTLE_LOG_INFO( "******** PROCESS READER tuttle.dpxreader FILLED 10 BITS, METHOD A ********" );
+	checkFilled10BitsRoundTrip( 1, false );
+}
+
+BOOST_AUTO_TEST_CASE( process_reader_methodA_swapEndian )
+{
+	TUTTLE_LOG_INFO( "******** PROCESS READER tuttle.dpxreader FILLED 10 BITS, METHOD A, SWAP ENDIAN ********" );
+	checkFilled10BitsRoundTrip( 1, true );
+}
+
+BOOST_AUTO_TEST_CASE( process_reader_methodB_nativeEndian )
+{
+	TUTTLE_LOG_INFO( "******** PROCESS READER tuttle.dpxreader FILLED 10 BITS, METHOD B ********" );
+	checkFilled10BitsRoundTrip( 2, false );
+}
+
+BOOST_AUTO_TEST_CASE( process_reader_methodB_swapEndian )
+{
+	TUTTLE_LOG_INFO( "******** PROCESS READER tuttle.dpxreader FILLED 10 BITS, METHOD B, SWAP ENDIAN ********" );
+	checkFilled10BitsRoundTrip( 2, true );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
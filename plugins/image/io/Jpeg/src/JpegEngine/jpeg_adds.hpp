@@ -0,0 +1,93 @@
+#ifndef _JPEG_ADDS_HPP
+#define _JPEG_ADDS_HPP
+
+#include <stdio.h>
+#include <setjmp.h>
+#include <string>
+
+#include <boost/gil/gil_config.hpp>
+#include <boost/gil/utilities.hpp>
+#include <boost/gil/extension/io/io_error.hpp>
+#include <boost/gil/extension/io/jpeg_io_private.hpp>
+
+namespace boost {
+namespace gil {
+
+namespace detail {
+
+struct jpeg_rows_error_mgr
+{
+	jpeg_error_mgr pub;
+	jmp_buf setjmp_buffer;
+};
+
+extern "C" inline void jpeg_rows_error_exit( j_common_ptr cinfo )
+{
+	longjmp( reinterpret_cast<jpeg_rows_error_mgr*>( cinfo->err )->setjmp_buffer, 1 );
+}
+
+/// \brief Writes 8 bits RGB rows already in the file layout,
+/// so the only work left to the caller thread is the compression.
+/// Unlike jpeg_write_view, errors are reported with io_error instead of exiting.
+class jpeg_rows_writer : public file_mgr
+{
+protected:
+	jpeg_compress_struct _cinfo;
+	jpeg_rows_error_mgr _jerr;
+
+public:
+	jpeg_rows_writer( const std::string& filename ) : file_mgr( filename.c_str(), "wb" ) { init(); }
+
+	void init()
+	{
+		_cinfo.err = jpeg_std_error( &_jerr.pub );
+		_jerr.pub.error_exit = jpeg_rows_error_exit;
+		jpeg_create_compress( &_cinfo );
+		jpeg_stdio_dest( &_cinfo, get() );
+	}
+
+	virtual ~jpeg_rows_writer()
+	{
+		jpeg_destroy_compress( &_cinfo );
+	}
+
+	/// \param quality from 0 (smallest file) to 100 (best quality)
+	/// \param optimize_coding compute optimal Huffman tables (smaller file, extra pass)
+	/// \param progressive write a progressive jpeg
+	void apply( const unsigned char* data, const std::ptrdiff_t row_bytes,
+		    const JDIMENSION width, const JDIMENSION height,
+		    const int quality, const bool optimize_coding, const bool progressive, const J_DCT_METHOD dct_method )
+	{
+		if( setjmp( _jerr.setjmp_buffer ) )
+		{
+			char message[JMSG_LENGTH_MAX];
+			( *_cinfo.err->format_message )( reinterpret_cast<j_common_ptr>( &_cinfo ), message );
+			io_error( ( std::string( "jpeg_rows_writer: fail to write the file: " ) + message ).c_str() );
+		}
+		_cinfo.image_width      = width;
+		_cinfo.image_height     = height;
+		_cinfo.input_components = 3;
+		_cinfo.in_color_space   = JCS_RGB;
+		jpeg_set_defaults( &_cinfo );
+		jpeg_set_quality( &_cinfo, quality, TRUE );
+		_cinfo.optimize_coding = optimize_coding ? TRUE : FALSE;
+		_cinfo.dct_method      = dct_method;
+		if( progressive )
+			jpeg_simple_progression( &_cinfo );
+
+		jpeg_start_compress( &_cinfo, TRUE );
+		while( _cinfo.next_scanline < _cinfo.image_height )
+		{
+			JSAMPROW row = const_cast<JSAMPROW>( data + _cinfo.next_scanline * row_bytes );
+			jpeg_write_scanlines( &_cinfo, &row, 1 );
+		}
+		jpeg_finish_compress( &_cinfo );
+	}
+};
+
+}
+
+}
+}
+
+#endif  /* _JPEG_ADDS_HPP */
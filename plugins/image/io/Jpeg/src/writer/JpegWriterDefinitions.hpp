@@ -16,6 +16,31 @@ enum ETuttlePluginBitDepth
 
 static const std::string kParamQuality = "quality";
 
+static const std::string kParamOptimizeCoding      = "optimizeCoding";
+static const std::string kParamOptimizeCodingLabel = "Optimize coding";
+static const std::string kParamOptimizeCodingHint  = "Compute optimal Huffman tables: smaller files for a slower compression.";
+
+static const std::string kParamProgressive      = "progressive";
+static const std::string kParamProgressiveLabel = "Progressive";
+static const std::string kParamProgressiveHint  = "Write a progressive jpeg.";
+
+static const std::string kParamDctMethod        = "dctMethod";
+static const std::string kParamDctMethodLabel   = "DCT method";
+static const std::string kParamDctMethodHint    = "Discrete cosine transform used by the compression.\n"
+                                                  "integer: accurate integer method\n"
+                                                  "fast integer: faster, less accurate\n"
+                                                  "float: floating point method";
+static const std::string kParamDctMethodInteger     = "integer";
+static const std::string kParamDctMethodFastInteger = "fast integer";
+static const std::string kParamDctMethodFloat       = "float";
+
+enum EParamDctMethod
+{
+	eParamDctMethodInteger = 0,
+	eParamDctMethodFastInteger,
+	eParamDctMethodFloat
+};
+
 }
 }
 }
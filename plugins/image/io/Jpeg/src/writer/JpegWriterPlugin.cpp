@@ -14,6 +14,9 @@ JpegWriterPlugin::JpegWriterPlugin( OfxImageEffectHandle handle )
 {
 	_paramPremult = fetchBooleanParam( kParamPremultiplied );
 	_paramQuality = fetchIntParam( kParamQuality );
+	_paramOptimizeCoding = fetchBooleanParam( kParamOptimizeCoding );
+	_paramProgressive = fetchBooleanParam( kParamProgressive );
+	_paramDctMethod = fetchChoiceParam( kParamDctMethod );
 }
 
 JpegWriterProcessParams JpegWriterPlugin::getProcessParams( const OfxTime time )
@@ -23,6 +26,9 @@ JpegWriterProcessParams JpegWriterPlugin::getProcessParams( const OfxTime time )
 	params._filepath = getAbsoluteFilenameAt( time );
 	params._quality  = this->_paramQuality->getValue();
 	params._premult  = this->_paramPremult->getValue();
+	params._optimizeCoding = this->_paramOptimizeCoding->getValue();
+	params._progressive = this->_paramProgressive->getValue();
+	params._dctMethod = static_cast<EParamDctMethod>( this->_paramDctMethod->getValue() );
 	return params;
 }
 
@@ -1,6 +1,8 @@
 #ifndef _TUTTLE_PLUGIN_JPEG_WRITER_PLUGIN_HPP_
 #define _TUTTLE_PLUGIN_JPEG_WRITER_PLUGIN_HPP_
 
+#include "JpegWriterDefinitions.hpp"
+
 #include <tuttle/plugin/context/WriterPlugin.hpp>
 
 namespace tuttle {
@@ -14,6 +16,9 @@ struct JpegWriterProcessParams
 	bool _premult;              ///< Premultiply by alpha or directly use RGB channels
 	int _bitDepth;              ///< Output bit depth
 	int _quality;
+	bool _optimizeCoding;       ///< compute optimal Huffman tables
+	bool _progressive;          ///< progressive jpeg
+	EParamDctMethod _dctMethod;
 };
 
 /**
@@ -31,6 +36,9 @@ public:
 public:
 	OFX::BooleanParam* _paramPremult; ///< premult output by alpha
 	OFX::IntParam* _paramQuality; ///< quality / compression for jpeg
+	OFX::BooleanParam* _paramOptimizeCoding; ///< optimal Huffman tables
+	OFX::BooleanParam* _paramProgressive; ///< progressive jpeg
+	OFX::ChoiceParam* _paramDctMethod; ///< dct used by the compression
 };
 
 }
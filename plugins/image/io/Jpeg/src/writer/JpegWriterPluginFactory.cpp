@@ -99,6 +99,24 @@ void JpegWriterPluginFactory::describeInContext( OFX::ImageEffectDescriptor& des
 	quality->setRange( 0, 100 );
 	quality->setDisplayRange( 0, 100 );
 	quality->setDefault( 80 );
+
+	OFX::BooleanParamDescriptor* optimizeCoding = desc.defineBooleanParam( kParamOptimizeCoding );
+	optimizeCoding->setLabel( kParamOptimizeCodingLabel );
+	optimizeCoding->setHint( kParamOptimizeCodingHint );
+	optimizeCoding->setDefault( false );
+
+	OFX::BooleanParamDescriptor* progressive = desc.defineBooleanParam( kParamProgressive );
+	progressive->setLabel( kParamProgressiveLabel );
+	progressive->setHint( kParamProgressiveHint );
+	progressive->setDefault( false );
+
+	OFX::ChoiceParamDescriptor* dctMethod = desc.defineChoiceParam( kParamDctMethod );
+	dctMethod->setLabel( kParamDctMethodLabel );
+	dctMethod->setHint( kParamDctMethodHint );
+	dctMethod->appendOption( kParamDctMethodInteger );
+	dctMethod->appendOption( kParamDctMethodFastInteger );
+	dctMethod->appendOption( kParamDctMethodFloat );
+	dctMethod->setDefault( eParamDctMethodInteger );
 }
 
 /**
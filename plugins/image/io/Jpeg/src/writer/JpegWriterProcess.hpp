@@ -3,6 +3,9 @@
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
+#include <tuttle/plugin/memory/OfxAllocator.hpp>
+
+#include <vector>
 
 namespace tuttle {
 namespace plugin {
@@ -23,15 +26,20 @@ protected:
 	JpegWriterPlugin&    _plugin;        ///< Rendering plugin
 	JpegWriterProcessParams _params;
 
+	typedef std::vector<char, OfxAllocator<char> > DataVector;
+	DataVector     _data;     ///< rgb8 rows, filled in parallel
+	std::ptrdiff_t _rowBytes;
+
 public:
 	JpegWriterProcess( JpegWriterPlugin& instance );
 
 	void setup( const OFX::RenderArguments& args );
 
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+	void postProcess();
 
-	template<class Bits>
-	void writeImage( View& src );
+private:
+	void writeImage();
 };
 
 }
@@ -4,6 +4,8 @@
 #include <terry/globals.hpp>
 #include <tuttle/plugin/exceptions.hpp>
 
+#include "JpegEngine/jpeg_adds.hpp"
+
 #include <boost/gil/gil_all.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/gil/extension/io/jpeg_io.hpp>
@@ -18,8 +20,8 @@ template<class View>
 JpegWriterProcess<View>::JpegWriterProcess( JpegWriterPlugin& instance )
 	: ImageGilFilterProcessor<View>( instance, eImageOrientationFromTopToBottom )
 	, _plugin( instance )
+	, _rowBytes( 0 )
 {
-	this->setNoMultiThreading();
 }
 
 template<class View>
@@ -28,25 +30,43 @@ void JpegWriterProcess<View>::setup( const OFX::RenderArguments& args )
 	ImageGilFilterProcessor<View>::setup( args );
 
 	_params = _plugin.getProcessParams( args.time );
+
+	_rowBytes = this->_srcView.width() * sizeof( boost::gil::rgb8_pixel_t );
+	_data.resize( _rowBytes * this->_srcView.height() );
 }
 
 
 /**
  * @brief Function called by rendering thread each time a process must be done.
+ * Converts the rows of the processing window to rgb8,
+ * the compression is done once all rows are converted.
  * @param[in] procWindowRoW  Processing window in RoW
- * @warning no multithread here !
  */
 template<class View>
 void JpegWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
 {
-	BOOST_ASSERT( procWindowRoW == this->_srcPixelRod );
 	using namespace boost::gil;
+	using namespace terry;
+	const OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
+	const std::ptrdiff_t nbRows = procWindowRoW.y2 - procWindowRoW.y1;
+
+	const View srcRows = subimage_view( this->_srcView, 0, procWindowOutput.y1, this->_srcView.width(), nbRows );
+	const View dstRows = subimage_view( this->_dstView, 0, procWindowOutput.y1, this->_dstView.width(), nbRows );
 
-	View srcView = this->_srcView;
+	rgb8_view_t rows = interleaved_view( srcRows.width(), nbRows,
+	                                     reinterpret_cast<rgb8_pixel_t*>( &_data[procWindowOutput.y1 * _rowBytes] ),
+	                                     _rowBytes );
+	copy_and_convert_pixels( srcRows, rows );
 
+	copy_pixels( srcRows, dstRows ); // @todo ?
+}
+
+template<class View>
+void JpegWriterProcess<View>::postProcess()
+{
 	try
 	{
-		writeImage<bits8>( srcView );
+		writeImage();
 	}
 	catch( exception::Common& e )
 	{
@@ -60,22 +80,24 @@ void JpegWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWind
 			<< exception::dev( boost::current_exception_diagnostic_information() )
 			<< exception::filename( _params._filepath ) );
 	}
-	copy_pixels( this->_srcView, this->_dstView ); // @todo ?
+	ImageGilFilterProcessor<View>::postProcess();
 }
 
-/**
- *
- */
 template<class View>
-template<class Bits>
-void JpegWriterProcess<View>::writeImage( View& src )
+void JpegWriterProcess<View>::writeImage()
 {
-	using namespace boost::gil;
-	using namespace terry;
-
-	typedef pixel<Bits, rgb_layout_t> OutPixelType;
-	jpeg_write_view( _params._filepath, color_converted_view<OutPixelType>( src ), _params._quality );
+	J_DCT_METHOD dctMethod = JDCT_ISLOW;
+	switch( _params._dctMethod )
+	{
+		case eParamDctMethodFastInteger: dctMethod = JDCT_IFAST; break;
+		case eParamDctMethodFloat:       dctMethod = JDCT_FLOAT; break;
+		case eParamDctMethodInteger:     break;
+	}
 
+	boost::gil::detail::jpeg_rows_writer writer( _params._filepath );
+	writer.apply( reinterpret_cast<const unsigned char*>( &_data.front() ), _rowBytes,
+	              this->_srcView.width(), this->_srcView.height(),
+	              _params._quality, _params._optimizeCoding, _params._progressive, dctMethod );
 }
 
 }
@@ -81,6 +81,60 @@ public:
 	int get_interlace_type() { return interlace_type; }
 };
 
+/// \brief Writes rows already in the file layout (16 bits samples in big endian),
+/// so the only work left to the caller thread is the compression.
+class png_rows_writer : public file_mgr
+{
+protected:
+	png_structp _png_ptr;
+	png_infop _info_ptr;
+
+public:
+	png_rows_writer( const std::string& filename ) : file_mgr( filename.c_str(), "wb" ) { init(); }
+
+	void init()
+	{
+		_png_ptr = png_create_write_struct( PNG_LIBPNG_VER_STRING, NULL, NULL, NULL );
+		io_error_if( _png_ptr == NULL, "png_rows_writer: fail to call png_create_write_struct()" );
+		_info_ptr = png_create_info_struct( _png_ptr );
+		if( _info_ptr == NULL )
+		{
+			png_destroy_write_struct( &_png_ptr, png_infopp_NULL );
+			io_error( "png_rows_writer: fail to call png_create_info_struct()" );
+		}
+		png_init_io( _png_ptr, get() );
+	}
+
+	virtual ~png_rows_writer()
+	{
+		png_destroy_write_struct( &_png_ptr, &_info_ptr );
+	}
+
+	/// \param compression_level zlib compression level, from 0 (none) to 9 (best)
+	/// \param filters combination of PNG_FILTER_* flags tried on each row
+	void apply( const unsigned char* data, const std::ptrdiff_t row_bytes,
+		    const png_uint_32 width, const png_uint_32 height,
+		    const int bit_depth, const int color_type,
+		    const int compression_level, const int filters )
+	{
+		if( setjmp( png_jmpbuf( _png_ptr ) ) )
+		{
+			io_error( "png_rows_writer: fail to write the file" );
+		}
+		png_set_IHDR( _png_ptr, _info_ptr, width, height, bit_depth, color_type,
+			      PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT );
+		png_set_compression_level( _png_ptr, compression_level );
+		png_set_filter( _png_ptr, PNG_FILTER_TYPE_BASE, filters );
+		png_write_info( _png_ptr, _info_ptr );
+
+		for( png_uint_32 y = 0; y < height; ++y )
+		{
+			png_write_row( _png_ptr, const_cast<png_bytep>( data + y * row_bytes ) );
+		}
+		png_write_end( _png_ptr, _info_ptr );
+	}
+};
+
 }
 
 /// \ingroup PNG_IO
@@ -23,6 +23,32 @@ enum ETuttlePluginComponents
 	eTuttlePluginComponentsRGBA
 };
 
+static const std::string kParamCompressionLevel      = "compressionLevel";
+static const std::string kParamCompressionLevelLabel = "Compression level";
+static const std::string kParamCompressionLevelHint  = "zlib compression level, from 0 (no compression, fastest) to 9 (smallest file, slowest).";
+
+static const std::string kParamFilter        = "filter";
+static const std::string kParamFilterLabel   = "Filter";
+static const std::string kParamFilterHint    = "Filter applied on each row before compression.\n"
+                                               "auto: libpng chooses the best filter for each row\n"
+                                               "none: fastest, good for synthetic images";
+static const std::string kParamFilterAuto    = "auto";
+static const std::string kParamFilterNone    = "none";
+static const std::string kParamFilterSub     = "sub";
+static const std::string kParamFilterUp      = "up";
+static const std::string kParamFilterAverage = "average";
+static const std::string kParamFilterPaeth   = "paeth";
+
+enum EParamFilter
+{
+	eParamFilterAuto = 0,
+	eParamFilterNone,
+	eParamFilterSub,
+	eParamFilterUp,
+	eParamFilterAverage,
+	eParamFilterPaeth
+};
+
 }
 }
 }
@@ -16,6 +16,8 @@ PngWriterPlugin::PngWriterPlugin( OfxImageEffectHandle handle )
 	: WriterPlugin( handle )
 {
 	_paramOutputComponents = fetchChoiceParam( kTuttlePluginChannel );
+	_paramCompressionLevel = fetchIntParam( kParamCompressionLevel );
+	_paramFilter           = fetchChoiceParam( kParamFilter );
 }
 
 PngWriterProcessParams PngWriterPlugin::getProcessParams( const OfxTime time )
@@ -25,6 +27,8 @@ PngWriterProcessParams PngWriterPlugin::getProcessParams( const OfxTime time )
 	params._filepath   = getAbsoluteFilenameAt( time );
 	params._components = static_cast<ETuttlePluginComponents>( this->_paramOutputComponents->getValue() );
 	params._bitDepth   = static_cast<ETuttlePluginBitDepth>( this->_paramBitDepth->getValue() );
+	params._compressionLevel = this->_paramCompressionLevel->getValue();
+	params._filter     = static_cast<EParamFilter>( this->_paramFilter->getValue() );
 
 	return params;
 }
@@ -14,6 +14,8 @@ struct PngWriterProcessParams
 	std::string             _filepath;   ///< filepath
 	ETuttlePluginComponents _components; ///< output components
 	ETuttlePluginBitDepth   _bitDepth;   ///< Output bit depth
+	int                     _compressionLevel; ///< zlib compression level
+	EParamFilter            _filter;     ///< row filter
 };
 
 /**
@@ -31,6 +33,8 @@ public:
 
 public:
 	OFX::ChoiceParam* _paramOutputComponents;     ///< Choose components RGBA or RGB
+	OFX::IntParam*    _paramCompressionLevel;     ///< zlib compression level
+	OFX::ChoiceParam* _paramFilter;               ///< row filter
 };
 
 }
@@ -65,6 +65,24 @@ void PngWriterPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc
 	dstClip->setSupportsTiles( kSupportTiles );
 
 	describeWriterParamsInContext( desc, context );
+
+	OFX::IntParamDescriptor* compressionLevel = desc.defineIntParam( kParamCompressionLevel );
+	compressionLevel->setLabel( kParamCompressionLevelLabel );
+	compressionLevel->setHint( kParamCompressionLevelHint );
+	compressionLevel->setRange( 0, 9 );
+	compressionLevel->setDisplayRange( 0, 9 );
+	compressionLevel->setDefault( 6 );
+
+	OFX::ChoiceParamDescriptor* filter = desc.defineChoiceParam( kParamFilter );
+	filter->setLabel( kParamFilterLabel );
+	filter->setHint( kParamFilterHint );
+	filter->appendOption( kParamFilterAuto );
+	filter->appendOption( kParamFilterNone );
+	filter->appendOption( kParamFilterSub );
+	filter->appendOption( kParamFilterUp );
+	filter->appendOption( kParamFilterAverage );
+	filter->appendOption( kParamFilterPaeth );
+	filter->setDefault( eParamFilterAuto );
 }
 
 /**
@@ -6,6 +6,9 @@
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
+#include <tuttle/plugin/memory/OfxAllocator.hpp>
+
+#include <vector>
 
 namespace tuttle {
 namespace plugin {
@@ -26,15 +29,27 @@ protected:
 	PngWriterPlugin&    _plugin;        ///< Rendering plugin
 
 	PngWriterProcessParams _params;
+
+	typedef std::vector<char, OfxAllocator<char> > DataVector;
+	DataVector              _data;         ///< rows converted to the file layout, filled in parallel
+	std::ptrdiff_t          _rowBytes;
+	ETuttlePluginComponents _components;   ///< output components, resolved from the input clip in auto mode
 	
 public:
 	PngWriterProcess( PngWriterPlugin& instance );
 
 	void setup( const OFX::RenderArguments& args );
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+	void postProcess();
 
+private:
 	template<class Bits>
-	void writeImage( View& src );
+	void convertRows( const View& src, const std::ptrdiff_t y );
+
+	template<class OutPixel>
+	void convertRowsToPixel( const View& src, const std::ptrdiff_t y );
+
+	void writeImage();
 };
 
 }
@@ -4,23 +4,60 @@
 #include <terry/globals.hpp>
 #include <tuttle/plugin/exceptions.hpp>
 
+#include "PngEngine/png_adds.hpp"
+
 #include <boost/gil/gil_all.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/gil/extension/io/png_io.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/cstdint.hpp>
 
 namespace tuttle {
 namespace plugin {
 namespace png {
 namespace writer {
 
+namespace detail {
+
+inline bool isLittleEndian()
+{
+	const boost::uint16_t one = 1;
+	return *reinterpret_cast<const boost::uint8_t*>( &one ) == 1;
+}
+
+/**
+ * @brief Png stores 16 bits samples in network byte order.
+ */
+inline void swapWords( boost::uint16_t* it, const boost::uint16_t* end )
+{
+	for( ; it != end; ++it )
+		*it = static_cast<boost::uint16_t>( ( *it >> 8 ) | ( *it << 8 ) );
+}
+
+inline int pngFilters( const EParamFilter filter )
+{
+	switch( filter )
+	{
+		case eParamFilterNone:    return PNG_FILTER_NONE;
+		case eParamFilterSub:     return PNG_FILTER_SUB;
+		case eParamFilterUp:      return PNG_FILTER_UP;
+		case eParamFilterAverage: return PNG_FILTER_AVG;
+		case eParamFilterPaeth:   return PNG_FILTER_PAETH;
+		case eParamFilterAuto:    break;
+	}
+	return PNG_ALL_FILTERS;
+}
+
+}
+
 template<class View>
 PngWriterProcess<View>::PngWriterProcess( PngWriterPlugin& instance )
 	: ImageGilFilterProcessor<View>( instance, eImageOrientationFromTopToBottom )
 	, _plugin( instance )
+	, _rowBytes( 0 )
+	, _components( eTuttlePluginComponentsAuto )
 {
-	this->setNoMultiThreading();
 }
 
 template<class View>
@@ -29,32 +66,64 @@ void PngWriterProcess<View>::setup( const OFX::RenderArguments& args )
 	ImageGilFilterProcessor<View>::setup( args );
 
 	_params = _plugin.getProcessParams( args.time );
+
+	_components = _params._components;
+	if( _components == eTuttlePluginComponentsAuto )
+	{
+		switch( _plugin._clipSrc->getPixelComponents() )
+		{
+			case OFX::ePixelComponentAlpha: _components = eTuttlePluginComponentsGray; break;
+			case OFX::ePixelComponentRGB:   _components = eTuttlePluginComponentsRGB;  break;
+			case OFX::ePixelComponentRGBA:  _components = eTuttlePluginComponentsRGBA; break;
+			default:
+			{
+				BOOST_THROW_EXCEPTION( exception::Unsupported()
+				    << exception::user( "Png Writer: components not supported" ) );
+				break;
+			}
+		}
+	}
+
+	const std::size_t nbComponents = ( _components == eTuttlePluginComponentsGray ) ? 1 : ( _components == eTuttlePluginComponentsRGB ) ? 3 : 4;
+	const std::size_t channelBytes = ( _params._bitDepth == eTuttlePluginBitDepth16 ) ? 2 : 1;
+	_rowBytes = this->_srcView.width() * nbComponents * channelBytes;
+	_data.resize( _rowBytes * this->_srcView.height() );
 }
 
 /**
  * @brief Function called by rendering thread each time a process must be done.
+ * Converts the rows of the processing window to the file layout,
+ * the compression is done once all rows are converted.
  * @param[in] procWindowRoW  Processing window in RoW
- * @warning no multithread here !
  */
 template<class View>
 void PngWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
 {
-	BOOST_ASSERT( procWindowRoW == this->_srcPixelRod );
 	using namespace boost::gil;
+	const OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
+	const std::ptrdiff_t nbRows = procWindowRoW.y2 - procWindowRoW.y1;
 
-	View srcView = this->_srcView;
+	const View srcRows = subimage_view( this->_srcView, 0, procWindowOutput.y1, this->_srcView.width(), nbRows );
+	const View dstRows = subimage_view( this->_dstView, 0, procWindowOutput.y1, this->_dstView.width(), nbRows );
 
+	switch( _params._bitDepth )
+	{
+		case eTuttlePluginBitDepth8:
+			convertRows<bits8>( srcRows, procWindowOutput.y1 );
+			break;
+		case eTuttlePluginBitDepth16:
+			convertRows<bits16>( srcRows, procWindowOutput.y1 );
+			break;
+	}
+	copy_pixels( srcRows, dstRows ); /// @todo ?
+}
+
+template<class View>
+void PngWriterProcess<View>::postProcess()
+{
 	try
 	{
-		switch( _params._bitDepth )
-		{
-			case eTuttlePluginBitDepth8:
-				writeImage<bits8>( srcView );
-				break;
-			case eTuttlePluginBitDepth16:
-				writeImage<bits16>( srcView );
-				break;
-		}
+		writeImage();
 	}
 	catch( exception::Common& e )
 	{
@@ -68,73 +137,75 @@ void PngWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 			<< exception::dev( boost::current_exception_diagnostic_information() )
 			<< exception::filename( _params._filepath ) );
 	}
-	copy_pixels( this->_srcView, this->_dstView ); /// @todo ?
+	ImageGilFilterProcessor<View>::postProcess();
 }
 
-/**
- *
- */
 template<class View>
 template<class Bits>
-void PngWriterProcess<View>::writeImage( View& src )
+void PngWriterProcess<View>::convertRows( const View& src, const std::ptrdiff_t y )
 {
 	using namespace boost::gil;
-	using namespace terry;
 
-	switch( _params._components )
+	switch( _components )
 	{
-		case eTuttlePluginComponentsAuto:
-		{
-			switch ( _plugin._clipSrc->getPixelComponents() )
-			{
-				case OFX::ePixelComponentAlpha:
-				{
-					typedef pixel<Bits, gray_layout_t> OutPixelType;
-					png_write_view( _params._filepath, color_converted_view<OutPixelType>( src ) );
-					break;
-				}
-				case OFX::ePixelComponentRGB:
-				{
-					typedef pixel<Bits, rgb_layout_t> OutPixelType;
-					png_write_view( _params._filepath, color_converted_view<OutPixelType>( src ) );
-					break;
-				}
-				case OFX::ePixelComponentRGBA:
-				{
-					typedef pixel<Bits, rgba_layout_t> OutPixelType;
-					png_write_view( _params._filepath, color_converted_view<OutPixelType>( src ) );
-					break;
-				}
-				default:
-				{
-					BOOST_THROW_EXCEPTION( exception::Unsupported()
-					    << exception::user( "Png Writer: components not supported" ) );
-					break;
-				}
-			}
-			break;
-		}
 		case eTuttlePluginComponentsRGBA:
-		{
-			typedef pixel<Bits, rgba_layout_t> OutPixelType;
-			png_write_view( _params._filepath, color_converted_view<OutPixelType>( src ) );
+			convertRowsToPixel<pixel<Bits, rgba_layout_t> >( src, y );
 			break;
-		}
 		case eTuttlePluginComponentsRGB:
-		{
-			typedef pixel<Bits, rgb_layout_t> OutPixelType;
-			png_write_view( _params._filepath, color_converted_view<OutPixelType>( src ) );
+			convertRowsToPixel<pixel<Bits, rgb_layout_t> >( src, y );
 			break;
-		}
 		case eTuttlePluginComponentsGray:
-		{
-			typedef pixel<Bits, gray_layout_t> OutPixelType;
-			png_write_view( _params._filepath, color_converted_view<OutPixelType>( src ) );
+			convertRowsToPixel<pixel<Bits, gray_layout_t> >( src, y );
 			break;
-		}
+		case eTuttlePluginComponentsAuto:
+			break;
+	}
+}
+
+/**
+ * @brief Convert rows into the staging buffer, starting at row @p y.
+ */
+template<class View>
+template<class OutPixel>
+void PngWriterProcess<View>::convertRowsToPixel( const View& src, const std::ptrdiff_t y )
+{
+	using namespace boost::gil;
+	using namespace terry;
+	typedef typename view_type_from_pixel<OutPixel>::type OutView;
+	typedef typename channel_type<OutPixel>::type OutChannel;
+
+	char* rowsBegin = &_data[y * _rowBytes];
+	OutView rows = interleaved_view( src.width(), src.height(), reinterpret_cast<OutPixel*>( rowsBegin ), _rowBytes );
+	copy_and_convert_pixels( src, rows );
+
+	if( sizeof( OutChannel ) == 2 && detail::isLittleEndian() )
+	{
+		detail::swapWords( reinterpret_cast<boost::uint16_t*>( rowsBegin ),
+		                   reinterpret_cast<const boost::uint16_t*>( rowsBegin + src.height() * _rowBytes ) );
 	}
 }
 
+template<class View>
+void PngWriterProcess<View>::writeImage()
+{
+	using namespace boost::gil;
+
+	int colorType = PNG_COLOR_TYPE_RGB_ALPHA;
+	switch( _components )
+	{
+		case eTuttlePluginComponentsGray: colorType = PNG_COLOR_TYPE_GRAY; break;
+		case eTuttlePluginComponentsRGB:  colorType = PNG_COLOR_TYPE_RGB;  break;
+		case eTuttlePluginComponentsRGBA:
+		case eTuttlePluginComponentsAuto: break;
+	}
+
+	boost::gil::detail::png_rows_writer writer( _params._filepath );
+	writer.apply( reinterpret_cast<const unsigned char*>( &_data.front() ), _rowBytes,
+	              this->_srcView.width(), this->_srcView.height(),
+	              ( _params._bitDepth == eTuttlePluginBitDepth16 ) ? 16 : 8, colorType,
+	              _params._compressionLevel, detail::pngFilters( _params._filter ) );
+}
+
 }
 }
 }
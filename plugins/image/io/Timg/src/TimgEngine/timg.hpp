@@ -0,0 +1,267 @@
+#ifndef _TUTTLE_PLUGIN_TIMG_HPP_
+#define _TUTTLE_PLUGIN_TIMG_HPP_
+
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <ofxsImageEffect.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+namespace timg {
+
+static const char            kTimgMagic[4]      = { 'T', 'I', 'M', 'G' };
+static const boost::uint32_t kTimgVersion       = 1;
+/// pixel rows start on a page boundary, so the mapped rows are aligned
+static const std::size_t     kTimgDataAlignment = 4096;
+
+enum ETimgOrientation
+{
+	eTimgOrientationBottomToTop = 0,
+	eTimgOrientationTopToBottom
+};
+
+/**
+ * @brief Fixed size header of a timg file, followed by the uncompressed pixel rows.
+ *
+ * Rows are not padded and are stored like the host images (from bottom to top).
+ * Values are in the host byte order: the format is made for local scratch files,
+ * the magic number doesn't match if the file comes from a host with another endianness.
+ */
+struct TimgHeader
+{
+	char            magic[4];
+	boost::uint32_t version;
+	boost::int32_t  rod[4];       ///< pixel region of definition: x1, y1, x2, y2
+	boost::uint32_t channelBytes; ///< 1 (8 bits), 2 (16 bits) or 4 (32 bits float)
+	boost::uint32_t nbComponents; ///< 1 (alpha), 3 (rgb) or 4 (rgba)
+	boost::uint32_t orientation;  ///< ETimgOrientation
+	boost::uint32_t rowBytes;     ///< distance between rows in the file
+	boost::uint64_t dataOffset;   ///< position of the first row in the file
+
+	std::size_t width() const  { return rod[2] - rod[0]; }
+	std::size_t height() const { return rod[3] - rod[1]; }
+	std::size_t dataBytes() const { return height() * rowBytes; }
+};
+
+inline std::size_t channelBytes( const OFX::EBitDepth bitDepth )
+{
+	switch( bitDepth )
+	{
+		case OFX::eBitDepthUByte:  return 1;
+		case OFX::eBitDepthUShort: return 2;
+		case OFX::eBitDepthFloat:  return 4;
+		case OFX::eBitDepthNone:
+		case OFX::eBitDepthCustom:
+			break;
+	}
+	BOOST_THROW_EXCEPTION( exception::BitDepthMismatch()
+		<< exception::user( "Timg: unsupported bit depth" ) );
+}
+
+inline std::size_t nbComponents( const OFX::EPixelComponent components )
+{
+	switch( components )
+	{
+		case OFX::ePixelComponentAlpha: return 1;
+		case OFX::ePixelComponentRGB:   return 3;
+		case OFX::ePixelComponentRGBA:  return 4;
+		default:
+			break;
+	}
+	BOOST_THROW_EXCEPTION( exception::InputMismatch()
+		<< exception::user( "Timg: unsupported components" ) );
+}
+
+inline OFX::EBitDepth bitDepth( const TimgHeader& header )
+{
+	switch( header.channelBytes )
+	{
+		case 1: return OFX::eBitDepthUByte;
+		case 2: return OFX::eBitDepthUShort;
+		case 4: return OFX::eBitDepthFloat;
+	}
+	return OFX::eBitDepthNone;
+}
+
+inline OFX::EPixelComponent components( const TimgHeader& header )
+{
+	switch( header.nbComponents )
+	{
+		case 1: return OFX::ePixelComponentAlpha;
+		case 3: return OFX::ePixelComponentRGB;
+		case 4: return OFX::ePixelComponentRGBA;
+	}
+	return OFX::ePixelComponentNone;
+}
+
+inline TimgHeader makeHeader( const OfxRectI& rod, const OFX::EBitDepth depth, const OFX::EPixelComponent comps )
+{
+	TimgHeader header;
+	std::memset( &header, 0, sizeof( TimgHeader ) );
+	std::memcpy( header.magic, kTimgMagic, sizeof( kTimgMagic ) );
+	header.version      = kTimgVersion;
+	header.rod[0]       = rod.x1;
+	header.rod[1]       = rod.y1;
+	header.rod[2]       = rod.x2;
+	header.rod[3]       = rod.y2;
+	header.channelBytes = channelBytes( depth );
+	header.nbComponents = nbComponents( comps );
+	header.orientation  = eTimgOrientationBottomToTop;
+	header.rowBytes     = header.width() * header.nbComponents * header.channelBytes;
+	header.dataOffset   = kTimgDataAlignment;
+	return header;
+}
+
+inline void checkHeader( const TimgHeader& header, const std::string& filename )
+{
+	if( std::memcmp( header.magic, kTimgMagic, sizeof( kTimgMagic ) ) != 0 ||
+	    header.version != kTimgVersion )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Timg: not a timg file (or written on a host with another endianness)" )
+			<< exception::filename( filename ) );
+	}
+	if( bitDepth( header ) == OFX::eBitDepthNone || components( header ) == OFX::ePixelComponentNone ||
+	    header.rod[2] < header.rod[0] || header.rod[3] < header.rod[1] ||
+	    header.rowBytes < header.width() * header.nbComponents * header.channelBytes )
+	{
+		BOOST_THROW_EXCEPTION( exception::ImageFormat()
+			<< exception::user( "Timg: corrupted header" )
+			<< exception::filename( filename ) );
+	}
+}
+
+inline TimgHeader readHeader( const std::string& filename )
+{
+	TimgHeader header;
+	std::FILE* file = std::fopen( filename.c_str(), "rb" );
+	if( file == NULL )
+	{
+		BOOST_THROW_EXCEPTION( exception::FileNotExist()
+			<< exception::user( "Timg: Unable to open file" )
+			<< exception::filename( filename ) );
+	}
+	const std::size_t nbRead = std::fread( &header, sizeof( TimgHeader ), 1, file );
+	std::fclose( file );
+	if( nbRead != 1 )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Timg: Unable to read the header" )
+			<< exception::filename( filename ) );
+	}
+	checkHeader( header, filename );
+	return header;
+}
+
+/**
+ * @brief Read-only mapping of a whole timg file, rows are used without any copy or decoding.
+ */
+class TimgMappedFile
+{
+public:
+	explicit TimgMappedFile( const std::string& filename )
+	{
+		try
+		{
+			_file = boost::interprocess::file_mapping( filename.c_str(), boost::interprocess::read_only );
+			_region = boost::interprocess::mapped_region( _file, boost::interprocess::read_only );
+		}
+		catch( boost::interprocess::interprocess_exception& e )
+		{
+			BOOST_THROW_EXCEPTION( exception::File()
+				<< exception::user( "Timg: Unable to map file" )
+				<< exception::dev( e.what() )
+				<< exception::filename( filename ) );
+		}
+		if( _region.get_size() < sizeof( TimgHeader ) )
+		{
+			BOOST_THROW_EXCEPTION( exception::File()
+				<< exception::user( "Timg: Unable to read the header" )
+				<< exception::filename( filename ) );
+		}
+		std::memcpy( &_header, _region.get_address(), sizeof( TimgHeader ) );
+		checkHeader( _header, filename );
+		if( _region.get_size() < _header.dataOffset + _header.dataBytes() )
+		{
+			BOOST_THROW_EXCEPTION( exception::File()
+				<< exception::user( "Timg: truncated file" )
+				<< exception::filename( filename ) );
+		}
+		_data = static_cast<const char*>( _region.get_address() ) + _header.dataOffset;
+	}
+
+	const TimgHeader& header() const { return _header; }
+
+	/// @param y row index from the bottom of the image
+	const char* row( const std::ptrdiff_t y ) const
+	{
+		const std::ptrdiff_t fileRow = ( _header.orientation == eTimgOrientationBottomToTop ) ? y : _header.height() - 1 - y;
+		return _data + fileRow * _header.rowBytes;
+	}
+
+private:
+	boost::interprocess::file_mapping  _file;
+	boost::interprocess::mapped_region _region;
+	TimgHeader  _header;
+	const char* _data;
+};
+
+/**
+ * @brief Writes a timg file without any intermediate buffering:
+ * one write for the header, then ideally one write for all the rows.
+ */
+class TimgFileWriter
+{
+public:
+	TimgFileWriter( const std::string& filename, const TimgHeader& header )
+	: _filename( filename )
+	{
+		_file = std::fopen( filename.c_str(), "wb" );
+		if( _file == NULL )
+		{
+			BOOST_THROW_EXCEPTION( exception::File()
+				<< exception::user( "Timg: Unable to open output file" )
+				<< exception::filename( filename ) );
+		}
+		std::setvbuf( _file, NULL, _IONBF, 0 );
+
+		// header padded up to the data offset
+		std::vector<char> headerBlock( header.dataOffset, 0 );
+		std::memcpy( &headerBlock.front(), &header, sizeof( TimgHeader ) );
+		write( &headerBlock.front(), headerBlock.size() );
+	}
+
+	~TimgFileWriter()
+	{
+		std::fclose( _file );
+	}
+
+	void write( const void* data, const std::size_t size )
+	{
+		if( size && std::fwrite( data, size, 1, _file ) != 1 )
+		{
+			BOOST_THROW_EXCEPTION( exception::File()
+				<< exception::user( "Timg: Unable to write data" )
+				<< exception::filename( _filename ) );
+		}
+	}
+
+private:
+	std::string _filename;
+	std::FILE*  _file;
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,19 @@
+#define OFXPLUGIN_VERSION_MAJOR 1
+#define OFXPLUGIN_VERSION_MINOR 0
+
+#include <tuttle/plugin/Plugin.hpp>
+#include "reader/TimgReaderPluginFactory.hpp"
+#include "writer/TimgWriterPluginFactory.hpp"
+
+namespace OFX
+{
+namespace Plugin
+{
+void getPluginIDs( OFX::PluginFactoryArray& ids )
+{
+	mAppendPluginFactory( ids, tuttle::plugin::timg::reader::TimgReaderPluginFactory, "tuttle.timgreader" );
+	mAppendPluginFactory( ids, tuttle::plugin::timg::writer::TimgWriterPluginFactory, "tuttle.timgwriter" );
+}
+
+}
+}
@@ -0,0 +1,17 @@
+#ifndef _TUTTLE_PLUGIN_TIMGREADER_DEFINITIONS_HPP_
+#define _TUTTLE_PLUGIN_TIMGREADER_DEFINITIONS_HPP_
+
+#include <tuttle/plugin/global.hpp>
+#include <tuttle/plugin/context/ReaderDefinition.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace timg {
+namespace reader {
+
+}
+}
+}
+}
+
+#endif
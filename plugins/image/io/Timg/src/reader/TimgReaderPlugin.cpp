@@ -0,0 +1,99 @@
+#include "TimgReaderPlugin.hpp"
+#include "TimgReaderProcess.hpp"
+#include "TimgReaderDefinitions.hpp"
+
+#include "TimgEngine/timg.hpp"
+
+#include <tuttle/plugin/context/ReaderPlugin.hpp>
+
+#include <boost/gil/gil_all.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/exception/all.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace timg {
+namespace reader {
+
+namespace bfs = boost::filesystem;
+
+TimgReaderPlugin::TimgReaderPlugin( OfxImageEffectHandle handle )
+	: ReaderPlugin( handle )
+{}
+
+TimgReaderProcessParams TimgReaderPlugin::getProcessParams( const OfxTime time )
+{
+	TimgReaderProcessParams params;
+
+	params._filepath = getAbsoluteFilenameAt( time );
+	return params;
+}
+
+void TimgReaderPlugin::changedParam( const OFX::InstanceChangedArgs& args, const std::string& paramName )
+{
+	ReaderPlugin::changedParam( args, paramName );
+}
+
+bool TimgReaderPlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod )
+{
+	const std::string filename( getAbsoluteFilenameAt( args.time ) );
+	if( ! bfs::exists( filename ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::FileInSequenceNotExist()
+			<< exception::user( "Timg: Unable to open file" )
+			<< exception::filename( filename ) );
+	}
+
+	const TimgHeader header = readHeader( filename );
+	rod.x1 = header.rod[0];
+	rod.y1 = header.rod[1];
+	rod.x2 = header.rod[2];
+	rod.y2 = header.rod[3];
+	return true;
+}
+
+void TimgReaderPlugin::getClipPreferences( OFX::ClipPreferencesSetter& clipPreferences )
+{
+	ReaderPlugin::getClipPreferences( clipPreferences );
+	const std::string filename( getAbsoluteFirstFilename() );
+
+	if( ! bfs::exists( filename ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::FileNotExist()
+			<< exception::user( "Timg: Unable to open file" )
+			<< exception::filename( filename ) );
+	}
+	const TimgHeader header = readHeader( filename );
+
+	// by default keep the file layout, so rows are only copied
+	if( getExplicitBitDepthConversion() == eParamReaderBitDepthAuto )
+	{
+		clipPreferences.setClipBitDepth( *this->_clipDst, bitDepth( header ) );
+	}
+
+	if( getExplicitChannelConversion() == eParamReaderChannelAuto )
+	{
+		OFX::EPixelComponent comps = components( header );
+		if( comps == OFX::ePixelComponentRGB &&
+		    ! OFX::getImageEffectHostDescription()->supportsPixelComponent( OFX::ePixelComponentRGB ) )
+			comps = OFX::ePixelComponentRGBA;
+		clipPreferences.setClipComponents( *this->_clipDst, comps );
+	}
+
+	clipPreferences.setPixelAspectRatio( *this->_clipDst, 1.0 );
+}
+
+/**
+ * @brief The overridden render function
+ * @param[in]   args     Rendering parameters
+ */
+void TimgReaderPlugin::render( const OFX::RenderArguments& args )
+{
+	ReaderPlugin::render( args );
+	doGilRender<TimgReaderProcess>( *this, args );
+}
+
+}
+}
+}
+}
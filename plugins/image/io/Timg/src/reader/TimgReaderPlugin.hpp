@@ -0,0 +1,40 @@
+#ifndef _TUTTLE_PLUGIN_TIMGREADER_PLUGIN_HPP_
+#define _TUTTLE_PLUGIN_TIMGREADER_PLUGIN_HPP_
+
+#include <tuttle/plugin/context/ReaderPlugin.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace timg {
+namespace reader {
+
+struct TimgReaderProcessParams
+{
+	std::string _filepath;       ///< filepath
+};
+
+/**
+ * @brief Timg reader
+ *
+ */
+class TimgReaderPlugin : public ReaderPlugin
+{
+public:
+	TimgReaderPlugin( OfxImageEffectHandle handle );
+
+public:
+	TimgReaderProcessParams getProcessParams( const OfxTime time );
+
+	void                    changedParam( const OFX::InstanceChangedArgs& args, const std::string& paramName );
+	bool                    getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod );
+	void                    getClipPreferences( OFX::ClipPreferencesSetter& clipPreferences );
+
+	void                    render( const OFX::RenderArguments& args );
+};
+
+}
+}
+}
+}
+
+#endif
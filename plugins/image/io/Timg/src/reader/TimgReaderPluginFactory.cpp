@@ -0,0 +1,83 @@
+#include "TimgReaderPluginFactory.hpp"
+#include "TimgReaderDefinitions.hpp"
+#include "TimgReaderPlugin.hpp"
+
+#include <tuttle/plugin/context/ReaderPluginFactory.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace timg {
+namespace reader {
+
+/**
+ * @brief Function called to describe the plugin main features.
+ * @param[in, out]   desc     Effect descriptor
+ */
+void TimgReaderPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
+{
+	desc.setLabels( "TuttleTimgReader", "TimgReader",
+			"Timg file reader" );
+	desc.setPluginGrouping( "tuttle/image/io" );
+
+	desc.setDescription( "Timg File reader\n"
+			     "Plugin is used to read timg files: uncompressed images in the host memory layout, "
+			     "made for scratch intermediates of a graph (caches, precomps). "
+			     "Files are memory mapped, so rows are directly copied from the page cache "
+			     "when the output has the same bit depth and components as the file.\n\n"
+			     "supported extensions:\n"
+			     "timg" );
+
+	// add the supported contexts
+	desc.addSupportedContext( OFX::eContextReader );
+	desc.addSupportedContext( OFX::eContextGeneral );
+
+	// add supported pixel depths
+	desc.addSupportedBitDepth( OFX::eBitDepthUByte );
+	desc.addSupportedBitDepth( OFX::eBitDepthUShort );
+	desc.addSupportedBitDepth( OFX::eBitDepthFloat );
+
+	// add supported extensions
+	desc.addSupportedExtension( "timg" );
+
+	// plugin flags
+	desc.setRenderThreadSafety( OFX::eRenderFullySafe );
+	desc.setHostFrameThreading( false );
+	desc.setSupportsMultiResolution( false );
+	desc.setSupportsMultipleClipDepths( true );
+	desc.setSupportsTiles( kSupportTiles );
+}
+
+/**
+ * @brief Function called to describe the plugin controls and features.
+ * @param[in, out]   desc       Effect descriptor
+ * @param[in]        context    Application context
+ */
+void TimgReaderPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
+						 OFX::EContext               context )
+{
+	// Create the mandated output clip
+	OFX::ClipDescriptor* dstClip = desc.defineClip( kOfxImageEffectOutputClipName );
+	dstClip->addSupportedComponent( OFX::ePixelComponentRGBA );
+	dstClip->addSupportedComponent( OFX::ePixelComponentRGB );
+	dstClip->addSupportedComponent( OFX::ePixelComponentAlpha );
+	dstClip->setSupportsTiles( kSupportTiles );
+
+	describeReaderParamsInContext( desc, context );
+}
+
+/**
+ * @brief Function called to create a plugin effect instance
+ * @param[in] handle  effect handle
+ * @param[in] context    Application context
+ * @return  plugin instance
+ */
+OFX::ImageEffect* TimgReaderPluginFactory::createInstance( OfxImageEffectHandle handle,
+							   OFX::EContext        context )
+{
+	return new TimgReaderPlugin( handle );
+}
+
+}
+}
+}
+}
@@ -0,0 +1,21 @@
+#ifndef _TUTTLE_PLUGIN_TIMGREADER_PLUGIN_FACTORY_HPP_
+#define _TUTTLE_PLUGIN_TIMGREADER_PLUGIN_FACTORY_HPP_
+
+#include <ofxsImageEffect.h>
+
+namespace tuttle {
+namespace plugin {
+namespace timg {
+namespace reader {
+
+static const bool kSupportTiles = false;
+
+mDeclarePluginFactory( TimgReaderPluginFactory, {}, {}
+                       );
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef _TUTTLE_PLUGIN_TIMGREADER_PROCESS_HPP_
+#define _TUTTLE_PLUGIN_TIMGREADER_PROCESS_HPP_
+
+#include "TimgEngine/timg.hpp"
+
+#include <tuttle/plugin/ImageGilProcessor.hpp>
+
+#include <boost/scoped_ptr.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace timg {
+namespace reader {
+
+/**
+ * @brief Copy the rows of a memory mapped timg file into the output image.
+ * Each thread copies its own rows, directly from the mapping.
+ */
+template<class View>
+class TimgReaderProcess : public ImageGilProcessor<View>
+{
+protected:
+	TimgReaderPlugin&    _plugin;        ///< Rendering plugin
+
+	TimgReaderProcessParams _params;
+	boost::scoped_ptr<TimgMappedFile> _file;
+
+public:
+	TimgReaderProcess( TimgReaderPlugin& instance );
+
+	void setup( const OFX::RenderArguments& args );
+	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+
+private:
+	template<class FileView>
+	void readRows( const OfxRectI& procWindowOutput );
+};
+
+}
+}
+}
+}
+
+#include "TimgReaderProcess.tcc"
+
+#endif
@@ -0,0 +1,126 @@
+#include "TimgReaderDefinitions.hpp"
+#include "TimgReaderProcess.hpp"
+#include "TimgReaderPlugin.hpp"
+
+#include <terry/globals.hpp>
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <boost/gil/gil_all.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/assert.hpp>
+
+#include <cstring>
+
+namespace tuttle {
+namespace plugin {
+namespace timg {
+namespace reader {
+
+using namespace boost::gil;
+
+namespace detail {
+
+/// same pixel layout: a single memcpy per row
+template<class View, class FileView>
+void copyRow( const char* src, const View& dst, const std::ptrdiff_t y, const boost::true_type )
+{
+	std::memcpy( &dst( 0, y ), src, dst.width() * sizeof( typename View::value_type ) );
+}
+
+template<class View, class FileView>
+void copyRow( const char* src, const View& dst, const std::ptrdiff_t y, const boost::false_type )
+{
+	typedef typename FileView::value_type FilePixel;
+	const FileView srcRow = interleaved_view( dst.width(), 1,
+	                                          reinterpret_cast<const FilePixel*>( src ),
+	                                          dst.width() * sizeof( FilePixel ) );
+	copy_and_convert_pixels( srcRow, subimage_view( dst, 0, y, dst.width(), 1 ) );
+}
+
+}
+
+template<class View>
+TimgReaderProcess<View>::TimgReaderProcess( TimgReaderPlugin& instance )
+	: ImageGilProcessor<View>( instance, eImageOrientationFromBottomToTop )
+	, _plugin( instance )
+{
+}
+
+template<class View>
+void TimgReaderProcess<View>::setup( const OFX::RenderArguments& args )
+{
+	ImageGilProcessor<View>::setup( args );
+
+	_params = _plugin.getProcessParams( args.time );
+	_file.reset( new TimgMappedFile( _params._filepath ) );
+
+	const TimgHeader& header = _file->header();
+	if( std::ptrdiff_t( header.width() ) != this->_dstView.width() ||
+	    std::ptrdiff_t( header.height() ) != this->_dstView.height() )
+	{
+		BOOST_THROW_EXCEPTION( exception::Unsupported()
+			<< exception::user( "Timg: the file size doesn't match the output image (render scale is not supported)." )
+			<< exception::filename( _params._filepath ) );
+	}
+}
+
+/**
+ * @brief Function called by rendering thread each time a process must be done.
+ * @param[in] procWindowRoW  Processing window in RoW
+ */
+template<class View>
+void TimgReaderProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
+{
+	const OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
+	const TimgHeader& header = _file->header();
+
+	switch( header.nbComponents )
+	{
+		case 1:
+			switch( header.channelBytes )
+			{
+				case 1: readRows<gray8c_view_t>( procWindowOutput ); return;
+				case 2: readRows<gray16c_view_t>( procWindowOutput ); return;
+				case 4: readRows<gray32fc_view_t>( procWindowOutput ); return;
+			}
+			break;
+		case 3:
+			switch( header.channelBytes )
+			{
+				case 1: readRows<rgb8c_view_t>( procWindowOutput ); return;
+				case 2: readRows<rgb16c_view_t>( procWindowOutput ); return;
+				case 4: readRows<rgb32fc_view_t>( procWindowOutput ); return;
+			}
+			break;
+		case 4:
+			switch( header.channelBytes )
+			{
+				case 1: readRows<rgba8c_view_t>( procWindowOutput ); return;
+				case 2: readRows<rgba16c_view_t>( procWindowOutput ); return;
+				case 4: readRows<rgba32fc_view_t>( procWindowOutput ); return;
+			}
+			break;
+	}
+	BOOST_THROW_EXCEPTION( exception::ImageFormat()
+		<< exception::user( "Timg: unsupported pixel type" )
+		<< exception::filename( _params._filepath ) );
+}
+
+template<class View>
+template<class FileView>
+void TimgReaderProcess<View>::readRows( const OfxRectI& procWindowOutput )
+{
+	typedef typename boost::is_same<typename View::value_type, typename FileView::value_type>::type SameLayout;
+
+	for( int y = procWindowOutput.y1; y < procWindowOutput.y2; ++y )
+	{
+		detail::copyRow<View, FileView>( _file->row( y ), this->_dstView, y, SameLayout() );
+		if( this->progressForward( procWindowOutput.x2 - procWindowOutput.x1 ) )
+			return;
+	}
+}
+
+}
+}
+}
+}
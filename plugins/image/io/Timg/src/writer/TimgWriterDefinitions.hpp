@@ -0,0 +1,17 @@
+#ifndef _TUTTLE_PLUGIN_TIMGWRITER_DEFINITIONS_HPP_
+#define _TUTTLE_PLUGIN_TIMGWRITER_DEFINITIONS_HPP_
+
+#include <tuttle/plugin/context/WriterDefinition.hpp>
+#include <tuttle/plugin/global.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace timg {
+namespace writer {
+
+}
+}
+}
+}
+
+#endif
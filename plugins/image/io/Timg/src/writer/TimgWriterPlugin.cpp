@@ -0,0 +1,39 @@
+#include "TimgWriterDefinitions.hpp"
+#include "TimgWriterPlugin.hpp"
+#include "TimgWriterProcess.hpp"
+
+#include <boost/gil/gil_all.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace timg {
+namespace writer {
+
+TimgWriterPlugin::TimgWriterPlugin( OfxImageEffectHandle handle )
+	: WriterPlugin( handle )
+{
+}
+
+TimgWriterProcessParams TimgWriterPlugin::getProcessParams( const OfxTime time )
+{
+	TimgWriterProcessParams params;
+
+	params._filepath = getAbsoluteFilenameAt( time );
+	return params;
+}
+
+/**
+ * @brief The overridden render function
+ * @param[in]   args     Rendering parameters
+ */
+void TimgWriterPlugin::render( const OFX::RenderArguments& args )
+{
+	WriterPlugin::render( args );
+
+	doGilRender<TimgWriterProcess>( *this, args );
+}
+
+}
+}
+}
+}
@@ -0,0 +1,36 @@
+#ifndef _TUTTLE_PLUGIN_TIMGWRITER_PLUGIN_HPP_
+#define _TUTTLE_PLUGIN_TIMGWRITER_PLUGIN_HPP_
+
+#include "TimgWriterDefinitions.hpp"
+
+#include <tuttle/plugin/context/WriterPlugin.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace timg {
+namespace writer {
+
+struct TimgWriterProcessParams
+{
+	std::string _filepath;      ///< filepath
+};
+
+/**
+ * @brief Timg writer
+ */
+class TimgWriterPlugin : public WriterPlugin
+{
+public:
+	TimgWriterPlugin( OfxImageEffectHandle handle );
+
+public:
+	TimgWriterProcessParams getProcessParams( const OfxTime time );
+	void                    render( const OFX::RenderArguments& args );
+};
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,107 @@
+#include "TimgWriterPluginFactory.hpp"
+#include "TimgWriterDefinitions.hpp"
+#include "TimgWriterPlugin.hpp"
+
+#include <tuttle/plugin/context/WriterPluginFactory.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace timg {
+namespace writer {
+
+/**
+ * @brief Function called to describe the plugin main features.
+ * @param[in, out]   desc     Effect descriptor
+ */
+void TimgWriterPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
+{
+	desc.setLabels( "TuttleTimgWriter", "TimgWriter",
+			"Timg file writer" );
+	desc.setPluginGrouping( "tuttle/image/io" );
+
+	desc.setDescription( "Timg File writer\n"
+			     "Plugin is used to write timg files: uncompressed images in the host memory layout, "
+			     "made for scratch intermediates of a graph (caches, precomps). "
+			     "The image is written as is, without conversion, compression or buffering. "
+			     "The file is only readable on a host with the same endianness.\n\n"
+			     "supported extensions:\n"
+			     "timg" );
+
+	// add the supported contexts
+	desc.addSupportedContext( OFX::eContextWriter );
+	desc.addSupportedContext( OFX::eContextGeneral );
+
+	// add supported pixel depths
+	desc.addSupportedBitDepth( OFX::eBitDepthUByte );
+	desc.addSupportedBitDepth( OFX::eBitDepthUShort );
+	desc.addSupportedBitDepth( OFX::eBitDepthFloat );
+
+	// add supported extensions
+	desc.addSupportedExtension( "timg" );
+
+	// plugin flags
+	desc.setRenderThreadSafety( OFX::eRenderFullySafe );
+	desc.setHostFrameThreading( false );
+	desc.setSupportsMultiResolution( false );
+	desc.setSupportsMultipleClipDepths( true );
+	desc.setSupportsTiles( kSupportTiles );
+}
+
+/**
+ * @brief Function called to describe the plugin controls and features.
+ * @param[in, out]   desc       Effect descriptor
+ * @param[in]        context    Application context
+ */
+void TimgWriterPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
+						 OFX::EContext               context )
+{
+	OFX::ClipDescriptor* srcClip = desc.defineClip( kOfxImageEffectSimpleSourceClipName );
+
+	srcClip->addSupportedComponent( OFX::ePixelComponentRGBA );
+	srcClip->addSupportedComponent( OFX::ePixelComponentRGB );
+	srcClip->addSupportedComponent( OFX::ePixelComponentAlpha );
+	srcClip->setSupportsTiles( kSupportTiles );
+
+	OFX::ClipDescriptor* dstClip = desc.defineClip( kOfxImageEffectOutputClipName );
+	dstClip->addSupportedComponent( OFX::ePixelComponentRGBA );
+	dstClip->addSupportedComponent( OFX::ePixelComponentRGB );
+	dstClip->addSupportedComponent( OFX::ePixelComponentAlpha );
+	dstClip->setSupportsTiles( kSupportTiles );
+
+	// Controls
+	describeWriterParamsInContext( desc, context );
+
+	// the file always keeps the bit depth and the components of the input clip
+	OFX::ChoiceParamDescriptor* bitDepth = static_cast<OFX::ChoiceParamDescriptor*>( desc.getParamDescriptor( kTuttlePluginBitDepth ) );
+	bitDepth->resetOptions();
+	bitDepth->appendOption( kTuttlePluginBitDepthAuto );
+	bitDepth->setDefault( 0 );
+	bitDepth->setEnabled( false );
+
+	OFX::ChoiceParamDescriptor* channel = static_cast<OFX::ChoiceParamDescriptor*>( desc.getParamDescriptor( kTuttlePluginChannel ) );
+	channel->resetOptions();
+	channel->appendOption( kTuttlePluginChannelAuto );
+	channel->setDefault( 0 );
+	channel->setEnabled( false );
+
+	OFX::BooleanParamDescriptor* premult = static_cast<OFX::BooleanParamDescriptor*>( desc.getParamDescriptor( kParamPremultiplied ) );
+	premult->setDefault( false );
+	premult->setEnabled( false );
+}
+
+/**
+ * @brief Function called to create a plugin effect instance
+ * @param[in] handle  effect handle
+ * @param[in] context    Application context
+ * @return  plugin instance
+ */
+OFX::ImageEffect* TimgWriterPluginFactory::createInstance( OfxImageEffectHandle handle,
+							   OFX::EContext        context )
+{
+	return new TimgWriterPlugin( handle );
+}
+
+}
+}
+}
+}
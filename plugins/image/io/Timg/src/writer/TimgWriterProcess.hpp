@@ -0,0 +1,45 @@
+#ifndef _TUTTLE_PLUGIN_TIMGWRITER_PROCESS_HPP_
+#define _TUTTLE_PLUGIN_TIMGWRITER_PROCESS_HPP_
+
+#include <tuttle/plugin/global.hpp>
+#include <tuttle/plugin/ImageGilFilterProcessor.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace timg {
+namespace writer {
+
+/**
+ * @brief Dumps the source image in a timg file.
+ * The output clip is filled in parallel, the file is written at once in postProcess.
+ */
+template<class View>
+class TimgWriterProcess : public ImageGilFilterProcessor<View>
+{
+public:
+	typedef typename View::value_type Pixel;
+
+protected:
+	TimgWriterPlugin&    _plugin;        ///< Rendering plugin
+	TimgWriterProcessParams _params;
+
+public:
+	TimgWriterProcess( TimgWriterPlugin& instance );
+
+	void setup( const OFX::RenderArguments& args );
+
+	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+	void postProcess();
+
+private:
+	void writeImage();
+};
+
+}
+}
+}
+}
+
+#include "TimgWriterProcess.tcc"
+
+#endif
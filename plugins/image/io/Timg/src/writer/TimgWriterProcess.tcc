@@ -0,0 +1,95 @@
+#include "TimgWriterDefinitions.hpp"
+#include "TimgWriterPlugin.hpp"
+
+#include "TimgEngine/timg.hpp"
+
+#include <terry/globals.hpp>
+#include <tuttle/plugin/exceptions.hpp>
+
+#include <boost/gil/gil_all.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace timg {
+namespace writer {
+
+template<class View>
+TimgWriterProcess<View>::TimgWriterProcess( TimgWriterPlugin& instance )
+	: ImageGilFilterProcessor<View>( instance, eImageOrientationFromBottomToTop )
+	, _plugin( instance )
+{
+}
+
+template<class View>
+void TimgWriterProcess<View>::setup( const OFX::RenderArguments& args )
+{
+	ImageGilFilterProcessor<View>::setup( args );
+
+	_params = _plugin.getProcessParams( args.time );
+}
+
+/**
+ * @brief Function called by rendering thread each time a process must be done.
+ * @param[in] procWindowRoW  Processing window in RoW
+ */
+template<class View>
+void TimgWriterProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
+{
+	using namespace boost::gil;
+	const OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
+	const std::ptrdiff_t nbRows = procWindowRoW.y2 - procWindowRoW.y1;
+
+	copy_pixels( subimage_view( this->_srcView, 0, procWindowOutput.y1, this->_srcView.width(), nbRows ),
+	             subimage_view( this->_dstView, 0, procWindowOutput.y1, this->_dstView.width(), nbRows ) );
+}
+
+template<class View>
+void TimgWriterProcess<View>::postProcess()
+{
+	try
+	{
+		writeImage();
+	}
+	catch( exception::Common& e )
+	{
+		e << exception::filename( _params._filepath );
+		throw;
+	}
+	catch(...)
+	{
+		BOOST_THROW_EXCEPTION( exception::Unknown()
+			<< exception::user( "Unable to write image" )
+			<< exception::dev( boost::current_exception_diagnostic_information() )
+			<< exception::filename( _params._filepath ) );
+	}
+	ImageGilFilterProcessor<View>::postProcess();
+}
+
+template<class View>
+void TimgWriterProcess<View>::writeImage()
+{
+	const TimgHeader header = makeHeader( this->_srcPixelRod,
+	                                      this->_src->getPixelDepth(),
+	                                      this->_src->getPixelComponents() );
+	TimgFileWriter file( _params._filepath, header );
+
+	const OfxRectI bounds = this->_src->getBounds();
+	const bool contiguous = bounds.x1 == this->_srcPixelRod.x1 && bounds.x2 == this->_srcPixelRod.x2 &&
+	                        bounds.y1 == this->_srcPixelRod.y1 && bounds.y2 == this->_srcPixelRod.y2 &&
+	                        this->_src->getRowDistanceBytes() == std::ptrdiff_t( header.rowBytes );
+	if( contiguous )
+	{
+		// the host buffer already has the file layout: a single write
+		file.write( this->_src->getPixelData(), header.dataBytes() );
+		return;
+	}
+	for( std::ptrdiff_t y = 0; y < this->_srcView.height(); ++y )
+	{
+		file.write( &this->_srcView( 0, y ), header.rowBytes );
+	}
+}
+
+}
+}
+}
+}
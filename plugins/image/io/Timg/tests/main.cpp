@@ -0,0 +1,196 @@
+#define BOOST_TEST_MODULE plugin_Timg
+#include <tuttle/test/main.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <tuttle/host/Graph.hpp>
+#include <tuttle/host/attribute/Image.hpp>
+
+#include <boost/preprocessor/stringize.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/timer.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <cstring>
+#include <list>
+#include <string>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+namespace bfs = boost::filesystem;
+
+BOOST_AUTO_TEST_SUITE( plugin_Timg_writer )
+std::string pluginName = "tuttle.timgwriter";
+std::string filename = "test-timg.timg";
+#include <tuttle/test/io/writer.hpp>
+BOOST_AUTO_TEST_SUITE_END()
+
+
+BOOST_AUTO_TEST_SUITE( plugin_Timg_reader )
+
+/**
+ * Timg file written by the writer plugin for a test case,
+ * removed at the end of the test case.
+ */
+struct TimgFile
+{
+	TimgFile()
+	: filename( ( bfs::temp_directory_path() / bfs::unique_path( "tuttle-timg-%%%%-%%%%.timg" ) ).string() )
+	{
+		Graph g;
+		Graph::Node& constant = g.createNode( "tuttle.constant" );
+		Graph::Node& writer   = g.createNode( "tuttle.timgwriter" );
+		constant.getParam( "width" ).setValue( 50 );
+		constant.getParam( "height" ).setValue( 40 );
+		writer.getParam( "filename" ).setValue( filename );
+		g.connect( constant, writer );
+
+		memory::MemoryCache outputCache;
+		g.compute( outputCache, writer );
+		writtenRod = outputCache.get( writer.getName(), 0 )->getROD();
+	}
+
+	~TimgFile()
+	{
+		boost::system::error_code error;
+		bfs::remove( filename, error );
+	}
+
+	std::string filename;
+	OfxRectI writtenRod;
+};
+
+BOOST_FIXTURE_TEST_CASE( process_reader, TimgFile )
+{
+	TUTTLE_LOG_INFO( "******** PROCESS READER tuttle.timgreader ********" );
+	Graph g;
+	Graph::Node& read = g.createNode( "tuttle.timgreader" );
+	read.getParam( "filename" ).setValue( filename );
+
+	memory::MemoryCache outputCache;
+	g.compute( outputCache, read );
+
+	memory::CACHE_ELEMENT imgRes = outputCache.get( read.getName(), 0 );
+
+	TUTTLE_TLOG_VAR( TUTTLE_INFO, imgRes->getROD() );
+	BOOST_CHECK_EQUAL( imgRes->getROD().x1, writtenRod.x1 );
+	BOOST_CHECK_EQUAL( imgRes->getROD().y1, writtenRod.y1 );
+	BOOST_CHECK_EQUAL( imgRes->getROD().x2, writtenRod.x2 );
+	BOOST_CHECK_EQUAL( imgRes->getROD().y2, writtenRod.y2 );
+
+	TUTTLE_TLOG_VAR( TUTTLE_INFO, imgRes->getBounds() );
+	BOOST_CHECK_EQUAL( imgRes->getBounds().x1, writtenRod.x1 );
+	BOOST_CHECK_EQUAL( imgRes->getBounds().y1, writtenRod.y1 );
+	BOOST_CHECK_EQUAL( imgRes->getBounds().x2, writtenRod.x2 );
+	BOOST_CHECK_EQUAL( imgRes->getBounds().y2, writtenRod.y2 );
+}
+
+BOOST_FIXTURE_TEST_CASE( process_reader_twice, TimgFile )
+{
+	TUTTLE_LOG_INFO( "******** PROCESS READER tuttle.timgreader TWICE ********" );
+	// the file is mapped by the reader, a second graph reads it again
+	for( int i = 0; i < 2; ++i )
+	{
+		Graph g;
+		Graph::Node& read = g.createNode( "tuttle.timgreader" );
+		read.getParam( "filename" ).setValue( filename );
+
+		memory::MemoryCache outputCache;
+		g.compute( outputCache, read );
+		BOOST_CHECK_EQUAL( outputCache.get( read.getName(), 0 )->getROD().x2, writtenRod.x2 );
+	}
+}
+
+/**
+ * Write an image varying in both directions and read it back:
+ * the file keeps the layout of the source, so the buffers must be the same.
+ * @param explicitConversion bit depth of the source: 1: 8 bits, 2: 16 bits, 3: 32 bits float
+ */
+void checkPixelsRoundTrip( const int explicitConversion )
+{
+	const std::string filename = ( bfs::temp_directory_path() / bfs::unique_path( "tuttle-timg-%%%%-%%%%.timg" ) ).string();
+
+	Graph gWrite;
+	Graph::Node& source = gWrite.createNode( "tuttle.colorwheel" );
+	Graph::Node& writer = gWrite.createNode( "tuttle.timgwriter" );
+	source.getParam( "type" ).setValue( 2 ); // rainbow
+	source.getParam( "explicitConversion" ).setValue( explicitConversion );
+	source.getParam( "mode" ).setValue( 1 ); // size
+	source.getParam( "specificRatio" ).setValue( false );
+	source.getParam( "size" ).setValue( 61, 35 );
+	writer.getParam( "filename" ).setValue( filename );
+	gWrite.connect( source, writer );
+
+	std::list<std::string> outputs;
+	outputs.push_back( source.getName() );
+	outputs.push_back( writer.getName() );
+	memory::MemoryCache writeCache;
+	BOOST_REQUIRE( gWrite.compute( writeCache, outputs ) );
+
+	Graph gRead;
+	Graph::Node& reader = gRead.createNode( "tuttle.timgreader" );
+	reader.getParam( "filename" ).setValue( filename );
+	memory::MemoryCache readCache;
+	BOOST_REQUIRE( gRead.compute( readCache, reader ) );
+
+	boost::system::error_code error;
+	bfs::remove( filename, error );
+
+	memory::CACHE_ELEMENT sourceImg = writeCache.get( source.getName(), 0 );
+	memory::CACHE_ELEMENT readImg = readCache.get( reader.getName(), 0 );
+	BOOST_REQUIRE( sourceImg.get() != NULL );
+	BOOST_REQUIRE( readImg.get() != NULL );
+
+	const OfxRectI sourceBounds = sourceImg->getBounds();
+	const OfxRectI readBounds = readImg->getBounds();
+	BOOST_REQUIRE_EQUAL( readBounds.x1, sourceBounds.x1 );
+	BOOST_REQUIRE_EQUAL( readBounds.y1, sourceBounds.y1 );
+	BOOST_REQUIRE_EQUAL( readBounds.x2, sourceBounds.x2 );
+	BOOST_REQUIRE_EQUAL( readBounds.y2, sourceBounds.y2 );
+	BOOST_REQUIRE_EQUAL( readImg->getBitDepth(), sourceImg->getBitDepth() );
+	BOOST_REQUIRE_EQUAL( readImg->getNbComponents(), sourceImg->getNbComponents() );
+
+	const std::size_t rowSize = ( sourceBounds.x2 - sourceBounds.x1 ) * sourceImg->getNbComponents() * sourceImg->getBitDepthMemorySize();
+	const boost::uint8_t* sourceRow = sourceImg->getOrientedPixelData( attribute::Image::eImageOrientationFromBottomToTop );
+	const boost::uint8_t* readRow = readImg->getOrientedPixelData( attribute::Image::eImageOrientationFromBottomToTop );
+	const int sourceDistance = sourceImg->getOrientedRowDistanceBytes( attribute::Image::eImageOrientationFromBottomToTop );
+	const int readDistance = readImg->getOrientedRowDistanceBytes( attribute::Image::eImageOrientationFromBottomToTop );
+	int differentRows = 0;
+	for( int y = sourceBounds.y1; y < sourceBounds.y2; ++y, sourceRow += sourceDistance, readRow += readDistance )
+	{
+		if( std::memcmp( sourceRow, readRow, rowSize ) != 0 )
+			++differentRows;
+	}
+	BOOST_CHECK_EQUAL( differentRows, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( process_pixels_8bits )
+{
+	TUTTLE_LOG_INFO( "******** PROCESS WRITER/READER tuttle.timg PIXELS 8 BITS ********" );
+	checkPixelsRoundTrip( 1 );
+}
+
+BOOST_AUTO_TEST_CASE( process_pixels_16bits )
+{
+	TUTTLE_LOG_INFO( "******** PROCESS WRITER/READER tuttle.timg PIXELS 16 BITS ********" );
+	checkPixelsRoundTrip( 2 );
+}
+
+BOOST_AUTO_TEST_CASE( process_pixels_32fbits )
+{
+	TUTTLE_LOG_INFO( "******** PROCESS WRITER/READER tuttle.timg PIXELS 32 BITS FLOAT ********" );
+	checkPixelsRoundTrip( 3 );
+}
+
+BOOST_AUTO_TEST_CASE( process_nofile )
+{
+	TUTTLE_LOG_INFO( "******** PROCESS READER tuttle.timgreader NO FILE ********" );
+	Graph g;
+	Graph::Node& read = g.createNode( "tuttle.timgreader" );
+	read.getParam( "filename" ).setValue( "data/no-such-file" );
+
+	BOOST_REQUIRE_THROW( g.compute( read ), boost::exception );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,11 +1,65 @@
 #ifndef _TUTTLE_PLUGIN_TURBOJPEG_READER_ALGORITHM_HPP_
 #define _TUTTLE_PLUGIN_TURBOJPEG_READER_ALGORITHM_HPP_
 
+#include <boost/gil/gil_all.hpp>
+
+#include <turbojpeg.h>
+
+#include <vector>
+
 namespace tuttle {
 namespace plugin {
 namespace turboJpeg {
 namespace reader {
 
+/**
+ * @brief Select the smallest DCT-domain scaling factor supported by libjpeg-turbo
+ * which decodes an image at least as big as the requested size.
+ * @return 1/1 if no downscaling factor is big enough.
+ */
+inline tjscalingfactor selectScalingFactor( const int width, const int height, const int requestedWidth, const int requestedHeight )
+{
+	tjscalingfactor best = { 1, 1 };
+	int bestWidth = width;
+
+	int nbFactors = 0;
+	const tjscalingfactor* factors = tjGetScalingFactors( &nbFactors );
+	for( int i = 0; i < nbFactors; ++i )
+	{
+		const int scaledWidth  = TJSCALED( width, factors[i] );
+		const int scaledHeight = TJSCALED( height, factors[i] );
+		if( scaledWidth >= requestedWidth && scaledHeight >= requestedHeight && scaledWidth < bestWidth )
+		{
+			best = factors[i];
+			bestWidth = scaledWidth;
+		}
+	}
+	return best;
+}
+
+/**
+ * @brief Nearest neighbor resize with color conversion.
+ * Used for the remaining scale once decoded at the nearest DCT scaling factor,
+ * which is always a small downscale.
+ */
+template<class SrcView, class DstView>
+void resizeAndConvertPixels( const SrcView& src, const DstView& dst )
+{
+	using namespace boost::gil;
+	std::vector<std::ptrdiff_t> srcX( dst.width() );
+	for( std::ptrdiff_t x = 0; x < dst.width(); ++x )
+		srcX[x] = ( x * src.width() ) / dst.width();
+
+	default_color_converter converter;
+	for( std::ptrdiff_t y = 0; y < dst.height(); ++y )
+	{
+		typename SrcView::x_iterator srcRow = src.row_begin( ( y * src.height() ) / dst.height() );
+		typename DstView::x_iterator dstRow = dst.row_begin( y );
+		for( std::ptrdiff_t x = 0; x < dst.width(); ++x )
+			converter( srcRow[srcX[x]], dstRow[x] );
+	}
+}
+
 }
 }
 }
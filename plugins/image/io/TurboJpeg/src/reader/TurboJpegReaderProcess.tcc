@@ -86,12 +86,18 @@ void TurboJpegReaderProcess<View>::readImage( View& dst )
 			<< exception::filename( _params.filepath ) );
 	}
 	
-	yuvsize = tjBufSizeYUV( width, height, jpegsubsamp );
-	bufsize = tjBufSize( width, height, jpegsubsamp );
+	// with a render scale, dst is smaller than the image:
+	// decode directly at the nearest DCT scaling factor instead of decoding all the pixels.
+	const tjscalingfactor scalingFactor = selectScalingFactor( width, height, dst.width(), dst.height() );
+	const int scaledWidth  = TJSCALED( width, scalingFactor );
+	const int scaledHeight = TJSCALED( height, scalingFactor );
+
+	yuvsize = tjBufSizeYUV( scaledWidth, scaledHeight, jpegsubsamp );
+	bufsize = scaledWidth * scaledHeight * tjPixelSize[ps];
 	
 	rgbbuf = new unsigned char[ bufsize ];
 	
-	ret = tjDecompress2( jpeghandle, jpegbuf, jpgbufsize, rgbbuf, width, 0, height, ps, flags );
+	ret = tjDecompress2( jpeghandle, jpegbuf, jpgbufsize, rgbbuf, scaledWidth, 0, scaledHeight, ps, flags );
 	if( ret != 0 )
 	{
 		BOOST_THROW_EXCEPTION( exception::File()
@@ -99,11 +105,19 @@ void TurboJpegReaderProcess<View>::readImage( View& dst )
 			<< exception::filename( _params.filepath ) );
 	}
 	
-	rgb8_view_t bufferView = interleaved_view( width, height,
+	rgb8_view_t bufferView = interleaved_view( scaledWidth, scaledHeight,
 											( typename rgb8_view_t::value_type* )( rgbbuf ),
-											 width * sizeof( typename rgb8_view_t::value_type ) );
+											 scaledWidth * sizeof( typename rgb8_view_t::value_type ) );
 	
-	boost::gil::copy_and_convert_pixels( bufferView, dst );
+	if( bufferView.dimensions() == dst.dimensions() )
+	{
+		boost::gil::copy_and_convert_pixels( bufferView, dst );
+	}
+	else
+	{
+		// the render scale is not one of the DCT scaling factors
+		resizeAndConvertPixels( bufferView, dst );
+	}
 	
 	delete[] jpegbuf; jpegbuf = NULL;
 	delete[] rgbbuf;  rgbbuf = NULL;
@@ -45,6 +45,7 @@ void BitDepthPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
 
 	// plugin flags
 	desc.setSupportsTiles( kSupportTiles );
+	desc.setIsPointOperation( true );
 	desc.setSupportsMultipleClipDepths( true );
 	desc.setRenderThreadSafety( OFX::eRenderFullySafe );
 }
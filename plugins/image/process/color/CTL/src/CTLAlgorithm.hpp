@@ -1,14 +1,187 @@
 #ifndef _TUTTLE_PLUGIN_CTL_ALGORITHM_HPP_
 #define _TUTTLE_PLUGIN_CTL_ALGORITHM_HPP_
 
+#include "CTLPlugin.hpp"
+
 #include <terry/channel.hpp>
+#include <terry/color/lut3d.hpp>
+
+#include <CtlSimdInterpreter.h>
+#include <Iex.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
 
 namespace tuttle {
 namespace plugin {
 namespace ctl {
 
+/**
+ * @brief HACK: workaround CTL limitation to load a module which source code
+ * comes from a string and not a file.
+ */
+void loadModule( Ctl::Interpreter& interpreter, const std::string &moduleName, const std::string& code );
+void loadModuleRecursive( Ctl::Interpreter& interpreter,const std::string &moduleName, const std::string& code );
+
+template<class Type>
+void fillInputArg( Ctl::FunctionArgPtr& arg, const std::string& argStr, const Type& v, const std::size_t n )
+{
+	if( !arg ||
+//		!arg->type().cast<half>() ||
+		!arg->isVarying( ) )
+	{
+		// The CTL function has no argument argStr, the argument
+		// is not of type half, or the argument is not varying
+		BOOST_THROW_EXCEPTION( Iex::ArgExc( std::string("Cannot set value of argument ")+argStr ) );
+	}
+
+	memcpy( arg->data(), &v, n*sizeof(Type) );
+}
+
+template<class Type>
+void retrieveOutputArg( const Ctl::FunctionArgPtr& arg, const std::string& argStr, Type& v, const std::size_t n )
+{
+	if( !arg ||
+//		!arg->type( ).cast<half>() ||
+		!arg->isVarying( ) )
+	{
+		// The CTL function has no argument argStr, the argument
+		// is not of type half, or the argument is not varying
+		BOOST_THROW_EXCEPTION( Iex::ArgExc( std::string("Cannot set value of argument ")+argStr ) );
+	}
+
+	memcpy( &v, arg->data(), n*sizeof(Type) );
+}
+
+template<class Type>
+void callCtlChunk(
+	Ctl::FunctionCallPtr call,
+	const std::size_t n,
+	Type& rOut,
+	Type& gOut,
+	Type& bOut,
+	Type& aOut,
+	const Type& r,
+	const Type& g,
+	const Type& b,
+	const Type& a )
+{
+	// First set the input arguments for the function call:
+	Ctl::FunctionArgPtr rArg = call->findInputArg( "rIn" );
+	fillInputArg( rArg, "rIn", r, n );
+	Ctl::FunctionArgPtr gArg = call->findInputArg( "gIn" );
+	fillInputArg( gArg, "gIn", g, n );
+	Ctl::FunctionArgPtr bArg = call->findInputArg( "bIn" );
+	fillInputArg( bArg, "bIn", b, n );
+	Ctl::FunctionArgPtr aArg = call->findInputArg( "aIn" );
+	fillInputArg( aArg, "aIn", a, n );
+
+	// Now we can call the CTL function for
+	// pixels 0, through n-1
+	call->callFunction( n );
+
+	// Retrieve the results
+	Ctl::FunctionArgPtr rOutArg = call->findOutputArg( "rOut" );
+	retrieveOutputArg( rOutArg, "rOut", rOut, n );
+	Ctl::FunctionArgPtr gOutArg = call->findOutputArg( "gOut" );
+	retrieveOutputArg( gOutArg, "gOut", gOut, n );
+	Ctl::FunctionArgPtr bOutArg = call->findOutputArg( "bOut" );
+	retrieveOutputArg( bOutArg, "bOut", bOut, n );
+	Ctl::FunctionArgPtr aOutArg = call->findOutputArg( "aOut" );
+	retrieveOutputArg( aOutArg, "aOut", aOut, n );
+}
+
+template<class Type>
+void callCtl(
+	Ctl::Interpreter &interp,
+	Ctl::FunctionCallPtr call,
+	const std::size_t size,
+	Type* rOut,
+	Type* gOut,
+	Type* bOut,
+	Type* aOut,
+	const Type* r,
+	const Type* g,
+	const Type* b,
+	const Type* a )
+{
+	std::size_t n = size;
+	while( n > 0 )
+	{
+		const std::size_t m = std::min( n, interp.maxSamples() );
+		callCtlChunk( call, m, *rOut, *gOut, *bOut, *aOut, *r, *g, *b, *a );
+
+		n    -= m;
+		rOut += m;
+		gOut += m;
+		bOut += m;
+		aOut += m;
+		r    += m;
+		g    += m;
+		b    += m;
+		a    += m;
+	}
+}
+
+/**
+ * @brief Load the CTL module of the parameters into the interpreter.
+ */
+template<typename Scalar>
+void loadCtlModule( Ctl::Interpreter& interpreter, const CTLProcessParams<Scalar>& params )
+{
+	switch( params._inputType )
+	{
+		case eParamChooseInputCode:
+		{
+			TUTTLE_TLOG( TUTTLE_INFO, "CTL -- Load code: " << params._code );
+			loadModule( interpreter, params._module, params._code );
+			break;
+		}
+		case eParamChooseInputFile:
+		{
+			interpreter.setModulePaths( params._paths );
+			TUTTLE_TLOG( TUTTLE_INFO, "CTL -- Load module: " << params._module );
+			interpreter.loadModule( params._module );
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Evaluate the main CTL function on the nodes of a lut
+ * (see terry::color::lut3d::bake), with an opaque alpha.
+ */
+struct CtlLutTransform
+{
+	Ctl::Interpreter& _interpreter;
+	Ctl::FunctionCallPtr _call;
 
+	CtlLutTransform( Ctl::Interpreter& interpreter, const Ctl::FunctionCallPtr& call )
+	: _interpreter( interpreter )
+	, _call( call )
+	{}
 
+	void operator()( float* nodes, const std::size_t nbNodes ) const
+	{
+		static const std::size_t nodeSize = terry::color::lut3d::kNodeSize;
+		// planar buffers: r, g, b, a
+		std::vector<float> in( 4 * nbNodes );
+		std::vector<float> out( 4 * nbNodes );
+		for( std::size_t i = 0; i < nbNodes; ++i )
+		{
+			for( std::size_t c = 0; c < 3; ++c )
+				in[c * nbNodes + i] = nodes[i * nodeSize + c];
+			in[3 * nbNodes + i] = 1.0f;
+		}
+		callCtl<float>( _interpreter, _call, nbNodes,
+		                &out[0], &out[nbNodes], &out[2 * nbNodes], &out[3 * nbNodes],
+		                &in[0], &in[nbNodes], &in[2 * nbNodes], &in[3 * nbNodes] );
+		for( std::size_t i = 0; i < nbNodes; ++i )
+			for( std::size_t c = 0; c < 3; ++c )
+				nodes[i * nodeSize + c] = out[c * nbNodes + i];
+	}
+};
 
 }
 }
@@ -22,6 +22,37 @@ enum EParamChooseInput
 
 static const std::string kParamCTLCode               ( "code" );
 
+static const std::string kParamMode                  ( "mode" );
+static const std::string kParamModeInterpreter       ( "interpreter" );
+static const std::string kParamModeBakedLut          ( "bakedLut" );
+
+enum EParamMode
+{
+	eParamModeInterpreter = 0,
+	eParamModeBakedLut,
+};
+
+static const std::string kParamLutShaper             ( "lutShaper" );
+static const std::string kParamLutShaperLinear       ( "linear" );
+static const std::string kParamLutShaperLog          ( "log" );
+
+enum EParamLutShaper
+{
+	eParamLutShaperLinear = 0,
+	eParamLutShaperLog,
+};
+
+static const std::string kParamLutRangeMin           ( "lutRangeMin" );
+static const std::string kParamLutRangeMax           ( "lutRangeMax" );
+static const std::string kParamLutSize               ( "lutSize" );
+static const std::string kParamLutCheck              ( "lutCheck" );
+
+static const int kDefaultLutSize = 65;
+/// number of random pixels compared between the baked lut and the interpreter
+static const std::size_t kLutCheckNbSamples = 4096;
+/// maximum error of the baked lut before a warning
+static const double kLutCheckTolerance = 1e-3;
+
 }
 }
 }
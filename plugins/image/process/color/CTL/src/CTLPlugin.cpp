@@ -1,12 +1,18 @@
 #include "CTLPlugin.hpp"
 #include "CTLProcess.hpp"
+#include "CTLAlgorithm.hpp"
 #include "CTLDefinitions.hpp"
 
 #include <boost/gil/gil_all.hpp>
 #include <boost/algorithm/string/split.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/lexical_cast.hpp>
 
+#include <cmath>
 #include <fstream>
+#include <sstream>
 #include <boost/filesystem/path.hpp>
+#include <boost/filesystem/operations.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -15,13 +21,21 @@ namespace ctl {
 
 CTLPlugin::CTLPlugin( OfxImageEffectHandle handle )
 : ImageEffectGilPlugin( handle )
+, _lutMutex( 0 )
 {
 	_paramInput        = fetchChoiceParam     ( kParamChooseInput );
 	_paramCode         = fetchStringParam     ( kParamCTLCode );
 	_paramFile         = fetchStringParam     ( kTuttlePluginFilename );
 	_paramUpdateRender = fetchPushButtonParam ( kParamChooseInputCodeUpdate );
+	_paramMode         = fetchChoiceParam     ( kParamMode );
+	_paramLutShaper    = fetchChoiceParam     ( kParamLutShaper );
+	_paramLutRangeMin  = fetchDoubleParam     ( kParamLutRangeMin );
+	_paramLutRangeMax  = fetchDoubleParam     ( kParamLutRangeMax );
+	_paramLutSize      = fetchIntParam        ( kParamLutSize );
+	_paramLutCheck     = fetchBooleanParam    ( kParamLutCheck );
 
 	changedParam ( _instanceChangedArgs, kParamChooseInput );
+	changedParam ( _instanceChangedArgs, kParamMode );
 }
 
 CTLProcessParams<CTLPlugin::Scalar> CTLPlugin::getProcessParams( const OfxPointD& renderScale ) const
@@ -35,6 +49,7 @@ CTLProcessParams<CTLPlugin::Scalar> CTLPlugin::getProcessParams( const OfxPointD
 		{
 			params._module = "inputCode";
 			params._code = _paramCode->getValue();
+			params._key = params._code;
 			break;
 		}
 		case eParamChooseInputFile:
@@ -45,12 +60,75 @@ CTLProcessParams<CTLPlugin::Scalar> CTLPlugin::getProcessParams( const OfxPointD
 			const path filename = path( _paramFile->getValue() );
 			params._module = filename.stem().string();
 			params._paths.push_back( filename.parent_path().string() );
+			params._key = filename.string();
+			if( exists( filename ) )
+				params._key += "@" + boost::lexical_cast<std::string>( last_write_time( filename ) );
+			break;
+		}
+	}
+
+	params._mode     = static_cast<EParamMode>( _paramMode->getValue() );
+	params._lutSize  = _paramLutSize->getValue();
+	params._lutCheck = _paramLutCheck->getValue();
+	const double rangeMin = _paramLutRangeMin->getValue();
+	const double rangeMax = _paramLutRangeMax->getValue();
+	if( rangeMin >= rangeMax )
+	{
+		BOOST_THROW_EXCEPTION( exception::Value()
+			<< exception::user() + "The lut range is empty." );
+	}
+	switch( static_cast<EParamLutShaper>( _paramLutShaper->getValue() ) )
+	{
+		case eParamLutShaperLinear:
+		{
+			params._lutShaper = terry::color::lut3d_shaper_t( terry::color::eLut3DShaperLinear, rangeMin, rangeMax );
+			break;
+		}
+		case eParamLutShaperLog:
+		{
+			if( rangeMin <= 0.0 )
+			{
+				BOOST_THROW_EXCEPTION( exception::Value()
+					<< exception::user() + "The lut range must be positive with a log shaper." );
+			}
+			params._lutShaper = terry::color::lut3d_shaper_t( terry::color::eLut3DShaperLog2, std::log( rangeMin ) / std::log( 2.0 ), std::log( rangeMax ) / std::log( 2.0 ) );
 			break;
 		}
 	}
 	return params;
 }
 
+CTLPlugin::LutPtr CTLPlugin::getBakedLut( const CTLProcessParams<Scalar>& params )
+{
+	std::ostringstream key;
+	key << params._key << "|" << params._lutShaper.type << "|" << params._lutShaper.min << "|" << params._lutShaper.max << "|" << params._lutSize;
+
+	OFX::MultiThread::AutoMutex lock( _lutMutex );
+	if( _lut && _lutKey == key.str() )
+		return _lut;
+
+	// the CTL function is evaluated once on each node of the lut
+	Ctl::SimdInterpreter interpreter;
+	loadCtlModule( interpreter, params );
+	boost::shared_ptr<terry::color::lut3d> lut = boost::make_shared<terry::color::lut3d>();
+	lut->bake( params._lutSize, params._lutShaper, CtlLutTransform( interpreter, interpreter.newFunctionCall( "main" ) ) );
+	TUTTLE_LOG_INFO( "CTL -- Baked into a lut of size " << params._lutSize );
+
+	_lut    = lut;
+	_lutKey = key.str();
+	return _lut;
+}
+
+/**
+ * @brief Bake the CTL program before the first frame.
+ */
+void CTLPlugin::beginSequenceRender( const OFX::BeginSequenceRenderArguments& args )
+{
+	const CTLProcessParams<Scalar> params = getProcessParams( args.renderScale );
+	if( params._mode == eParamModeBakedLut )
+		getBakedLut( params );
+}
+
 void CTLPlugin::changedParam( const OFX::InstanceChangedArgs &args, const std::string &paramName )
 {
 	if( paramName == kParamChooseInput )
@@ -74,6 +152,15 @@ void CTLPlugin::changedParam( const OFX::InstanceChangedArgs &args, const std::s
 			}
 		}
 	}
+	else if( paramName == kParamMode )
+	{
+		const bool interpreter = static_cast<EParamMode>( _paramMode->getValue() ) == eParamModeInterpreter;
+		_paramLutShaper   -> setIsSecretAndDisabled( interpreter );
+		_paramLutRangeMin -> setIsSecretAndDisabled( interpreter );
+		_paramLutRangeMax -> setIsSecretAndDisabled( interpreter );
+		_paramLutSize     -> setIsSecretAndDisabled( interpreter );
+		_paramLutCheck    -> setIsSecretAndDisabled( interpreter );
+	}
 	else if( paramName == kParamCTLCode )
 	{
 		_paramInput->setValue( eParamChooseInputCode );
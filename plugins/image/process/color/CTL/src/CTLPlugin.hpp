@@ -5,6 +5,12 @@
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
+#include <terry/color/lut3d.hpp>
+
+#include <ofxsMultiThread.h>
+
+#include <boost/shared_ptr.hpp>
+
 namespace tuttle {
 namespace plugin {
 namespace ctl {
@@ -16,6 +22,12 @@ struct CTLProcessParams
 	std::vector<std::string> _paths;
 	std::string _module;
 	std::string _code;
+
+	EParamMode _mode;
+	terry::color::lut3d_shaper_t _lutShaper;
+	std::size_t _lutSize;
+	bool _lutCheck;
+	std::string _key; ///< identifies the CTL program (code or file and modification date)
 };
 
 /**
@@ -25,6 +37,7 @@ class CTLPlugin : public ImageEffectGilPlugin
 {
 public:
 	typedef float Scalar;
+	typedef boost::shared_ptr<const terry::color::lut3d> LutPtr;
 public:
     CTLPlugin( OfxImageEffectHandle handle );
 
@@ -33,6 +46,11 @@ public:
 
     void changedParam( const OFX::InstanceChangedArgs &args, const std::string &paramName );
 
+	void beginSequenceRender( const OFX::BeginSequenceRenderArguments& args );
+
+	/// CTL program baked into a 3D lut, only rebuilt if the program or the lut settings change
+	LutPtr getBakedLut( const CTLProcessParams<Scalar>& params );
+
 //	bool getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod );
 //	void getRegionsOfInterest( const OFX::RegionsOfInterestArguments& args, OFX::RegionOfInterestSetter& rois );
 	bool isIdentity( const OFX::RenderArguments& args, OFX::Clip*& identityClip, double& identityTime );
@@ -44,8 +62,18 @@ public:
 	OFX::StringParam*        _paramCode;
 	OFX::StringParam*        _paramFile;
 	OFX::PushButtonParam*    _paramUpdateRender;
+	OFX::ChoiceParam*        _paramMode;
+	OFX::ChoiceParam*        _paramLutShaper;
+	OFX::DoubleParam*        _paramLutRangeMin;
+	OFX::DoubleParam*        _paramLutRangeMax;
+	OFX::IntParam*           _paramLutSize;
+	OFX::BooleanParam*       _paramLutCheck;
 private:
 	OFX::InstanceChangedArgs _instanceChangedArgs;
+
+	OFX::MultiThread::Mutex _lutMutex;
+	LutPtr _lut;
+	std::string _lutKey;
 };
 
 }
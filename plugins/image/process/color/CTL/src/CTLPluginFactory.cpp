@@ -112,6 +112,51 @@ void CTLPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
 	file->setHint ( "CTL source code file." );
 	file->setStringType( OFX::eStringTypeFilePath );
 
+	OFX::ChoiceParamDescriptor* mode = desc.defineChoiceParam( kParamMode );
+	mode->setLabel( "Mode" );
+	mode->appendOption( kParamModeInterpreter );
+	mode->appendOption( kParamModeBakedLut );
+	mode->setDefault( eParamModeInterpreter );
+	mode->setHint(
+		"interpreter: each pixel is computed by the CTL interpreter.\n"
+		"bakedLut: for CTL programs which are pure color transforms (the result of a pixel only depends on its rgb values), "
+		"the program is evaluated once per sequence on the nodes of a 3D lut, then the pixels are interpolated in the lut. "
+		"The alpha channel is copied." );
+
+	OFX::ChoiceParamDescriptor* lutShaper = desc.defineChoiceParam( kParamLutShaper );
+	lutShaper->setLabel( "Lut shaper" );
+	lutShaper->appendOption( kParamLutShaperLinear );
+	lutShaper->appendOption( kParamLutShaperLog );
+	lutShaper->setDefault( eParamLutShaperLinear );
+	lutShaper->setHint( "Distribution of the lut nodes in the lut range: linear for display referred images, log for scene linear images (ACES)." );
+
+	OFX::DoubleParamDescriptor* lutRangeMin = desc.defineDoubleParam( kParamLutRangeMin );
+	lutRangeMin->setLabel( "Lut range min" );
+	lutRangeMin->setDefault( 0.0 );
+	lutRangeMin->setDisplayRange( 0.0, 1.0 );
+	lutRangeMin->setHint( "Smallest input value of the lut, smaller values are clamped. Must be positive with the log shaper." );
+
+	OFX::DoubleParamDescriptor* lutRangeMax = desc.defineDoubleParam( kParamLutRangeMax );
+	lutRangeMax->setLabel( "Lut range max" );
+	lutRangeMax->setDefault( 1.0 );
+	lutRangeMax->setDisplayRange( 0.0, 256.0 );
+	lutRangeMax->setHint( "Biggest input value of the lut, bigger values are clamped." );
+
+	OFX::IntParamDescriptor* lutSize = desc.defineIntParam( kParamLutSize );
+	lutSize->setLabel( "Lut size" );
+	lutSize->setDefault( kDefaultLutSize );
+	lutSize->setRange( 2, 257 );
+	lutSize->setDisplayRange( 17, 129 );
+	lutSize->setHint( "Number of nodes on each axis of the lut." );
+
+	OFX::BooleanParamDescriptor* lutCheck = desc.defineBooleanParam( kParamLutCheck );
+	lutCheck->setLabel( "Check lut error" );
+	lutCheck->setDefault( false );
+	lutCheck->setHint(
+		"For each frame, compare the lut with the CTL interpreter on random pixels of the image, "
+		"and log the maximum and the RMS errors (a warning is logged above 1e-3). "
+		"Use it to choose the shaper, the range and the size of the lut." );
+
 
 }
 
@@ -25,6 +25,7 @@ protected:
 	CTLProcessParams<Scalar> _params; ///< parameters
 
 	Ctl::SimdInterpreter _interpreter;
+	CTLPlugin::LutPtr _lut; ///< baked CTL program, in eParamModeBakedLut
 
 public:
     CTLProcess( CTLPlugin& effect );
@@ -32,6 +33,12 @@ public:
 	void setup( const OFX::RenderArguments& args );
 
     void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+
+private:
+	void processBakedLut( const OfxRectI& procWindowRoW );
+
+	/// compare the baked lut with the interpreter on random pixels of the source image
+	void checkLut();
 };
 
 }
@@ -6,18 +6,17 @@
 #include <Iex.h>
 #include <CtlMessage.h>
 
+#include <boost/random/linear_congruential.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 
 namespace tuttle {
 namespace plugin {
 namespace ctl {
 
-/**
- * @brief HACK: workaround CTL limitation to load a module which source code
- * comes from a string and not a file.
- */
-void loadModule( Ctl::Interpreter& interpreter, const std::string &moduleName, const std::string& code );
-void loadModuleRecursive( Ctl::Interpreter& interpreter,const std::string &moduleName, const std::string& code );
-
 namespace {
 
 CTLPlugin* ctlPlugin;
@@ -30,106 +29,6 @@ void ctlMessageOutput( const std::string& message )
 	}
 }
 
-template<class Type>
-void fillInputArg( Ctl::FunctionArgPtr& arg, const std::string& argStr, const Type& v, const std::size_t n )
-{
-	if( !arg ||
-//		!arg->type().cast<half>() ||
-		!arg->isVarying( ) )
-	{
-		// The CTL function has no argument argStr, the argument
-		// is not of type half, or the argument is not varying
-		BOOST_THROW_EXCEPTION( Iex::ArgExc( std::string("Cannot set value of argument ")+argStr ) );
-	}
-
-	memcpy( arg->data(), &v, n*sizeof(Type) );
-}
-
-template<class Type>
-void retrieveOutputArg( const Ctl::FunctionArgPtr& arg, const std::string& argStr, Type& v, const std::size_t n )
-{
-	if( !arg ||
-//		!arg->type( ).cast<half>() ||
-		!arg->isVarying( ) )
-	{
-		// The CTL function has no argument argStr, the argument
-		// is not of type half, or the argument is not varying
-		BOOST_THROW_EXCEPTION( Iex::ArgExc( std::string("Cannot set value of argument ")+argStr ) );
-	}
-
-	memcpy( &v, arg->data(), n*sizeof(Type) );
-}
-
-template<class Type>
-void callCtlChunk(
-	Ctl::FunctionCallPtr call,
-	const std::size_t n,
-	Type& rOut,
-	Type& gOut,
-	Type& bOut,
-	Type& aOut,
-	const Type& r,
-	const Type& g,
-	const Type& b,
-	const Type& a )
-{
-	// First set the input arguments for the function call:
-	Ctl::FunctionArgPtr rArg = call->findInputArg( "rIn" );
-	fillInputArg( rArg, "rIn", r, n );
-	Ctl::FunctionArgPtr gArg = call->findInputArg( "gIn" );
-	fillInputArg( gArg, "gIn", g, n );
-	Ctl::FunctionArgPtr bArg = call->findInputArg( "bIn" );
-	fillInputArg( bArg, "bIn", b, n );
-	Ctl::FunctionArgPtr aArg = call->findInputArg( "aIn" );
-	fillInputArg( aArg, "aIn", a, n );
-
-	// Now we can call the CTL function for
-	// pixels 0, through n-1
-	call->callFunction( n );
-
-	// Retrieve the results
-	Ctl::FunctionArgPtr rOutArg = call->findOutputArg( "rOut" );
-	retrieveOutputArg( rOutArg, "rOut", rOut, n );
-	Ctl::FunctionArgPtr gOutArg = call->findOutputArg( "gOut" );
-	retrieveOutputArg( gOutArg, "gOut", gOut, n );
-	Ctl::FunctionArgPtr bOutArg = call->findOutputArg( "bOut" );
-	retrieveOutputArg( bOutArg, "bOut", bOut, n );
-	Ctl::FunctionArgPtr aOutArg = call->findOutputArg( "aOut" );
-	retrieveOutputArg( aOutArg, "aOut", aOut, n );
-}
-
-template<class Type>
-void callCtl(
-	Ctl::Interpreter &interp,
-	Ctl::FunctionCallPtr call,
-	const std::size_t size,
-	Type* rOut,
-	Type* gOut,
-	Type* bOut,
-	Type* aOut,
-	const Type* r,
-	const Type* g,
-	const Type* b,
-	const Type* a )
-{
-	std::size_t n = size;
-	while( n > 0 )
-	{
-		const std::size_t m = std::min( n, interp.maxSamples() );
-		callCtlChunk( call, m, *rOut, *gOut, *bOut, *aOut, *r, *g, *b, *a );
-
-		n    -= m;
-		rOut += m;
-		gOut += m;
-		bOut += m;
-		aOut += m;
-		r    += m;
-		g    += m;
-		b    += m;
-		a    += m;
-	}
-}
-
 }
 
 template<class View>
@@ -148,21 +47,70 @@ void CTLProcess<View>::setup( const OFX::RenderArguments& args )
 	ImageGilFilterProcessor<View>::setup( args );
 	_params = _plugin.getProcessParams( args.renderScale );
 
-	switch( _params._inputType )
+	if( _params._mode == eParamModeBakedLut )
+	{
+		// baked by the plugin at the beginning of the sequence
+		_lut = _plugin.getBakedLut( _params );
+		if( ! _params._lutCheck )
+			return;
+	}
+
+	loadCtlModule( _interpreter, _params );
+	Ctl::setMessageOutputFunction( ctlMessageOutput );
+
+	if( _lut )
+		checkLut();
+}
+
+template<class View>
+void CTLProcess<View>::checkLut()
+{
+	using namespace boost::gil;
+	const std::size_t width    = this->_srcView.width();
+	const std::size_t nbPixels = width * this->_srcView.height();
+	const std::size_t n        = std::min( kLutCheckNbSamples, nbPixels );
+	if( n == 0 )
+		return;
+
+	// random pixels, interleaved for the lut and planar for the interpreter
+	boost::minstd_rand generator;
+	std::vector<float> interleaved( 4 * n );
+	std::vector<float> planar( 4 * n );
+	for( std::size_t i = 0; i < n; ++i )
 	{
-		case eParamChooseInputCode:
+		const std::size_t index = generator() % nbPixels;
+		rgba32f_pixel_t p;
+		color_convert( this->_srcView( index % width, index / width ), p );
+		for( std::size_t c = 0; c < 4; ++c )
 		{
-			TUTTLE_TLOG( TUTTLE_INFO, "CTL -- Load code: " << _params._code );
-			loadModule( _interpreter, _params._module, _params._code );
+			interleaved[i * 4 + c] = p[c];
+			planar[c * n + i]      = p[c];
 		}
-		case eParamChooseInputFile:
+	}
+
+	std::vector<float> ctlOut( 4 * n );
+	callCtl<float>( _interpreter, _interpreter.newFunctionCall( "main" ), n,
+	                &ctlOut[0], &ctlOut[n], &ctlOut[2 * n], &ctlOut[3 * n],
+	                &planar[0], &planar[n], &planar[2 * n], &planar[3 * n] );
+	std::vector<float> lutOut( 4 * n );
+	_lut->apply( &interleaved[0], &lutOut[0], n, 4 );
+
+	double maxError   = 0.0;
+	double sumSquares = 0.0;
+	for( std::size_t i = 0; i < n; ++i )
+	{
+		for( std::size_t c = 0; c < 3; ++c )
 		{
-			_interpreter.setModulePaths( _params._paths );
-			TUTTLE_TLOG( TUTTLE_INFO, "CTL -- Load module: " << _params._module );
-			_interpreter.loadModule( _params._module );
+			const double error = std::abs( double( lutOut[i * 4 + c] ) - double( ctlOut[c * n + i] ) );
+			maxError    = std::max( maxError, error );
+			sumSquares += error * error;
 		}
 	}
-	Ctl::setMessageOutputFunction( ctlMessageOutput );
+	const double rms = std::sqrt( sumSquares / ( 3 * n ) );
+	if( maxError > kLutCheckTolerance )
+		TUTTLE_LOG_WARNING( "CTL -- baked lut error on " << n << " pixels: max " << maxError << ", rms " << rms );
+	else
+		TUTTLE_LOG_INFO( "CTL -- baked lut error on " << n << " pixels: max " << maxError << ", rms " << rms );
 }
 
 /**
@@ -173,6 +121,12 @@ template<class View>
 void CTLProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
 {
 	using namespace boost::gil;
+	if( _lut )
+	{
+		processBakedLut( procWindowRoW );
+		return;
+	}
+
 	const OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
 	const OfxRectI procWindowSrc = translateRegion( procWindowRoW, this->_srcPixelRod );
 	
@@ -227,6 +181,34 @@ void CTLProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
 	}
 }
 
+template<class View>
+void CTLProcess<View>::processBakedLut( const OfxRectI& procWindowRoW )
+{
+	using namespace boost::gil;
+	const OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
+	const OfxRectI procWindowSrc = translateRegion( procWindowRoW, this->_srcPixelRod );
+	const OfxPointI procWindowSize = {
+		procWindowRoW.x2 - procWindowRoW.x1,
+		procWindowRoW.y2 - procWindowRoW.y1 };
+
+	rgba32f_image_t workLine( procWindowSize.x, 1 );
+	rgba32f_view_t  workLineV = view( workLine );
+	float* line = reinterpret_cast<float*>( &workLineV(0,0)[0] );
+
+	for( int y = 0; y < procWindowSize.y; ++y )
+	{
+		View srcLineV = subimage_view( this->_srcView, procWindowSrc.x1,    procWindowSrc.y1 + y,    procWindowSize.x, 1 );
+		View dstLineV = subimage_view( this->_dstView, procWindowOutput.x1, procWindowOutput.y1 + y, procWindowSize.x, 1 );
+
+		copy_and_convert_pixels( srcLineV, workLineV );
+		_lut->apply( line, line, procWindowSize.x, 4 );
+		copy_and_convert_pixels( workLineV, dstLineV );
+
+		if( this->progressForward( procWindowSize.x ) )
+			return;
+	}
+}
+
 }
 }
 }
@@ -39,6 +39,7 @@ void ColorGradationPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
 
 	// plugin flags
 	desc.setSupportsTiles( kSupportTiles );
+	desc.setIsPointOperation( true );
 	desc.setRenderThreadSafety( OFX::eRenderFullySafe );
 }
 
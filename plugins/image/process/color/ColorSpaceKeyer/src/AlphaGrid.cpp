@@ -0,0 +1,151 @@
+#include "AlphaGrid.hpp"
+
+#include <ofxsMultiThread.h>
+
+#include <cmath>
+
+namespace tuttle {
+namespace plugin {
+namespace colorSpaceKeyer {
+
+namespace {
+
+/*
+ * Compute the grid nodes: each thread computes a band of red slices
+ * with its own copies of the geodesic forms (intersection tests modify them)
+ */
+class AlphaGridProcessor : public OFX::MultiThread::Processor
+{
+public:
+	AlphaGridProcessor(const GeodesicForm& geodesicFormColor, const GeodesicForm& geodesicFormSpill, const std::size_t resolution,
+	                   const BoundingBox& boundingBox, const Ofx3DPointD& step, std::vector<float>& values)
+	: _geodesicFormColor(geodesicFormColor)
+	, _geodesicFormSpill(geodesicFormSpill)
+	, _resolution(resolution)
+	, _boundingBox(boundingBox)
+	, _step(step)
+	, _values(values)
+	{
+	}
+
+	void multiThreadFunction(const unsigned int threadId, const unsigned int nThreads)
+	{
+		//copies point to the points of the original forms (read only)
+		GeodesicForm geodesicFormColor = _geodesicFormColor;
+		GeodesicForm geodesicFormSpill = _geodesicFormSpill;
+		
+		const std::size_t x1 = threadId * _resolution / nThreads;
+		const std::size_t x2 = (threadId + 1) * _resolution / nThreads;
+		for(std::size_t x = x1; x < x2; ++x)
+		{
+			for(std::size_t y = 0; y < _resolution; ++y)
+			{
+				float* value = &_values[(x * _resolution + y) * _resolution];
+				for(std::size_t z = 0; z < _resolution; ++z, ++value)
+				{
+					Ofx3DPointD node;
+					node.x = std::min(_boundingBox.min.x + x * _step.x, _boundingBox.max.x);	//red
+					node.y = std::min(_boundingBox.min.y + y * _step.y, _boundingBox.max.y);	//green
+					node.z = std::min(_boundingBox.min.z + z * _step.z, _boundingBox.max.z);	//blue
+					*value = static_cast<float>(AlphaGrid::computeAlpha(geodesicFormColor, geodesicFormSpill, node));
+				}
+			}
+		}
+	}
+
+private:
+	const GeodesicForm& _geodesicFormColor;
+	const GeodesicForm& _geodesicFormSpill;
+	const std::size_t _resolution;
+	const BoundingBox& _boundingBox;
+	const Ofx3DPointD& _step;
+	std::vector<float>& _values;
+};
+
+}
+
+/*
+ * AlphaGrid constructor (empty grid: alpha is 0 everywhere)
+ */
+AlphaGrid::AlphaGrid()
+: _resolution(0)
+{
+	_invStep.x = _invStep.y = _invStep.z = 0.0;
+}
+
+/*
+ * Sample the alpha of the geodesic forms on the nodes of the grid
+ */
+void AlphaGrid::compute(const GeodesicForm& geodesicFormColor, const GeodesicForm& geodesicFormSpill, const std::size_t resolution)
+{
+	_resolution = std::max(resolution, std::size_t(2));				//at least one cell
+	_boundingBox = geodesicFormSpill._boundingBox;					//alpha is 0 out of spill form
+	
+	Ofx3DPointD step;												//distance between two nodes
+	step.x = (_boundingBox.max.x - _boundingBox.min.x) / (_resolution - 1);
+	step.y = (_boundingBox.max.y - _boundingBox.min.y) / (_resolution - 1);
+	step.z = (_boundingBox.max.z - _boundingBox.min.z) / (_resolution - 1);
+	_invStep.x = step.x > 0 ? 1.0 / step.x : 0.0;					//flat bounding box: all of colors are on the first node
+	_invStep.y = step.y > 0 ? 1.0 / step.y : 0.0;
+	_invStep.z = step.z > 0 ? 1.0 / step.z : 0.0;
+	
+	_values.assign(_resolution * _resolution * _resolution, 0.0f);
+	AlphaGridProcessor processor(geodesicFormColor, geodesicFormSpill, _resolution, _boundingBox, step, _values);
+	processor.multiThread(std::min(OFX::MultiThread::getNumCPUs(), static_cast<unsigned int>(_resolution)));
+}
+
+/*
+ * Alpha of a color: 1 into the color form, 0 out of the spill form
+ * and the relative distance to the color form between them
+ */
+double AlphaGrid::computeAlpha(GeodesicForm& geodesicFormColor, GeodesicForm& geodesicFormSpill, const Ofx3DPointD& testPoint)
+{
+	double alpha = 0.0;
+	if(geodesicFormSpill.isIntoBoundingBox(testPoint))						//if current point is into spill bounding box
+	{
+		if(geodesicFormColor.isIntoBoundingBox(testPoint))					//bounding box test (process optimization)
+		{
+			if(geodesicFormColor.isPointIntoGeodesicForm(testPoint))		//if current point is into the color geodesic form
+			{
+				alpha = 1.0;												//change alpha to 1
+			}
+		}
+		if(alpha != 1.0 && geodesicFormSpill.isPointIntoGeodesicForm(testPoint))
+		{
+			//intersections test
+			if(geodesicFormColor.testIntersection2(testPoint,false,true))	//normal intersection
+			{
+				//computes vectors
+				Ofx3DPointD vectMax;
+				Ofx3DPointD vectMin;
+				//compute min vector
+				vectMin.x = testPoint.x - geodesicFormColor._intersectionPoint.x;	//x value
+				vectMin.y = testPoint.y - geodesicFormColor._intersectionPoint.y;	//y value
+				vectMin.z = testPoint.z - geodesicFormColor._intersectionPoint.z;	//z value
+				//compute max vector
+				vectMax.x = geodesicFormSpill._intersectionPoint.x - geodesicFormColor._intersectionPoint.x; //x value
+				vectMax.y = geodesicFormSpill._intersectionPoint.y - geodesicFormColor._intersectionPoint.y; //y value
+				vectMax.z = geodesicFormSpill._intersectionPoint.z - geodesicFormColor._intersectionPoint.z; //z value
+				//compute norms
+				double normMin,normMax;			//initialize
+				normMin  = vectMin.x*vectMin.x;	//add x*x
+				normMin += vectMin.y*vectMin.y;	//add y*y
+				normMin += vectMin.z*vectMin.z;	//add z*z
+				normMin = std::sqrt(normMin);	//compute norm minimal
+
+				normMax  = vectMax.x*vectMax.x;	//add x*x
+				normMax += vectMax.y*vectMax.y;	//add y*y
+				normMax += vectMax.z*vectMax.z;	//add z*z
+				normMax = std::sqrt(normMax);	//compute norm maximal
+
+				//compute alpha value
+				alpha = normMin/normMax;
+			}
+		}
+	}
+	return alpha;
+}
+
+}
+}
+}
@@ -0,0 +1,80 @@
+#ifndef ALPHAGRID_HPP
+#define	ALPHAGRID_HPP
+
+#include "ColorSpaceKeyerDefinitions.hpp"
+#include "GeodesicForm.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+namespace colorSpaceKeyer {
+
+/*
+ * Alpha of the color and spill geodesic forms, sampled on a regular grid over the spill bounding box.
+ * The grid is computed once when the geodesic forms change, the keying of a pixel is then
+ * a trilinear interpolation (cost doesn't depend on geodesic forms precision).
+ * Alpha isn't smooth across the form surfaces (steps to 1 into the color form, to 0 out of
+ * the spill form, kinks on the form faces): in the cells crossed by a surface the interpolation
+ * is only an approximation of computeAlpha, so the resolution is a parameter of the plugin.
+ */
+class AlphaGrid
+{
+public:
+	AlphaGrid();
+
+	//Sample alpha of the geodesic forms on resolution^3 nodes (with the SMP threads)
+	void compute(const GeodesicForm& geodesicFormColor, const GeodesicForm& geodesicFormSpill, const std::size_t resolution);
+
+	//Alpha of a color (1 into color form, 0 out of spill form), trilinear interpolation of the grid
+	double getAlpha(const double r, const double g, const double b) const
+	{
+		if(_values.empty() ||
+		   r < _boundingBox.min.x || r > _boundingBox.max.x ||
+		   g < _boundingBox.min.y || g > _boundingBox.max.y ||
+		   b < _boundingBox.min.z || b > _boundingBox.max.z)
+			return 0.0;						//out of spill bounding box
+
+		//continuous grid coordinates
+		const double x = (r - _boundingBox.min.x) * _invStep.x;
+		const double y = (g - _boundingBox.min.y) * _invStep.y;
+		const double z = (b - _boundingBox.min.z) * _invStep.z;
+		//cell (the last node is the last cell max)
+		const std::size_t last = _resolution - 2;
+		const std::size_t x0 = std::min(static_cast<std::size_t>(x), last);
+		const std::size_t y0 = std::min(static_cast<std::size_t>(y), last);
+		const std::size_t z0 = std::min(static_cast<std::size_t>(z), last);
+		const float fx = static_cast<float>(x - x0);
+		const float fy = static_cast<float>(y - y0);
+		const float fz = static_cast<float>(z - z0);
+
+		const float* c = &_values[(x0 * _resolution + y0) * _resolution + z0];
+		const std::size_t dy = _resolution;
+		const std::size_t dx = _resolution * _resolution;
+		//interpolate on z, y then x
+		const float c00 = c[0]       + fz * (c[1]           - c[0]);
+		const float c01 = c[dy]      + fz * (c[dy + 1]      - c[dy]);
+		const float c10 = c[dx]      + fz * (c[dx + 1]      - c[dx]);
+		const float c11 = c[dx + dy] + fz * (c[dx + dy + 1] - c[dx + dy]);
+		const float c0 = c00 + fy * (c01 - c00);
+		const float c1 = c10 + fy * (c11 - c10);
+		return c0 + fx * (c1 - c0);
+	}
+
+	//Exact alpha of a color (geodesic forms intersection tests)
+	static double computeAlpha(GeodesicForm& geodesicFormColor, GeodesicForm& geodesicFormSpill, const Ofx3DPointD& testPoint);
+
+private:
+	std::size_t _resolution;		//number of nodes on each axis
+	BoundingBox _boundingBox;		//spill bounding box
+	Ofx3DPointD _invStep;			//1 / distance between two nodes on each axis
+	std::vector<float> _values;		//alpha of each node (red major, blue minor)
+};
+
+}
+}
+}
+
+#endif	/* ALPHAGRID_HPP */
@@ -4,7 +4,7 @@
 
 #include <tuttle/plugin/opengl/gl.h>
 
-#include <terry/algorithm/transform_pixels.hpp>
+#include <boost/gil/image_view_factory.hpp>
 
 
 namespace tuttle {
@@ -104,18 +104,31 @@ void CloudPointData::updateVBO()
 	_selectionSpillVBO.createVBO(&(_spillCopy.front()), _spillCopy.size()/3,GL_STATIC_DRAW ,&(_spillCopy.front()));				//generate spill selection VBO to draw
 }
 
+/*
+ * Subsample the clip source (the cloud point doesn't need more than kMaxCloudPoints points)
+ */
+SView CloudPointData::getSubsampledView(const SView& srcView) const
+{
+	const double ratio = (double)srcView.width() * (double)srcView.height() / kMaxCloudPoints;	//number of pixels for one point
+	if( ratio <= 1.0 )
+		return srcView;																		//no subsampling needed
+	const int step = (int)std::ceil( std::sqrt( ratio ) );									//subsampling step on each axis
+	return boost::gil::subsampled_view( srcView, step, step );
+}
+
 /*
  * Copy RGB channels of the clip source into a buffer
  */
 int CloudPointData::generateAllPointsVBOData(SView srcView)
 {
+	SView view = getSubsampledView( srcView );			//source view (subsampled)
 	//compute buffer size
-	int size = (int)(srcView.height()*srcView.width());	//return size : full image here
+	int size = (int)(view.height()*view.width());		//return size : full image here
 
-	//copy full image into buffer
-	Pixel_copy funct( _imgCopy );						//functor declaration	
-	//treatment
-	terry::algorithm::transform_pixels( srcView, funct );		//transform pixel did with functor reference
+	//copy full image into buffer (each thread copies a band of lines)
+	Pixel_copy funct;									//accumulator declaration
+	reducePixelsParallel( view, funct );
+	_imgCopy.swap( funct._data );
 	return size;
 }
 
@@ -127,10 +140,10 @@ int CloudPointData::generateDiscretizedVBOData(SView srcView, const int& discret
 	//compute buffer size
 	int size = (int)(srcView.height()*srcView.width());						//return size : full image here
 
-	//Create and use functor to get discretize data  (functor with template)
-	Pixel_copy_discretization<SPixel> funct(_imgCopy,discretizationStep);	//functor declaration	
-	terry::algorithm::transform_pixels( srcView, funct);							//with functor reference
-	funct.convertSetDataToVectorData();										//copy functor data to _imgCopy data
+	//Create and use accumulator to get discretize data (each thread fills its own cells)
+	Pixel_copy_discretization funct(discretizationStep);					//accumulator declaration
+	reducePixelsParallel( getSubsampledView( srcView ), funct );
+	funct.convertCellsToVectorData( _imgCopy );								//copy accumulator data to _imgCopy data
 	size = _imgCopy.size();													//change size
 	return size;
 }
@@ -196,13 +209,10 @@ int CloudPointData::generateAllPointsSelectionVBOData(SView srcView)
 	int size;				 //returned size
 	bool isSelection = true; //current operations are on selected pixels
 	
-	//clear selection copy
-	_selectionCopy.clear();								//clear selection VBO data
-	
-	//copy full image into buffer
-	Pixel_copy funct(_selectionCopy, isSelection);		//functor declaration creation	
-	//treatment
-	terry::algorithm::transform_pixels( srcView, funct );		//transform pixel did with functor reference
+	//copy full image into buffer (each thread copies a band of lines)
+	Pixel_copy funct(isSelection);						//accumulator declaration
+	reducePixelsParallel( srcView, funct );
+	_selectionCopy.swap( funct._data );					//replace selection VBO data
 	size = _selectionCopy.size();						//get current size of VBO
 
 	return size;					//return size of VBO buffers (same color and vertex)
@@ -268,13 +278,10 @@ int CloudPointData::generateAllPointsSpillVBOData(SView srcView)
 	int size;				 //returned size
 	bool isSelection = true; //current operations are on selected pixels
 	
-	//clear selection copy
-	_spillCopy.clear();								//clear selection VBO data
-	
-	//copy full image into buffer
-	Pixel_copy funct(_spillCopy, isSelection);		//functor declaration creation	
-	//treatment
-	terry::algorithm::transform_pixels( srcView, funct );	//transform pixel did with functor reference
+	//copy full image into buffer (each thread copies a band of lines)
+	Pixel_copy funct(isSelection);					//accumulator declaration
+	reducePixelsParallel( srcView, funct );
+	_spillCopy.swap( funct._data );					//replace selection VBO data
 	
 	size = _spillCopy.size();						//get current size of VBO
 	return size;									//return size of VBO buffers (same color and vertex)
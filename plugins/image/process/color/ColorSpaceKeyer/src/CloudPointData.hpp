@@ -10,10 +10,13 @@
 #include <terry/numeric/operations.hpp>
 #include <terry/numeric/assign.hpp>
 
+#include <tuttle/plugin/ParallelReduction.hpp>
+
 #include <boost/foreach.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
-#include <set>
 
 namespace tuttle {
 namespace plugin {
@@ -24,48 +27,28 @@ typedef boost::gil::rgba32f_view_t SView;
 typedef boost::gil::rgba32f_pixel_t SPixel;
 	
 
-template <typename PixelRef1, // models pixel concept
-          typename PixelRef2> // models pixel concept
-struct pixel_is_lesser_t
-{
-	GIL_FORCEINLINE
-    bool operator()( const PixelRef1& p1,
-                     const PixelRef2& p2) const
-	{
-		for( int v = 0; v < 3/*boost::gil::num_channels<Pixel>::type::value*/; ++v )
-		{
-			if( p1[v] < p2[v] )
-				return true;
-			if( p1[v] > p2[v] )
-				return false;
-		}
-        return false;
-    }
-};
-
-//Functor : copy image into a buffer (ignore alpha channel)
+//Accumulator : copy image into a buffer (ignore alpha channel), used with reducePixelsParallel
 struct Pixel_copy
 {
 	//Arguments
-    DataVector& _data; //buffer to fill up
+	DataVector _data;  //buffer to fill up (RGB of each pixel)
 	bool _isSelection; //is current operation on selection (only take good alpha pixels)
 	
 	//Constructor
-	Pixel_copy(DataVector& data, bool isSelection = false)
-	:_data( data ),
-	_isSelection(isSelection)
+	Pixel_copy(bool isSelection = false)
+	:_isSelection(isSelection)
 	{
 	}
 	//Operator ()
 	template< typename Pixel>
-    Pixel operator()( const Pixel& p )
-    {
-        using namespace boost::gil;
+	void operator()( const Pixel& p )
+	{
+		using namespace boost::gil;
 		//is current operation for selectionVBO
 		if(_isSelection) //test if current operation is to selection VBO
 		{
 			if(p[3] != 1) //if current pixel is not selected (alpha != 1)
-				return p; //stop treatment
+				return; //stop treatment
 		}
 		//recopy channels
 		for( int v = 0; v < 3 /*boost::gil::num_channels<Pixel>::type::value*/; ++v )
@@ -73,80 +56,77 @@ struct Pixel_copy
 			const float val = boost::gil::channel_convert<boost::gil::bits32f>( p[v] );		//capt channel (red, green or blue)
 			_data.push_back( val );	//add value to buffer data
 		}
-        return p;
-    }
+	}
+	//Merge the pixels copied by another thread (next lines of the image)
+	void merge( const Pixel_copy& other )
+	{
+		_data.insert( _data.end(), other._data.begin(), other._data.end() );
+	}
 };
 
-//Functor copy image (with discretization)
-template< typename Pixel>
+//Accumulator : copy image with discretization (each point is a cell of a nbStep^3 grid), used with reducePixelsParallel
 struct Pixel_copy_discretization
 {
-	typedef std::set< SPixel, tuttle::plugin::colorSpaceKeyer::pixel_is_lesser_t<SPixel,SPixel> > PixelSet;
+	typedef std::vector<unsigned int> CellVector;
 	
 	//Arguments
-    DataVector& _data; //buffer to fill up
-	int _nbStep;	   // discretization step
-	float _step;	   // discretization value
-	PixelSet _setData; //we use to set to prevent double same data many times
-	bool _isSelection; //is current operation to selection VBO
-			
+	CellVector _cells;			// index of the cells of the copied pixels: (red * nbStep + green) * nbStep + blue
+	std::size_t _nbCompacted;	// number of cells already sorted without duplicate
+	int _nbStep;				// discretization step
+	float _step;				// discretization value
+	
 	//Constructor
-	Pixel_copy_discretization(DataVector& data, int nbStep, bool isSelection = false):
-	_data( data ),
-	_nbStep(nbStep),
-	_isSelection(isSelection)
+	Pixel_copy_discretization(int nbStep):
+	_nbCompacted(0),
+	_nbStep(std::max(nbStep,2))
 	{
-		_step = (float)(1/(float)(nbStep-1));	//compute discretization value
+		_step = (float)(1/(float)(_nbStep-1));	//compute discretization value
 	}
 	
-	//Operator ()	
-    Pixel operator()( const Pixel& p )
-    {
-		Pixel add;		//used to put data in the std::set
-        using namespace boost::gil;	
-		//test if current operation is to selection VBO
-		if(_isSelection) //test
-		{
-			if(p[3] != 1) //if current pixel is not selected (alpha != 1)
-				return p; //stop treatment
-		}
-		//recopy channels
+	//Operator ()
+	template< typename Pixel>
+	void operator()( const Pixel& p )
+	{
+		unsigned int cell = 0;
 		for( int v = 0; v < 3 /*boost::gil::num_channels<Pixel>::type::value*/; ++v ) //We don't want work with alpha channel
 		{
-			double val = p[v];		//capt channel (red, green or blue)
-			
-			bool placedInVector = false;	//values is not in the vector yet
-			int iteration = 0;				//initialize index to 0
-			while(!placedInVector)			//place round value in the vector
-			{
-				float previousValue = iteration*_step;
-				float nextValue = (iteration+1)*_step;
-				if(val <= previousValue)
-				{
-					add[v] = previousValue;				//add value to pixel data
-					placedInVector = true;				// value is put in the vector
-				}
-				else if( val < nextValue)
-				{
-					add[v] = nextValue;					//add value to pixel data
-					placedInVector = true;				//value is put in the vector
-				}
-				++iteration;	//increments indice
-			}
+			const float val = p[v];		//capt channel (red, green or blue)
+			//round value to the next discretization value (clamped to [0,1])
+			int index = 0;
+			if( val > 0 )
+				index = std::min( (int)std::ceil( val / _step ), _nbStep-1 );
+			cell = cell * _nbStep + index;
 		}
-		_setData.insert(add); //insert current pixel into the set (doubles are not allowed)
-		return p;
-    }
+		_cells.push_back(cell);
+		if( _cells.size() >= 2 * _nbCompacted + 4096 ) //remove doubles from time to time
+			compact();
+	}
+	
+	//Merge the cells of another thread
+	void merge( const Pixel_copy_discretization& other )
+	{
+		_cells.insert( _cells.end(), other._cells.begin(), other._cells.end() );
+		compact();
+	}
+	
+	//Sort cells and remove doubles
+	void compact()
+	{
+		std::sort( _cells.begin(), _cells.end() );
+		_cells.erase( std::unique( _cells.begin(), _cells.end() ), _cells.end() );
+		_nbCompacted = _cells.size();
+	}
 	
-	//Convert _setData values to _data values
-	void convertSetDataToVectorData()
+	//Convert cells to _data values
+	void convertCellsToVectorData( DataVector& data )
 	{
-		//iterator creation
-		BOOST_FOREACH( const SPixel& p, _setData )	//iterator used to scan the set
+		compact();
+		data.reserve( data.size() + 3 * _cells.size() );
+		BOOST_FOREACH( const unsigned int cell, _cells )
 		{
-			 _data.push_back(p[0]);	//red channel copy into vector
-			 _data.push_back(p[1]);	//green channel copy into vector
-			 _data.push_back(p[2]);	//blue channel copy into vector
+			data.push_back( ( cell / ( _nbStep * _nbStep ) ) * _step );	//red channel copy into vector
+			data.push_back( ( ( cell / _nbStep ) % _nbStep ) * _step );	//green channel copy into vector
+			data.push_back( ( cell % _nbStep ) * _step );					//blue channel copy into vector
 		}
 	}
 };
@@ -225,6 +205,7 @@ public:
 	
 private:
 	//VBO data management
+	SView getSubsampledView(const SView& srcView) const;										//subsample the source to draw at most kMaxCloudPoints points
 	int generateAllPointsVBOData(SView srcView);												//generate a VBO with all of the pixels
 	int generateDiscretizedVBOData(SView srcView, const int& discretizationStep);				//generate a  VBO with discretization
 	//selection VBO data management
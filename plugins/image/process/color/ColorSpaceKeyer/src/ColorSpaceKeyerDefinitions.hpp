@@ -95,6 +95,14 @@ const static std::string kBoolSpillSelectionDisplayLabel = "Display spill select
 const static std::string kDoubleScaleGeodesicForm = "scaleGF";
 const static std::string kDoubleScaleGeodesicFormLabel = "Scale geodesic form";
 
+//Alpha grid resolution
+const static std::string kIntAlphaGridResolution = "alphaGridResolution";
+const static std::string kIntAlphaGridResolutionLabel = "Alpha grid resolution";
+
+//Process constants
+const static int kAlphaGridResolution = 64;			//default number of alpha samples on each axis of spill bounding box
+const static std::size_t kMaxCloudPoints = 1024*1024;	//maximal number of points read to draw a clip (subsampling)
+
 //Rotation constants
 const static int KMaxDegres = 360;		//360° max for a rotation
 const static int kRotationSpeed = 5;	//mouse rotation scale
@@ -31,6 +31,7 @@ ColorSpaceKeyerPlugin::ColorSpaceKeyerPlugin( OfxImageEffectHandle handle )
 		_paramDoubleScaleGF = fetchDoubleParam(kDoubleScaleGeodesicForm);				//scale geodesic form - double parameter
 		_paramBoolSeeSpillSelection = fetchBooleanParam(kBoolSpillSelectionDisplay);	//see spill selection - check box
 		_paramBoolDisplaySpillGF = fetchBooleanParam(kBoolDisplaySpillGF);				//see spill geodesic form - check box
+		_paramIntAlphaGridResolution = fetchIntParam(kIntAlphaGridResolution);			//alpha grid resolution - Int parameter
 		
 		//verify display Discrete enable value
 		if(_paramBoolPointCloudDisplay->getValue())	//called default value
@@ -203,6 +204,10 @@ void ColorSpaceKeyerPlugin::changedParam( const OFX::InstanceChangedArgs &args,
 	{
 		updateGeodesicForms(args);
 	}
+	if(paramName == kIntAlphaGridResolution)
+	{
+		_renderAttributes.recomputeGeodesicForm = true;		//resample alpha of the forms
+	}
 }
 
 /*
@@ -426,6 +431,8 @@ void ColorSpaceKeyerPlugin::updateProcessGeodesicForms(const OFX::RenderArgument
 	selectionAverage.extendGeodesicForm(_clipColor,_renderScale,_renderAttributes.geodesicFormColor);	//extends geodesic form color
 	_renderAttributes.geodesicFormSpill.copyGeodesicForm(_renderAttributes.geodesicFormColor);							//extends geodesic form spill (color clip)
 	selectionAverage.extendGeodesicForm(_clipSpill,_renderScale,_renderAttributes.geodesicFormSpill);	//extends geodesic form spill (spill takes account of spill clip)
+	//Sample alpha once for all of the pixels
+	_renderAttributes.alphaGrid.compute(_renderAttributes.geodesicFormColor,_renderAttributes.geodesicFormSpill,static_cast<std::size_t>(_paramIntAlphaGridResolution->getValue()));
 	_renderAttributes.recomputeGeodesicForm = false;
 }
 
@@ -3,6 +3,7 @@
 
 #include "ColorSpaceKeyerDefinitions.hpp"
 #include "CloudPointData.hpp"
+#include "AlphaGrid.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
@@ -30,6 +31,7 @@ struct CSProcessParams
 	//Create geodesic form
 	GeodesicForm geodesicFormColor;          //color form
 	GeodesicForm geodesicFormSpill;          //spill form
+	AlphaGrid    alphaGrid;                  //alpha of the forms used by the process
 };
 
 
@@ -58,6 +60,7 @@ public:
 	OFX::DoubleParam*     _paramDoubleScaleGF;              // scale geodesic form - Double parameters
 	OFX::BooleanParam*    _paramBoolSeeSpillSelection;      // see spill selection on overlay - check box
 	OFX::BooleanParam*    _paramBoolDisplaySpillGF;         // see spill geodesic form on screen - check box
+	OFX::IntParam*        _paramIntAlphaGridResolution;     // number of alpha samples on each axis - Int parameter
 	
 	//Overlay data parameters
 	bool                  _updateVBO;                       // VBO data has been changed so update VBO
@@ -197,6 +197,17 @@ void ColorSpaceKeyerPluginFactory::describeInContext( OFX::ImageEffectDescriptor
 	scaleGF->setDisplayRange(0,2);									//set display range
 	scaleGF->setHint("Scale geodesic form");						//help
 	scaleGF->setParent(groupProcess);								//add to process group	
+	
+	//Alpha grid resolution (samples of the geodesic forms alpha)
+	OFX::IntParamDescriptor* alphaGridResolution = desc.defineIntParam(kIntAlphaGridResolution);
+	alphaGridResolution->setLabel(kIntAlphaGridResolutionLabel);	//add label
+	alphaGridResolution->setDefault(kAlphaGridResolution);			//default value
+	alphaGridResolution->setRange(2,256);							//value range
+	alphaGridResolution->setDisplayRange(16,128);					//display range values
+	alphaGridResolution->setHint("Number of alpha samples on each axis of the spill form bounding box.\n"
+	                             "Alpha is interpolated between the samples: thin forms or sharp form edges need more samples "
+	                             "(memory and computing time grow with the cube of the resolution)."); //help
+	alphaGridResolution->setParent(groupProcess);					//add to process group
 }
 
 /**
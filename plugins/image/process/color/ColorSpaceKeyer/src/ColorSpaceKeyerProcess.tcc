@@ -40,7 +40,7 @@ void ColorSpaceKeyerProcess<View>::multiThreadProcessImages( const OfxRectI& pro
 							                  procWindowSize.x, procWindowSize.y );
 	
     //Create and initialize functor 
-	Compute_alpha_pixel funct(false,_plugin._renderAttributes.geodesicFormColor, _plugin._renderAttributes.geodesicFormSpill); //Output is alpha
+	Compute_alpha_pixel funct(false,_plugin._renderAttributes.alphaGrid); //Output is alpha
 	//this function is chose because of functor reference and not copy
 	terry::algorithm::transform_pixels_progress(src,dst,funct,*this);
 }
@@ -41,6 +41,7 @@ ColorTransferProcessParams<ColorTransferPlugin::Scalar> ColorTransferPlugin::get
 
 void ColorTransferPlugin::changedParam( const OFX::InstanceChangedArgs &args, const std::string &paramName )
 {
+	_analysisCache.clear();
 //	if( paramName == kParamSameRegion )
 //	{
 //		const bool status = _paramSameRegion->getValue();
@@ -49,6 +50,16 @@ void ColorTransferPlugin::changedParam( const OFX::InstanceChangedArgs &args, co
 //	}
 }
 
+void ColorTransferPlugin::changedClip( const OFX::InstanceChangedArgs& args, const std::string& clipName )
+{
+	_analysisCache.clear();
+}
+
+void ColorTransferPlugin::beginSequenceRender( const OFX::BeginSequenceRenderArguments& args )
+{
+	_analysisCache.clear();
+}
+
 void ColorTransferPlugin::getRegionsOfInterest( const OFX::RegionsOfInterestArguments& args, OFX::RegionOfInterestSetter& rois )
 {
 	if( _clipSrcRef->isConnected() )
@@ -4,6 +4,7 @@
 #include "ColorTransferDefinitions.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
+#include <tuttle/plugin/AnalysisCache.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -31,6 +32,8 @@ public:
 	ColorTransferProcessParams<Scalar> getProcessParams( const OfxPointD& renderScale = OFX::kNoRenderScale ) const;
 
 	void changedParam( const OFX::InstanceChangedArgs &args, const std::string &paramName );
+	void changedClip( const OFX::InstanceChangedArgs& args, const std::string& clipName );
+	void beginSequenceRender( const OFX::BeginSequenceRenderArguments& args );
 
 	void getRegionsOfInterest( const OFX::RegionsOfInterestArguments& args, OFX::RegionOfInterestSetter& rois );
 
@@ -44,6 +47,7 @@ public:
 	OFX::DoubleParam* _paramAverageCoef;
 	OFX::DoubleParam* _paramDynamicCoef;
 
+	AnalysisCache _analysisCache; ///< averages and deviations of the references
 };
 
 }
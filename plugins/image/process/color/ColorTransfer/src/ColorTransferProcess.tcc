@@ -13,9 +13,13 @@
 #include <terry/numeric/assign.hpp>
 #include <terry/numeric/sqrt.hpp>
 #include <terry/numeric/operations_assign.hpp>
+#include <terry/numeric/statistics.hpp>
 #include <terry/globals.hpp>
 
-#include <boost/units/pow.hpp>
+#include <tuttle/plugin/ParallelReduction.hpp>
+
+#include <boost/array.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/mpl/vector.hpp>
 #include <boost/mpl/erase.hpp>
 #include <boost/mpl/find.hpp>
@@ -127,60 +131,50 @@ ColorTransferProcess<View>::ColorTransferProcess( ColorTransferPlugin &effect )
 {
 }
 
+/**
+ * @brief Moments of the pixels converted into the working colorspace.
+ */
+template<class Pixel, class CPixel>
+struct ColorspaceMoments
+{
+	terry::numeric::pixel_moments_t<CPixel> _moments;
+	EColorspace _eColorspace;
+
+	ColorspaceMoments( const EColorspace eColorspace )
+	: _eColorspace( eColorspace )
+	{}
+
+	GIL_FORCEINLINE
+	void operator()( const Pixel& p )
+	{
+		_moments( getPixel<Pixel, CPixel>( p, _eColorspace ) );
+	}
+
+	void merge( const ColorspaceMoments& other )
+	{
+		_moments.merge( other._moments );
+	}
+};
+
 template<class View>
 void ColorTransferProcess<View>::computeAverage( const View& image, Pixel& average, Pixel& deviation, const EColorspace& eColorspace )
 {
 	typedef typename color_space_type<View>::type Colorspace;
 	typedef pixel<boost::gil::bits64f, layout<Colorspace> > CPixel;
-	CPixel sumAverage, sumDeviation;
-	pixel_zeros_t<CPixel>()( sumAverage );
-	pixel_zeros_t<CPixel>()( sumDeviation );
-//	const std::size_t nbPixels = image.width( ) * image.height( );
 
-	// Average
-	CPixel cAverage;
-	pixel_zeros_t<CPixel>()( cAverage );
-	for( std::ssize_t y = 0; y < image.height( ); ++y )
-	{
-		CPixel sumAverageLine;
-		pixel_zeros_t<CPixel>()( sumAverageLine );
-		typename View::x_iterator src_it = image.x_at( 0, y );
-		for( std::ssize_t x = 0; x < image.width( ); ++x, ++src_it )
-		{
-//			CPixel pix; pixel_assigns_t<Pixel, CPixel>()( * src_it, pix );
-			CPixel pix = getPixel<Pixel, CPixel>( *src_it, eColorspace );
-			pixel_plus_assign_t<CPixel, CPixel>()( pix, sumAverageLine );
-		}
-		pixel_divides_scalar_assign_t<double, CPixel>()( image.width(), sumAverageLine );
-		pixel_plus_assign_t<CPixel>()( sumAverageLine, cAverage );
-	}
-	pixel_divides_scalar_assign_t<double, CPixel>()( image.height(), cAverage );
-	pixel_assigns_t<CPixel, Pixel>()( cAverage, average );
-//	average = pixel_divides_scalar_t<CPixel, double, Pixel>()( sumAverage, nbPixels );
+	// average and standard deviation in a single parallel pass
+	ColorspaceMoments<Pixel, CPixel> moments( eColorspace );
+	reducePixelsParallel( image, moments );
 
+	CPixel cAverage;
 	CPixel cDeviation;
-	pixel_zeros_t<CPixel>()( cDeviation );
-	// Standard deviation
-	for( std::ssize_t y = 0; y < image.height( ); ++y )
+	for( int i = 0; i < num_channels<CPixel>::value; ++i )
 	{
-		CPixel sumDeviationLine;
-		pixel_zeros_t<CPixel>()( sumDeviationLine );
-		typename View::x_iterator src_it = image.x_at( 0, y );
-		for( std::ssize_t x = 0; x < image.width(); ++x, ++src_it )
-		{
-//			CPixel pix; pixel_assigns_t<Pixel, CPixel>()( *src_it, pix );
-			CPixel pix = getPixel<Pixel, CPixel>( *src_it, eColorspace );
-			pixel_minus_assign_t<CPixel>()( cAverage, pix );
-			pix = pixel_pow_t<CPixel, 2>()( pix );
-			pixel_plus_assign_t<CPixel>()( pix, sumDeviationLine );
-		}
-		pixel_plus_assign_t<CPixel>()(
-				pixel_divides_scalar_t<CPixel, double>()( sumDeviationLine, image.width() ),
-				cDeviation
-			);
+		cAverage[i]   = moments._moments.moments[i].mean;
+		cDeviation[i] = moments._moments.moments[i].standard_deviation();
 	}
-	pixel_divides_scalar_assign_t<double, CPixel>()( image.height(), cDeviation );
-	deviation = pixel_sqrt_t<CPixel,Pixel>()( cDeviation );
+	pixel_assigns_t<CPixel, Pixel>()( cAverage, average );
+	pixel_assigns_t<CPixel, Pixel>()( cDeviation, deviation );
 }
 
 template<class View>
@@ -226,9 +220,39 @@ void ColorTransferProcess<View>::setup( const OFX::RenderArguments& args )
 	this->_dstRefView = this->getView( this->_dstRef.get( ), _dstRefPixelRod );
 
 	// analyse srcRef and dstRef
+	std::size_t analysisHash = 0;
+	boost::hash_combine( analysisHash, static_cast<int>( _params._colorspace ) );
+	boost::hash_combine( analysisHash, _plugin._clipSrcRef->isConnected() );
+	boost::hash_combine( analysisHash, _srcRefPixelRod.x1 );
+	boost::hash_combine( analysisHash, _srcRefPixelRod.y1 );
+	boost::hash_combine( analysisHash, _srcRefPixelRod.x2 );
+	boost::hash_combine( analysisHash, _srcRefPixelRod.y2 );
+	boost::hash_combine( analysisHash, _dstRefPixelRod.x1 );
+	boost::hash_combine( analysisHash, _dstRefPixelRod.y1 );
+	boost::hash_combine( analysisHash, _dstRefPixelRod.x2 );
+	boost::hash_combine( analysisHash, _dstRefPixelRod.y2 );
+	boost::hash_combine( analysisHash, args.renderScale.x );
+	boost::hash_combine( analysisHash, args.renderScale.y );
+
 	Pixel srcRefDeviation, dstRefDeviation;
-	computeAverage( this->_srcRefView, _srcRefAverage, srcRefDeviation, _params._colorspace );
-	computeAverage( this->_dstRefView, _dstRefAverage, dstRefDeviation, _params._colorspace );
+	boost::array<Pixel, 4> analysis;
+	if( _plugin._analysisCache.get( args.time, analysisHash, analysis ) )
+	{
+		_srcRefAverage  = analysis[0];
+		srcRefDeviation = analysis[1];
+		_dstRefAverage  = analysis[2];
+		dstRefDeviation = analysis[3];
+	}
+	else
+	{
+		computeAverage( this->_srcRefView, _srcRefAverage, srcRefDeviation, _params._colorspace );
+		computeAverage( this->_dstRefView, _dstRefAverage, dstRefDeviation, _params._colorspace );
+		analysis[0] = _srcRefAverage;
+		analysis[1] = srcRefDeviation;
+		analysis[2] = _dstRefAverage;
+		analysis[3] = dstRefDeviation;
+		_plugin._analysisCache.set( args.time, analysisHash, analysis );
+	}
 	//TUTTLE_LOG_VAR4( TUTTLE_INFO, _srcRefAverage[0], _srcRefDeviation[0], _dstRefAverage[0], _dstRefDeviation[0]);
 	
 	TUTTLE_TLOG_VAR( TUTTLE_INFO, get_color( dstRefDeviation, red_t() ) );
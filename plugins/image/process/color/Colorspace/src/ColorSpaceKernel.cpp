@@ -0,0 +1,560 @@
+#include "ColorSpaceKernel.hpp"
+#include "ColorSpacePlugin.hpp"
+
+#include <terry/colorspace/gradation.hpp>
+#include <terry/colorspace/temperature.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace tuttle {
+namespace plugin {
+namespace colorspace {
+
+namespace {
+
+/// D65 white point of the XYZ layouts
+static const double kWhiteX = 0.95047;
+static const double kWhiteY = 1.0;
+static const double kWhiteZ = 1.08883;
+
+/// CIE constants of the Lab and Luv layouts
+static const double kLabDelta = 6.0 / 29.0;
+
+/// sRGB / Rec709 primaries
+static const double kRgbToXyz[9] = {
+	0.4124564, 0.3575761, 0.1804375,
+	0.2126729, 0.7151522, 0.0721750,
+	0.0193339, 0.1191920, 0.9503041
+};
+
+static const double kRgbToYuv[9] = {
+	 0.299,    0.587,    0.114,
+	-0.14713, -0.28886,  0.436,
+	 0.615,   -0.51499, -0.10001
+};
+
+static const double kRgbToYPbPr[9] = {
+	 0.299,     0.587,     0.114,
+	-0.168736, -0.331264,  0.5,
+	 0.5,      -0.418688, -0.081312
+};
+
+static const double kIdentity[9] = {
+	1.0, 0.0, 0.0,
+	0.0, 1.0, 0.0,
+	0.0, 0.0, 1.0
+};
+
+void multiplyMatrices( const double* a, const double* b, double* out )
+{
+	double tmp[9];
+	for( int i = 0; i < 3; ++i )
+		for( int j = 0; j < 3; ++j )
+			tmp[i * 3 + j] = a[i * 3] * b[j] + a[i * 3 + 1] * b[3 + j] + a[i * 3 + 2] * b[6 + j];
+	std::copy( tmp, tmp + 9, out );
+}
+
+void invert( const double* m, double* out )
+{
+	const double c00 = m[4] * m[8] - m[5] * m[7];
+	const double c01 = m[5] * m[6] - m[3] * m[8];
+	const double c02 = m[3] * m[7] - m[4] * m[6];
+	const double invDet = 1.0 / ( m[0] * c00 + m[1] * c01 + m[2] * c02 );
+	out[0] = c00 * invDet;
+	out[1] = ( m[2] * m[7] - m[1] * m[8] ) * invDet;
+	out[2] = ( m[1] * m[5] - m[2] * m[4] ) * invDet;
+	out[3] = c01 * invDet;
+	out[4] = ( m[0] * m[8] - m[2] * m[6] ) * invDet;
+	out[5] = ( m[2] * m[3] - m[0] * m[5] ) * invDet;
+	out[6] = c02 * invDet;
+	out[7] = ( m[1] * m[6] - m[0] * m[7] ) * invDet;
+	out[8] = ( m[0] * m[4] - m[1] * m[3] ) * invDet;
+}
+
+/// matrix from RGB to the linear part of a layout
+void layoutFromRgb( const ttlc::EParamLayout layout, double* m )
+{
+	switch( layout )
+	{
+		case ttlc::eParamLayoutYUV:
+			std::copy( kRgbToYuv, kRgbToYuv + 9, m );
+			break;
+		case ttlc::eParamLayoutYPbPr:
+			std::copy( kRgbToYPbPr, kRgbToYPbPr + 9, m );
+			break;
+		case ttlc::eParamLayoutXYZ:
+		case ttlc::eParamLayoutLab:
+		case ttlc::eParamLayoutLuv:
+		case ttlc::eParamLayoutYxy:
+			std::copy( kRgbToXyz, kRgbToXyz + 9, m );
+			break;
+		case ttlc::eParamLayoutRGB:
+		case ttlc::eParamLayoutHSV:
+		case ttlc::eParamLayoutHSL:
+			std::copy( kIdentity, kIdentity + 9, m );
+			break;
+	}
+}
+
+ColorSpaceKernel::ENonLinearStep nonLinearStep( const ttlc::EParamLayout layout )
+{
+	switch( layout )
+	{
+		case ttlc::eParamLayoutHSV:
+			return ColorSpaceKernel::eNonLinearHSV;
+		case ttlc::eParamLayoutHSL:
+			return ColorSpaceKernel::eNonLinearHSL;
+		case ttlc::eParamLayoutLab:
+			return ColorSpaceKernel::eNonLinearLab;
+		case ttlc::eParamLayoutLuv:
+			return ColorSpaceKernel::eNonLinearLuv;
+		case ttlc::eParamLayoutYxy:
+			return ColorSpaceKernel::eNonLinearYxy;
+		default:
+			break;
+	}
+	return ColorSpaceKernel::eNonLinearNone;
+}
+
+/// diagonal coefficients of the conversion from D65 (terry's intermediate temperature) to a temperature
+const double* temperatureFromD65( const ttlc::EColorTemperature temperature )
+{
+	namespace tt = terry::color::temperature;
+	switch( temperature )
+	{
+		case ttlc::eColorTemperatureA:     return terry::color::coefficients_from_inter<tt::T_A>();
+		case ttlc::eColorTemperatureB:     return terry::color::coefficients_from_inter<tt::T_B>();
+		case ttlc::eColorTemperatureC:     return terry::color::coefficients_from_inter<tt::T_C>();
+		case ttlc::eColorTemperatureD50:   return terry::color::coefficients_from_inter<tt::T_D50>();
+		case ttlc::eColorTemperatureD55:   return terry::color::coefficients_from_inter<tt::T_D55>();
+		case ttlc::eColorTemperatureD58:   return terry::color::coefficients_from_inter<tt::T_D58>();
+		case ttlc::eColorTemperatureD65:   return terry::color::coefficients_from_inter<tt::T_D65>();
+		case ttlc::eColorTemperatureD75:   return terry::color::coefficients_from_inter<tt::T_D75>();
+		case ttlc::eColorTemperature9300:  return terry::color::coefficients_from_inter<tt::T_9300>();
+		case ttlc::eColorTemperatureE:     return terry::color::coefficients_from_inter<tt::T_E>();
+		case ttlc::eColorTemperatureF2:    return terry::color::coefficients_from_inter<tt::T_F2>();
+		case ttlc::eColorTemperatureF7:    return terry::color::coefficients_from_inter<tt::T_F7>();
+		case ttlc::eColorTemperatureF11:   return terry::color::coefficients_from_inter<tt::T_F11>();
+		case ttlc::eColorTemperatureDCIP3: return terry::color::coefficients_from_inter<tt::T_DCIP3>();
+	}
+	return terry::color::coefficients_from_inter<tt::T_INTER>();
+}
+
+/// terry conversion of a value between a gradation law and linear
+template<class Law>
+double convertGradation( const Law& law, const bool toLinear, const double v )
+{
+	namespace tg = terry::color::gradation;
+	const tg::Linear linear;
+	double result;
+	if( toLinear )
+		terry::color::channel_color_gradation_t<double, Law, tg::Linear>( law, linear )( v, result );
+	else
+		terry::color::channel_color_gradation_t<double, tg::Linear, Law>( linear, law )( v, result );
+	return result;
+}
+
+bool isIdentityMatrix( const double* m )
+{
+	for( int i = 0; i < 9; ++i )
+		if( std::abs( m[i] - kIdentity[i] ) > 1e-12 )
+			return false;
+	return true;
+}
+
+inline double labF( const double t )
+{
+	return t > kLabDelta * kLabDelta * kLabDelta ? std::pow( t, 1.0 / 3.0 ) : t / ( 3.0 * kLabDelta * kLabDelta ) + 4.0 / 29.0;
+}
+
+inline double labInvF( const double t )
+{
+	return t > kLabDelta ? t * t * t : 3.0 * kLabDelta * kLabDelta * ( t - 4.0 / 29.0 );
+}
+
+inline double hueToRgb( const double p, const double q, double h )
+{
+	if( h < 0.0 )
+		h += 1.0;
+	if( h > 1.0 )
+		h -= 1.0;
+	if( h < 1.0 / 6.0 )
+		return p + ( q - p ) * 6.0 * h;
+	if( h < 0.5 )
+		return q;
+	if( h < 2.0 / 3.0 )
+		return p + ( q - p ) * ( 2.0 / 3.0 - h ) * 6.0;
+	return p;
+}
+
+/// hue in [0,1] and chroma of a rgb color
+inline void hueChroma( const float* c, double& hue, double& maxColor, double& minColor )
+{
+	maxColor = std::max( c[0], std::max( c[1], c[2] ) );
+	minColor = std::min( c[0], std::min( c[1], c[2] ) );
+	const double diff = maxColor - minColor;
+	if( diff == 0.0 )
+	{
+		hue = 0.0;
+		return;
+	}
+	if( maxColor == c[0] )
+		hue = ( c[1] - c[2] ) / diff;
+	else if( maxColor == c[1] )
+		hue = 2.0 + ( c[2] - c[0] ) / diff;
+	else
+		hue = 4.0 + ( c[0] - c[1] ) / diff;
+	if( hue < 0.0 )
+		hue += 6.0;
+	hue /= 6.0;
+}
+
+}
+
+void TransferCurve::reset( const ttlc::EParamGradationLaw law, const bool toLinear, const double gamma, const ttlc::GradationLaw::cineon& cineon )
+{
+	_law      = law;
+	_toLinear = toLinear;
+	_gamma    = gamma;
+	_cineon   = cineon;
+	_linear   = ( law == ttlc::eParamLinear || law == ttlc::eParamREDSpace || ( law == ttlc::eParamGamma && gamma == 1.0 ) );
+	_lut.clear();
+	if( _linear )
+		return;
+	_lut.resize( kLutSize + 1 );
+	for( std::size_t i = 0; i <= kLutSize; ++i )
+		_lut[i] = static_cast<float>( exact( double( i ) / kLutSize ) );
+}
+
+double TransferCurve::exact( const double v ) const
+{
+	namespace tg = terry::color::gradation;
+	switch( _law )
+	{
+		case ttlc::eParamLinear:
+			return v;
+		case ttlc::eParamsRGB:
+			return convertGradation( tg::sRGB(), _toLinear, v );
+		case ttlc::eParamCineon:
+			return convertGradation( tg::Cineon( _cineon.blackPoint, _cineon.whitePoint, _cineon.gammaSensito ), _toLinear, v );
+		case ttlc::eParamGamma:
+			return convertGradation( tg::Gamma( _gamma ), _toLinear, v );
+		case ttlc::eParamPanalog:
+			return convertGradation( tg::Panalog(), _toLinear, v );
+		case ttlc::eParamREDLog:
+			return convertGradation( tg::REDLog(), _toLinear, v );
+		case ttlc::eParamViperLog:
+			return convertGradation( tg::ViperLog(), _toLinear, v );
+		case ttlc::eParamREDSpace:
+			return convertGradation( tg::REDSpace(), _toLinear, v );
+		case ttlc::eParamAlexaLogC:
+			return convertGradation( tg::AlexaV3LogC(), _toLinear, v );
+	}
+	return v;
+}
+
+void TransferCurve::buildTable( const std::size_t maxValue, std::vector<float>& table ) const
+{
+	table.resize( maxValue + 1 );
+	for( std::size_t i = 0; i <= maxValue; ++i )
+		table[i] = static_cast<float>( exact( double( i ) / maxValue ) );
+}
+
+ColorSpaceKernel::ColorSpaceKernel()
+	: _decodeStep( eNonLinearNone )
+	, _encodeStep( eNonLinearNone )
+	, _matrixInIdentity( true )
+	, _matrixOutIdentity( true )
+	, _identity( true )
+{
+	std::copy( kIdentity, kIdentity + 9, _matrixIn );
+	std::copy( kIdentity, kIdentity + 9, _matrixOut );
+	std::fill( _scale, _scale + 3, 1.0f );
+}
+
+bool isSameGradation( const ColorSpaceProcessParams& params )
+{
+	return params._gradationIn == params._gradationOut &&
+		( params._gradationIn != ttlc::eParamGamma || params._sGammaIn.value == params._sGammaOut.value ) &&
+		( params._gradationIn != ttlc::eParamCineon || (
+			params._sCineonIn.blackPoint   == params._sCineonOut.blackPoint &&
+			params._sCineonIn.whitePoint   == params._sCineonOut.whitePoint &&
+			params._sCineonIn.gammaSensito == params._sCineonOut.gammaSensito ) );
+}
+
+bool isSameColor( const ColorSpaceProcessParams& params )
+{
+	return params._layoutIn == params._layoutOut && params._tempColorIn == params._tempColorOut;
+}
+
+void ColorSpaceKernel::reset( const ColorSpaceProcessParams& params )
+{
+	_curveIn.reset( params._gradationIn, true, params._sGammaIn.value, params._sCineonIn );
+	_curveOut.reset( params._gradationOut, false, params._sGammaOut.value, params._sCineonOut );
+	const bool linearCurves = _curveIn.isLinear() && _curveOut.isLinear();
+
+	_identity = isSameColor( params ) && ( linearCurves || isSameGradation( params ) );
+	if( _identity )
+	{
+		_decodeStep = eNonLinearNone;
+		_encodeStep = eNonLinearNone;
+		std::copy( kIdentity, kIdentity + 9, _matrixIn );
+		std::copy( kIdentity, kIdentity + 9, _matrixOut );
+		std::fill( _scale, _scale + 3, 1.0f );
+		_matrixInIdentity = _matrixOutIdentity = true;
+		return;
+	}
+
+	_decodeStep = nonLinearStep( params._layoutIn );
+	_encodeStep = nonLinearStep( params._layoutOut );
+
+	double toRgb[9];
+	double fromRgb[9];
+	layoutFromRgb( params._layoutIn, fromRgb );
+	invert( fromRgb, toRgb );
+	layoutFromRgb( params._layoutOut, fromRgb );
+
+	// input temperature -> D65 -> output temperature
+	const double* temperatureIn  = temperatureFromD65( params._tempColorIn );
+	const double* temperatureOut = temperatureFromD65( params._tempColorOut );
+	double temperature[9];
+	std::copy( kIdentity, kIdentity + 9, temperature );
+	for( int i = 0; i < 3; ++i )
+		temperature[i * 4] = temperatureOut[i] / temperatureIn[i];
+
+	double matrixIn[9];
+	double matrixOut[9];
+	double scale[3];
+	if( linearCurves )
+	{
+		// no curve between the layouts: input layout -> RGB -> temperature -> output layout
+		double m[9];
+		multiplyMatrices( temperature, toRgb, m );
+		multiplyMatrices( fromRgb, m, m );
+		bool diagonal = true;
+		for( int i = 0; i < 9; ++i )
+			if( i % 4 != 0 && std::abs( m[i] ) > 1e-12 )
+				diagonal = false;
+		if( diagonal )
+		{
+			for( int i = 0; i < 3; ++i )
+				scale[i] = m[i * 4];
+			std::copy( kIdentity, kIdentity + 9, matrixIn );
+		}
+		else
+		{
+			std::fill( scale, scale + 3, 1.0 );
+			std::copy( m, m + 9, matrixIn );
+		}
+		std::copy( kIdentity, kIdentity + 9, matrixOut );
+	}
+	else
+	{
+		std::copy( toRgb, toRgb + 9, matrixIn );
+		for( int i = 0; i < 3; ++i )
+			scale[i] = temperature[i * 4];
+		std::copy( fromRgb, fromRgb + 9, matrixOut );
+	}
+
+	_matrixInIdentity  = isIdentityMatrix( matrixIn );
+	_matrixOutIdentity = isIdentityMatrix( matrixOut );
+	for( int i = 0; i < 9; ++i )
+	{
+		_matrixIn[i]  = static_cast<float>( matrixIn[i] );
+		_matrixOut[i] = static_cast<float>( matrixOut[i] );
+	}
+	for( int i = 0; i < 3; ++i )
+		_scale[i] = static_cast<float>( scale[i] );
+}
+
+void ColorSpaceKernel::buildSeparableTable( const int channel, const std::size_t maxValue, std::vector<float>& table ) const
+{
+	const double scale = _scale[channel];
+	table.resize( maxValue + 1 );
+	for( std::size_t i = 0; i <= maxValue; ++i )
+		table[i] = static_cast<float>( _curveOut.exact( scale * _curveIn.exact( double( i ) / maxValue ) ) );
+}
+
+void ColorSpaceKernel::decodeNonLinear( float* c ) const
+{
+	switch( _decodeStep )
+	{
+		case eNonLinearNone:
+			break;
+		case eNonLinearHSV:
+		{
+			// to RGB
+			const double h = c[0] * 6.0;
+			const double s = c[1];
+			const double v = c[2];
+			const int sector = static_cast<int>( std::floor( h ) );
+			const double f = h - sector;
+			const float p = static_cast<float>( v * ( 1.0 - s ) );
+			const float q = static_cast<float>( v * ( 1.0 - s * f ) );
+			const float t = static_cast<float>( v * ( 1.0 - s * ( 1.0 - f ) ) );
+			const float fv = static_cast<float>( v );
+			switch( ( ( sector % 6 ) + 6 ) % 6 )
+			{
+				case 0: c[0] = fv; c[1] = t;  c[2] = p;  break;
+				case 1: c[0] = q;  c[1] = fv; c[2] = p;  break;
+				case 2: c[0] = p;  c[1] = fv; c[2] = t;  break;
+				case 3: c[0] = p;  c[1] = q;  c[2] = fv; break;
+				case 4: c[0] = t;  c[1] = p;  c[2] = fv; break;
+				default: c[0] = fv; c[1] = p; c[2] = q;  break;
+			}
+			break;
+		}
+		case eNonLinearHSL:
+		{
+			// to RGB
+			const double h = c[0];
+			const double s = c[1];
+			const double l = c[2];
+			if( s == 0.0 )
+			{
+				c[0] = c[1] = c[2] = static_cast<float>( l );
+				break;
+			}
+			const double q = l < 0.5 ? l * ( 1.0 + s ) : l + s - l * s;
+			const double p = 2.0 * l - q;
+			c[0] = static_cast<float>( hueToRgb( p, q, h + 1.0 / 3.0 ) );
+			c[1] = static_cast<float>( hueToRgb( p, q, h ) );
+			c[2] = static_cast<float>( hueToRgb( p, q, h - 1.0 / 3.0 ) );
+			break;
+		}
+		case eNonLinearLab:
+		{
+			// to XYZ
+			const double fy = ( c[0] + 16.0 ) / 116.0;
+			const double fx = fy + c[1] / 500.0;
+			const double fz = fy - c[2] / 200.0;
+			c[0] = static_cast<float>( kWhiteX * labInvF( fx ) );
+			c[1] = static_cast<float>( kWhiteY * labInvF( fy ) );
+			c[2] = static_cast<float>( kWhiteZ * labInvF( fz ) );
+			break;
+		}
+		case eNonLinearLuv:
+		{
+			// to XYZ
+			const double l = c[0];
+			if( l == 0.0 )
+			{
+				c[0] = c[1] = c[2] = 0.0f;
+				break;
+			}
+			const double whiteDenom = kWhiteX + 15.0 * kWhiteY + 3.0 * kWhiteZ;
+			const double up = c[1] / ( 13.0 * l ) + 4.0 * kWhiteX / whiteDenom;
+			const double vp = c[2] / ( 13.0 * l ) + 9.0 * kWhiteY / whiteDenom;
+			const double y  = kWhiteY * labInvF( ( l + 16.0 ) / 116.0 );
+			c[0] = static_cast<float>( y * 9.0 * up / ( 4.0 * vp ) );
+			c[1] = static_cast<float>( y );
+			c[2] = static_cast<float>( y * ( 12.0 - 3.0 * up - 20.0 * vp ) / ( 4.0 * vp ) );
+			break;
+		}
+		case eNonLinearYxy:
+		{
+			// to XYZ
+			const double y  = c[0];
+			const double cx = c[1];
+			const double cy = c[2];
+			if( cy == 0.0 )
+			{
+				c[0] = c[1] = c[2] = 0.0f;
+				break;
+			}
+			c[0] = static_cast<float>( y * cx / cy );
+			c[1] = static_cast<float>( y );
+			c[2] = static_cast<float>( y * ( 1.0 - cx - cy ) / cy );
+			break;
+		}
+	}
+}
+
+void ColorSpaceKernel::encodeNonLinear( float* c ) const
+{
+	switch( _encodeStep )
+	{
+		case eNonLinearNone:
+			break;
+		case eNonLinearHSV:
+		{
+			// from RGB
+			double hue, maxColor, minColor;
+			hueChroma( c, hue, maxColor, minColor );
+			c[0] = static_cast<float>( hue );
+			c[1] = static_cast<float>( maxColor == 0.0 ? 0.0 : ( maxColor - minColor ) / maxColor );
+			c[2] = static_cast<float>( maxColor );
+			break;
+		}
+		case eNonLinearHSL:
+		{
+			// from RGB
+			double hue, maxColor, minColor;
+			hueChroma( c, hue, maxColor, minColor );
+			const double diff      = maxColor - minColor;
+			const double lightness = ( maxColor + minColor ) * 0.5;
+			double saturation = 0.0;
+			if( diff != 0.0 )
+				saturation = lightness < 0.5 ? diff / ( maxColor + minColor ) : diff / ( 2.0 - maxColor - minColor );
+			c[0] = static_cast<float>( hue );
+			c[1] = static_cast<float>( saturation );
+			c[2] = static_cast<float>( lightness );
+			break;
+		}
+		case eNonLinearLab:
+		{
+			// from XYZ
+			const double fx = labF( c[0] / kWhiteX );
+			const double fy = labF( c[1] / kWhiteY );
+			const double fz = labF( c[2] / kWhiteZ );
+			c[0] = static_cast<float>( 116.0 * fy - 16.0 );
+			c[1] = static_cast<float>( 500.0 * ( fx - fy ) );
+			c[2] = static_cast<float>( 200.0 * ( fy - fz ) );
+			break;
+		}
+		case eNonLinearLuv:
+		{
+			// from XYZ
+			const double denom      = c[0] + 15.0 * c[1] + 3.0 * c[2];
+			const double whiteDenom = kWhiteX + 15.0 * kWhiteY + 3.0 * kWhiteZ;
+			const double l = 116.0 * labF( c[1] / kWhiteY ) - 16.0;
+			if( denom == 0.0 )
+			{
+				c[0] = static_cast<float>( l );
+				c[1] = c[2] = 0.0f;
+				break;
+			}
+			const double up = 4.0 * c[0] / denom;
+			const double vp = 9.0 * c[1] / denom;
+			c[0] = static_cast<float>( l );
+			c[1] = static_cast<float>( 13.0 * l * ( up - 4.0 * kWhiteX / whiteDenom ) );
+			c[2] = static_cast<float>( 13.0 * l * ( vp - 9.0 * kWhiteY / whiteDenom ) );
+			break;
+		}
+		case eNonLinearYxy:
+		{
+			// from XYZ
+			const double sum = double( c[0] ) + c[1] + c[2];
+			const float y = c[1];
+			if( sum == 0.0 )
+			{
+				// black: chromaticity of the white point
+				const double whiteSum = kWhiteX + kWhiteY + kWhiteZ;
+				c[1] = static_cast<float>( kWhiteX / whiteSum );
+				c[2] = static_cast<float>( kWhiteY / whiteSum );
+			}
+			else
+			{
+				c[1] = static_cast<float>( c[0] / sum );
+				c[2] = static_cast<float>( y / sum );
+			}
+			c[0] = y;
+			break;
+		}
+	}
+}
+
+}
+}
+}
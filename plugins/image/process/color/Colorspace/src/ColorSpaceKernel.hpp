@@ -0,0 +1,175 @@
+#ifndef _TUTTLE_COLORSPACE_KERNEL_HPP_
+#define _TUTTLE_COLORSPACE_KERNEL_HPP_
+
+#include "ColorSpaceDefinitions.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+namespace colorspace {
+
+namespace ttlc = tuttle::plugin::color;
+
+struct ColorSpaceProcessParams;
+
+/// input and output gradation laws are the same
+bool isSameGradation( const ColorSpaceProcessParams& params );
+/// input and output layouts and color temperatures are the same
+bool isSameColor( const ColorSpaceProcessParams& params );
+
+/**
+ * @brief Transfer function of a gradation law, sampled in a 1D lut.
+ *
+ * Values in ]0,1[ are linearly interpolated in the lut, other values
+ * (first cell, negative or overexposed values) use the exact formula.
+ */
+class TransferCurve
+{
+public:
+	static const std::size_t kLutSize = 16384;
+
+public:
+	TransferCurve() : _linear( true ) {}
+
+	/**
+	 * @param toLinear direction of the conversion: from the law to linear or from linear to the law
+	 */
+	void reset( const ttlc::EParamGradationLaw law, const bool toLinear, const double gamma, const ttlc::GradationLaw::cineon& cineon );
+
+	bool isLinear() const { return _linear; }
+
+	inline float operator()( const float v ) const
+	{
+		if( _linear )
+			return v;
+		const float s = v * kLutSize;
+		if( s >= 1.0f && s < float( kLutSize ) )
+		{
+			const std::size_t i = static_cast<std::size_t>( s );
+			return _lut[i] + ( s - i ) * ( _lut[i + 1] - _lut[i] );
+		}
+		return static_cast<float>( exact( v ) );
+	}
+
+	/// exact formula of the conversion
+	double exact( const double v ) const;
+
+	/// exact values of all the values of an integer channel (value / maxValue)
+	void buildTable( const std::size_t maxValue, std::vector<float>& table ) const;
+
+private:
+	ttlc::EParamGradationLaw _law;
+	bool _toLinear;
+	bool _linear;
+	double _gamma;
+	ttlc::GradationLaw::cineon _cineon;
+	std::vector<float> _lut; ///< kLutSize+1 samples of the curve on [0,1]
+};
+
+/**
+ * @brief Whole colorspace conversion, fused at setup.
+ *
+ * The gradation laws apply to the RGB values, so the conversion is:
+ * non linear input layout (HSV, HSL to RGB or Lab, Luv, Yxy to XYZ),
+ * input layout to RGB, input curve, color temperatures, output curve,
+ * RGB to the output layout and non linear output layout.
+ * If both curves are linear, the linear steps are a single 3x3 matrix.
+ */
+class ColorSpaceKernel
+{
+public:
+	enum ENonLinearStep
+	{
+		eNonLinearNone = 0,
+		eNonLinearHSV,
+		eNonLinearHSL,
+		eNonLinearLab,
+		eNonLinearLuv,
+		eNonLinearYxy
+	};
+
+public:
+	ColorSpaceKernel();
+
+	void reset( const ColorSpaceProcessParams& params );
+
+	/// output == input
+	bool isIdentity() const { return _identity; }
+	/// the input curve is applied directly to the input values
+	bool hasRgbInput() const { return _decodeStep == eNonLinearNone && _matrixInIdentity; }
+	/// each output channel only depends on the same input channel
+	bool isSeparable() const { return hasRgbInput() && _encodeStep == eNonLinearNone && _matrixOutIdentity; }
+
+	const TransferCurve& inputCurve() const  { return _curveIn; }
+	const TransferCurve& outputCurve() const { return _curveOut; }
+
+	/// all the steps after the input curve, on linearized RGB values
+	inline void applyLinearized( float* c ) const
+	{
+		for( int i = 0; i < 3; ++i )
+			c[i] = _curveOut( c[i] * _scale[i] );
+		if( ! _matrixOutIdentity )
+			multiply( _matrixOut, c );
+		encode( c );
+	}
+
+	/// the whole conversion of a color
+	inline void apply( float* c ) const
+	{
+		decode( c );
+		if( ! _matrixInIdentity )
+			multiply( _matrixIn, c );
+		for( int i = 0; i < 3; ++i )
+			c[i] = _curveIn( c[i] );
+		applyLinearized( c );
+	}
+
+	/**
+	 * @brief Exact output values (normalized) of all the values of an integer channel.
+	 * Only valid if the kernel is separable.
+	 */
+	void buildSeparableTable( const int channel, const std::size_t maxValue, std::vector<float>& table ) const;
+
+private:
+	static inline void multiply( const float* m, float* c )
+	{
+		const float r = c[0];
+		const float g = c[1];
+		const float b = c[2];
+		c[0] = m[0] * r + m[1] * g + m[2] * b;
+		c[1] = m[3] * r + m[4] * g + m[5] * b;
+		c[2] = m[6] * r + m[7] * g + m[8] * b;
+	}
+	inline void decode( float* c ) const
+	{
+		if( _decodeStep != eNonLinearNone )
+			decodeNonLinear( c );
+	}
+	inline void encode( float* c ) const
+	{
+		if( _encodeStep != eNonLinearNone )
+			encodeNonLinear( c );
+	}
+	void decodeNonLinear( float* c ) const;
+	void encodeNonLinear( float* c ) const;
+
+private:
+	TransferCurve _curveIn;
+	TransferCurve _curveOut;
+	ENonLinearStep _decodeStep;
+	ENonLinearStep _encodeStep;
+	float _matrixIn[9];  ///< input layout to RGB, row major
+	float _matrixOut[9]; ///< RGB to output layout, row major
+	float _scale[3];     ///< color temperature change of the RGB channels
+	bool _matrixInIdentity;
+	bool _matrixOutIdentity;
+	bool _identity;
+};
+
+}
+}
+}
+
+#endif
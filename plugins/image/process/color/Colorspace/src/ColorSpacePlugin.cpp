@@ -2,6 +2,7 @@
 #include "ColorSpacePlugin.hpp"
 #include "ColorSpaceProcess.hpp"
 #include "ColorSpaceDefinitions.hpp"
+#include "ColorSpaceKernel.hpp"
 
 #include <boost/gil/gil_all.hpp>
 
@@ -122,22 +123,13 @@ ColorSpaceProcessParams ColorSpacePlugin::getProcessParams( ) const
 
 bool ColorSpacePlugin::isIdentity( const OFX::RenderArguments& args, OFX::Clip*& identityClip, double& identityTime )
 {
-	/*
-	ColorSpaceProcessParams params = getProcessParams();
-	if(
-		params._BlackPointIn	== params._BlackPointOut &&
-		params._GammaSensitoIn	== params._GammaSensitoOut &&
-		params._GammaValueIn	== params._GammaValueOut &&
-		params._WhitePointIn	== params._WhitePointOut &&
-		params._gradationIn	== params._gradationOut &&
-		params._layoutIn	== params._layoutOut &&
-		params._tempColorIn	== params._tempColorOut
-	 )
+	const ColorSpaceProcessParams params = getProcessParams();
+	if( isSameGradation( params ) && isSameColor( params ) )
 	{
 		identityClip = _clipSrc;
 		identityTime = args.time;
 		return true;
-	}*/
+	}
 	return false;
 }
 
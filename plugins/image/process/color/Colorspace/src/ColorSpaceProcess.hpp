@@ -1,6 +1,9 @@
 #ifndef _TUTTLE_COLORSPACE_PROCESS_HPP_
 #define _TUTTLE_COLORSPACE_PROCESS_HPP_
 
+#include "ColorSpacePlugin.hpp"
+#include "ColorSpaceKernel.hpp"
+
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
 #include <tuttle/plugin/exceptions.hpp>
 #include <terry/globals.hpp>
@@ -9,6 +12,10 @@
 #include <ofxsMultiThread.h>
 
 #include <boost/scoped_ptr.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <vector>
 
 namespace tuttle {
 namespace plugin {
@@ -17,8 +24,18 @@ namespace colorspace {
 template<class View>
 class ColorSpaceProcess : public ImageGilFilterProcessor<View>
 {
+public:
+	typedef typename boost::gil::channel_type<View>::type Channel;
+	typedef typename boost::mpl::bool_<boost::is_integral<Channel>::value> IsIntegral;
+
+	/// number of pixels processed at once: input values, conversion, then output values
+	static const std::size_t kBatchSize = 64;
+
 protected:
 	ColorSpaceProcessParams _params;
+	ColorSpaceKernel _kernel;           ///< whole conversion, fused at setup
+	std::vector<float> _inputTable;     ///< exact input curve of all the channel values, if the input is RGB (8 and 16 bits)
+	std::vector<Channel> _separableTables[3]; ///< exact conversion of all the channel values, if the kernel is separable (8 and 16 bits)
 
 	ColorSpacePlugin& _plugin; ///< Rendering plugin
 
@@ -28,6 +45,19 @@ public:
 	void setup( const OFX::RenderArguments& args );
 
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+
+private:
+	void applySeparableTables( const View& src, const View& dst );
+	void applyKernel( const View& src, const View& dst );
+
+	inline float inputValue( const Channel v, const boost::mpl::true_ /*integral*/ ) const
+	{
+		return _inputTable[v];
+	}
+	inline float inputValue( const Channel v, const boost::mpl::false_ /*integral*/ ) const
+	{
+		return _kernel.inputCurve()( v );
+	}
 };
 
 }
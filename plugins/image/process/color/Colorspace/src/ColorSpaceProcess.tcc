@@ -2,7 +2,8 @@
 #include <tuttle/plugin/exceptions.hpp>
 
 #include <terry/globals.hpp>
-#include <terry/color.hpp>
+
+#include <algorithm>
 
 namespace tuttle {
 namespace plugin {
@@ -21,8 +22,30 @@ template<class View>
 void ColorSpaceProcess<View>::setup( const OFX::RenderArguments& args )
 {
 	ImageGilFilterProcessor<View>::setup( args );
-	
+
 	_params = _plugin.getProcessParams();
+	_kernel.reset( _params );
+
+	if( ! IsIntegral::value || _kernel.isIdentity() )
+		return;
+
+	// 8 and 16 bits: exact tables instead of the interpolated curves
+	const std::size_t maxValue = channel_traits<Channel>::max_value();
+	if( _kernel.isSeparable() )
+	{
+		std::vector<float> table;
+		for( int c = 0; c < 3; ++c )
+		{
+			_kernel.buildSeparableTable( c, maxValue, table );
+			_separableTables[c].resize( maxValue + 1 );
+			for( std::size_t i = 0; i <= maxValue; ++i )
+				_separableTables[c][i] = static_cast<Channel>( std::min( std::max( table[i], 0.0f ), 1.0f ) * maxValue + 0.5f );
+		}
+	}
+	else if( _kernel.hasRgbInput() )
+	{
+		_kernel.inputCurve().buildTable( maxValue, _inputTable );
+	}
 }
 
 
@@ -44,15 +67,88 @@ void ColorSpaceProcess<View>::multiThreadProcessImages( const OfxRectI& procWind
 	View dst = subimage_view( this->_dstView, procWindowOutput.x1, procWindowOutput.y1,
 					procWindowSize.x, procWindowSize.y );
 
-	/*
-	terry::color::ColorSpaceAPI		csAPI;
-	csAPI.setGammaInProperties	( _params._sGammaIn );
-	csAPI.setCineonInProperties	( _params._sCineonIn );
-	csAPI.setGammaOutProperties	( _params._sGammaOut );
-	csAPI.setCineonOutProperties	( _params._sCineonOut );
+	if( num_channels<View>::value < 3 || _kernel.isIdentity() )
+	{
+		copy_pixels( src, dst );
+		return;
+	}
+
+	if( IsIntegral::value && _kernel.isSeparable() )
+		applySeparableTables( src, dst );
+	else
+		applyKernel( src, dst );
+}
+
+template<class View>
+void ColorSpaceProcess<View>::applySeparableTables( const View& src, const View& dst )
+{
+	typedef typename View::x_iterator vIterator;
+	for( int y = 0; y < src.height(); ++y )
+	{
+		vIterator sit = src.row_begin( y );
+		vIterator dit = dst.row_begin( y );
+		for( int x = 0; x < src.width(); ++x, ++sit, ++dit )
+		{
+			for( int c = 0; c < 3; ++c )
+				( *dit )[c] = _separableTables[c][( *sit )[c]];
+			if( num_channels<View>::value > 3 )
+				( *dit )[3] = ( *sit )[3];
+		}
+		if( this->progressForward( src.width() ) )
+			return;
+	}
+}
+
+template<class View>
+void ColorSpaceProcess<View>::applyKernel( const View& src, const View& dst )
+{
+	typedef typename View::x_iterator vIterator;
+	const bool rgbInput = _kernel.hasRgbInput();
+	float colors[kBatchSize][3];
 
-	terry::colorspace_pixels_progress( &csAPI, _params._gradationIn, _params._layoutIn, _params._tempColorIn, _params._gradationOut, _params._layoutOut, _params._tempColorOut, src, dst, this );
-	*/
+	for( int y = 0; y < src.height(); ++y )
+	{
+		vIterator sit = src.row_begin( y );
+		vIterator dit = dst.row_begin( y );
+		for( int x = 0; x < src.width(); x += kBatchSize )
+		{
+			const std::size_t nbPixels = std::min<std::size_t>( kBatchSize, src.width() - x );
+			if( rgbInput )
+			{
+				// the input curve is applied to the channels of the source
+				for( std::size_t i = 0; i < nbPixels; ++i )
+					for( int c = 0; c < 3; ++c )
+						colors[i][c] = inputValue( sit[i][c], IsIntegral() );
+				for( std::size_t i = 0; i < nbPixels; ++i )
+					_kernel.applyLinearized( colors[i] );
+			}
+			else
+			{
+				// the input curve is applied after the conversion of the input layout to RGB
+				for( std::size_t i = 0; i < nbPixels; ++i )
+					for( int c = 0; c < 3; ++c )
+						colors[i][c] = channel_convert<bits32f>( sit[i][c] );
+				for( std::size_t i = 0; i < nbPixels; ++i )
+					_kernel.apply( colors[i] );
+			}
+			for( std::size_t i = 0; i < nbPixels; ++i )
+			{
+				for( int c = 0; c < 3; ++c )
+				{
+					float v = colors[i][c];
+					if( IsIntegral::value )
+						v = std::min( std::max( v, 0.0f ), 1.0f );
+					dit[i][c] = channel_convert<Channel>( bits32f( v ) );
+				}
+				if( num_channels<View>::value > 3 )
+					dit[i][3] = sit[i][3];
+			}
+			sit += nbPixels;
+			dit += nbPixels;
+		}
+		if( this->progressForward( src.width() ) )
+			return;
+	}
 }
 
 }
@@ -0,0 +1,229 @@
+#define BOOST_TEST_MODULE plugin_ColorSpace
+#include <tuttle/test/main.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <tuttle/host/Graph.hpp>
+#include <tuttle/host/attribute/Image.hpp>
+#include <tuttle/plugin/color/colorDefinitions.hpp>
+
+#include <terry/colorspace/gradation.hpp>
+#include <terry/colorspace/temperature.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace boost::unit_test;
+using namespace tuttle::host;
+namespace ttlc = tuttle::plugin::color;
+namespace tg = terry::color::gradation;
+namespace tt = terry::color::temperature;
+
+namespace {
+
+static const double kGamma = 2.2;
+static const double kBlackPoint = 95.0;
+static const double kWhitePoint = 685.0;
+static const double kGammaSensito = 0.6;
+
+/// RGBA float pixels of an image, from bottom to top
+std::vector<float> readPixels( attribute::Image& image )
+{
+	const OfxRectI bounds = image.getBounds();
+	const std::size_t rowSize = ( bounds.x2 - bounds.x1 ) * image.getNbComponents();
+	BOOST_REQUIRE_EQUAL( image.getNbComponents(), 4 );
+	BOOST_REQUIRE_EQUAL( image.getBitDepthMemorySize(), sizeof( float ) );
+
+	std::vector<float> pixels( rowSize * ( bounds.y2 - bounds.y1 ) );
+	const boost::uint8_t* row = image.getOrientedPixelData( attribute::Image::eImageOrientationFromBottomToTop );
+	const int distance = image.getOrientedRowDistanceBytes( attribute::Image::eImageOrientationFromBottomToTop );
+	for( int y = 0; y < bounds.y2 - bounds.y1; ++y, row += distance )
+		std::memcpy( &pixels[y * rowSize], row, rowSize * sizeof( float ) );
+	return pixels;
+}
+
+/// 32 bits float image varying in both directions
+Graph::Node& createSource( Graph& g )
+{
+	Graph::Node& source = g.createNode( "tuttle.colorwheel" );
+	source.getParam( "type" ).setValue( 2 ); // rainbow
+	source.getParam( "explicitConversion" ).setValue( 3 ); // 32f
+	source.getParam( "mode" ).setValue( 1 ); // size
+	source.getParam( "specificRatio" ).setValue( false );
+	source.getParam( "size" ).setValue( 40, 30 );
+	return source;
+}
+
+Graph::Node& createColorSpace( Graph& g,
+                               const ttlc::EParamLayout layoutIn, const ttlc::EParamGradationLaw gradationIn,
+                               const ttlc::EParamLayout layoutOut, const ttlc::EParamGradationLaw gradationOut,
+                               const ttlc::EColorTemperature temperatureIn = ttlc::eColorTemperatureD65,
+                               const ttlc::EColorTemperature temperatureOut = ttlc::eColorTemperatureD65 )
+{
+	Graph::Node& colorspace = g.createNode( "tuttle.colorspace" );
+	colorspace.getParam( "inLayout" ).setValue( static_cast<int>( layoutIn ) );
+	colorspace.getParam( "outLayout" ).setValue( static_cast<int>( layoutOut ) );
+	colorspace.getParam( "inGradationLaw" ).setValue( static_cast<int>( gradationIn ) );
+	colorspace.getParam( "outGradationLaw" ).setValue( static_cast<int>( gradationOut ) );
+	colorspace.getParam( "inColorTemperature" ).setValue( static_cast<int>( temperatureIn ) );
+	colorspace.getParam( "outColorTemperature" ).setValue( static_cast<int>( temperatureOut ) );
+	colorspace.getParam( "inGammaValue" ).setValue( kGamma );
+	colorspace.getParam( "outGammaValue" ).setValue( kGamma );
+	colorspace.getParam( "inBlackPoint" ).setValue( kBlackPoint );
+	colorspace.getParam( "outBlackPoint" ).setValue( kBlackPoint );
+	colorspace.getParam( "inWhitePoint" ).setValue( kWhitePoint );
+	colorspace.getParam( "outWhitePoint" ).setValue( kWhitePoint );
+	colorspace.getParam( "inGammaSensito" ).setValue( kGammaSensito );
+	colorspace.getParam( "outGammaSensito" ).setValue( kGammaSensito );
+	return colorspace;
+}
+
+/// pixels of the output of a node
+std::vector<float> computePixels( Graph& g, Graph::Node& node )
+{
+	memory::MemoryCache cache;
+	BOOST_REQUIRE( g.compute( cache, node ) );
+	memory::CACHE_ELEMENT image = cache.get( node.getName(), 0 );
+	BOOST_REQUIRE( image.get() != NULL );
+	return readPixels( *image );
+}
+
+/// @return the number of RGB values with a difference greater than tolerance (relative to the values above 1)
+int countDifferences( const std::vector<float>& a, const std::vector<float>& b, const double tolerance )
+{
+	BOOST_REQUIRE_EQUAL( a.size(), b.size() );
+	int differences = 0;
+	for( std::size_t i = 0; i < a.size(); ++i )
+	{
+		if( i % 4 == 3 )
+			continue; // alpha
+		if( a[i] != b[i] && ! ( std::abs( a[i] - b[i] ) <= tolerance * std::max( 1.0, std::abs( double( b[i] ) ) ) ) )
+			++differences;
+	}
+	return differences;
+}
+
+/**
+ * Compare the conversion of the source from a gradation law to linear
+ * and from linear to the law, with the terry conversions.
+ */
+template<class Law>
+void checkGradation( const ttlc::EParamGradationLaw gradation, const Law& law )
+{
+	Graph g;
+	Graph::Node& source = createSource( g );
+	Graph::Node& toLinear = createColorSpace( g, ttlc::eParamLayoutRGB, gradation, ttlc::eParamLayoutRGB, ttlc::eParamLinear );
+	Graph::Node& fromLinear = createColorSpace( g, ttlc::eParamLayoutRGB, ttlc::eParamLinear, ttlc::eParamLayoutRGB, gradation );
+	g.connect( source, toLinear );
+	g.connect( source, fromLinear );
+
+	const std::vector<float> sourcePixels = computePixels( g, source );
+	std::vector<float> expectedToLinear( sourcePixels );
+	std::vector<float> expectedFromLinear( sourcePixels );
+	const tg::Linear linear;
+	for( std::size_t i = 0; i < sourcePixels.size(); ++i )
+	{
+		if( i % 4 == 3 )
+			continue;
+		const double v = sourcePixels[i];
+		double toLinearValue, fromLinearValue;
+		terry::color::channel_color_gradation_t<double, Law, tg::Linear>( law, linear )( v, toLinearValue );
+		terry::color::channel_color_gradation_t<double, tg::Linear, Law>( linear, law )( v, fromLinearValue );
+		expectedToLinear[i] = static_cast<float>( toLinearValue );
+		expectedFromLinear[i] = static_cast<float>( fromLinearValue );
+	}
+	BOOST_CHECK_EQUAL( countDifferences( computePixels( g, toLinear ), expectedToLinear, 1e-4 ), 0 );
+	BOOST_CHECK_EQUAL( countDifferences( computePixels( g, fromLinear ), expectedFromLinear, 1e-4 ), 0 );
+}
+
+/**
+ * Compare the conversion of the source from linear RGB to a temperature,
+ * with the terry coefficients.
+ */
+template<class TemperatureIn, class TemperatureOut>
+void checkTemperature( const ttlc::EColorTemperature temperatureIn, const ttlc::EColorTemperature temperatureOut )
+{
+	Graph g;
+	Graph::Node& source = createSource( g );
+	Graph::Node& colorspace = createColorSpace( g, ttlc::eParamLayoutRGB, ttlc::eParamLinear, ttlc::eParamLayoutRGB, ttlc::eParamLinear,
+	                                            temperatureIn, temperatureOut );
+	g.connect( source, colorspace );
+
+	double coefficients[3];
+	terry::color::temperature_coefficients<TemperatureIn, TemperatureOut>( coefficients );
+	std::vector<float> expected = computePixels( g, source );
+	for( std::size_t i = 0; i < expected.size(); ++i )
+	{
+		if( i % 4 != 3 )
+			expected[i] = static_cast<float>( expected[i] * coefficients[i % 4] );
+	}
+	BOOST_CHECK_EQUAL( countDifferences( computePixels( g, colorspace ), expected, 1e-5 ), 0 );
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( plugin_ColorSpace )
+
+BOOST_AUTO_TEST_CASE( process_gradations )
+{
+	TUTTLE_LOG_INFO( "******** PROCESS GRADATIONS tuttle.colorspace ********" );
+	checkGradation( ttlc::eParamsRGB, tg::sRGB() );
+	checkGradation( ttlc::eParamCineon, tg::Cineon( kBlackPoint, kWhitePoint, kGammaSensito ) );
+	checkGradation( ttlc::eParamGamma, tg::Gamma( kGamma ) );
+	checkGradation( ttlc::eParamPanalog, tg::Panalog() );
+	checkGradation( ttlc::eParamREDLog, tg::REDLog() );
+	checkGradation( ttlc::eParamViperLog, tg::ViperLog() );
+	checkGradation( ttlc::eParamREDSpace, tg::REDSpace() );
+	checkGradation( ttlc::eParamAlexaLogC, tg::AlexaV3LogC() );
+}
+
+BOOST_AUTO_TEST_CASE( process_temperatures )
+{
+	TUTTLE_LOG_INFO( "******** PROCESS TEMPERATURES tuttle.colorspace ********" );
+	checkTemperature<tt::T_D65, tt::T_A>( ttlc::eColorTemperatureD65, ttlc::eColorTemperatureA );
+	checkTemperature<tt::T_D65, tt::T_F11>( ttlc::eColorTemperatureD65, ttlc::eColorTemperatureF11 );
+	checkTemperature<tt::T_F11, tt::T_D65>( ttlc::eColorTemperatureF11, ttlc::eColorTemperatureD65 );
+	checkTemperature<tt::T_F11, tt::T_DCIP3>( ttlc::eColorTemperatureF11, ttlc::eColorTemperatureDCIP3 );
+}
+
+/**
+ * For each layout and gradation law:
+ * - the gradation law applies to the RGB values, whatever the layout:
+ *   converting a layout with a gradation law to linear RGB is the same as
+ *   converting it to RGB, then the gradation law to linear,
+ * - RGB with the gradation law to the linear layout and back is the identity.
+ */
+BOOST_AUTO_TEST_CASE( process_layouts_round_trip )
+{
+	TUTTLE_LOG_INFO( "******** PROCESS LAYOUTS ROUND TRIP tuttle.colorspace ********" );
+	for( int layout = ttlc::eParamLayoutRGB; layout <= ttlc::eParamLayoutYxy; ++layout )
+	{
+		for( int gradation = ttlc::eParamLinear; gradation <= ttlc::eParamAlexaLogC; ++gradation )
+		{
+			TUTTLE_LOG_INFO( "layout " << layout << ", gradation law " << gradation );
+			const ttlc::EParamLayout l = static_cast<ttlc::EParamLayout>( layout );
+			const ttlc::EParamGradationLaw law = static_cast<ttlc::EParamGradationLaw>( gradation );
+			Graph g;
+			Graph::Node& source = createSource( g );
+
+			Graph::Node& toLayout = createColorSpace( g, ttlc::eParamLayoutRGB, ttlc::eParamLinear, l, ttlc::eParamLinear );
+			Graph::Node& layoutToLinear = createColorSpace( g, l, law, ttlc::eParamLayoutRGB, ttlc::eParamLinear );
+			Graph::Node& rgbToLinear = createColorSpace( g, ttlc::eParamLayoutRGB, law, ttlc::eParamLayoutRGB, ttlc::eParamLinear );
+			g.connect( source, toLayout );
+			g.connect( toLayout, layoutToLinear );
+			g.connect( source, rgbToLinear );
+			BOOST_CHECK_EQUAL( countDifferences( computePixels( g, layoutToLinear ), computePixels( g, rgbToLinear ), 1e-3 ), 0 );
+
+			Graph::Node& forward = createColorSpace( g, ttlc::eParamLayoutRGB, law, l, ttlc::eParamLinear );
+			Graph::Node& backward = createColorSpace( g, l, ttlc::eParamLinear, ttlc::eParamLayoutRGB, law );
+			g.connect( source, forward );
+			g.connect( forward, backward );
+			BOOST_CHECK_EQUAL( countDifferences( computePixels( g, backward ), computePixels( g, source ), 1e-3 ), 0 );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -31,6 +31,7 @@ void GammaPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
 
 	// plugin flags
 	desc.setSupportsTiles( kSupportTiles );
+	desc.setIsPointOperation( true );
 	desc.setRenderThreadSafety( OFX::eRenderFullySafe );
 }
 
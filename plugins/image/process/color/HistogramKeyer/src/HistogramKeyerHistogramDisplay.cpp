@@ -20,7 +20,7 @@ void displayASpecificHistogram(const HistogramVector& v,const HistogramVector& s
 	if(v.size())
 	{
 		//maximum data in the current channel vector
-		const Number max_value = *(std::max_element(v.begin(),v.end()));
+		const HistogramVector::value_type max_value = *(std::max_element(v.begin(),v.end()));
 		const float ratio = height/max_value;
 		//OpenGL 2.X
 		glEnable(GL_BLEND);
@@ -59,7 +59,7 @@ void displayASpecificHistogramBorder(const HistogramVector& v, const double step
 	//Draw the border line
 	glBegin( GL_LINE_STRIP );
 	//maximum data in the current channel vector
-	const Number max_value = *(std::max_element(v.begin(),v.end()));
+	const HistogramVector::value_type max_value = *(std::max_element(v.begin(),v.end()));
 	const float ratio = height/max_value;
 	double base_step = 0.0;
 	glColor3f(color._colorBorder.r, color._colorBorder.g, color._colorBorder.b);
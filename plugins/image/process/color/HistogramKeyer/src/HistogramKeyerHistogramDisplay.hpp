@@ -2,7 +2,7 @@
 #define	HISTOGRAMKEYERHISTOGRAMDISPLAY_HPP
 
 #include "HistogramKeyerDefinitions.hpp"
-#include "OverlayData.hpp"
+#include <tuttle/plugin/HistogramOverlayData.hpp>
 
 namespace tuttle {
 namespace plugin {
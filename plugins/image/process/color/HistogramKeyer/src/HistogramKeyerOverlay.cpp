@@ -73,6 +73,11 @@ bool HistogramKeyerOverlay::draw( const OFX::DrawArgs& args )
 			drawWarning(warningPoint, ratio);			//draw warning sign
 		}
 	}
+	else if( getOverlayData().isSelectionModified() && ! _plugin->_isRendering )
+	{
+		// only the pixels selected or unselected since the last draw
+		getOverlayData().computeSelectionData( _plugin->_clipSrc, args.time, args.renderScale );
+	}
 	
 	// Draw component
 	bool displaySomething = false;
@@ -140,9 +145,9 @@ bool HistogramKeyerOverlay::penMotion( const OFX::PenArgs& args )
 		x -= pixelRegionOfDefinition.x1; //repere change (reformat)
 		
 		if( _plugin->_paramSelectionMode->getValue() == 2 )	//selection mode is subtractive mode
-			getOverlayData()._imgBool[y][x] = 0;	//current pixel is no more marked as selected
+			getOverlayData().setSelected( x, y, false );	//current pixel is no more marked as selected
 		else
-			getOverlayData()._imgBool[y][x] = 255;	//current pixel is marked as selected
+			getOverlayData().setSelected( x, y, true );	//current pixel is marked as selected
 		return true;	//event captured
 	}
 	return false; //event is not captured
@@ -270,25 +275,18 @@ bool HistogramKeyerOverlay::penUp( const OFX::PenArgs& args )
 		BOOST_ASSERT( getOverlayData()._imgBool.shape()[0] >= std::size_t(endY + step_y) );
 		BOOST_ASSERT( getOverlayData()._imgBool.shape()[1] >= std::size_t(endX + step_x) );
 		
-		unsigned char fillValue;
+		OfxRectI selection;
+		selection.x1 = endX - pixelRegionOfDefinition.x1; // x in img bool size (reformat)
+		selection.y1 = endY - pixelRegionOfDefinition.y1; // y in img bool size (reformat)
+		selection.x2 = selection.x1 + step_x;
+		selection.y2 = selection.y1 + step_y;
+		
 		if( _plugin->_paramSelectionMode->getValue() == 2 )	//selection mode is subtractive
-			fillValue = 0; //remove all of the selected pixel
+			getOverlayData().setSelected( selection, false ); //remove all of the selected pixel
 		else
-			fillValue = 255; //mark all of the selected pixel
+			getOverlayData().setSelected( selection, true ); //mark all of the selected pixel
 		
-		for( int val_y = 0; val_y < step_y; ++val_y )
-		{
-			for( int val_x = 0; val_x < step_x; ++val_x )
-			{
-				const int y = endY + val_y - pixelRegionOfDefinition.y1; // y in img bool size (reformat)
-				const int x = endX + val_x - pixelRegionOfDefinition.x1; // x in img bool size (reformat)
-				
-				getOverlayData()._imgBool[y][x] = fillValue;
-			}
-		}
-		// recompute full data
-		//getOverlayData().computeFullData(_plugin->_clipSrc,args.time,args.renderScale);
-		getOverlayData()._isDataInvalid = true;
+		// selection data is updated with the modified pixels at the next draw
 		_plugin->redrawOverlays();
 	}
 	_penDown = false; // treatment is finished
@@ -324,8 +322,7 @@ bool HistogramKeyerOverlay::keyUp( const OFX::KeyArgs& args )
 		_keyDown = false; // treatment ends
 		_penDown = false; // pen down
 		
-//		getOverlayData().computeFullData( _plugin->_clipSrc, args.time, args.renderScale );
-		getOverlayData()._isDataInvalid = true;
+		// selection data is updated with the painted pixels at the next draw
 		_plugin->redrawOverlays();
 		
 		return true; // event captured
@@ -425,7 +422,7 @@ void HistogramKeyerOverlay::drawWarning(const Ofx3DPointD& centerPoint, const do
  * Get overlay data from plugin
  * @return 
  */
-OverlayData& HistogramKeyerOverlay::getOverlayData()
+HistogramOverlayData& HistogramKeyerOverlay::getOverlayData()
 {
 	return _plugin->getOverlayData();
 }
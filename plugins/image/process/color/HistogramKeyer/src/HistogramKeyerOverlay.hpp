@@ -60,7 +60,7 @@ public:
 	void displaySelectionZone();	//display the current selection zone (white square)
 	
 	/*Get overlay data*/
-	OverlayData& getOverlayData();
+	HistogramOverlayData& getOverlayData();
 private:
 	void drawWarning(const Ofx3DPointD& centerPoint, const double ratio);		//draw a warning signal
 };
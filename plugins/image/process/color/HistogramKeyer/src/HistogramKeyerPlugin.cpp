@@ -732,6 +732,7 @@ void HistogramKeyerPlugin::changedClip( const OFX::InstanceChangedArgs& args, co
 	{
 		if( this->hasOverlayData( ) )
 		{
+			this->getOverlayData().clearCache();
 			this->getOverlayData()._isDataInvalid = true;
 			this->redrawOverlays();
 		}
@@ -778,7 +779,7 @@ void HistogramKeyerPlugin::addRefOverlayData( )
 	if( _overlayDataCount == 0 )
 	{
 		const OfxPointI imgSize = this->_clipSrc->getPixelRodSize( 0 ); ///@todo set the correct time !
-		_overlayData.reset( new OverlayData( imgSize, this->_paramNbStepSelection->getValue( ),this->_paramSelectionFromCurve->getValue()) );
+		_overlayData.reset( new HistogramOverlayData( imgSize, this->_paramNbStepSelection->getValue( ),this->_paramSelectionFromCurve->getValue()) );
 	}
 	++_overlayDataCount;
 }
@@ -797,12 +798,12 @@ bool HistogramKeyerPlugin::hasOverlayData( ) const
 	return _overlayDataCount != 0;
 }
 
-OverlayData& HistogramKeyerPlugin::getOverlayData( )
+HistogramOverlayData& HistogramKeyerPlugin::getOverlayData( )
 {
 	return *_overlayData.get( );
 }
 
-const OverlayData& HistogramKeyerPlugin::getOverlayData( ) const
+const HistogramOverlayData& HistogramKeyerPlugin::getOverlayData( ) const
 {
 	return *_overlayData.get( );
 }
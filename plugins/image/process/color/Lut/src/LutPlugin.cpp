@@ -18,6 +18,16 @@ LutPlugin::LutPlugin( OfxImageEffectHandle handle )
 	: ImageEffectGilPlugin( handle )
 {
 	_sFilename = fetchStringParam( kTuttlePluginFilename );
+	_paramInterpolation = fetchChoiceParam( kParamInterpolation );
+}
+
+void LutPlugin::resetLut()
+{
+	if( ! _lut3D.reset( _lutReader ) )
+	{
+		BOOST_THROW_EXCEPTION( exception::File()
+			<< exception::user( "Lut: the number of values doesn't match the lattice size." ) );
+	}
 }
 
 /**
@@ -40,7 +50,7 @@ void LutPlugin::render( const OFX::RenderArguments& args )
 			BOOST_THROW_EXCEPTION( exception::File()
 				<< exception::user( "Unable to read lut file." ) );
 		}
-		_lut3D.reset( new TetraInterpolator(), _lutReader );
+		resetLut();
 	}
 	if( !_lutReader.readOk() )
 	{
@@ -61,7 +71,7 @@ void LutPlugin::changedParam( const OFX::InstanceChangedArgs& args, const std::s
 			{
 				BOOST_THROW_EXCEPTION( exception::File() << exception::user( "Unable to read lut file..." ) );
 			}
-			_lut3D.reset( new TetraInterpolator(), _lutReader );
+			resetLut();
 		}
 	}
 }
@@ -1,8 +1,9 @@
 #ifndef _TUTTLE_PLUGIN_LUTPLUGIN_HPP_
 #define _TUTTLE_PLUGIN_LUTPLUGIN_HPP_
 
+#include "LutDefinitions.hpp"
 #include "lutEngine/LutReader.hpp"
-#include "lutEngine/Lut.hpp"
+#include "lutEngine/FlatLut3D.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
@@ -23,11 +24,15 @@ public:
 	void render( const OFX::RenderArguments& args );
 	void changedParam( const OFX::InstanceChangedArgs& args, const std::string& paramName );
 
+private:
+	void resetLut();
+
 public:
 	OFX::StringParam* _sFilename;    ///< Filename
+	OFX::ChoiceParam* _paramInterpolation;
 
 	LutReader _lutReader;               ///< Reader
-	Lut3D _lut3D;
+	FlatLut3D _lut3D;
 };
 
 }
@@ -32,6 +32,7 @@ void LutPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
 	desc.addSupportedBitDepth( OFX::eBitDepthFloat );
 
 	desc.setSupportsTiles( kSupportTiles );
+	desc.setIsPointOperation( true );
 	//desc.setRenderThreadSafety( OFX::eRenderFullySafe ); //< @todo tuttle: remove process data from LutPlugin
 }
 
@@ -59,6 +60,12 @@ void LutPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc, OFX:
 	filename->setDefault( "" );
 	filename->setLabels( kTuttlePluginFilenameLabel, kTuttlePluginFilenameLabel, kTuttlePluginFilenameLabel );
 	filename->setStringType( OFX::eStringTypeFilePath );
+
+	OFX::ChoiceParamDescriptor* interpolation = desc.defineChoiceParam( kParamInterpolation );
+	interpolation->setLabel( "Interpolation" );
+	interpolation->appendOption( kParamInterpolationTetrahedral );
+	interpolation->appendOption( kParamInterpolationTrilinear );
+	interpolation->setDefault( eParamInterpolationTetrahedral );
 }
 
 /**
@@ -2,8 +2,7 @@
 #define _TUTTLE_PLUGIN_LUTPROCESS_HPP_
 
 #include "LutPlugin.hpp"
-#include "lutEngine/LutReader.hpp"
-#include "lutEngine/Lut.hpp"
+#include "lutEngine/FlatLut3D.hpp"
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
@@ -13,6 +12,10 @@
 #include <ofxsMultiThread.h>
 
 #include <boost/gil/gil_all.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <vector>
 
 namespace tuttle {
 namespace plugin {
@@ -24,17 +27,38 @@ namespace lut {
 template<class View>
 class LutProcess : public ImageGilFilterProcessor<View>
 {
+public:
+	typedef typename boost::gil::channel_type<View>::type Channel;
+	typedef typename boost::mpl::bool_<boost::is_integral<Channel>::value> IsIntegral;
+
+	/// number of pixels processed at once: lattice coordinates, then interpolations, then outputs
+	static const std::size_t kBatchSize = 64;
+
 private:
-	Lut3D* _lut3D;               ///< Lut3D
+	const FlatLut3D& _lut3D;     ///< Lut3D
 	LutPlugin&  _plugin;        ///< Rendering plugin
+	EParamInterpolation _interpolation;
+	std::vector<FlatLut3D::Coord> _directLookup; ///< lattice coordinates of all the channel values (8 and 16 bits)
 
 public:
 	LutProcess<View>( LutPlugin & instance );
 
+	void setup( const OFX::RenderArguments& args );
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
 
 	// Lut3D Transform
-	void applyLut( View& dst, View& src, const OfxRectI& procWindow );
+	template<class Interpolation>
+	void applyLut( const View& dst, const View& src, const OfxRectI& procWindow );
+
+private:
+	inline FlatLut3D::Coord latticeCoord( const Channel v, const boost::mpl::true_ /*integral*/ ) const
+	{
+		return _directLookup[v];
+	}
+	inline FlatLut3D::Coord latticeCoord( const Channel v, const boost::mpl::false_ /*integral*/ ) const
+	{
+		return _lut3D.coord( v );
+	}
 };
 
 }
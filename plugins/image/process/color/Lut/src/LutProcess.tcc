@@ -4,9 +4,7 @@
 
 #include "LutProcess.hpp"
 #include "LutDefinitions.hpp"
-#include "lutEngine/LutReader.hpp"
-#include "lutEngine/Lut.hpp"
-#include "lutEngine/TetraInterpolator.hpp"
+#include "lutEngine/FlatLut3D.hpp"
 
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
@@ -17,20 +15,30 @@
 #include <ofxsMultiThread.h>
 
 #include <boost/gil/gil_all.hpp>
-#include <boost/filesystem/fstream.hpp>
+
+#include <algorithm>
 
 namespace tuttle {
 namespace plugin {
 namespace lut {
 
-using namespace boost::filesystem;
-
 template<class View>
 LutProcess<View>::LutProcess( LutPlugin& instance )
 	: ImageGilFilterProcessor<View>( instance, eImageOrientationIndependant )
+	, _lut3D( instance._lut3D )
 	, _plugin( instance )
+	, _interpolation( eParamInterpolationTetrahedral )
+{}
+
+template<class View>
+void LutProcess<View>::setup( const OFX::RenderArguments& args )
 {
-	_lut3D = &_plugin._lut3D;
+	ImageGilFilterProcessor<View>::setup( args );
+	_interpolation = static_cast<EParamInterpolation>( _plugin._paramInterpolation->getValue() );
+
+	// 8 and 16 bits: one lookup per channel instead of the pre-shaper computation
+	if( IsIntegral::value )
+		_lut3D.buildDirectLookup( boost::gil::channel_traits<Channel>::max_value(), _directLookup );
 }
 
 /**
@@ -42,33 +50,61 @@ void LutProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW )
 {
 	OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
 
-	applyLut( this->_dstView, this->_srcView, procWindowOutput );
+	if( boost::gil::num_channels<View>::value < 3 )
+	{
+		const OfxPointI procWindowSize = {
+			procWindowOutput.x2 - procWindowOutput.x1,
+			procWindowOutput.y2 - procWindowOutput.y1 };
+		copy_pixels( subimage_view( this->_srcView, procWindowOutput.x1, procWindowOutput.y1, procWindowSize.x, procWindowSize.y ),
+		             subimage_view( this->_dstView, procWindowOutput.x1, procWindowOutput.y1, procWindowSize.x, procWindowSize.y ) );
+		return;
+	}
+
+	switch( _interpolation )
+	{
+		case eParamInterpolationTetrahedral:
+			applyLut<FlatTetraInterpolation>( this->_dstView, this->_srcView, procWindowOutput );
+			break;
+		case eParamInterpolationTrilinear:
+			applyLut<FlatTrilinInterpolation>( this->_dstView, this->_srcView, procWindowOutput );
+			break;
+	}
 }
 
 template<class View>
-void LutProcess<View>::applyLut( View& dst, View& src, const OfxRectI& procWindow )
+template<class Interpolation>
+void LutProcess<View>::applyLut( const View& dst, const View& src, const OfxRectI& procWindow )
 {
 	using namespace terry;
 	typedef typename View::x_iterator vIterator;
-	typedef typename channel_type<View>::type Pixel;
 	const OfxPointI procWindowSize = {
 		procWindow.x2 - procWindow.x1,
 		procWindow.y2 - procWindow.y1 };
 
+	FlatLut3D::Coord coords[3][kBatchSize];
+	float colors[kBatchSize][3];
+
 	for( int y = procWindow.y1; y < procWindow.y2; ++y )
 	{
-		vIterator sit = src.row_begin( y );
-		vIterator dit = dst.row_begin( y );
-		for( int x = procWindow.x1; x < procWindow.x2; ++x )
+		vIterator sit = src.x_at( procWindow.x1, y );
+		vIterator dit = dst.x_at( procWindow.x1, y );
+		for( int x = 0; x < procWindowSize.x; x += kBatchSize )
 		{
-			tuttle::Color col = _lut3D->getColor( ( *sit )[0], ( *sit )[1], ( *sit )[2] );
-			( *dit )[0] = static_cast<Pixel>( col.x );
-			( *dit )[1] = static_cast<Pixel>( col.y );
-			( *dit )[2] = static_cast<Pixel>( col.z );
-			if( dst.num_channels() > 3 )
-				( *dit )[3] = channel_traits< typename channel_type< View >::type >::max_value();
-			++sit;
-			++dit;
+			const std::size_t nbPixels = std::min<std::size_t>( kBatchSize, procWindowSize.x - x );
+			for( int c = 0; c < 3; ++c )
+				for( std::size_t i = 0; i < nbPixels; ++i )
+					coords[c][i] = latticeCoord( sit[i][c], IsIntegral() );
+			for( std::size_t i = 0; i < nbPixels; ++i )
+				Interpolation::interpolate( _lut3D, coords[0][i], coords[1][i], coords[2][i], colors[i] );
+			for( std::size_t i = 0; i < nbPixels; ++i )
+			{
+				for( int c = 0; c < 3; ++c )
+					dit[i][c] = channel_convert<Channel>( bits32f( colors[i][c] ) );
+				if( num_channels<View>::value > 3 )
+					dit[i][3] = channel_traits<Channel>::max_value();
+			}
+			sit += nbPixels;
+			dit += nbPixels;
 		}
 		if( this->progressForward( procWindowSize.x ) )
 			return;
@@ -0,0 +1,177 @@
+#ifndef _LUTENGINE_FLATLUT3D_HPP_
+#define _LUTENGINE_FLATLUT3D_HPP_
+
+#include "LutReader.hpp"
+
+#include <terry/color/lut3d.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace tuttle {
+
+/**
+ * @brief 3D lut stored as a flat float lattice, with inlined interpolations.
+ *
+ * Input values are first mapped to lattice coordinates by a 1D pre-shaper,
+ * built from the input steps of the lut file (which may be non uniform).
+ * For 8 and 16 bits images, the lattice coordinates of all the possible
+ * channel values are precomputed (see buildDirectLookup).
+ */
+class FlatLut3D
+{
+public:
+	/// position on one axis of the lattice: cell index and position inside the cell
+	struct Coord
+	{
+		boost::uint32_t index;
+		float fraction;
+	};
+
+	static const std::size_t kShaperSize = 4096;
+
+public:
+	FlatLut3D() : _dimSize( 0 ), _uniform( true ) {}
+
+	/**
+	 * @brief Copy the lut values and build the pre-shaper.
+	 * @return false if the data doesn't contain steps.size()^3 colors
+	 */
+	bool reset( LutReader& reader )
+	{
+		const LutReader::VectorDouble& steps = reader.steps();
+		const LutReader::VectorDouble& data  = reader.data();
+		const std::size_t dimSize = steps.size();
+		if( dimSize < 2 || data.size() != dimSize * dimSize * dimSize * 3 || steps.back() <= steps.front() )
+		{
+			_dimSize = 0;
+			return false;
+		}
+		_dimSize = dimSize;
+		_lattice.assign( data.begin(), data.end() );
+
+		// steps are normalized by the last one
+		std::vector<double> nodes( dimSize );
+		_uniform = true;
+		for( std::size_t i = 0; i < dimSize; ++i )
+		{
+			nodes[i] = steps[i] / steps.back();
+			const double uniformNode = double( i ) / ( dimSize - 1 );
+			if( std::abs( nodes[i] - uniformNode ) > 1e-6 )
+				_uniform = false;
+		}
+		_shaper.clear();
+		if( ! _uniform )
+		{
+			// sampled piecewise linear mapping from the input value to the lattice coordinate
+			_shaper.resize( kShaperSize + 1 );
+			std::size_t node = 0;
+			for( std::size_t i = 0; i <= kShaperSize; ++i )
+			{
+				const double v = double( i ) / kShaperSize;
+				while( node + 2 < dimSize && nodes[node + 1] <= v )
+					++node;
+				const double width = nodes[node + 1] - nodes[node];
+				const double t     = width > 0 ? ( v - nodes[node] ) / width : 0.0;
+				_shaper[i] = static_cast<float>( node + std::min( std::max( t, 0.0 ), 1.0 ) );
+			}
+		}
+		return true;
+	}
+
+	bool empty() const { return _dimSize == 0; }
+	std::size_t dimSize() const { return _dimSize; }
+	const float* lattice() const { return &_lattice.front(); }
+
+	/// lattice coordinate of a normalized input value (clamped to the lattice)
+	inline Coord coord( const float value ) const
+	{
+		const float v = std::min( std::max( value, 0.0f ), 1.0f );
+		float c;
+		if( _uniform )
+		{
+			c = v * ( _dimSize - 1 );
+		}
+		else
+		{
+			const float s = v * kShaperSize;
+			const std::size_t i = std::min( static_cast<std::size_t>( s ), kShaperSize - 1 );
+			c = _shaper[i] + ( s - i ) * ( _shaper[i + 1] - _shaper[i] );
+		}
+		Coord coord;
+		coord.index    = std::min( static_cast<boost::uint32_t>( c ), static_cast<boost::uint32_t>( _dimSize - 2 ) );
+		coord.fraction = c - coord.index;
+		return coord;
+	}
+
+	/// lattice coordinates of all the values of an integer channel (value / maxValue)
+	void buildDirectLookup( const std::size_t maxValue, std::vector<Coord>& table ) const
+	{
+		table.resize( maxValue + 1 );
+		for( std::size_t i = 0; i <= maxValue; ++i )
+			table[i] = coord( float( i ) / maxValue );
+	}
+
+	/// lattice offset of a node
+	inline std::size_t offset( const Coord& r, const Coord& g, const Coord& b ) const
+	{
+		return ( ( r.index * _dimSize + g.index ) * _dimSize + b.index ) * 3;
+	}
+
+private:
+	std::size_t _dimSize;
+	std::vector<float> _lattice; ///< rgb values, red is the slowest axis and blue the fastest
+	std::vector<float> _shaper;  ///< kShaperSize+1 lattice coordinates, empty if the steps are uniform
+	bool _uniform;
+};
+
+/**
+ * @brief Tetrahedral interpolation in a cell of a FlatLut3D.
+ */
+struct FlatTetraInterpolation
+{
+	static inline void interpolate( const FlatLut3D& lut, const FlatLut3D::Coord& r, const FlatLut3D::Coord& g, const FlatLut3D::Coord& b, float* out )
+	{
+		const std::size_t sb = 3;
+		const std::size_t sg = lut.dimSize() * sb;
+		const std::size_t sr = lut.dimSize() * sg;
+		terry::color::tetrahedral_interpolation<3>( lut.lattice() + lut.offset( r, g, b ), sr, sg, sb,
+		                                             r.fraction, g.fraction, b.fraction, out );
+	}
+};
+
+/**
+ * @brief Trilinear interpolation in a cell of a FlatLut3D.
+ */
+struct FlatTrilinInterpolation
+{
+	static inline void interpolate( const FlatLut3D& lut, const FlatLut3D::Coord& r, const FlatLut3D::Coord& g, const FlatLut3D::Coord& b, float* out )
+	{
+		const std::size_t sb = 3;
+		const std::size_t sg = lut.dimSize() * sb;
+		const std::size_t sr = lut.dimSize() * sg;
+		const float* p = lut.lattice() + lut.offset( r, g, b );
+		const float fr = r.fraction;
+		const float fg = g.fraction;
+		const float fb = b.fraction;
+
+		for( int c = 0; c < 3; ++c )
+		{
+			const float c00 = p[c]                + fb * ( p[c + sb]           - p[c] );
+			const float c01 = p[c + sg]           + fb * ( p[c + sg + sb]      - p[c + sg] );
+			const float c10 = p[c + sr]           + fb * ( p[c + sr + sb]      - p[c + sr] );
+			const float c11 = p[c + sr + sg]      + fb * ( p[c + sr + sg + sb] - p[c + sr + sg] );
+			const float c0  = c00 + fg * ( c01 - c00 );
+			const float c1  = c10 + fg * ( c11 - c10 );
+			out[c] = c0 + fr * ( c1 - c0 );
+		}
+	}
+};
+
+}
+
+#endif
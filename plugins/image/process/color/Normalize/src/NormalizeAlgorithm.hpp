@@ -7,7 +7,8 @@
 #include <terry/numeric/operations.hpp>
 #include <terry/numeric/assign.hpp>
 #include <terry/numeric/minmax.hpp>
-#include <terry/algorithm/transform_pixels_progress.hpp>
+
+#include <tuttle/plugin/ParallelReduction.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -23,10 +24,7 @@ void analyseChannel( View& src, typename View::value_type& min, typename View::v
 	typedef channel_view_type<LocalChannel,View> LocalView;
 	typename LocalView::type localView( LocalView::make(src) );
 	pixel_minmax_by_channel_t<typename LocalView::type::value_type> minmax( localView(0,0) );
-	transform_pixels_progress(
-		localView,
-		minmax,
-		p );
+	reducePixelsParallel( localView, minmax, p );
 	static_fill( min, minmax.min[0] );
 	static_fill( max, minmax.max[0] );
 }
@@ -39,9 +37,10 @@ void analyseChannel( View& src, typename View::value_type& min, typename View::v
  * @param[in] analyseMode: choose the analyse method
  * @param[out] min: output min values
  * @param[out] max: output max values
+ * @return false if the analysis was aborted
  */
 template<class View>
-void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, typename View::value_type& min, typename View::value_type& max, IProgress& p )
+bool analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, typename View::value_type& min, typename View::value_type& max, IProgress& p )
 {
 	using namespace terry;
 	using namespace terry::numeric;
@@ -55,10 +54,8 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 		{
 			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
 			// compute the maximum value
-			transform_pixels_progress(
-				src,
-				minmax,
-				p );
+			if( ! reducePixelsParallel( src, minmax, p ) )
+				return false;
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -69,10 +66,8 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 			typedef typename color_converted_view_type<View, PixelGray>::type LocalView;
 			LocalView localView(src);
 			pixel_minmax_by_channel_t<typename LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-				localView,
-				minmax,
-				p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -82,10 +77,8 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 			typedef channel_view_type<red_t, View> LocalView;
 			typename LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t< typename LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -95,10 +88,8 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 			typedef channel_view_type<green_t,View> LocalView;
 			typename LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t< typename LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -108,10 +99,8 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 			typedef channel_view_type<blue_t,View> LocalView;
 			typename LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t< typename LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -121,19 +110,18 @@ void analyseInputMinMax( const View& src, const EParamAnalyseMode analyseMode, t
 			typedef channel_view_type<alpha_t,View> LocalView;
 			typename LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t< typename LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
 		}
 	}
+	return true;
 }
 
 template<>
-void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnalyseMode analyseMode, boost::gil::rgb32f_view_t::value_type& min, boost::gil::rgb32f_view_t::value_type& max, IProgress& p )
+bool analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnalyseMode analyseMode, boost::gil::rgb32f_view_t::value_type& min, boost::gil::rgb32f_view_t::value_type& max, IProgress& p )
 {
 	using namespace terry;
 	using namespace terry::numeric;
@@ -147,10 +135,8 @@ void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnaly
 		{
 			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
 			// compute the maximum value
-			transform_pixels_progress(
-				src,
-				minmax,
-				p );
+			if( ! reducePixelsParallel( src, minmax, p ) )
+				return false;
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -161,10 +147,8 @@ void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnaly
 			typedef color_converted_view_type<rgb32f_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
 			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-				localView,
-				minmax,
-				p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -174,10 +158,8 @@ void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnaly
 			typedef channel_view_type<red_t,rgb32f_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -187,10 +169,8 @@ void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnaly
 			typedef channel_view_type<green_t,rgb32f_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -200,10 +180,8 @@ void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnaly
 			typedef channel_view_type<blue_t,rgb32f_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -215,10 +193,11 @@ void analyseInputMinMax( const boost::gil::rgb32f_view_t& src, const EParamAnaly
 			break;
 		}
 	}
+	return true;
 }
 
 template<>
-void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalyseMode analyseMode, boost::gil::rgb16_view_t::value_type& min, boost::gil::rgb16_view_t::value_type& max, IProgress& p )
+bool analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalyseMode analyseMode, boost::gil::rgb16_view_t::value_type& min, boost::gil::rgb16_view_t::value_type& max, IProgress& p )
 {
 	using namespace terry;
 	using namespace terry::numeric;
@@ -232,10 +211,8 @@ void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalys
 		{
 			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
 			// compute the maximum value
-			transform_pixels_progress(
-				src,
-				minmax,
-				p );
+			if( ! reducePixelsParallel( src, minmax, p ) )
+				return false;
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -246,10 +223,8 @@ void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalys
 			typedef color_converted_view_type<rgb16_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
 			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-				localView,
-				minmax,
-				p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -259,10 +234,8 @@ void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalys
 			typedef channel_view_type<red_t,rgb16_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -272,10 +245,8 @@ void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalys
 			typedef channel_view_type<green_t,rgb16_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -285,10 +256,8 @@ void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalys
 			typedef channel_view_type<blue_t,rgb16_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -300,10 +269,11 @@ void analyseInputMinMax( const boost::gil::rgb16_view_t& src, const EParamAnalys
 			break;
 		}
 	}
+	return true;
 }
 
 template<>
-void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyseMode analyseMode, boost::gil::rgb8_view_t::value_type& min, boost::gil::rgb8_view_t::value_type& max, IProgress& p )
+bool analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyseMode analyseMode, boost::gil::rgb8_view_t::value_type& min, boost::gil::rgb8_view_t::value_type& max, IProgress& p )
 {
 	using namespace terry;
 	using namespace terry::numeric;
@@ -317,10 +287,8 @@ void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyse
 		{
 			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
 			// compute the maximum value
-			transform_pixels_progress(
-				src,
-				minmax,
-				p );
+			if( ! reducePixelsParallel( src, minmax, p ) )
+				return false;
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -331,10 +299,8 @@ void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyse
 			typedef color_converted_view_type<rgb8_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
 			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-				localView,
-				minmax,
-				p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -344,10 +310,8 @@ void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyse
 			typedef channel_view_type<red_t,rgb8_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -357,10 +321,8 @@ void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyse
 			typedef channel_view_type<green_t,rgb8_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -370,10 +332,8 @@ void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyse
 			typedef channel_view_type<blue_t,rgb8_view_t> LocalView;
 			LocalView::type localView( LocalView::make(src) );
 			pixel_minmax_by_channel_t<LocalView::type::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-					localView,
-					minmax,
-					p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -385,10 +345,11 @@ void analyseInputMinMax( const boost::gil::rgb8_view_t& src, const EParamAnalyse
 			break;
 		}
 	}
+	return true;
 }
 
 template<>
-void analyseInputMinMax( const boost::gil::gray32f_view_t& src, const EParamAnalyseMode analyseMode, boost::gil::gray32f_view_t::value_type& min, boost::gil::gray32f_view_t::value_type& max, IProgress& p )
+bool analyseInputMinMax( const boost::gil::gray32f_view_t& src, const EParamAnalyseMode analyseMode, boost::gil::gray32f_view_t::value_type& min, boost::gil::gray32f_view_t::value_type& max, IProgress& p )
 {
 	using namespace terry;
 	using namespace terry::numeric;
@@ -402,10 +363,8 @@ void analyseInputMinMax( const boost::gil::gray32f_view_t& src, const EParamAnal
 		{
 			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
 			// compute the maximum value
-			transform_pixels_progress(
-				src,
-				minmax,
-				p );
+			if( ! reducePixelsParallel( src, minmax, p ) )
+				return false;
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -416,10 +375,8 @@ void analyseInputMinMax( const boost::gil::gray32f_view_t& src, const EParamAnal
 			typedef color_converted_view_type<gray32f_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
 			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-				localView,
-				minmax,
-				p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -434,10 +391,11 @@ void analyseInputMinMax( const boost::gil::gray32f_view_t& src, const EParamAnal
 			break;
 		}
 	}
+	return true;
 }
 
 template<>
-void analyseInputMinMax( const boost::gil::gray16_view_t& src, const EParamAnalyseMode analyseMode, boost::gil::gray16_view_t::value_type& min, boost::gil::gray16_view_t::value_type& max, IProgress& p )
+bool analyseInputMinMax( const boost::gil::gray16_view_t& src, const EParamAnalyseMode analyseMode, boost::gil::gray16_view_t::value_type& min, boost::gil::gray16_view_t::value_type& max, IProgress& p )
 {
 	using namespace terry;
 	using namespace terry::numeric;
@@ -451,10 +409,8 @@ void analyseInputMinMax( const boost::gil::gray16_view_t& src, const EParamAnaly
 		{
 			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
 			// compute the maximum value
-			transform_pixels_progress(
-				src,
-				minmax,
-				p );
+			if( ! reducePixelsParallel( src, minmax, p ) )
+				return false;
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -465,10 +421,8 @@ void analyseInputMinMax( const boost::gil::gray16_view_t& src, const EParamAnaly
 			typedef color_converted_view_type<gray16_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
 			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-				localView,
-				minmax,
-				p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -483,10 +437,11 @@ void analyseInputMinMax( const boost::gil::gray16_view_t& src, const EParamAnaly
 			break;
 		}
 	}
+	return true;
 }
 
 template<>
-void analyseInputMinMax( const boost::gil::gray8_view_t& src, const EParamAnalyseMode analyseMode, boost::gil::gray8_view_t::value_type& min, boost::gil::gray8_view_t::value_type& max, IProgress& p )
+bool analyseInputMinMax( const boost::gil::gray8_view_t& src, const EParamAnalyseMode analyseMode, boost::gil::gray8_view_t::value_type& min, boost::gil::gray8_view_t::value_type& max, IProgress& p )
 {
 	using namespace terry;
 	using namespace terry::numeric;
@@ -500,10 +455,8 @@ void analyseInputMinMax( const boost::gil::gray8_view_t& src, const EParamAnalys
 		{
 			pixel_minmax_by_channel_t<Pixel> minmax( src(0,0) );
 			// compute the maximum value
-			transform_pixels_progress(
-				src,
-				minmax,
-				p );
+			if( ! reducePixelsParallel( src, minmax, p ) )
+				return false;
 			min = minmax.min;
 			max = minmax.max;
 			break;
@@ -514,10 +467,8 @@ void analyseInputMinMax( const boost::gil::gray8_view_t& src, const EParamAnalys
 			typedef color_converted_view_type<gray8_view_t, PixelGray>::type LocalView;
 			LocalView localView(src);
 			pixel_minmax_by_channel_t<LocalView::value_type> minmax( localView(0,0) );
-			transform_pixels_progress(
-				localView,
-				minmax,
-				p );
+			if( ! reducePixelsParallel( localView, minmax, p ) )
+				return false;
 			static_fill( min, minmax.min[0] );
 			static_fill( max, minmax.max[0] );
 			break;
@@ -532,6 +483,7 @@ void analyseInputMinMax( const boost::gil::gray8_view_t& src, const EParamAnalys
 			break;
 		}
 	}
+	return true;
 }
 
 }
@@ -62,6 +62,8 @@ NormalizeProcessParams<NormalizePlugin::Scalar> NormalizePlugin::getProcessParam
 
 void NormalizePlugin::changedParam( const OFX::InstanceChangedArgs &args, const std::string &paramName )
 {
+	_analysisCache.clear();
+
 	if( paramName == kParamMode )
 	{
 		switch( static_cast<EParamMode>( _mode->getValue() ) )
@@ -226,6 +228,16 @@ void NormalizePlugin::changedParam( const OFX::InstanceChangedArgs &args, const
 	}
 }
 
+void NormalizePlugin::changedClip( const OFX::InstanceChangedArgs& args, const std::string& clipName )
+{
+	_analysisCache.clear();
+}
+
+void NormalizePlugin::beginSequenceRender( const OFX::BeginSequenceRenderArguments& args )
+{
+	_analysisCache.clear();
+}
+
 void NormalizePlugin::getRegionsOfInterest( const OFX::RegionsOfInterestArguments& args, OFX::RegionOfInterestSetter& rois )
 {
 	NormalizeProcessParams<Scalar> params = getProcessParams();
@@ -4,6 +4,7 @@
 #include "NormalizeDefinitions.hpp"
 
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
+#include <tuttle/plugin/AnalysisCache.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -40,6 +41,8 @@ public:
 	NormalizeProcessParams<Scalar> getProcessParams( const OfxPointD& renderScale = OFX::kNoRenderScale ) const;
 
     void changedParam( const OFX::InstanceChangedArgs &args, const std::string &paramName );
+	void changedClip( const OFX::InstanceChangedArgs& args, const std::string& clipName );
+	void beginSequenceRender( const OFX::BeginSequenceRenderArguments& args );
 
 	void getRegionsOfInterest( const OFX::RegionsOfInterestArguments& args, OFX::RegionOfInterestSetter& rois );
 
@@ -63,6 +66,8 @@ public:
 	OFX::BooleanParam* _processG;
 	OFX::BooleanParam* _processB;
 	OFX::BooleanParam* _processA;
+
+	AnalysisCache _analysisCache; ///< min and max of the analysed frames
 };
 
 }
@@ -13,6 +13,9 @@
 #include <terry/numeric/scale.hpp>
 
 #include <boost/gil/color_base_algorithm.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <utility>
 
 
 namespace tuttle {
@@ -49,7 +52,28 @@ void NormalizeProcess<View>::setup( const OFX::RenderArguments& args )
 	{
 		case eParamModeAnalyse:
 		{
-			analyseInputMinMax<View>( src, _params._analyseMode, smin, smax, *this );
+			// the whole image is analysed for each tile, so the result is kept
+			std::size_t analysisHash = 0;
+			boost::hash_combine( analysisHash, static_cast<int>( _params._analyseMode ) );
+			boost::hash_combine( analysisHash, this->_srcPixelRod.x1 );
+			boost::hash_combine( analysisHash, this->_srcPixelRod.y1 );
+			boost::hash_combine( analysisHash, this->_srcPixelRod.x2 );
+			boost::hash_combine( analysisHash, this->_srcPixelRod.y2 );
+			boost::hash_combine( analysisHash, args.renderScale.x );
+			boost::hash_combine( analysisHash, args.renderScale.y );
+
+			std::pair<Pixel, Pixel> minmax;
+			if( _plugin._analysisCache.get( args.time, analysisHash, minmax ) )
+			{
+				smin = minmax.first;
+				smax = minmax.second;
+			}
+			else
+			{
+				// an aborted analysis only covers a part of the image, so it is not kept
+				if( analyseInputMinMax<View>( src, _params._analyseMode, smin, smax, *this ) )
+					_plugin._analysisCache.set( args.time, analysisHash, std::make_pair( smin, smax ) );
+			}
 			break;
 		}
 		case eParamModeCustom:
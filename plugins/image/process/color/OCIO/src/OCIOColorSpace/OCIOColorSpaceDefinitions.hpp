@@ -4,6 +4,8 @@
 #include <tuttle/plugin/global.hpp>
 #include <tuttle/plugin/context/Definition.hpp>
 
+#include "../OCIODefinitions.hpp"
+
 namespace tuttle
 {
   namespace plugin
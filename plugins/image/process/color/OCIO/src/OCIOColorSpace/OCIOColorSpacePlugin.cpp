@@ -29,6 +29,8 @@ namespace tuttle
           _paramFilename = fetchStringParam(kTuttlePluginFilename);
           _paramInputSpace = fetchChoiceParam(kParamInputSpace);
           _paramOutputSpace = fetchChoiceParam(kParamOutputSpace);
+          _paramMode = fetchChoiceParam(kParamMode);
+          _paramLutSize = fetchIntParam(kParamLutSize);
 
         }
 
@@ -106,9 +108,36 @@ namespace tuttle
           BOOST_THROW_EXCEPTION( exception::Unknown());
         }
 
+        /**
+         * @brief Build the processor before the first frame, and bake it
+         * into a lut if needed, instead of doing it in the render of a frame.
+         */
+        void
+        OCIOColorSpacePlugin::beginSequenceRender(
+            const OFX::BeginSequenceRenderArguments& args)
+        {
+          if (!_wasOCIOVarFund)
+            return;
+
+          OCIOColorSpaceProcessParams params = getProcessParams(
+              args.renderScale);
+          try
+            {
+              if (params._mode == eParamModeBakedLut)
+                getBakedLut(params);
+              else
+                getProcessor(params);
+            }
+          catch (OCIO::Exception & exception)
+            {
+              BOOST_THROW_EXCEPTION(
+                  exception::File() << exception::user() + "OCIO: " + exception.what());
+            }
+        }
+
         OCIOColorSpaceProcessParams
         OCIOColorSpacePlugin::getProcessParams(
-            const OfxPointD& renderScale) const
+            const OfxPointD& renderScale)
         {
           using namespace boost::filesystem;
 
@@ -123,8 +152,16 @@ namespace tuttle
                   exception::FileNotExist( ) << exception::filename( str ));
             }
 
-          // Get the OCIO configuration processor.
-          params._config = OCIO::Config::CreateFromFile(str.c_str());
+          // Get the OCIO configuration, only reloaded if the file changed.
+          try
+            {
+              params._config = _transformCache.getConfig(str);
+            }
+          catch (OCIO::Exception & exception)
+            {
+              BOOST_THROW_EXCEPTION(
+                  exception::File() << exception::user() + "OCIO: " + exception.what() << exception::filename( str ));
+            }
 
           int index;
           _paramInputSpace->getValue(index);
@@ -132,9 +169,39 @@ namespace tuttle
           _paramOutputSpace->getValue(index);
           params._outputSpace = params._config->getColorSpaceNameByIndex(index);
 
+          params._mode = static_cast<EParamMode>(_paramMode->getValue());
+          params._lutSize = _paramLutSize->getValue();
+          params._key = fileKey(str) + "|" + params._inputSpace + "|"
+              + params._outputSpace;
+
           return params;
         }
 
+        OCIO::ConstProcessorRcPtr
+        OCIOColorSpacePlugin::getProcessor(
+            const OCIOColorSpaceProcessParams& params)
+        {
+          OCIO::ConstProcessorRcPtr processor = _transformCache.getProcessor(
+              params._key);
+          if (!processor)
+            {
+              processor = params._config->getProcessor(
+                  params._inputSpace.c_str(), params._outputSpace.c_str());
+              _transformCache.setProcessor(params._key, processor);
+            }
+          return processor;
+        }
+
+        TransformCache::LutPtr
+        OCIOColorSpacePlugin::getBakedLut(
+            const OCIOColorSpaceProcessParams& params)
+        {
+          getProcessor(params);
+          // the shaper covers the values allowed by the input color space
+          return _transformCache.getBakedLut(params._key, params._lutSize,
+              getShaper(params._config->getColorSpace(params._inputSpace.c_str())));
+        }
+
       }
     }
   }
@@ -2,6 +2,7 @@
 #define _TUTTLE_PLUGIN_OCIOColorSpacePlugin_HPP_
 
 #include "OCIOColorSpaceDefinitions.hpp"
+#include "../OCIOTransformCache.hpp"
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -19,6 +20,9 @@ namespace tuttle
           OCIO_NAMESPACE::ConstConfigRcPtr _config;
           std::string _inputSpace;
           std::string _outputSpace;
+          EParamMode _mode;
+          std::size_t _lutSize;
+          std::string _key; ///< identifies the transformation (config file and color spaces)
         };
 
         /**
@@ -35,16 +39,31 @@ namespace tuttle
           void
           render(const OFX::RenderArguments& args);
 
+          void
+          beginSequenceRender(const OFX::BeginSequenceRenderArguments& args);
+
         public:
           OFX::StringParam* _paramFilename;
           OFX::ChoiceParam* _paramInputSpace;
           OFX::ChoiceParam* _paramOutputSpace;
+          OFX::ChoiceParam* _paramMode;
+          OFX::IntParam* _paramLutSize;
 
           OCIOColorSpaceProcessParams
           getProcessParams(
-              const OfxPointD& renderScale = OFX::kNoRenderScale) const;
+              const OfxPointD& renderScale = OFX::kNoRenderScale);
+
+          /// processor of the transformation, built once for all the renders
+          OCIO_NAMESPACE::ConstProcessorRcPtr
+          getProcessor(const OCIOColorSpaceProcessParams& params);
+
+          /// transformation baked into a 3D lut
+          TransformCache::LutPtr
+          getBakedLut(const OCIOColorSpaceProcessParams& params);
+
         private:
           const bool _wasOCIOVarFund;
+          TransformCache _transformCache;
         };
 
       }
@@ -91,6 +91,24 @@ namespace tuttle
               kParamOutputSpace);
           outputSpace->setLabel("Output Space");
 
+          OFX::ChoiceParamDescriptor* mode = desc.defineChoiceParam(kParamMode);
+          mode->setLabel("Mode");
+          mode->appendOption(kParamModeExact);
+          mode->appendOption(kParamModeBakedLut);
+          mode->setDefault(eParamModeExact);
+          mode->setHint(
+              "exact: apply the OCIO processor on each pixel.\n"
+              "bakedLut: bake the transformation into a 3D lut at the beginning of the sequence, "
+              "the input values are mapped to the lut with the allocation of the input color space. "
+              "Faster, but an approximation of the transformation.");
+
+          OFX::IntParamDescriptor* lutSize = desc.defineIntParam(kParamLutSize);
+          lutSize->setLabel("Lut size");
+          lutSize->setDefault(kDefaultLutSize);
+          lutSize->setRange(2, 129);
+          lutSize->setDisplayRange(17, 65);
+          lutSize->setHint("Number of nodes on each axis of the baked lut.");
+
           if (file == NULL)
             {
               filename->setDefault(
@@ -35,7 +35,8 @@ namespace tuttle
             OCIOColorSpacePlugin& _plugin; ///< Rendering plugin
             OCIOColorSpaceProcessParams _params; ///< parameters
 
-            OCIO::ConstConfigRcPtr _config;
+            OCIO::ConstProcessorRcPtr _processor; ///< shared by all the renders of the plugin
+            TransformCache::LutPtr _lut; ///< baked processor, in eParamModeBakedLut
 
           public:
             OCIOColorSpaceProcess<View>(OCIOColorSpacePlugin & instance);
@@ -45,9 +46,13 @@ namespace tuttle
             void
             multiThreadProcessImages(const OfxRectI& procWindowRoW);
 
-            // Lut Transform
+            /// OCIO processor on the whole tile
             void
-            applyLut(View& dst, View& src);
+            applyProcessor(const View& dst, const View& src);
+
+            /// baked lut, line by line
+            void
+            applyBakedLut(const View& dst, const View& src);
           };
 
       }
@@ -34,11 +34,10 @@ void OCIOColorSpaceProcess<View>::setup(const OFX::RenderArguments& args)
 	
 	try
 	{
-		// Load the current config.
-		_config = _params._config;
-
-		// Try to load the processor
-		_config->getProcessor(  _params._inputSpace.c_str(),  _params._outputSpace.c_str() );
+		// The processor is built by the plugin for the first render, then reused.
+		_processor = _plugin.getProcessor( _params );
+		if( _params._mode == eParamModeBakedLut )
+			_lut = _plugin.getBakedLut( _params );
 	}
 	catch(OCIO::Exception & exception)
 	{
@@ -66,42 +65,35 @@ void OCIOColorSpaceProcess<View>::multiThreadProcessImages(
 	View dst = subimage_view(this->_dstView, procWindowOutput.x1,
 			procWindowOutput.y1, procWindowSize.x, procWindowSize.y);
 
-	applyLut(dst, src);
+	if( _lut )
+		applyBakedLut(dst, src);
+	else
+		applyProcessor(dst, src);
 }
 
 template<class View>
-void OCIOColorSpaceProcess<View>::applyLut(View& dst, View& src) {
+void OCIOColorSpaceProcess<View>::applyProcessor(const View& dst, const View& src) {
 	using namespace boost::gil;
-	typedef typename View::x_iterator vIterator;
-	typedef typename channel_type<View>::type Pixel;
 
 	copy_pixels(src, dst);
 
 	try
 	{
-		OCIO::ConstProcessorRcPtr processor = _config->getProcessor( _params._inputSpace.c_str(), _params._outputSpace.c_str() );
-		
 		if (is_planar<View>::value)
 		{
 			BOOST_THROW_EXCEPTION( exception::NotImplemented() );
 		}
 		else
 		{
-			for (std::size_t y = 0; y < (unsigned int) dst.height(); ++y)
-			{
-				// Wrap the image in a light-weight ImageDescription
-				OCIO::PackedImageDesc imageDesc((float*) &(dst(0, y)[0]),
-						dst.width(), 1, num_channels<View>::type::value,
-						OCIO::AutoStride, dst.pixels().pixel_size(),
-						dst.pixels().row_size());
-				// Apply the color transformation (in place)
-				// Need normalized values
-				processor->apply(imageDesc);
-				if (this->progressForward(dst.width()))
-					return;
-			}
+			// Wrap the whole tile in a light-weight ImageDescription
+			OCIO::PackedImageDesc imageDesc((float*) &(dst(0, 0)[0]),
+					dst.width(), dst.height(), num_channels<View>::type::value,
+					OCIO::AutoStride, dst.pixels().pixel_size(),
+					dst.pixels().row_size());
+			// Apply the color transformation (in place)
+			_processor->apply(imageDesc);
+			this->progressForward(dst.width() * dst.height());
 		}
-		
 	}
 	catch( OCIO::Exception & exception )
 	{
@@ -110,6 +102,19 @@ void OCIOColorSpaceProcess<View>::applyLut(View& dst, View& src) {
 	}
 }
 
+template<class View>
+void OCIOColorSpaceProcess<View>::applyBakedLut(const View& dst, const View& src) {
+	using namespace boost::gil;
+
+	for (std::ptrdiff_t y = 0; y < dst.height(); ++y)
+	{
+		_lut->apply((const float*) &(src(0, y)[0]), (float*) &(dst(0, y)[0]),
+				dst.width(), num_channels<View>::type::value);
+		if (this->progressForward(dst.width()))
+			return;
+	}
+}
+
 }
 }
 }
@@ -0,0 +1,27 @@
+#ifndef _TUTTLE_PLUGIN_OCIODEFINITIONS_HPP_
+#define _TUTTLE_PLUGIN_OCIODEFINITIONS_HPP_
+
+#include <tuttle/plugin/global.hpp>
+
+namespace tuttle {
+namespace plugin {
+namespace ocio {
+
+static const std::string kParamMode         = "mode";
+static const std::string kParamModeExact    = "exact";
+static const std::string kParamModeBakedLut = "bakedLut";
+
+enum EParamMode
+{
+	eParamModeExact = 0,
+	eParamModeBakedLut
+};
+
+static const std::string kParamLutSize = "lutSize";
+static const int kDefaultLutSize = 48;
+
+}
+}
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/gil/gil_all.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
 
 namespace bfs = boost::filesystem;
 
@@ -21,6 +22,8 @@ OCIOLutPlugin::OCIOLutPlugin(OfxImageEffectHandle handle) :
 {
 	_paramFilename = fetchStringParam(kTuttlePluginFilename);
 	_paramInterpolationType = fetchChoiceParam(kParamInterpolationType);
+	_paramMode = fetchChoiceParam(kParamMode);
+	_paramLutSize = fetchIntParam(kParamLutSize);
 
 }
 
@@ -81,6 +84,26 @@ void OCIOLutPlugin::render(const OFX::RenderArguments& args)
 	BOOST_THROW_EXCEPTION( exception::Unknown() );
 }
 
+/**
+ * @brief Build the processor before the first frame, and bake it
+ * into a lut if needed, instead of doing it in the render of a frame.
+ */
+void OCIOLutPlugin::beginSequenceRender( const OFX::BeginSequenceRenderArguments& args )
+{
+	const OCIOLutProcessParams params = getProcessParams( args.renderScale );
+	try
+	{
+		if( params._mode == eParamModeBakedLut )
+			getBakedLut( params );
+		else
+			getProcessor( params );
+	}
+	catch( OCIO::Exception& exception )
+	{
+		BOOST_THROW_EXCEPTION( exception::File() << exception::user() + "OCIO Error: " + exception.what() );
+	}
+}
+
 OCIOLutProcessParams OCIOLutPlugin::getProcessParams( const OfxPointD& renderScale) const
 {
 	using namespace boost::filesystem;
@@ -93,10 +116,56 @@ OCIOLutProcessParams OCIOLutPlugin::getProcessParams( const OfxPointD& renderSca
 		BOOST_THROW_EXCEPTION( exception::FileNotExist( )
 				<< exception::filename( params._filename ) );
 	}
+	params._mode = static_cast<EParamMode>( _paramMode->getValue() );
+	params._lutSize = _paramLutSize->getValue();
+	params._key = fileKey( params._filename ) + "|" + boost::lexical_cast<std::string>( static_cast<int>( params._interpolationType ) );
 
 	return params;
 }
 
+OCIO::ConstProcessorRcPtr OCIOLutPlugin::getProcessor( const OCIOLutProcessParams& params )
+{
+	OCIO::ConstProcessorRcPtr processor = _transformCache.getProcessor( params._key );
+	if( processor )
+		return processor;
+
+	OCIO::FileTransformRcPtr fileTransform = OCIO::FileTransform::Create();
+	fileTransform->setSrc( params._filename.c_str() );
+	fileTransform->setInterpolation( params._interpolationType );
+
+	//Add the file transform to the group, required by the transform process
+	OCIO::GroupTransformRcPtr groupTransform = OCIO::GroupTransform::Create();
+	groupTransform->push_back( fileTransform );
+
+	// Create the OCIO processor for the specified transform.
+	OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+	OCIO::ColorSpaceRcPtr inputColorSpace = OCIO::ColorSpace::Create();
+	inputColorSpace->setName( kOCIOInputspace.c_str() );
+
+	config->addColorSpace( inputColorSpace );
+
+	OCIO::ColorSpaceRcPtr outputColorSpace = OCIO::ColorSpace::Create();
+	outputColorSpace->setName( kOCIOOutputspace.c_str()) ;
+
+	outputColorSpace->setTransform( groupTransform, OCIO::COLORSPACE_DIR_FROM_REFERENCE );
+
+	TUTTLE_TLOG( TUTTLE_WARNING, "Specified Transform:" << *(groupTransform) );
+
+	config->addColorSpace( outputColorSpace );
+
+	processor = config->getProcessor( kOCIOInputspace.c_str(), kOCIOOutputspace.c_str() );
+	_transformCache.setProcessor( params._key, processor );
+	return processor;
+}
+
+TransformCache::LutPtr OCIOLutPlugin::getBakedLut( const OCIOLutProcessParams& params )
+{
+	getProcessor( params );
+	// lut files are defined on [0,1]
+	return _transformCache.getBakedLut( params._key, params._lutSize, terry::color::lut3d_shaper_t() );
+}
+
 }
 }
 }
@@ -2,6 +2,7 @@
 #define _TUTTLE_PLUGIN_OCIOLutPlugin_HPP_
 
 #include "OCIOLutDefinitions.hpp"
+#include "../OCIOTransformCache.hpp"
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -16,7 +17,9 @@ struct OCIOLutProcessParams
 {
 	std::string _filename;
 	OCIO::Interpolation _interpolationType;
-
+	EParamMode _mode;
+	std::size_t _lutSize;
+	std::string _key; ///< identifies the transformation (lut file and interpolation)
 };
 
 /**
@@ -32,12 +35,22 @@ public:
 public:
 	void render( const OFX::RenderArguments& args );
 
+	void beginSequenceRender( const OFX::BeginSequenceRenderArguments& args );
+
 public:
 	OFX::StringParam* _paramFilename;
 	OFX::ChoiceParam* _paramInterpolationType;
+	OFX::ChoiceParam* _paramMode;
+	OFX::IntParam* _paramLutSize;
 
 	OCIOLutProcessParams getProcessParams( const OfxPointD& renderScale = OFX::kNoRenderScale ) const;
 
+	/// processor of the lut file, built once for all the renders
+	OCIO::ConstProcessorRcPtr getProcessor( const OCIOLutProcessParams& params );
+
+	/// lut file resampled into a 3D lut
+	TransformCache::LutPtr getBakedLut( const OCIOLutProcessParams& params );
+
 	EInterpolationType getInterpolationType( ) const
 	{
 		return static_cast<EInterpolationType> ( _paramInterpolationType->getValue( ) );
@@ -57,6 +70,9 @@ public:
 		BOOST_ASSERT(false);
 		return OCIO_NAMESPACE::INTERP_LINEAR;
 	}
+
+private:
+	TransformCache _transformCache;
 };
 
 }
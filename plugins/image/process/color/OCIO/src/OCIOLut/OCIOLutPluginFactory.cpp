@@ -72,6 +72,23 @@ void OCIOLutPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
 	interpolationType->appendOption( kParamInterpolationLinear );
 	interpolationType->appendOption( kParamInterpolationTetrahedral );
 
+	OFX::ChoiceParamDescriptor* mode = desc.defineChoiceParam( kParamMode );
+	mode->setLabel( "Mode" );
+	mode->appendOption( kParamModeExact );
+	mode->appendOption( kParamModeBakedLut );
+	mode->setDefault( eParamModeExact );
+	mode->setHint( "exact: apply the OCIO processor on each pixel.\n"
+	               "bakedLut: resample the lut file into a 3D lut at the beginning of the sequence, "
+	               "applied with a tetrahedral interpolation on [0,1]. "
+	               "Faster for files with several transforms, but an approximation." );
+
+	OFX::IntParamDescriptor* lutSize = desc.defineIntParam( kParamLutSize );
+	lutSize->setLabel( "Lut size" );
+	lutSize->setDefault( kDefaultLutSize );
+	lutSize->setRange( 2, 129 );
+	lutSize->setDisplayRange( 17, 65 );
+	lutSize->setHint( "Number of nodes on each axis of the baked lut." );
+
 
 }
 
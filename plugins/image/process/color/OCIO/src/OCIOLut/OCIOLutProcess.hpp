@@ -31,9 +31,8 @@ private:
 	OCIOLutPlugin&  _plugin;        ///< Rendering plugin
 	OCIOLutProcessParams _params; ///< parameters
 
-	OCIO::FileTransformRcPtr  fileTransform;
-	OCIO::GroupTransformRcPtr groupTransform;
-	OCIO::ConfigRcPtr         config;
+	OCIO::ConstProcessorRcPtr _processor; ///< shared by all the renders of the plugin
+	TransformCache::LutPtr    _lut;       ///< baked processor, in eParamModeBakedLut
 
 public:
 	OCIOLutProcess<View>( OCIOLutPlugin & instance );
@@ -41,8 +40,11 @@ public:
 
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
 
-	// Lut Transform
-	void applyLut( View& dst, View& src );
+	/// OCIO processor on the whole tile
+	void applyProcessor( const View& dst, const View& src );
+
+	/// baked lut, line by line
+	void applyBakedLut( const View& dst, const View& src );
 };
 
 }
@@ -32,34 +32,12 @@ void OCIOLutProcess<View>::setup(const OFX::RenderArguments& args)
 	ImageGilFilterProcessor<View>::setup(args);
 	_params = _plugin.getProcessParams(args.renderScale);
 	
-	try {
-		fileTransform = OCIO::FileTransform::Create();
-		fileTransform->setSrc( _params._filename.c_str() );
-		fileTransform->setInterpolation( _params._interpolationType );
-	
-		//Add the file transform to the group, required by the transform process
-		groupTransform = OCIO::GroupTransform::Create();
-		groupTransform->push_back( fileTransform );
-	
-		// Create the OCIO processor for the specified transform.
-		config = OCIO::Config::Create();
-	
-		OCIO::ColorSpaceRcPtr inputColorSpace = OCIO::ColorSpace::Create();
-		inputColorSpace->setName( kOCIOInputspace.c_str() );
-		
-		config->addColorSpace( inputColorSpace );
-		
-		OCIO::ColorSpaceRcPtr outputColorSpace = OCIO::ColorSpace::Create();
-		outputColorSpace->setName( kOCIOOutputspace.c_str()) ;
-	
-		outputColorSpace->setTransform( groupTransform, OCIO::COLORSPACE_DIR_FROM_REFERENCE );
-	
-		TUTTLE_TLOG( TUTTLE_WARNING, "Specified Transform:" << *(groupTransform) );
-	
-		config->addColorSpace( outputColorSpace );
-		
-		// Try to load the processor
-		config->getProcessor( kOCIOInputspace.c_str(), kOCIOOutputspace.c_str() );
+	try
+	{
+		// The processor is built by the plugin for the first render, then reused.
+		_processor = _plugin.getProcessor( _params );
+		if( _params._mode == eParamModeBakedLut )
+			_lut = _plugin.getBakedLut( _params );
 	}
 	catch(OCIO::Exception & exception)
 	{
@@ -86,40 +64,34 @@ void OCIOLutProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowR
 	View dst = subimage_view(this->_dstView, procWindowOutput.x1,
 			procWindowOutput.y1, procWindowSize.x, procWindowSize.y);
 
-	applyLut(dst, src);
+	if( _lut )
+		applyBakedLut(dst, src);
+	else
+		applyProcessor(dst, src);
 }
 
 template<class View>
-void OCIOLutProcess<View>::applyLut(View& dst, View& src) {
+void OCIOLutProcess<View>::applyProcessor(const View& dst, const View& src) {
 	using namespace boost::gil;
-	typedef typename View::x_iterator vIterator;
-	typedef typename channel_type<View>::type Pixel;
 
 	copy_pixels(src, dst);
 
 	try
 	{
-		OCIO::ConstProcessorRcPtr processor = config->getProcessor( kOCIOInputspace.c_str(), kOCIOOutputspace.c_str() );
-		
 		if (is_planar<View>::value)
 		{
 			BOOST_THROW_EXCEPTION( exception::NotImplemented() );
 		}
 		else
 		{
-			for (std::size_t y = 0; y < (unsigned int) dst.height(); ++y)
-			{
-				// Wrap the image in a light-weight ImageDescription
-				OCIO::PackedImageDesc imageDesc((float*) &(dst(0, y)[0]),
-						dst.width(), 1, num_channels<View>::type::value,
-						OCIO::AutoStride, dst.pixels().pixel_size(),
-						dst.pixels().row_size());
-				// Apply the color transformation (in place)
-				// Need normalized values
-				processor->apply(imageDesc);
-				if (this->progressForward(dst.width()))
-					return;
-			}
+			// Wrap the whole tile in a light-weight ImageDescription
+			OCIO::PackedImageDesc imageDesc((float*) &(dst(0, 0)[0]),
+					dst.width(), dst.height(), num_channels<View>::type::value,
+					OCIO::AutoStride, dst.pixels().pixel_size(),
+					dst.pixels().row_size());
+			// Apply the color transformation (in place)
+			_processor->apply(imageDesc);
+			this->progressForward(dst.width() * dst.height());
 		}
 	}
 	catch (OCIO::Exception & exception)
@@ -128,6 +100,19 @@ void OCIOLutProcess<View>::applyLut(View& dst, View& src) {
 	}
 }
 
+template<class View>
+void OCIOLutProcess<View>::applyBakedLut(const View& dst, const View& src) {
+	using namespace boost::gil;
+
+	for (std::ptrdiff_t y = 0; y < dst.height(); ++y)
+	{
+		_lut->apply((const float*) &(src(0, y)[0]), (float*) &(dst(0, y)[0]),
+				dst.width(), num_channels<View>::type::value);
+		if (this->progressForward(dst.width()))
+			return;
+	}
+}
+
 }
 }
 }
@@ -0,0 +1,150 @@
+#ifndef _TUTTLE_PLUGIN_OCIOTRANSFORMCACHE_HPP_
+#define _TUTTLE_PLUGIN_OCIOTRANSFORMCACHE_HPP_
+
+#include <terry/color/lut3d.hpp>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include <ofxsMultiThread.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace tuttle {
+namespace plugin {
+namespace ocio {
+
+namespace OCIO = OCIO_NAMESPACE;
+
+/**
+ * @brief Key identifying a file by its name and its modification date,
+ * so a file rewritten on disk is reloaded.
+ */
+inline std::string fileKey( const std::string& filename )
+{
+	return filename + "@" + boost::lexical_cast<std::string>( boost::filesystem::last_write_time( filename ) );
+}
+
+/**
+ * @brief Shaper of a baked lut, from the allocation of the input colorspace
+ * (the same information OCIO uses to bake its GPU luts).
+ */
+inline terry::color::lut3d_shaper_t getShaper( const OCIO::ConstColorSpaceRcPtr& colorSpace )
+{
+	using namespace terry::color;
+	if( ! colorSpace )
+		return lut3d_shaper_t();
+	std::vector<float> vars( colorSpace->getAllocationNumVars() );
+	if( ! vars.empty() )
+		colorSpace->getAllocationVars( &vars.front() );
+	if( colorSpace->getAllocation() == OCIO::ALLOCATION_LG2 )
+		return lut3d_shaper_t( eLut3DShaperLog2,
+		                       vars.size() > 0 ? vars[0] : -10.0f,
+		                       vars.size() > 1 ? vars[1] : 6.0f,
+		                       vars.size() > 2 ? vars[2] : 0.0f );
+	return lut3d_shaper_t( eLut3DShaperLinear,
+	                       vars.size() > 0 ? vars[0] : 0.0f,
+	                       vars.size() > 1 ? vars[1] : 1.0f );
+}
+
+/**
+ * @brief OCIO objects of a plugin instance, reused by all the renders
+ * and threads until the parameters change.
+ *
+ * Loading a config and building a processor is expensive with big configs
+ * (ACES), often more than applying it on a frame.
+ */
+class TransformCache
+{
+public:
+	typedef boost::shared_ptr<const terry::color::lut3d> LutPtr;
+
+public:
+	TransformCache()
+		: _mutex( 0 )
+	{}
+
+	/// config loaded from a file
+	OCIO::ConstConfigRcPtr getConfig( const std::string& filename )
+	{
+		const std::string key = fileKey( filename );
+		OFX::MultiThread::AutoMutex lock( _mutex );
+		if( ! _config || key != _configKey )
+		{
+			_config    = OCIO::Config::CreateFromFile( filename.c_str() );
+			_configKey = key;
+		}
+		return _config;
+	}
+
+	/// @return the processor built for this key, or an empty pointer
+	OCIO::ConstProcessorRcPtr getProcessor( const std::string& key )
+	{
+		OFX::MultiThread::AutoMutex lock( _mutex );
+		if( key != _processorKey )
+			return OCIO::ConstProcessorRcPtr();
+		return _processor;
+	}
+
+	void setProcessor( const std::string& key, const OCIO::ConstProcessorRcPtr& processor )
+	{
+		OFX::MultiThread::AutoMutex lock( _mutex );
+		if( key == _processorKey )
+			return;
+		_processor    = processor;
+		_processorKey = key;
+		_lut.reset();
+	}
+
+	/**
+	 * @brief Processor baked into a 3D lut, only rebuilt if the processor
+	 * or the lut size changed.
+	 */
+	LutPtr getBakedLut( const std::string& key, const std::size_t lutSize, const terry::color::lut3d_shaper_t& shaper )
+	{
+		OFX::MultiThread::AutoMutex lock( _mutex );
+		if( key != _processorKey || ! _processor )
+			return LutPtr();
+		if( _lut && _lut->size() == lutSize )
+			return _lut;
+
+		boost::shared_ptr<terry::color::lut3d> lut = boost::make_shared<terry::color::lut3d>();
+		lut->bake( lutSize, shaper, ApplyProcessor( _processor ) );
+		_lut = lut;
+		return _lut;
+	}
+
+private:
+	struct ApplyProcessor
+	{
+		OCIO::ConstProcessorRcPtr _processor;
+
+		ApplyProcessor( const OCIO::ConstProcessorRcPtr& processor ) : _processor( processor ) {}
+
+		void operator()( float* nodes, const std::size_t nbNodes ) const
+		{
+			OCIO::PackedImageDesc desc( nodes, nbNodes, 1, terry::color::lut3d::kNodeSize );
+			_processor->apply( desc );
+		}
+	};
+
+private:
+	OFX::MultiThread::Mutex _mutex;
+	OCIO::ConstConfigRcPtr _config;
+	std::string _configKey;
+	OCIO::ConstProcessorRcPtr _processor;
+	std::string _processorKey;
+	LutPtr _lut; ///< baked _processor
+};
+
+}
+}
+}
+
+#endif
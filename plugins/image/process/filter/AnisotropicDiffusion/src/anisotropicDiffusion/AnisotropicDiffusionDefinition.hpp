@@ -14,6 +14,10 @@ static const std::string kParamGroupPDEAlgorithm( "groupPDEAlgorithm" );
 
 static const std::string kParamFastApproximation( "fastApproximation" );
 static const std::string kParamAmplitude( "amplitude" );
+static const std::string kParamPyramidLevels( "pyramidLevels" );
+
+/// similarity tolerance of the guided upsampling (relative to the maximum channel value)
+static const float kPyramidRangeSigma( 0.1f );
 
 }
 }
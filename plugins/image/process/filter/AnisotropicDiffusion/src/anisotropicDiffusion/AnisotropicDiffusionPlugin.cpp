@@ -2,6 +2,7 @@
 #include "AnisotropicDiffusionPlugin.hpp"
 #include "AnisotropicDiffusionPluginFactory.hpp"
 #include "AnisotropicDiffusionProcess.hpp"
+#include "../imageUtils/pyramid.hpp"
 
 #include <ofxsImageEffect.h>
 #include <ofxsMultiThread.h>
@@ -19,6 +20,7 @@ AnisotropicDiffusionPlugin::AnisotropicDiffusionPlugin( OfxImageEffectHandle han
     _clipSrcTensors = fetchClip( kClipInputTensors );
 
     _paramAmplitude = fetchRGBParam( kParamAmplitude );
+    _paramPyramidLevels = fetchIntParam( kParamPyramidLevels );
 }
 
 int AnisotropicDiffusionPlugin::getMargin()
@@ -33,7 +35,7 @@ int AnisotropicDiffusionPlugin::getMargin()
 				std::sqrt( 2.0f * color.b )
 				)
 			)
-		);
+		) + imageUtils::pyramidMargin( _paramPyramidLevels->getValue() );
 }
 
 void AnisotropicDiffusionPlugin::getRegionsOfInterest( const OFX::RegionsOfInterestArguments& args, OFX::RegionOfInterestSetter& rois )
@@ -30,6 +30,7 @@ public:
     // do not need to delete these, the ImageEffect is managing them for us
     OfxRectD            _overSizedRect;
 	OFX::RGBParam*      _paramAmplitude; ///< Amplitude control parameter
+	OFX::IntParam*      _paramPyramidLevels; ///< Coarse-to-fine mode
 
     OFX::Clip* _clipSrcTensors; ///< Tensors source image clip
 };
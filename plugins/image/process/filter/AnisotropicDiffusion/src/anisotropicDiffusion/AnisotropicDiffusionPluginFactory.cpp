@@ -33,7 +33,8 @@ void AnisotropicDiffusionPluginFactory::describe( OFX::ImageEffectDescriptor &de
 		"- Input tensors: Needed to get edges directions and strengths.\n"
 		"\n"
 		"Parameters:\n"
-		"- {Red, Green, Blue} amplitude: amplitude by channel."
+		"- {Red, Green, Blue} amplitude: amplitude by channel.\n"
+		"- Pyramid levels: compute the blur at a lower resolution, much faster on large images."
 		);
 	
 	// add the supported contexts, only filter at the moment
@@ -105,6 +106,15 @@ void AnisotropicDiffusionPluginFactory::describeInContext(
 //	amplitude->setRange( 0.0, 1000.0 );
 //	amplitude->setDisplayRange( 0.0, 10.0 );
 	amplitude->setHint( "Amplitude of the anisotropic blur" );
+
+	OFX::IntParamDescriptor* pyramidLevels = desc.defineIntParam( kParamPyramidLevels );
+	pyramidLevels->setLabel( "Pyramid levels" );
+	pyramidLevels->setParent( *groupParamsPDE );
+	pyramidLevels->setDefault( kDefaultPyramidLevels );
+	pyramidLevels->setRange( 0, kMaxPyramidLevels );
+	pyramidLevels->setDisplayRange( 0, kMaxPyramidLevels );
+	pyramidLevels->setHint( "Coarse-to-fine mode: the blur is computed on the image downscaled by 2^levels "
+	                        "and upsampled with the source as guide (0: full resolution)." );
 }
 
 /**
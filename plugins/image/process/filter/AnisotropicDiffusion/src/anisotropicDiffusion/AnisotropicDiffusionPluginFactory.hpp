@@ -11,6 +11,8 @@ namespace diffusion {
 static const bool   kSupportTiles(true);
 static const int    kDefaultInterpolationValue(1);
 static const double kDefaultAmplitudeValue(2.0);
+static const int    kDefaultPyramidLevels(0);
+static const int    kMaxPyramidLevels(4);
 
 
 mDeclarePluginFactory(AnisotropicDiffusionPluginFactory, {}, {});
@@ -2,6 +2,7 @@
 #define _PDE_DENOISER_PROCESS_HPP_
 
 #include "../imageUtils/ImageTensors.hpp"
+#include "../imageUtils/pyramid.hpp"
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
 
 #include <tuttle/common/utils/global.hpp>
@@ -40,9 +41,11 @@ protected :
 	boost::scoped_ptr<OFX::Image> _srcTensor;
     OFX::BooleanParam*  _fast_approx;   ///< Perform fast approximation
     OFX::RGBParam*      _amplitude;   ///< Red amplitude control parameter
+    OFX::IntParam*      _pyramidLevels; ///< Coarse-to-fine mode
     View                _srcView;       ///< Source image view
     View                _srcTensorView; ///< Source tensors image view
     OfxRectI _upScaledSrcBounds, _dBounds;
+    OfxRectI            _srcPixelRod;   ///< Origin of the pyramid grid
 
 public :
     AnisotropicDiffusionProcess<View>( AnisotropicDiffusionPlugin& instance );
@@ -56,6 +59,11 @@ public :
                            const region_t & dregion, const OfxRGBColourD& amplitude,
                            const bool fast_approx=true, const float dl=0.8f,
                            const float da=30.0f, const float gauss_prec=2.0f );
+
+    // Anisotropic blur on a level of the gaussian pyramid
+    void blur_anisotropic_pyramid( View &dst, View &src, View &G,
+                                   const region_t & dregion, const OfxRGBColourD& amplitude,
+                                   const bool fast_approx, const int levels );
 };
 
 }
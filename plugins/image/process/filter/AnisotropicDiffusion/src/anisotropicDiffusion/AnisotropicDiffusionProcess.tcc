@@ -15,6 +15,7 @@ AnisotropicDiffusionProcess<View>::AnisotropicDiffusionProcess( AnisotropicDiffu
 {
     _fast_approx = instance.fetchBooleanParam( kParamFastApproximation );
     _amplitude = instance.fetchRGBParam( kParamAmplitude );
+    _pyramidLevels = instance.fetchIntParam( kParamPyramidLevels );
 }
 
 template<class View>
@@ -34,6 +35,7 @@ void AnisotropicDiffusionProcess<View>::setup( const OFX::RenderArguments &args
 	if( !this->_src.get( ) )
 		BOOST_THROW_EXCEPTION( exception::ImageNotReady() << exception::user( "Input" ) );
 	_upScaledSrcBounds = this->_src->getBounds();
+	_srcPixelRod = _plugin._clipSrc->getPixelRod( args.time, args.renderScale );
 
 	if( !_plugin._clipSrcTensors->isConnected( ) )
 		BOOST_THROW_EXCEPTION( exception::ImageNotConnected() << exception::user( "Tensor" ) );
@@ -102,6 +104,11 @@ void AnisotropicDiffusionProcess<View>::multiThreadProcessImages( const OfxRectI
 
     srcRect = rectanglesIntersection(srcRect, _upScaledSrcBounds);
 
+    // all the tiles use the same pyramid grid, aligned on the RoD
+    const int levels = _pyramidLevels->getValue();
+    srcRect.x1 = imageUtils::pyramidAlign( srcRect.x1, _srcPixelRod.x1, _upScaledSrcBounds.x1, levels );
+    srcRect.y1 = imageUtils::pyramidAlign( srcRect.y1, _srcPixelRod.y1, _upScaledSrcBounds.y1, levels );
+
     // dest starting offset among x and y
     dregion.dox = procWindowRoW.x1 - srcRect.x1;
     dregion.doy = procWindowRoW.y1 - srcRect.y1;
@@ -128,7 +135,66 @@ void AnisotropicDiffusionProcess<View>::multiThreadProcessImages( const OfxRectI
                              procWindowRoW.x2 - procWindowRoW.x1 + dregion.dw,
                              procWindowRoW.y2 - procWindowRoW.y1 + dregion.dh);
 
-    blur_anisotropic( dst, src, srct, dregion, amplitude_rgb, _fast_approx->getValue() );
+    if( levels > 0 )
+        blur_anisotropic_pyramid( dst, src, srct, dregion, amplitude_rgb, _fast_approx->getValue(), levels );
+    else
+        blur_anisotropic( dst, src, srct, dregion, amplitude_rgb, _fast_approx->getValue() );
+}
+
+/**
+ * @brief Coarse-to-fine anisotropic blur
+ *
+ * The source and the tensors are downscaled by 2^levels, blurred with the
+ * amplitude scaled to the pyramid level (the amplitude is a variance),
+ * and the result is upsampled with the full resolution source as guide.
+ *
+ * @param[out]  dst     Destination image view
+ * @param[in]   levels  Pyramid level used for the blur
+ */
+template<class View>
+void AnisotropicDiffusionProcess<View>::blur_anisotropic_pyramid( View &dst, View &src, View &G, const region_t & dregion,
+                                                                  const OfxRGBColourD& amplitude, const bool fast_approx,
+                                                                  const int levels )
+{
+    using namespace boost::gil;
+    typedef typename terry::image_from_view<View>::type image_t;
+
+    if( amplitude.r <= 0.0f && amplitude.g <= 0.0f && amplitude.b <= 0.0f )
+    {
+        blur_anisotropic( dst, src, G, dregion, amplitude, fast_approx );
+        return;
+    }
+
+    image_t coarseSrc;
+    image_t coarseTensors;
+    buildPyramidLevel( src, levels, coarseSrc );
+    buildPyramidLevel( G, levels, coarseTensors );
+    // channels which are not blurred are copied from the source
+    image_t coarseDst( coarseSrc );
+
+    View coarseSrcView( view( coarseSrc ) );
+    View coarseTensorsView( view( coarseTensors ) );
+    View coarseDstView( view( coarseDst ) );
+
+    const double levelScale2 = double( 1 << ( 2 * levels ) );
+    OfxRGBColourD coarseAmplitude;
+    coarseAmplitude.r = amplitude.r / levelScale2;
+    coarseAmplitude.g = amplitude.g / levelScale2;
+    coarseAmplitude.b = amplitude.b / levelScale2;
+
+    region_t coarseRegion;
+    coarseRegion.dox = 0;
+    coarseRegion.doy = 0;
+    coarseRegion.dw  = coarseSrcView.width();
+    coarseRegion.dh  = coarseSrcView.height();
+
+    blur_anisotropic( coarseDstView, coarseSrcView, coarseTensorsView, coarseRegion, coarseAmplitude, fast_approx );
+    if( _plugin.abort() )
+        return;
+
+    guidedPyramidUp( coarseDstView, coarseSrcView, src, levels, kPyramidRangeSigma,
+                     subimage_view( dst, dregion.dox, dregion.doy, dregion.dw - dregion.dox, dregion.dh - dregion.doy ),
+                     point2<std::ptrdiff_t>( dregion.dox, dregion.doy ) );
 }
 
 /**
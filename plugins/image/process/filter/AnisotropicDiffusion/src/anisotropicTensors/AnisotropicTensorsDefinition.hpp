@@ -23,6 +23,8 @@ static const std::string kParamEdgeDetectAlgo( "edgeDetectAlgorithm" );
 static const std::string kParamSharpness( "sharpness" );
 static const std::string kParamAnisotropy( "anisotropy" );
 
+static const std::string kParamPyramidLevels( "pyramidLevels" );
+
 }
 }
 }
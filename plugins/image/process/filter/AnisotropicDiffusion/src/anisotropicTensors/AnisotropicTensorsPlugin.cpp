@@ -3,6 +3,8 @@
 #include "AnisotropicTensorsPluginFactory.hpp"
 #include "AnisotropicTensorsProcess.hpp"
 
+#include <imageUtils/pyramid.hpp>
+
 #include <iostream>
 #include <ofxsImageEffect.h>
 #include <ofxsMultiThread.h>
@@ -22,6 +24,7 @@ TensorsPlugin::TensorsPlugin( OfxImageEffectHandle handle )
     _paramDisplayMargin = fetchBooleanParam( kParamDisplayEffectMargin );
 	_paramAlpha = fetchDoubleParam( kParamAlpha );
 	_paramSigma = fetchDoubleParam( kParamSigma );
+	_paramPyramidLevels = fetchIntParam( kParamPyramidLevels );
 }
 
 int TensorsPlugin::getMargin()
@@ -49,7 +52,7 @@ int TensorsPlugin::getMargin()
 	}
 	int fAdd2 = ( int ) ( std::max( ( x - 1.0f ) / a, 2.0f ) );
 	// fAdd is the margin in pixels
-	int margin = fAdd1 + fAdd2;
+	int margin = fAdd1 + fAdd2 + imageUtils::pyramidMargin( _paramPyramidLevels->getValue() );
 	if( margin < 0 )
 		margin = 0;
 	return margin;
@@ -29,6 +29,7 @@ public:
 	OFX::BooleanParam *_paramDisplayMargin; ///< Display margin boolean
 	OFX::DoubleParam *_paramAlpha;
 	OFX::DoubleParam *_paramSigma;
+	OFX::IntParam *_paramPyramidLevels;
 
 	OfxRectD _renderRect; ///< Render zone
 	OfxRectD _overSizedRect; ///< Over sized render zone
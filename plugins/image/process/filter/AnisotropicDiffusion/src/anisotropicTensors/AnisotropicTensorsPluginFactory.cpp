@@ -163,6 +163,14 @@ void AnisotropicTensorsPluginFactory::describeInContext( OFX::ImageEffectDescrip
     anisotropy->setDisplayRange( 0.0, 1.0 );
     //    anisotropy->setIsSecret(true);
     anisotropy->setHint( "Smoothing anisotropy" );
+
+    OFX::IntParamDescriptor* pyramidLevels = desc.defineIntParam( kParamPyramidLevels );
+    pyramidLevels->setLabel( "Pyramid levels" );
+    pyramidLevels->setDefault( kDefaultPyramidLevels );
+    pyramidLevels->setRange( 0, kMaxPyramidLevels );
+    pyramidLevels->setDisplayRange( 0, kMaxPyramidLevels );
+    pyramidLevels->setHint( "Coarse-to-fine mode: the structure tensors are computed on the image downscaled by 2^levels "
+                            "and upsampled (0: full resolution)." );
 }
 
 /**
@@ -18,6 +18,8 @@ static const double kDefaultSigmaValue(2.0);
 static const double kDefaultGeomFactValue(1.0);
 static const double kDefaultThresholdValue(0.00001);
 static const int kDefaultTensorsAlgo(2);
+static const int kDefaultPyramidLevels(0);
+static const int kMaxPyramidLevels(4);
 
 mDeclarePluginFactory( AnisotropicTensorsPluginFactory, {}, {} );
 
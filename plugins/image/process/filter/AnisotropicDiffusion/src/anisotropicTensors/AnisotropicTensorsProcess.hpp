@@ -33,6 +33,7 @@ public:
 protected:
     TensorsPlugin& _plugin; ///< Tensor rendering plugin
     OfxRectI _upScaledSrcBounds, _dBounds;
+    OfxRectI _srcPixelRod; ///< Origin of the pyramid grid
     OFX::BooleanParam *_algorithm; ///< Generation algorithm
     OFX::ChoiceParam *_stAlgo; ///< Structure tensors algorithm
     OFX::DoubleParam *_alpha; ///< Pre-blurring (noise scale)
@@ -41,6 +42,7 @@ protected:
     OFX::DoubleParam *_anisotropy; ///< Anisotropic filtering
     OFX::DoubleParam *_geom_fact; ///< Geometry factor
     OFX::DoubleParam *_threshold; ///< Thresholding quantization factor
+    OFX::IntParam *_pyramidLevels; ///< Coarse-to-fine mode
 
 public:
 	AnisotropicTensorsProcess( TensorsPlugin &instance );
@@ -22,6 +22,7 @@ AnisotropicTensorsProcess<View>::AnisotropicTensorsProcess( TensorsPlugin &insta
     _anisotropy = instance.fetchDoubleParam( kParamAnisotropy );
     _geom_fact = instance.fetchDoubleParam( kParamGeometryFactor );
     _threshold = instance.fetchDoubleParam( kParamThresholdingQuantization );
+    _pyramidLevels = instance.fetchIntParam( kParamPyramidLevels );
 }
 
 /**
@@ -36,6 +37,7 @@ void AnisotropicTensorsProcess<View>::setup( const OFX::RenderArguments &args )
 	if( !this->_src.get( ) )
 		BOOST_THROW_EXCEPTION(exception::ImageNotReady() );
 	_upScaledSrcBounds = this->_src->getBounds();
+	_srcPixelRod = _plugin._clipSrc->getPixelRod( args.time, args.renderScale );
 
 	// fetch output image
 	this->_dst.reset( _plugin._clipDst->fetchImage( args.time ) );
@@ -81,6 +83,7 @@ void AnisotropicTensorsProcess<View>::multiThreadProcessImages( const OfxRectI&
 	params.anisotropy = _anisotropy->getValue();
 	params.geom_fact = _geom_fact->getValue();
 	params.threshold = _threshold->getValue();
+	params.pyramidLevels = _pyramidLevels->getValue();
 
 	// dest width and height
 	params.dw = procWindowRoW.x2 - procWindowRoW.x1;
@@ -94,6 +97,9 @@ void AnisotropicTensorsProcess<View>::multiThreadProcessImages( const OfxRectI&
 	srcRect.y2 = procWindowRoW.y2 + margin + 1;
 
 	srcRect = rectanglesIntersection(srcRect, _upScaledSrcBounds);
+	// all the tiles use the same pyramid grid, aligned on the RoD
+	srcRect.x1 = imageUtils::pyramidAlign( srcRect.x1, _srcPixelRod.x1, _upScaledSrcBounds.x1, params.pyramidLevels );
+	srcRect.y1 = imageUtils::pyramidAlign( srcRect.y1, _srcPixelRod.y1, _upScaledSrcBounds.y1, params.pyramidLevels );
 
 	// dest starting offset among x and y
 	params.dox = procWindowRoW.x1 - srcRect.x1;
@@ -7,6 +7,7 @@
 
 #include "filters/edgeDetect.hpp"
 #include "filters/blurFilters.hpp"
+#include "pyramid.hpp"
 
 #include <tuttle/plugin/IProgress.hpp>
 #include <terry/math.hpp>
@@ -30,7 +31,7 @@ struct tensor_t
     tensor_t( )
 	: dox(0), doy(0), dw(0), dh(0), algorithm( false ), stAlgo( 0 ),
 	alpha( 0.0 ), sigma( 0.0 ), sharpness( 0.0 ),
-	anisotropy( 0.0 ), geom_fact( 0.0 ), threshold( 0.0 ) { };
+	anisotropy( 0.0 ), geom_fact( 0.0 ), threshold( 0.0 ), pyramidLevels( 0 ) { };
 	int dox, doy, dw, dh;
 	bool algorithm; ///< Generation algorithm
 	int  stAlgo; ///< Structure tensors algorithm
@@ -40,6 +41,7 @@ struct tensor_t
 	double anisotropy; ///< Anisotropic filtering
 	double geom_fact; ///< Geometry factor
 	double threshold; ///< Thresholding quantization factor
+	int pyramidLevels; ///< Structure tensors computed on the image downscaled by 2^pyramidLevels
 };
 
 /** 
@@ -177,13 +179,27 @@ void ImageTensors<View>::anisotropic_gradient( const View & src, tuttle::plugin:
     std::vector<double> vec( 4 );
     View & dst = *( View* )this;
 
+    // Coarse-to-fine: structure tensors are computed on a level of the
+    // gaussian pyramid, with the blurs scaled to this level
+    const int levels = args->pyramidLevels;
+    const float levelScale = float( 1 << levels );
+    image_t coarseSrc;
+    View work = src;
+    if( levels > 0 )
+    {
+        buildPyramidLevel( src, levels, coarseSrc );
+        work = view( coarseSrc );
+        alpha /= levelScale;
+        sigma /= levelScale;
+    }
+
     progress->progressBegin( 5 * 25, "Tensors generator algorithm in progress" );
-	image_t tmp1( src.dimensions() );
-	image_t tmp2( src.dimensions() );
+	image_t tmp1( work.dimensions() );
+	image_t tmp2( work.dimensions() );
     View tmpv1( view( tmp1 ) );
     View tmpv2( view( tmp2 ) );
     // Apply pre-blur (attenuate noise effect in tensors map)
-    dericheFilter( src, tmpv1, alpha );
+    dericheFilter( work, tmpv1, alpha );
     if( progress->progressForward( 25 ) )
         return;
 
@@ -226,18 +242,35 @@ void ImageTensors<View>::anisotropic_gradient( const View & src, tuttle::plugin:
     if( progress->progressForward( 25 ) )
         return;
 
+    // Structure tensors of the destination region.
+    // Back to full resolution, the gradients of the pyramid level are
+    // levelScale times bigger, so the structure tensors levelScale^2 times.
+    image_t fullTensors;
+    View tensors;
+    if( levels > 0 )
+    {
+        fullTensors.recreate( args->dw - args->dox, args->dh - args->doy );
+        tensors = view( fullTensors );
+        pyramidUp( tmpv2, levels, tensors,
+                   point2<std::ptrdiff_t>( args->dox, args->doy ),
+                   1.0f / ( levelScale * levelScale ) );
+    }
+    else
+    {
+        tensors = subimage_view( tmpv2, args->dox, args->doy, args->dw - args->dox, args->dh - args->doy );
+    }
+
     // Compute diffusion tensors (gaussian kernel directions map).
     if( tensorAlgo == false )
     {
         const float step = 25 / (args->dh - args->doy);
-		for( int y = args->doy; y < args->dh; ++y )
+		for( int y = 0; y < tensors.height(); ++y )
         {
-            iterator src_it = tmpv2.row_begin( y );
-			iterator dst_it = this->row_begin( y - args->doy );
+            iterator src_it = tensors.row_begin( y );
+			iterator dst_it = this->row_begin( y );
             if( progress->progressForward( ( int ) step ) )
                 return;
-			src_it += args->dox;
-			for( int x = args->dox; x < args->dw; ++x )
+			for( int x = 0; x < tensors.width(); ++x )
             {
                 // eigen value and vectors gives strength and direction of
                 // the vectors for the gaussian kernel.
@@ -252,7 +285,7 @@ void ImageTensors<View>::anisotropic_gradient( const View & src, tuttle::plugin:
     }
     else
     {
-        copy_pixels( subimage_view(tmpv2, args->dox, args->doy, dst.width(), dst.height()), dst );
+        copy_pixels( tensors, dst );
     }
 }
 
@@ -0,0 +1,250 @@
+/**
+ * @brief This file provides the gaussian pyramid functions used by the
+ *        coarse-to-fine mode of the anisotropic filters.
+ */
+#ifndef _TUTTLE_PLUGIN_IMAGEUTILS_PYRAMID_HPP_
+#define _TUTTLE_PLUGIN_IMAGEUTILS_PYRAMID_HPP_
+
+#include <terry/globals.hpp>
+
+#include <boost/gil/gil_all.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace tuttle {
+namespace imageUtils {
+
+namespace bgil = boost::gil;
+
+/**
+ * @brief Margin needed around a region by the pyramid filters
+ * (decimation and upsampling) at a pyramid level.
+ */
+inline int pyramidMargin( const int level )
+{
+	return level > 0 ? 3 << level : 0;
+}
+
+/**
+ * @brief Size of a dimension at a pyramid level.
+ */
+inline std::ptrdiff_t pyramidLevelSize( std::ptrdiff_t size, const int level )
+{
+	for( int i = 0; i < level; ++i )
+		size = ( size + 1 ) / 2;
+	return size;
+}
+
+/**
+ * @brief First coordinate of a region aligned on the pyramid grid of the RoD,
+ * so that all the tiles use the same coarse pixels (no seam between the tiles).
+ *
+ * @param[in]  x       first coordinate of the region
+ * @param[in]  origin  first coordinate of the RoD
+ * @param[in]  min     first coordinate available in the source
+ * @param[in]  level   pyramid level
+ */
+inline int pyramidAlign( const int x, const int origin, const int min, const int level )
+{
+	const int step = 1 << level;
+	int phase = ( x - origin ) % step;
+	if( phase < 0 )
+		phase += step;
+	const int aligned = x - phase;
+	// the margin contains the pyramid filters support, we can loose a few pixels of it
+	return aligned < min ? aligned + step : aligned;
+}
+
+template<typename Channel>
+inline Channel pyramidChannelCast( const float v )
+{
+	if( boost::is_integral<Channel>::value )
+		return static_cast<Channel>( std::floor( v + 0.5f ) );
+	return static_cast<Channel>( v );
+}
+
+/**
+ * @brief Half resolution image: separable binomial filter [1 2 1]/4 and decimation.
+ * The coarse pixel x is centered on the fine pixel 2x, borders are clamped.
+ *
+ * @param[in]   src  fine image
+ * @param[out]  dst  coarse image, of size ( (w+1)/2, (h+1)/2 )
+ */
+template<class SView, class DView>
+void pyramidDown( const SView& src, const DView& dst )
+{
+	typedef typename bgil::channel_type<DView>::type DChannel;
+	static const int nc = bgil::num_channels<DView>::value;
+	const int w = src.width();
+	const int h = src.height();
+
+	std::vector<float> row( w * nc );
+	for( int yd = 0; yd < dst.height(); ++yd )
+	{
+		// vertical filter
+		const int y = 2 * yd;
+		typename SView::x_iterator up     = src.row_begin( std::max( y - 1, 0 ) );
+		typename SView::x_iterator center = src.row_begin( std::min( y, h - 1 ) );
+		typename SView::x_iterator down   = src.row_begin( std::min( y + 1, h - 1 ) );
+		for( int x = 0; x < w; ++x )
+			for( int c = 0; c < nc; ++c )
+				row[x * nc + c] = 0.25f * ( float( up[x][c] ) + float( down[x][c] ) ) + 0.5f * float( center[x][c] );
+
+		// horizontal filter and decimation
+		typename DView::x_iterator d = dst.row_begin( yd );
+		for( int xd = 0; xd < dst.width(); ++xd, ++d )
+		{
+			const int x = 2 * xd;
+			const float* left  = &row[std::max( x - 1, 0 ) * nc];
+			const float* mid   = &row[std::min( x, w - 1 ) * nc];
+			const float* right = &row[std::min( x + 1, w - 1 ) * nc];
+			for( int c = 0; c < nc; ++c )
+				( *d )[c] = pyramidChannelCast<DChannel>( 0.25f * ( left[c] + right[c] ) + 0.5f * mid[c] );
+		}
+	}
+}
+
+/**
+ * @brief Image at a pyramid level, by successive decimations.
+ */
+template<class View, class Image>
+void buildPyramidLevel( const View& src, const int level, Image& dst )
+{
+	dst.recreate( src.dimensions() );
+	bgil::copy_pixels( src, bgil::view( dst ) );
+	for( int i = 0; i < level; ++i )
+	{
+		Image coarse( ( dst.width() + 1 ) / 2, ( dst.height() + 1 ) / 2 );
+		pyramidDown( bgil::const_view( dst ), bgil::view( coarse ) );
+		dst.swap( coarse );
+	}
+}
+
+/**
+ * @brief Bilinear upsampling of a pyramid level.
+ *
+ * @param[in]   coarse      image at the pyramid level
+ * @param[in]   level       pyramid level of the coarse image
+ * @param[out]  dst         full resolution region
+ * @param[in]   dstOffset   position of the region in the full resolution image
+ * @param[in]   multiplier  applied to the values
+ */
+template<class SView, class DView>
+void pyramidUp( const SView& coarse, const int level, const DView& dst, const bgil::point2<std::ptrdiff_t>& dstOffset, const float multiplier = 1.0f )
+{
+	typedef typename bgil::channel_type<DView>::type DChannel;
+	static const int nc = bgil::num_channels<DView>::value;
+	const float scale = 1.0f / ( 1 << level );
+	const int cw = coarse.width();
+	const int ch = coarse.height();
+
+	for( int y = 0; y < dst.height(); ++y )
+	{
+		const float cy = std::min( ( y + dstOffset.y ) * scale, float( ch - 1 ) );
+		const int y0 = static_cast<int>( cy );
+		const int y1 = std::min( y0 + 1, ch - 1 );
+		const float fy = cy - y0;
+		typename DView::x_iterator d = dst.row_begin( y );
+		for( int x = 0; x < dst.width(); ++x, ++d )
+		{
+			const float cx = std::min( ( x + dstOffset.x ) * scale, float( cw - 1 ) );
+			const int x0 = static_cast<int>( cx );
+			const int x1 = std::min( x0 + 1, cw - 1 );
+			const float fx = cx - x0;
+			for( int c = 0; c < nc; ++c )
+			{
+				const float top    = float( coarse( x0, y0 )[c] ) + fx * ( float( coarse( x1, y0 )[c] ) - float( coarse( x0, y0 )[c] ) );
+				const float bottom = float( coarse( x0, y1 )[c] ) + fx * ( float( coarse( x1, y1 )[c] ) - float( coarse( x0, y1 )[c] ) );
+				( *d )[c] = pyramidChannelCast<DChannel>( multiplier * ( top + fy * ( bottom - top ) ) );
+			}
+		}
+	}
+}
+
+/**
+ * @brief Joint bilateral upsampling of a pyramid level (Kopf et al. 2007).
+ *
+ * Each pixel is a mix of the 4x4 nearest coarse pixels, weighted by their
+ * distance and by the similarity between the full resolution guide and the
+ * guide at the pyramid level, so the edges of the guide are preserved.
+ *
+ * @param[in]   coarse       image at the pyramid level
+ * @param[in]   coarseGuide  guide at the pyramid level
+ * @param[in]   guide        full resolution guide
+ * @param[in]   level        pyramid level of the coarse images
+ * @param[in]   rangeSigma   similarity tolerance, relative to the maximum channel value
+ * @param[out]  dst          full resolution region
+ * @param[in]   dstOffset    position of the region in the guide
+ */
+template<class CView, class GView, class DView>
+void guidedPyramidUp( const CView& coarse, const CView& coarseGuide, const GView& guide, const int level,
+                      const float rangeSigma, const DView& dst, const bgil::point2<std::ptrdiff_t>& dstOffset )
+{
+	typedef typename bgil::channel_type<DView>::type DChannel;
+	typedef typename bgil::channel_type<GView>::type GChannel;
+	static const int nc = bgil::num_channels<DView>::value;
+	static const int ncGuide = bgil::num_channels<GView>::value < 3 ? bgil::num_channels<GView>::value : 3;
+	const float scale = 1.0f / ( 1 << level );
+	const float sigma = rangeSigma * float( bgil::channel_traits<GChannel>::max_value() );
+	const float rangeFactor = 1.0f / ( 2.0f * sigma * sigma );
+	const int cw = coarse.width();
+	const int ch = coarse.height();
+
+	float values[nc];
+	for( int y = 0; y < dst.height(); ++y )
+	{
+		const float cy = ( y + dstOffset.y ) * scale;
+		const int yc = static_cast<int>( cy );
+		typename DView::x_iterator d = dst.row_begin( y );
+		typename GView::x_iterator g = guide.row_begin( y + dstOffset.y ) + dstOffset.x;
+		for( int x = 0; x < dst.width(); ++x, ++d, ++g )
+		{
+			const float cx = ( x + dstOffset.x ) * scale;
+			const int xc = static_cast<int>( cx );
+			std::fill( values, values + nc, 0.0f );
+			float sumWeights = 0.0f;
+			float sumSpatial = 0.0f;
+			float spatialValues[nc];
+			std::fill( spatialValues, spatialValues + nc, 0.0f );
+			for( int j = std::max( yc - 1, 0 ); j <= std::min( yc + 2, ch - 1 ); ++j )
+			{
+				for( int i = std::max( xc - 1, 0 ); i <= std::min( xc + 2, cw - 1 ); ++i )
+				{
+					const float spatial = std::exp( -0.5f * ( ( i - cx ) * ( i - cx ) + ( j - cy ) * ( j - cy ) ) );
+					float dist = 0.0f;
+					for( int c = 0; c < ncGuide; ++c )
+					{
+						const float e = float( ( *g )[c] ) - float( coarseGuide( i, j )[c] );
+						dist += e * e;
+					}
+					const float weight = spatial * std::exp( -dist * rangeFactor );
+					for( int c = 0; c < nc; ++c )
+					{
+						const float v = float( coarse( i, j )[c] );
+						values[c] += weight * v;
+						spatialValues[c] += spatial * v;
+					}
+					sumWeights += weight;
+					sumSpatial += spatial;
+				}
+			}
+			// no similar coarse pixel: spatial interpolation only
+			if( sumWeights < 1e-6f * sumSpatial )
+			{
+				std::copy( spatialValues, spatialValues + nc, values );
+				sumWeights = sumSpatial;
+			}
+			for( int c = 0; c < nc; ++c )
+				( *d )[c] = pyramidChannelCast<DChannel>( values[c] / sumWeights );
+		}
+	}
+}
+
+}
+}
+
+#endif
@@ -24,6 +24,19 @@ enum EParamBorder
 	eParamBorderPadded
 };
 
+static const std::string kParamAlgorithm         = "algorithm";
+static const std::string kParamAlgorithmGaussian = "Gaussian";
+static const std::string kParamAlgorithmBox      = "Box";
+
+enum EParamAlgorithm
+{
+	eParamAlgorithmGaussian = 0,
+	eParamAlgorithmBox
+};
+
+/// below this size, the gaussian kernel is small and is used even with the box algorithm
+static const double kBoxMinSize = 25.0;
+
 static const std::string kParamGroupAdvanced = "advanced";
 static const std::string kParamNormalizedKernel = "normalizedKernel";
 static const std::string kParamKernelEpsilon = "kernelEpsilon";
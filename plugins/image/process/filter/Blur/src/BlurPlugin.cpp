@@ -15,6 +15,7 @@ BlurPlugin::BlurPlugin( OfxImageEffectHandle handle )
 {
 	_paramSize   = fetchDouble2DParam( kParamSize );
 	_paramBorder = fetchChoiceParam( kParamBorder );
+	_paramAlgorithm = fetchChoiceParam( kParamAlgorithm );
 	_paramNormalizedKernel = fetchBooleanParam( kParamNormalizedKernel );
 	_paramKernelEpsilon = fetchDoubleParam( kParamKernelEpsilon );
 }
@@ -26,12 +27,20 @@ BlurProcessParams<BlurPlugin::Scalar> BlurPlugin::getProcessParams( const OfxPoi
 	BlurProcessParams<Scalar> params;
 	params._size   = ofxToGil( _paramSize->getValue() ) * ofxToGil( renderScale  );
 	params._border = static_cast<EParamBorder>( _paramBorder->getValue() );
+	params._algorithm = static_cast<EParamAlgorithm>( _paramAlgorithm->getValue() );
 
 	const bool normalizedKernel = _paramNormalizedKernel->getValue();
 	const double kernelEpsilon = _paramKernelEpsilon->getValue();
 
 	params._gilKernelX = buildGaussian1DKernel<Scalar>( params._size.x, normalizedKernel, kernelEpsilon );
 	params._gilKernelY = buildGaussian1DKernel<Scalar>( params._size.y, normalizedKernel, kernelEpsilon );
+	if( params._algorithm == eParamAlgorithmBox )
+	{
+		if( params._size.x >= kBoxMinSize )
+			params._boxKernelX = buildBoxBlurKernel<Scalar>( params._size.x );
+		if( params._size.y >= kBoxMinSize )
+			params._boxKernelY = buildBoxBlurKernel<Scalar>( params._size.y );
+	}
 	
 	params._boundary_option = convolve_option_extend_mirror;
 	switch( params._border )
@@ -76,18 +85,18 @@ bool BlurPlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArguments&
 	switch( params._border )
 	{
 		case eParamBorderPadded:
-			rod.x1 = srcRod.x1 + params._gilKernelX.left_size();
-			rod.y1 = srcRod.y1 + params._gilKernelY.left_size();
-			rod.x2 = srcRod.x2 - params._gilKernelX.right_size();
-			rod.y2 = srcRod.y2 - params._gilKernelY.right_size();
+			rod.x1 = srcRod.x1 + params.marginX();
+			rod.y1 = srcRod.y1 + params.marginY();
+			rod.x2 = srcRod.x2 - params.marginX();
+			rod.y2 = srcRod.y2 - params.marginY();
 			return true;
 		case eParamBorderBlack:
 		case eParamBorderConstant:
 		case eParamBorderMirror:
-			rod.x1 = srcRod.x1 - params._gilKernelX.left_size();
-			rod.y1 = srcRod.y1 - params._gilKernelY.left_size();
-			rod.x2 = srcRod.x2 + params._gilKernelX.right_size();
-			rod.y2 = srcRod.y2 + params._gilKernelY.right_size();
+			rod.x1 = srcRod.x1 - params.marginX();
+			rod.y1 = srcRod.y1 - params.marginY();
+			rod.x2 = srcRod.x2 + params.marginX();
+			rod.y2 = srcRod.y2 + params.marginY();
 			return true;
 		case eParamBorderNo:
 			return false; // don't modify the source image RoD
@@ -102,10 +111,10 @@ void BlurPlugin::getRegionsOfInterest( const OFX::RegionsOfInterestArguments& ar
 	OfxRectD srcRod                  = _clipSrc->getCanonicalRod( args.time );
 
 	OfxRectD srcRoi;
-	srcRoi.x1 = srcRod.x1 - params._gilKernelX.left_size();
-	srcRoi.y1 = srcRod.y1 - params._gilKernelY.left_size();
-	srcRoi.x2 = srcRod.x2 + params._gilKernelX.right_size();
-	srcRoi.y2 = srcRod.y2 + params._gilKernelY.right_size();
+	srcRoi.x1 = srcRod.x1 - params.marginX();
+	srcRoi.y1 = srcRod.y1 - params.marginY();
+	srcRoi.x2 = srcRod.x2 + params.marginX();
+	srcRoi.y2 = srcRod.y2 + params.marginY();
 	rois.setRegionOfInterest( *_clipSrc, srcRoi );
 }
 
@@ -5,6 +5,7 @@
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
 #include <terry/filter/convolve.hpp>
+#include <terry/filter/boxBlur.hpp>
 
 #include <boost/gil/gil_all.hpp>
 
@@ -16,12 +17,20 @@ template<typename Scalar>
 struct BlurProcessParams
 {
 	typedef typename terry::filter::kernel_1d<Scalar> Kernel;
+	typedef terry::filter::box_blur_kernel BoxKernel;
 	terry::point2<double> _size;
 	EParamBorder _border;
+	EParamAlgorithm _algorithm;
 	terry::filter::convolve_boundary_option _boundary_option;
 
 	Kernel _gilKernelX;
 	Kernel _gilKernelY;
+	/// used instead of the gaussian kernels if not empty
+	BoxKernel _boxKernelX;
+	BoxKernel _boxKernelY;
+
+	std::size_t marginX() const { return _boxKernelX.size() ? _boxKernelX.left_size() : _gilKernelX.left_size(); }
+	std::size_t marginY() const { return _boxKernelY.size() ? _boxKernelY.left_size() : _gilKernelY.left_size(); }
 };
 
 /**
@@ -48,6 +57,7 @@ public:
 public:
 	OFX::Double2DParam* _paramSize;
 	OFX::ChoiceParam* _paramBorder;
+	OFX::ChoiceParam* _paramAlgorithm;
 	OFX::BooleanParam* _paramNormalizedKernel;
 	OFX::DoubleParam* _paramKernelEpsilon;
 };
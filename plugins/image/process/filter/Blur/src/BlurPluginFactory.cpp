@@ -97,6 +97,16 @@ void BlurPluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
 	border->appendOption( kParamBorderPadded );
 	border->setDefault( eParamBorderMirror );
 
+	OFX::ChoiceParamDescriptor* algorithm = desc.defineChoiceParam( kParamAlgorithm );
+	algorithm->setLabel( "Algorithm" );
+	algorithm->setHint( "Gaussian: convolution with the gaussian kernel, the cost increases with the size.\n"
+	                    "Box: successive box filters approximating the gaussian, the cost doesn't depend on the size, "
+	                    "for large blurs. The result differs from the gaussian by less than 5% of the image range on each axis. "
+	                    "Small sizes (under 25) still use the gaussian kernel." );
+	algorithm->appendOption( kParamAlgorithmGaussian );
+	algorithm->appendOption( kParamAlgorithmBox );
+	algorithm->setDefault( eParamAlgorithmGaussian );
+
 	OFX::GroupParamDescriptor* advanced = desc.defineGroupParam( kParamGroupAdvanced );
 	advanced->setLabel( "Advanced" );
 	advanced->setOpen( false );
@@ -31,6 +31,10 @@ public:
 
 	void setup( const OFX::RenderArguments& args );
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+
+private:
+	template<class KernelX, class KernelY>
+	void blur( const View& dst, const Point& proc_tl, const KernelX& kernelX, const KernelY& kernelY );
 };
 
 }
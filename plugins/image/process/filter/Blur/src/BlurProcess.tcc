@@ -2,9 +2,13 @@
 
 #include <terry/filter/gaussianKernel.hpp>
 #include <terry/filter/convolve.hpp>
+#include <terry/filter/boxBlur.hpp>
 
 #include <tuttle/plugin/memory/OfxAllocator.hpp>
 
+#include <boost/mpl/if.hpp>
+#include <boost/mpl/or.hpp>
+
 namespace tuttle {
 namespace plugin {
 namespace blur {
@@ -52,18 +56,42 @@ void BlurProcess<View>::multiThreadProcessImages( const OfxRectI& procWindowRoW
 
 	const Point proc_tl( procWindowRoW.x1 - this->_srcPixelRod.x1, procWindowRoW.y1 - this->_srcPixelRod.y1 );
 
-	if( _params._size.x == 0 )
+	if( _params._boxKernelX.size() )
+	{
+		if( _params._boxKernelY.size() )
+			blur( dst, proc_tl, _params._boxKernelX, _params._boxKernelY );
+		else
+			blur( dst, proc_tl, _params._boxKernelX, _params._gilKernelY );
+	}
+	else if( _params._boxKernelY.size() )
+		blur( dst, proc_tl, _params._gilKernelX, _params._boxKernelY );
+	else
+		blur( dst, proc_tl, _params._gilKernelX, _params._gilKernelY );
+}
+
+template<class View>
+template<class KernelX, class KernelY>
+void BlurProcess<View>::blur( const View& dst, const Point& proc_tl, const KernelX& kernelX, const KernelY& kernelY )
+{
+	using namespace terry::filter;
+	// the box filters accumulate in float, whatever the bit depth
+	typedef boost::gil::pixel<boost::gil::bits32f, typename boost::gil::layout_type<View>::type> FloatPixel;
+	typedef typename boost::mpl::if_<
+		boost::mpl::or_< is_box_blur_kernel<KernelX>, is_box_blur_kernel<KernelY> >,
+		FloatPixel, Pixel >::type PixelAccum;
+
+	if( kernelX.size() == 0 )
 	{
-		correlate_cols_auto<Pixel>( this->_srcView, _params._gilKernelY, dst, proc_tl, _params._boundary_option );
+		correlate_cols_auto<PixelAccum>( this->_srcView, kernelY, dst, proc_tl, _params._boundary_option );
 	}
-	else if( _params._size.y == 0 )
+	else if( kernelY.size() == 0 )
 	{
-		correlate_rows_auto<Pixel>( this->_srcView, _params._gilKernelX, dst, proc_tl, _params._boundary_option );
+		correlate_rows_auto<PixelAccum>( this->_srcView, kernelX, dst, proc_tl, _params._boundary_option );
 	}
 	else
 	{
-		correlate_rows_cols_auto<Pixel, OfxAllocator>(
-			this->_srcView, _params._gilKernelX, _params._gilKernelY, dst, proc_tl, _params._boundary_option );
+		correlate_rows_cols_auto<PixelAccum, OfxAllocator>(
+			this->_srcView, kernelX, kernelY, dst, proc_tl, _params._boundary_option );
 	}
 }
 
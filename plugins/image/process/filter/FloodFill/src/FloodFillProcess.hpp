@@ -2,6 +2,9 @@
 #define _TUTTLE_PLUGIN_FLOODFILL_PROCESS_HPP_
 
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
+
+#include <terry/filter/connectedComponents.hpp>
+
 #include <boost/scoped_ptr.hpp>
 
 namespace tuttle {
@@ -27,11 +30,20 @@ protected :
 	Scalar _lowerThres;
 	Scalar _upperThres;
 
+	OfxRectI _labelledRegion; ///< source pixels with all their neighbours
+	terry::filter::connected_components _components; ///< labelling of the source pixels above the lower threshold (source view coordinates)
+
 public:
     FloodFillProcess( FloodFillPlugin& effect );
 
 	void setup( const OFX::RenderArguments& args );
 
+private:
+	template<class Connexity>
+	void labelComponents();
+
+public:
+
     void multiThreadProcessImages( const OfxRectI& procWindowRoW );
 };
 
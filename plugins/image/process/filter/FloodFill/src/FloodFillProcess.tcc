@@ -4,6 +4,7 @@
 #include <tuttle/plugin/ofxToGil/point.hpp>
 #include <tuttle/plugin/numeric/rectOp.hpp>
 #include <tuttle/plugin/memory/OfxAllocator.hpp>
+#include <tuttle/plugin/ParallelLabelling.hpp>
 
 #include <terry/globals.hpp>
 #include <terry/filter/floodFill.hpp>
@@ -23,7 +24,6 @@ FloodFillProcess<View>::FloodFillProcess( FloodFillPlugin &effect )
 : ImageGilFilterProcessor<View>( effect, eImageOrientationIndependant )
 , _plugin( effect )
 {
-	this->setNoMultiThreading();
 }
 
 template<class View>
@@ -57,6 +57,42 @@ void FloodFillProcess<View>::setup( const OFX::RenderArguments& args )
 		_lowerThres = _params._lowerThres;
 		_upperThres = _params._upperThres;
 	}
+
+	if( _isConstantImage )
+		return;
+
+	// the output pixels depend on the whole image: the components are labelled here,
+	// by tiles with the SMP threads, the render threads only read them
+	switch( _params._method )
+	{
+		case eParamMethod4:
+			labelComponents<terry::filter::floodFill::Connexity4>();
+			break;
+		case eParamMethod8:
+			labelComponents<terry::filter::floodFill::Connexity8>();
+			break;
+		case eParamMethodBruteForce: // not in production
+		{
+			// no labelling: black output
+			const OfxRectI noRegion = { 0, 0, 0, 0 };
+			_labelledRegion = noRegion;
+			break;
+		}
+	}
+}
+
+template<class View>
+template<class Connexity>
+void FloodFillProcess<View>::labelComponents()
+{
+	using namespace terry::filter::floodFill;
+
+	static const unsigned int border = 1;
+	const OfxRectI srcRodCrop = rectangleReduce( this->_srcPixelRod, border );
+	_labelledRegion = rectanglesIntersection( srcRodCrop, this->_dstPixelRod );
+
+	_components.reset( ofxToGil( translateRegion( _labelledRegion, this->_srcPixelRod ) ) );
+	labelPixelsParallel<Connexity>( _components, this->_srcView, IsUpper<Scalar>(_lowerThres), IsUpper<Scalar>(_upperThres) );
 }
 
 /**
@@ -70,53 +106,20 @@ void FloodFillProcess<View>::multiThreadProcessImages( const OfxRectI& procWindo
 	using namespace terry;
 	OfxRectI procWindowOutput = this->translateRoWToOutputClipCoordinates( procWindowRoW );
 	
-	static const unsigned int border = 1;
-	const OfxRectI srcRodCrop = rectangleReduce( this->_srcPixelRod, border );
-	const OfxRectI procWindowRoWCrop = rectanglesIntersection( procWindowRoW, srcRodCrop );
-
 	terry::draw::fill_pixels( this->_dstView, ofxToGil(procWindowOutput), get_black<Pixel>() );
 
 	if( _isConstantImage )
 		return;
 
-	using namespace terry::filter::floodFill;
-	
-	switch( _params._method )
-	{
-		case eParamMethod4:
-		{
-			flood_fill<Connexity4, IsUpper<Scalar>, IsUpper<Scalar>, View, View, OfxAllocator>(
-				this->_srcView, ofxToGil(this->_srcPixelRod),
-				this->_dstView, ofxToGil(this->_dstPixelRod),
-				ofxToGil(procWindowRoWCrop),
-				IsUpper<Scalar>(_upperThres),
-				IsUpper<Scalar>(_lowerThres)
-				);
-			break;
-		}
-		case eParamMethod8:
-		{
-			flood_fill<Connexity8, IsUpper<Scalar>, IsUpper<Scalar>, View, View, OfxAllocator>(
-				this->_srcView, ofxToGil(this->_srcPixelRod),
-				this->_dstView, ofxToGil(this->_dstPixelRod),
-				ofxToGil(procWindowRoWCrop),
-				IsUpper<Scalar>(_upperThres),
-				IsUpper<Scalar>(_lowerThres)
-				);
-			break;
-		}
-		case eParamMethodBruteForce: // not in production
-		{
-//			flood_fill_bruteForce<IsUpper<Scalar>, IsUpper<Scalar>, View, View>(
-//				this->_srcView, ofxToGil(this->_srcPixelRod),
-//				this->_dstView, ofxToGil(this->_dstPixelRod),
-//				ofxToGil(procWindowRoWCrop),
-//				IsUpper<Scalar>(_upperThres),
-//				IsUpper<Scalar>(_lowerThres)
-//				);
-			break;
-		}
-	}
+	// pixels of the components connected to a pixel above the upper threshold
+	const OfxRectI procWindowRoWCrop = rectanglesIntersection( procWindowRoW, _labelledRegion );
+	if( procWindowRoWCrop.x2 <= procWindowRoWCrop.x1 || procWindowRoWCrop.y2 <= procWindowRoWCrop.y1 )
+		return;
+	const OfxRectI procWindowSrc = translateRegion( procWindowRoWCrop, this->_srcPixelRod );
+	const OfxRectI procWindowDst = translateRegion( procWindowRoWCrop, this->_dstPixelRod );
+	View dst = subimage_view( this->_dstView, procWindowDst.x1, procWindowDst.y1,
+	                                          procWindowDst.x2 - procWindowDst.x1, procWindowDst.y2 - procWindowDst.y1 );
+	_components.fill_marked( ofxToGil( procWindowSrc ), dst, get_white<Pixel>() );
 }
 
 }
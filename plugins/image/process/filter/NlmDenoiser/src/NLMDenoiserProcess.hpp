@@ -6,6 +6,7 @@
 #include <tuttle/common/utils/global.hpp>
 #include <tuttle/plugin/ImageGilProcessor.hpp>
 #include <tuttle/plugin/exceptions.hpp>
+#include <tuttle/plugin/memory/OfxAllocator.hpp>
 #include <terry/globals.hpp>
 
 #include <cmath>
@@ -43,6 +44,10 @@ class NLMDenoiserProcess
 public:
 	typedef typename View::value_type Pixel;
 	typedef typename boost::gil::channel_type<View>::type Channel;
+	/// weights accumulation buffers, allocated by the host
+	typedef boost::gil::image<boost::gil::rgba32f_pixel_t, false, OfxAllocator<unsigned char> > WeightImage;
+	/// summed area table of the squared differences between two frames
+	typedef std::vector<double, OfxAllocator<double> > IntegralImage;
 
 protected:
 	OFX::BooleanParam* _paramOptimized; ///< Perform optimization (quality++, speed+++)
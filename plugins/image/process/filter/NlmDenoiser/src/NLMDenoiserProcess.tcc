@@ -17,6 +17,7 @@
 #include <boost/gil/gil_all.hpp>
 #include <boost/scoped_ptr.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <vector>
@@ -254,8 +255,8 @@ void NLMDenoiserProcess<View>::nlMeans( View &dst, const OfxRectI & procWindow,
 	}
 
 	// Allocate average buffers (assimilate this two buffers as 2D float buffers, not images !)
-	rgba32f_image_t weight_cumul( w, h ); /// @todo: use memory allocated by host using memorySuite
-	rgba32f_image_t weight_norm( w, h );
+	WeightImage weight_cumul( w, h );
+	WeightImage weight_norm( w, h );
 	rgba32f_view_t view_wc( view( weight_cumul ) );
 	rgba32f_view_t view_norm( view( weight_norm ) );
 
@@ -302,6 +303,18 @@ void NLMDenoiserProcess<View>::nlMeans( View &dst, const OfxRectI & procWindow,
 	}
 }
 
+/**
+ * @brief Accumulate the weighted colors of the similar pixels.
+ *
+ * For each displacement of the search region, the squared differences
+ * between the two frames are summed in an integral image, so the distance
+ * between two patches is obtained with 4 reads, whatever the patch size.
+ *
+ * @param[in] srcViews  frames (the current frame first), cropped to the upscaled process window
+ * @param[in] procWindow  process window in the source views
+ * @param[out] view_wc  sum of the weighted colors
+ * @param[out] view_norm  sum of the weights
+ */
 template<class View>
 void NLMDenoiserProcess<View>::computeWeights( const std::vector<View> & srcViews,
 											   const OfxRectI & procWindow,
@@ -311,9 +324,6 @@ void NLMDenoiserProcess<View>::computeWeights( const std::vector<View> & srcView
 {
 	typedef typename View::x_iterator sIterator;
 	typedef typename bgil::rgba32f_view_t::x_iterator wIterator;
-	typedef typename bgil::channel_type<View>::type dpix_t;
-	typedef typename View::locator Loc;
-	typedef typename bgil::rgba32f_view_t::locator WLoc;
 
 	const int patchRadius = params.patchRadius;
 	const int depth = srcViews.size();
@@ -324,8 +334,6 @@ void NLMDenoiserProcess<View>::computeWeights( const std::vector<View> & srcView
 	// Noise variance estimation
 	const double nv = imageUtils::noise_variance( srcViews[0] );
 	const double sigma = std::sqrt( nv < 0 ? 0 : nv );
-	Loc loc1, loc2;
-	WLoc wcLoc, wnLoc;
 
 	// Optimisation based on: AN IMPROVED NON-LOCAL DENOISING ALGORITHM, LNLA 2008
 	// Define the size of the neighborhood
@@ -338,7 +346,6 @@ void NLMDenoiserProcess<View>::computeWeights( const std::vector<View> & srcView
 	{
 		bws[i] = params.bws[i];
 	}
-	int lbound, hbound;
 	// [Kervrann] notations
 	std::vector<double> h1( nc );
 	std::vector<double> h2( nc );
@@ -350,8 +357,17 @@ void NLMDenoiserProcess<View>::computeWeights( const std::vector<View> & srcView
 		h1[i] = bws[i] * sigma;
 		h2[i] = 1.0 / ( h1[i] * h1[i] );
 	}
+	const double maxDist = *std::max_element( h1.begin(), h1.end() );
 
-	double abs_e, eucl_dist, weigth, e;
+	// Area covered by the patches of the process window
+	const int ax1 = std::max( procWindow.x1 - patchRadius, 0 );
+	const int ay1 = std::max( procWindow.y1 - patchRadius, 0 );
+	const int ax2 = std::min( procWindow.x2 + patchRadius, wi );
+	const int ay2 = std::min( procWindow.y2 + patchRadius, hi );
+	const std::ptrdiff_t stride = ax2 - ax1 + 1;
+
+	// integral( x, y ) is the sum of the squared differences in [ax1, ax1+x[ x [ay1, ay1+y[
+	IntegralImage integral( stride * ( ay2 - ay1 + 1 ), 0.0 );
 
 	// For zi (displacment)
 	for( int zi = 0; zi < depth; ++zi )
@@ -362,132 +378,77 @@ void NLMDenoiserProcess<View>::computeWeights( const std::vector<View> & srcView
 			// For xi (displacment)
 			for( int xi = -min_xpi; xi <= min_xpi; ++xi )
 			{
-				// If not 0 displacment
-				if( xi != 0 || yi != 0 )
+				// The pixel itself is added with the weight 1 in the final estimate
+				if( zi != 0 || xi != 0 || yi != 0 )
 				{
-					const int xl = xi < 0 ? std::abs( xi ) : 0;
-					const int xh = wi + xi > wi ? wi - xi : wi;
-					const int yl = yi < 0 ? std::abs( yi ) : 0;
-					const int yh = hi + yi > hi ? hi - yi : hi;
+					// Pixels with a displaced pixel inside the frame,
+					// the others don't contribute to the patch distances
+					const int xl = std::max( ax1, -xi );
+					const int xh = std::min( ax2, wi - xi );
 
-					// For yj
-					for( int yj = yl; yj < yh; ++yj )
+					for( int y = ay1; y < ay2; ++y )
 					{
-						// Initialize patch euclidian distance
-						eucl_dist = 0.0f;
-						int j = yj + yi;
-						// Horizontal & vertical averaging bounds
-						if( yi >= 0 )
+						const double* above = &integral[( y - ay1 ) * stride];
+						double* current = &integral[( y - ay1 + 1 ) * stride];
+						double rowSum = 0.0;
+						current[0] = 0.0;
+						if( y + yi < 0 || y + yi >= hi || xl >= xh )
 						{
-							lbound = -patchRadius + yj < 0 ? std::max( -yj, -patchRadius ) : -patchRadius;
-							hbound = lbound + ( patchRadius * 2 + 1 );
-							if( hbound + j > hi )
-								hbound = std::min( hi - j, patchRadius );
+							std::copy( above + 1, above + stride, current + 1 );
+							continue;
 						}
-						else
+						sIterator s0 = srcViews[0].row_begin( y );
+						sIterator s1 = srcViews[zi].row_begin( y + yi );
+						for( int x = ax1; x < ax2; ++x )
 						{
-							hbound = patchRadius + yj > hi ? std::min( patchRadius, ( hi - yj ) ) : patchRadius;
-							lbound = hbound - ( patchRadius * 2 + 1 );
-							if( lbound + j < 0 )
-								lbound = 0;
-						}
-
-						// Warmup: initial average accumulation
-						int xl_bound = std::max( xl - patchRadius, 0 );
-						int xr_bound = std::min( wi, xl_bound + patchRadius * 2 );
-						loc1 = srcViews[zi].xy_at( xi, j );
-						loc2 = srcViews[ 0].xy_at( 0, yj );
-						for( int xj = xl_bound; xj < xr_bound; ++xj )
-						{
-							// following "if" is bad but simplify the code
-							if( ( xj + xi ) >= 0 )
+							if( x >= xl && x < xh )
 							{
-								for( int k = lbound; k < hbound; ++k )
+								for( int v = 0; v < nc; ++v )
 								{
-									for( int v = 0; v < nc; ++v )
-									{
-										e = loc1( xj, k )[v] - loc2( xj, k )[v];
-										eucl_dist += e * e;
-									}
+									const double e = double( s0[x][v] ) - double( s1[x + xi][v] );
+									rowSum += e * e;
 								}
 							}
+							current[x - ax1 + 1] = above[x - ax1 + 1] + rowSum;
 						}
+					}
 
-						// For xj
-						for( int xj = xl; xj < xh; ++xj )
+					// Weight computation (Modified Bisquare weightening function)
+					const int yl = std::max( procWindow.y1, -yi );
+					const int yh = std::min( procWindow.y2, hi - yi );
+					const int pxl = std::max( procWindow.x1, -xi );
+					const int pxh = std::min( procWindow.x2, wi - xi );
+					for( int yj = yl; yj < yh; ++yj )
+					{
+						const double* top = &integral[( std::max( yj - patchRadius, ay1 ) - ay1 ) * stride];
+						const double* bottom = &integral[( std::min( yj + patchRadius + 1, ay2 ) - ay1 ) * stride];
+						sIterator s1 = srcViews[zi].row_begin( yj + yi );
+						wIterator wcIt = view_wc.row_begin( yj - procWindow.y1 );
+						wIterator wnIt = view_norm.row_begin( yj - procWindow.y1 );
+						for( int xj = pxl; xj < pxh; ++xj )
 						{
-							int i = xj + xi;
-
-							loc1 = srcViews[zi].xy_at( i, j );
-							loc2 = srcViews[0].xy_at( xj, yj );
-
-							// 2D centered patch sliding average
-							if( patchRadius + i < wi && patchRadius + xj < wi )
+							const int left = std::max( xj - patchRadius, ax1 ) - ax1;
+							const int right = std::min( xj + patchRadius + 1, ax2 ) - ax1;
+							const double eucl_dist = bottom[right] - bottom[left] - top[right] + top[left];
+							if( eucl_dist > maxDist )
+								continue;
+							for( int v = 0; v < nc; ++v )
 							{
-								for( int k = lbound; k < hbound; ++k )
+								if( eucl_dist <= h1[v] )
 								{
-									for( int v = 0; v < nc; ++v )
-									{
-										e = loc1( patchRadius, k )[v] - loc2( patchRadius, k )[v];
-										eucl_dist += e * e;
-									}
+									double weigth = 1.0 - ( eucl_dist * eucl_dist * h2[v] );
+									// Powerize to 8
+									weigth *= weigth;
+									weigth *= weigth;
+									weigth *= weigth;
+
+									// Weight accumulation
+									wcIt[xj - procWindow.x1][v] += weigth * s1[xj + xi][v];
+									wnIt[xj - procWindow.x1][v] += weigth;
 								}
 							}
-
-							if( xj - patchRadius - 1 >= 0 && i - patchRadius - 1 >= 0 )
-							{
-								for( int k = lbound; k < hbound; ++k )
-								{
-									for( int v = 0; v < nc; ++v )
-									{
-										e = loc1( -patchRadius - 1, k )[v] - loc2( -patchRadius - 1, k )[v];
-										eucl_dist -= e * e;
-									}
-								}
-							}
-
-							// Symetric weigthening will be computed
-							bool w1Pass = ( zi == 0 && i >= procWindow.x1 && i < procWindow.x2 &&
-										 j >= procWindow.y1 && j < procWindow.y2 );
-
-							// Weigthening will be computed
-							bool w2Pass = ( xj >= procWindow.x1 && xj < procWindow.x2 &&
-										 yj >= procWindow.y1 && yj < procWindow.y2 );
-
-							// Weight computation (Modified Bisquare weightening function)
-							if( w1Pass || w2Pass )
-							{
-								wcLoc = view_wc.xy_at( xj - procWindow.x1, yj - procWindow.y1 );
-								wnLoc = view_norm.xy_at( xj - procWindow.x1, yj - procWindow.y1 );
-
-								abs_e = std::abs( eucl_dist );
-								for( int v = 0; v < nc; ++v )
-								{
-									if( abs_e <= h1[v] )
-									{
-										weigth = 1.0 - ( abs_e * abs_e * h2[v] );
-										// Powerize to 8
-										weigth *= weigth;
-										weigth *= weigth;
-										weigth *= weigth;
-
-										// Weight accumulation
-										if( w1Pass )
-										{
-											wcLoc( xi, yi )[v] += weigth * loc2( 0, 0 )[v];
-											wnLoc( xi, yi )[v] += weigth;
-										}
-										if( w2Pass )
-										{
-											// Symmetry
-											wcLoc( 0, 0 )[v] += weigth * loc1( 0, 0 )[v];
-											wnLoc( 0, 0 )[v] += weigth;
-										}
-									}
-								}
-							}
-						} // End for xj
-					} // End for yj
+						}
+					}
 				} // End if not 0 displacment
 				if( this->progressForward( 1 ) ) /// @todo what is the step here ??
 					return;
@@ -2,6 +2,7 @@
 #include "CropPlugin.hpp"
 #include "CropProcess.hpp"
 
+#include <tuttle/plugin/numeric/rectOp.hpp>
 #include <tuttle/plugin/ofxToGil/point.hpp>
 
 #include <boost/gil/gil_all.hpp>
@@ -396,6 +397,28 @@ namespace tuttle
         return false;
       }
 
+      /**
+       * @brief Inside the crop region, the output is the source image
+       * (the host checks that the render window is inside the source image).
+       */
+      bool
+      CropPlugin::getInputView(const OFX::RenderArguments& args,
+          OFX::Clip*& viewClip, double& viewTime, OfxPointI& offset, bool& flip)
+      {
+        CropProcessParams<rgba32f_pixel_t> params = getProcessParams<
+            rgba32f_pixel_t>(args.time, args.renderScale);
+
+        if (!rectangleAContainsB(params._cropRegion, args.renderWindow))
+          return false;
+
+        viewClip = _clipSrc;
+        viewTime = args.time;
+        offset.x = 0;
+        offset.y = 0;
+        flip = false;
+        return true;
+      }
+
       /**
        * @brief The overridden render function
        * @param[in]   args     Rendering parameters
@@ -37,6 +37,7 @@ public:
 	void         changedClip( const OFX::InstanceChangedArgs& args, const std::string& clipName );
 	void         changedParam( const OFX::InstanceChangedArgs& args, const std::string& paramName );
 	bool         getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod );
+	bool         getInputView( const OFX::RenderArguments& args, OFX::Clip*& viewClip, double& viewTime, OfxPointI& offset, bool& flip );
 	
 	void render( const OFX::RenderArguments& args );
 
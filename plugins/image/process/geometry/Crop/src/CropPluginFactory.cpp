@@ -39,6 +39,7 @@ void CropPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
 
 	// plugin flags
 	desc.setSupportsTiles( kSupportTiles );
+	desc.setSupportsInputView( true );
 	desc.setRenderThreadSafety( OFX::eRenderFullySafe );
 
 	desc.setOverlayInteractDescriptor( new OFX::DefaultEffectOverlayWrap<CropEffectOverlay>() );
@@ -63,6 +63,26 @@ bool FlipPlugin::isIdentity( const OFX::RenderArguments& args, OFX::Clip*& ident
 	return true;
 }
 
+/**
+ * @brief A flip only is the source image read from top to bottom.
+ * A flop can't be a view (rows are read from left to right), so it is rendered.
+ */
+bool FlipPlugin::getInputView( const OFX::RenderArguments& args, OFX::Clip*& viewClip, double& viewTime, OfxPointI& offset, bool& flip )
+{
+	FlipProcessParams params = getProcessParams( args.time, args.renderScale );
+	if( ! params.flip || params.flop )
+		return false;
+
+	// same center as the process: the center of the source RoD
+	const OfxRectI srcPixelRod = _clipSrc->getPixelRod( args.time, args.renderScale );
+	viewClip = _clipSrc;
+	viewTime = args.time;
+	offset.x = 0;
+	offset.y = srcPixelRod.y1 + srcPixelRod.y2 - 1;
+	flip = true;
+	return true;
+}
+
 /**
  * @brief The overridden render function
  * @param[in]   args     Rendering parameters
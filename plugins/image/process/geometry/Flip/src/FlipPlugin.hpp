@@ -33,6 +33,7 @@ public:
 	OfxRectI computeFlipRegion( const OfxTime time, const bool fromRatio = false ) const;
 	void getRegionsOfInterest( const OFX::RegionsOfInterestArguments& args, OFX::RegionOfInterestSetter& rois );
 	bool isIdentity( const OFX::RenderArguments& args, OFX::Clip*& identityClip, double& identityTime );
+	bool getInputView( const OFX::RenderArguments& args, OFX::Clip*& viewClip, double& viewTime, OfxPointI& offset, bool& flip );
 
 	void render( const OFX::RenderArguments& args );
 
@@ -37,6 +37,7 @@ void FlipPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
 
 	// plugin flags
 	desc.setSupportsTiles( kSupportTiles );
+	desc.setSupportsInputView( true );
 	desc.setRenderThreadSafety( OFX::eRenderFullySafe );
 }
 
@@ -9,16 +9,51 @@
 #include <ofxsMultiThread.h>
 #include <ofxsParam.h>
 
+#include <boost/make_shared.hpp>
+
+#include <iomanip>
+#include <sstream>
+
 namespace tuttle {
 namespace plugin {
 namespace lens {
 
+namespace {
+
+/**
+ * @brief Evaluate the rows of a coordinates map with the SMP threads of the host.
+ */
+class CoordinatesMapProcessor : public OFX::MultiThread::Processor
+{
+public:
+	CoordinatesMapProcessor( const EParamLensType lensType, const LensDistortProcessParams<double>& params, terry::sampler::coordinates_map& map )
+		: _lensType( lensType )
+		, _params( params )
+		, _map( map )
+	{}
+
+	void multiThreadFunction( const unsigned int threadId, const unsigned int nThreads )
+	{
+		const terry::Rect<std::ssize_t>& region = _map.region();
+		const std::ssize_t height = region.y2 - region.y1;
+		computeCoordinatesMap( _lensType, _params, _map, region.y1 + threadId * height / nThreads, region.y1 + ( threadId + 1 ) * height / nThreads );
+	}
+
+private:
+	const EParamLensType _lensType;
+	const LensDistortProcessParams<double>& _params;
+	terry::sampler::coordinates_map& _map;
+};
+
+}
+
 OfxRectD LensDistortPlugin::_dstRoi     = { 0, 0, 0, 0 };
 OfxRectD LensDistortPlugin::_srcRoi     = { 0, 0, 0, 0 };
 OfxRectD LensDistortPlugin::_srcRealRoi = { 0, 0, 0, 0 };
 
 LensDistortPlugin::LensDistortPlugin( OfxImageEffectHandle handle )
 	: SamplerPlugin( handle )
+	, _coordinatesMapMutex( 0 )
 {
 	_srcRefClip = fetchClip( kClipOptionalSourceRef );
 
@@ -397,10 +432,44 @@ LensDistortParams LensDistortPlugin::getProcessParams(  ) const
 
 	lensDistortParams._lensType          = (tuttle::plugin::lens::EParamLensType)   _lensType        -> getValue();
 	lensDistortParams._centerType        = (tuttle::plugin::lens::EParamCenterType) _centerType      -> getValue();
+	lensDistortParams._lensAnimated      = isLensAnimated();
 
 	return lensDistortParams;
 }
 
+bool LensDistortPlugin::isLensAnimated() const
+{
+	return _coef1->getNumKeys() || _coef2->getNumKeys() || _squeeze->getNumKeys() || _asymmetric->getNumKeys() ||
+	       _center->getNumKeys() || _preScale->getNumKeys() || _postScale->getNumKeys();
+}
+
+LensDistortPlugin::CoordinatesMapPtr LensDistortPlugin::getCoordinatesMap( const EParamLensType lensType, const LensDistortProcessParams<Scalar>& params, const std::ptrdiff_t width, const std::ptrdiff_t height )
+{
+	std::ostringstream key;
+	key << std::setprecision( 17 )
+	    << lensType << "|" << params._distort << "|" << params._coef1 << "|" << params._coef2 << "|"
+	    << params._squeeze << "|" << params._asymmetric.x << "|" << params._asymmetric.y << "|"
+	    << params._preScale.x << "|" << params._preScale.y << "|" << params._postScale.x << "|" << params._postScale.y << "|"
+	    << params._lensCenterSrc.x << "|" << params._lensCenterSrc.y << "|" << params._lensCenterDst.x << "|" << params._lensCenterDst.y << "|"
+	    << params._imgSizeSrc.x << "|" << params._imgSizeSrc.y << "|" << params._imgCenterSrc.x << "|" << params._imgCenterSrc.y << "|"
+	    << params._imgCenterDst.x << "|" << params._imgCenterDst.y << "|" << params._imgHalfDiagonal << "|" << params._pixelRatio << "|"
+	    << width << "x" << height;
+
+	OFX::MultiThread::AutoMutex lock( _coordinatesMapMutex );
+	if( _coordinatesMap && _coordinatesMapKey == key.str() )
+		return _coordinatesMap;
+
+	_coordinatesMap.reset(); // released before the allocation of the new one
+	boost::shared_ptr<terry::sampler::coordinates_map> map = boost::make_shared<terry::sampler::coordinates_map>();
+	map->reset( terry::Rect<std::ssize_t>( 0, 0, width, height ) );
+	CoordinatesMapProcessor processor( lensType, params, *map );
+	processor.multiThread();
+
+	_coordinatesMap    = map;
+	_coordinatesMapKey = key.str();
+	return _coordinatesMap;
+}
+
 }
 }
 }
@@ -7,9 +7,18 @@
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 #include <tuttle/plugin/context/SamplerPlugin.hpp>
 
+#include <ofxsMultiThread.h>
+
 #include <boost/gil/utilities.hpp>
+#include <boost/shared_ptr.hpp>
 #include <string>
 
+namespace terry {
+namespace sampler {
+class coordinates_map;
+}
+}
+
 namespace tuttle {
 namespace plugin {
 namespace lens {
@@ -18,6 +27,7 @@ struct LensDistortParams
 {
 	EParamLensType                             _lensType;
 	EParamCenterType                           _centerType;
+	bool                                       _lensAnimated; ///< the transformation changes over time
 
 	SamplerProcessParams                       _samplerProcessParams;
 };
@@ -30,6 +40,7 @@ class LensDistortPlugin : public SamplerPlugin
 public:
 	typedef double Scalar;
 	typedef boost::gil::point2<double> Point2;
+	typedef boost::shared_ptr<const terry::sampler::coordinates_map> CoordinatesMapPtr;
 
 public:
 	///@{
@@ -93,12 +104,24 @@ public:
 
 	LensDistortParams                    getProcessParams( ) const ;
 
+	/**
+	 * @brief Source coordinates of the destination pixels [0,width)x[0,height),
+	 * computed once and reused while the transformation and the size don't change.
+	 */
+	CoordinatesMapPtr getCoordinatesMap( const EParamLensType lensType, const LensDistortProcessParams<Scalar>& params, const std::ptrdiff_t width, const std::ptrdiff_t height );
+
 	const EParamLensType                 getLensType  () const     { return static_cast<EParamLensType     >( _lensType->getValue()      ); }
 	const EParamCenterType               getCenterType() const    { return static_cast<EParamCenterType   >( _centerType->getValue()    ); }
 	const EParamResizeRod                getResizeRod () const    { return static_cast<EParamResizeRod    >( _resizeRod->getValue()     ); }
 
 private:
 	void initParamsProps();
+	bool isLensAnimated() const;
+
+private:
+	OFX::MultiThread::Mutex _coordinatesMapMutex;
+	CoordinatesMapPtr _coordinatesMap;
+	std::string _coordinatesMapKey;
 };
 
 }
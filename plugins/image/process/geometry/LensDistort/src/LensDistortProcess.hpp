@@ -33,6 +33,7 @@ protected:
 	LensDistortProcessParams<Scalar> _p;
 
 	LensDistortParams                _params;
+	LensDistortPlugin::CoordinatesMapPtr _coordinatesMap; ///< shared by the renders while the lens doesn't change
 
 public:
 	LensDistortProcess( LensDistortPlugin& instance );
@@ -4,7 +4,7 @@
 #include <tuttle/plugin/numeric/rectOp.hpp>
 #include <tuttle/plugin/ofxToGil/rect.hpp>
 
-#include <terry/sampler/resample_progress.hpp>
+#include <terry/sampler/resample_map.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -34,6 +34,10 @@ void LensDistortProcess<View>::setup( const OFX::RenderArguments& args )
 	{
 		_p = _plugin.getProcessParams( srcRod, dstRod, this->_clipDst->getPixelAspectRatio() );
 	}
+
+	// if the lens is animated, each tile computes its own coordinates
+	if( ! _params._lensAnimated )
+		_coordinatesMap = _plugin.getCoordinatesMap( _params._lensType, _p, this->_dstView.width(), this->_dstView.height() );
 }
 
 /**
@@ -144,39 +148,15 @@ void LensDistortProcess<View>::lensDistort( View& srcView, View& dstView, const
 	using namespace terry::sampler;
 	EParamFilterOutOfImage outOfImageProcess = _params._samplerProcessParams._outOfImageProcess;
 	terry::Rect<std::ssize_t> procWin = ofxToGil(procWindow);
-	switch( _params._lensType )
+	if( _coordinatesMap && _coordinatesMap->contains( procWin ) )
 	{
-		case eParamLensTypeStandard:
-		{
-			if( _p._distort )
-			{
-				resample_pixels_progress( srcView, dstView, static_cast<NormalLensDistortParams<double>&>( _p ), procWin, outOfImageProcess, this->getOfxProgress(), sampler );
-			}
-			else
-			{
-				resample_pixels_progress( srcView, dstView, static_cast<NormalLensUndistortParams<double>&>( _p ), procWin, outOfImageProcess,  this->getOfxProgress(), sampler );
-			}
-			return;
-		}
-		case eParamLensTypeFisheye:
-		{
-			if( _p._distort )
-				resample_pixels_progress( srcView, dstView, static_cast<FisheyeLensDistortParams<double>&>( _p ), procWin, outOfImageProcess,  this->getOfxProgress(), sampler );
-			else
-				resample_pixels_progress( srcView, dstView, static_cast<FisheyeLensUndistortParams<double>&>( _p ), procWin, outOfImageProcess,  this->getOfxProgress(), sampler );
-			return;
-		}
-		case eParamLensTypeAdvanced:
-		{
-			if( _p._distort )
-				resample_pixels_progress( srcView, dstView, static_cast<AdvancedLensDistortParams<double>&>( _p ), procWin, outOfImageProcess,  this->getOfxProgress(), sampler );
-			else
-				resample_pixels_progress( srcView, dstView, static_cast<AdvancedLensUndistortParams<double>&>( _p ), procWin, outOfImageProcess,  this->getOfxProgress(), sampler );
-			return;
-		}
+		resample_pixels_map( srcView, dstView, *_coordinatesMap, procWin, outOfImageProcess, this->getOfxProgress(), sampler );
+		return;
 	}
-	BOOST_THROW_EXCEPTION( exception::Bug()
-		<< exception::user( "Lens type not recognize." ) );
+	coordinates_map tileMap;
+	tileMap.reset( procWin );
+	computeCoordinatesMap( _params._lensType, _p, tileMap, procWin.y1, procWin.y2 );
+	resample_pixels_map( srcView, dstView, tileMap, procWin, outOfImageProcess, this->getOfxProgress(), sampler );
 }
 
 }
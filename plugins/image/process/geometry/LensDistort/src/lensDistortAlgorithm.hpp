@@ -164,6 +164,9 @@ inline point2<F> transform( const ::tuttle::plugin::lens::AdvancedLensDistortPar
 
 }
 
+// after the transform functions, used by the warp engine
+#include <terry/sampler/warp.hpp>
+
 namespace tuttle {
 namespace plugin {
 namespace lens {
@@ -308,6 +311,43 @@ inline void transformValuesApply( const EParamLensType lensType, const LensDisto
 	}
 }
 
+/**
+ * @brief Coordinates of the transformation on the rows [y1, y2) of the region of a coordinates map,
+ * interpolated on a sparse grid (see terry::sampler::warp_coordinates)
+ */
+inline void computeCoordinatesMap( const EParamLensType lensType, const LensDistortProcessParams<double>& params, terry::sampler::coordinates_map& map, const std::ssize_t y1, const std::ssize_t y2 )
+{
+	const terry::Rect<std::ssize_t> rows( map.region().x1, y1, map.region().x2, y2 );
+	switch( lensType )
+	{
+		case eParamLensTypeStandard:
+		{
+			if( params._distort )
+				terry::sampler::warp_coordinates( map, static_cast<const NormalLensDistortParams<double>&>( params ), rows );
+			else
+				terry::sampler::warp_coordinates( map, static_cast<const NormalLensUndistortParams<double>&>( params ), rows );
+			return;
+		}
+		case eParamLensTypeFisheye:
+		{
+			if( params._distort )
+				terry::sampler::warp_coordinates( map, static_cast<const FisheyeLensDistortParams<double>&>( params ), rows );
+			else
+				terry::sampler::warp_coordinates( map, static_cast<const FisheyeLensUndistortParams<double>&>( params ), rows );
+			return;
+		}
+		case eParamLensTypeAdvanced:
+		{
+			if( params._distort )
+				terry::sampler::warp_coordinates( map, static_cast<const AdvancedLensDistortParams<double>&>( params ), rows );
+			else
+				terry::sampler::warp_coordinates( map, static_cast<const AdvancedLensUndistortParams<double>&>( params ), rows );
+			return;
+		}
+	}
+	BOOST_THROW_EXCEPTION( exception::Bug()
+		<< exception::user( "Lens type not recognize." ) );
+}
 
 }
 }
@@ -5,6 +5,8 @@
 #include <boost/gil/gil_all.hpp>
 #include <boost/gil/utilities.hpp>
 
+#include <cmath>
+
 namespace tuttle {
 namespace plugin {
 namespace move2D {
@@ -84,6 +86,28 @@ bool Move2DPlugin::isIdentity( const OFX::RenderArguments& args, OFX::Clip*& ide
 	return false;
 }
 
+/**
+ * @brief A translation of an integer number of pixels is a view of the source image.
+ * The translation is in canonical coordinates, the pixels of the source are
+ * pixel aspect ratio times wider.
+ */
+bool Move2DPlugin::getInputView( const OFX::RenderArguments& args, OFX::Clip*& viewClip, double& viewTime, OfxPointI& offset, bool& flip )
+{
+	const Move2DProcessParams<Scalar> params = getProcessParams();
+
+	const double tx = params._translation.x * args.renderScale.x / this->_clipSrc->getPixelAspectRatio();
+	const double ty = params._translation.y * args.renderScale.y;
+	if( tx != std::floor( tx ) || ty != std::floor( ty ) )
+		return false;
+
+	viewClip = this->_clipSrc;
+	viewTime = args.time;
+	offset.x = - static_cast<int>( tx );
+	offset.y = - static_cast<int>( ty );
+	flip = false;
+	return true;
+}
+
 /**
  * @brief The overridden render function
  * @param[in]   args     Rendering parameters
@@ -33,6 +33,7 @@ public:
 	bool getRegionOfDefinition( const OFX::RegionOfDefinitionArguments& args, OfxRectD& rod );
 	void getRegionsOfInterest( const OFX::RegionsOfInterestArguments& args, OFX::RegionOfInterestSetter& rois );
 	bool isIdentity( const OFX::RenderArguments& args, OFX::Clip*& identityClip, double& identityTime );
+	bool getInputView( const OFX::RenderArguments& args, OFX::Clip*& viewClip, double& viewTime, OfxPointI& offset, bool& flip );
 
     void render( const OFX::RenderArguments &args );
 	
@@ -35,6 +35,7 @@ void Move2DPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
 
 	// plugin flags
 	desc.setSupportsTiles( kSupportTiles );
+	desc.setSupportsInputView( true );
 	desc.setRenderThreadSafety( OFX::eRenderFullySafe );
 }
 
@@ -5,7 +5,7 @@
 
 #include <terry/globals.hpp>
 #include <terry/sampler/all.hpp>
-#include <terry/sampler/resample_progress.hpp>
+#include <terry/sampler/warp.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -137,10 +137,10 @@ void PinningProcess<View>::resample( View& srcView, View& dstView, const terry::
 	{
 		case eParamMethodAffine:
 		case eParamMethodPerspective:
-			terry::sampler::resample_pixels_progress<Sampler>( srcView, dstView, _params._perspective, procWindow, _params._samplerProcessParams._outOfImageProcess, this->getOfxProgress(), sampler );
+			terry::sampler::warp_pixels_progress<Sampler>( srcView, dstView, _params._perspective, procWindow, _params._samplerProcessParams._outOfImageProcess, this->getOfxProgress(), sampler );
 			return;
 		case eParamMethodBilinear:
-			terry::sampler::resample_pixels_progress<Sampler>( srcView, dstView, _params._bilinear   , procWindow, _params._samplerProcessParams._outOfImageProcess, this->getOfxProgress(), sampler );
+			terry::sampler::warp_pixels_progress<Sampler>( srcView, dstView, _params._bilinear   , procWindow, _params._samplerProcessParams._outOfImageProcess, this->getOfxProgress(), sampler );
 			return;
 	}
 }
@@ -3,6 +3,9 @@
 
 #include <tuttle/plugin/ImageGilFilterProcessor.hpp>
 
+#include <terry/geometry/affine.hpp>
+#include <terry/sampler/sampler.hpp>
+
 namespace tuttle {
 namespace plugin {
 namespace resize {
@@ -22,6 +25,7 @@ public:
 protected:
 	ResizePlugin&			_plugin;	///< Rendering plugin
 	ResizeProcessParams<Scalar>	_params;	///< parameters
+	bool				_separable;	///< use the separable resampler
 
 public:
 	ResizeProcess( ResizePlugin& effect );
@@ -29,6 +33,11 @@ public:
 	void setup( const OFX::RenderArguments& args );
 
 	void multiThreadProcessImages( const OfxRectI& procWindowRoW );
+
+private:
+	template<class Sampler>
+	void resample( const OfxRectI& procWindow, const terry::matrix3x2<double>& mat,
+	               const terry::sampler::EParamFilterOutOfImage outOfImageProcess, Sampler sampler );
 };
 
 }
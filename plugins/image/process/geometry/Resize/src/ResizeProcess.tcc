@@ -1,5 +1,6 @@
 #include <tuttle/plugin/ofxToGil/rect.hpp>
 #include <terry/sampler/resample_progress.hpp>
+#include <terry/sampler/resample_separable.hpp>
 #include <terry/geometry/affine.hpp>
 
 namespace tuttle {
@@ -10,6 +11,7 @@ template<class View>
 ResizeProcess<View>::ResizeProcess( ResizePlugin &effect )
 : ImageGilFilterProcessor<View>( effect, eImageOrientationFromBottomToTop )
 , _plugin( effect )
+, _separable( false )
 {
 	this->setNoMultiThreading();
 }
@@ -19,6 +21,30 @@ void ResizeProcess<View>::setup( const OFX::RenderArguments& args )
 {
 	ImageGilFilterProcessor<View>::setup( args );
 	_params = _plugin.getProcessParams( args.renderScale );
+
+	// the separable resampler computes each output row independently
+	_separable = _params._samplerProcessParams._filter != terry::sampler::eParamFilterNearest;
+	if( _separable )
+		this->setNbThreadsAuto();
+}
+
+/**
+ * @brief Axis-aligned filters are resampled in two separable passes,
+ * the nearest neighbor keeps the direct 2D sampling.
+ */
+template<class View>
+template<class Sampler>
+void ResizeProcess<View>::resample( const OfxRectI& procWindow, const terry::matrix3x2<double>& mat,
+                                    const terry::sampler::EParamFilterOutOfImage outOfImageProcess, Sampler sampler )
+{
+	using namespace terry::sampler;
+	const terry::Rect<std::ssize_t> procWinOutput = ofxToGil( this->translateRoWToOutputClipCoordinates( procWindow ) );
+	if( _separable )
+	{
+		resample_pixels_separable_progress( this->_srcView, this->_dstView, mat, procWinOutput, outOfImageProcess, this->getOfxProgress(), sampler );
+		return;
+	}
+	resample_pixels_progress( this->_srcView, this->_dstView, mat, procWinOutput, outOfImageProcess, this->getOfxProgress(), sampler );
 }
 
 /**
@@ -31,8 +57,6 @@ void ResizeProcess<View>::multiThreadProcessImages( const OfxRectI& procWindow )
 	using namespace terry;
 	using namespace terry::sampler;
 
-	const terry::Rect<std::ssize_t> procWin = ofxToGil(procWindow);
-
 	const double src_width  = std::max<double>(this->_srcView.width () -1,1);
 	const double src_height = std::max<double>(this->_srcView.height() -1,1);
 	const double dst_width  = std::max<double>(this->_dstView.width () -1,1);
@@ -64,37 +88,22 @@ void ResizeProcess<View>::multiThreadProcessImages( const OfxRectI& procWindow )
 
 	switch( _params._samplerProcessParams._filter )
 	{
-		case eParamFilterNearest	: resample_pixels_progress< ::terry::sampler::nearest_neighbor_sampler >( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterBilinear	: resample_pixels_progress< ::terry::sampler::bilinear_sampler >( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterBC :
-		{
-			bc_sampler BCsampler( _params._samplerProcessParams._paramB, _params._samplerProcessParams._paramC );
-			resample_pixels_progress( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress(), BCsampler );
-			break;
-		}
-		case eParamFilterBicubic  : resample_pixels_progress< bicubic_sampler	>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterCatrom   : resample_pixels_progress< catrom_sampler	>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterKeys     : resample_pixels_progress< keys_sampler	>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterSimon    : resample_pixels_progress< simon_sampler	>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterRifman   : resample_pixels_progress< rifman_sampler	>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterMitchell : resample_pixels_progress< mitchell_sampler	>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterParzen   : resample_pixels_progress< parzen_sampler	>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress() ); break;
-		case eParamFilterGaussian :
-		{
-			gaussian_sampler gaussianSampler ( _params._samplerProcessParams._filterSize, _params._samplerProcessParams._filterSigma );
-			resample_pixels_progress( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress(), gaussianSampler );
-			break;
-		}
-		case eParamFilterLanczos  :
-		{
-			lanczos_sampler lanczosSampler ( _params._samplerProcessParams._filterSize, _params._samplerProcessParams._filterSharpen );
-			resample_pixels_progress( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress(), lanczosSampler );
-			break;
-		}
-		case eParamFilterLanczos3	: resample_pixels_progress< lanczos3_sampler		>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress()	); break;
-		case eParamFilterLanczos4	: resample_pixels_progress< lanczos4_sampler		>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress()	); break;
-		case eParamFilterLanczos6	: resample_pixels_progress< lanczos6_sampler		>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress()	); break;
-		case eParamFilterLanczos12	: resample_pixels_progress< lanczos12_sampler		>( this->_srcView, this->_dstView, mat, procWin, outOfImageProcess, this->getOfxProgress()	); break;
+		case eParamFilterNearest	: resample( procWindow, mat, outOfImageProcess, nearest_neighbor_sampler() ); break;
+		case eParamFilterBilinear	: resample( procWindow, mat, outOfImageProcess, bilinear_sampler() ); break;
+		case eParamFilterBC		: resample( procWindow, mat, outOfImageProcess, bc_sampler( _params._samplerProcessParams._paramB, _params._samplerProcessParams._paramC ) ); break;
+		case eParamFilterBicubic	: resample( procWindow, mat, outOfImageProcess, bicubic_sampler() ); break;
+		case eParamFilterCatrom		: resample( procWindow, mat, outOfImageProcess, catrom_sampler() ); break;
+		case eParamFilterKeys		: resample( procWindow, mat, outOfImageProcess, keys_sampler() ); break;
+		case eParamFilterSimon		: resample( procWindow, mat, outOfImageProcess, simon_sampler() ); break;
+		case eParamFilterRifman		: resample( procWindow, mat, outOfImageProcess, rifman_sampler() ); break;
+		case eParamFilterMitchell	: resample( procWindow, mat, outOfImageProcess, mitchell_sampler() ); break;
+		case eParamFilterParzen		: resample( procWindow, mat, outOfImageProcess, parzen_sampler() ); break;
+		case eParamFilterGaussian	: resample( procWindow, mat, outOfImageProcess, gaussian_sampler( _params._samplerProcessParams._filterSize, _params._samplerProcessParams._filterSigma ) ); break;
+		case eParamFilterLanczos	: resample( procWindow, mat, outOfImageProcess, lanczos_sampler( _params._samplerProcessParams._filterSize, _params._samplerProcessParams._filterSharpen ) ); break;
+		case eParamFilterLanczos3	: resample( procWindow, mat, outOfImageProcess, lanczos3_sampler() ); break;
+		case eParamFilterLanczos4	: resample( procWindow, mat, outOfImageProcess, lanczos4_sampler() ); break;
+		case eParamFilterLanczos6	: resample( procWindow, mat, outOfImageProcess, lanczos6_sampler() ); break;
+		case eParamFilterLanczos12	: resample( procWindow, mat, outOfImageProcess, lanczos12_sampler() ); break;
 	}
 }
 
@@ -35,6 +35,7 @@ void MathOperatorPluginFactory::describe( OFX::ImageEffectDescriptor& desc )
 
 	// plugin flags
 	desc.setSupportsTiles( kSupportTiles );
+	desc.setIsPointOperation( true );
 	desc.setRenderThreadSafety( OFX::eRenderFullySafe );
 }
 
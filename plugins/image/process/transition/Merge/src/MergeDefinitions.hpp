@@ -3,6 +3,8 @@
 
 #include <tuttle/plugin/global.hpp>
 
+#include <boost/lexical_cast.hpp>
+
 namespace tuttle {
 namespace plugin {
 namespace merge {
@@ -10,6 +12,9 @@ namespace merge {
 // Descriptors name
 static const std::string kParamSourceA       = "A";
 static const std::string kParamSourceB       = "B";
+/// A is the first layer, the other layers A2 to A8 are optional
+/// (OFX clips are defined once for all instances, keep their number small)
+static const unsigned int kMaxNbLayers       = 8;
 static const std::string kParamFunction      = "mergingFunction";
 static const std::string kParamFunctionLabel = "Merging function";
 
@@ -30,6 +35,12 @@ enum EParamRod
 	eParamRodB
 };
 
+/// name of the layer clip i, for i in [1, kMaxNbLayers[
+inline std::string getLayerClipName( const unsigned int i )
+{
+	return kParamSourceA + boost::lexical_cast<std::string>( i + 1 );
+}
+
 // Plugin internal data
 
 enum EParamMerge
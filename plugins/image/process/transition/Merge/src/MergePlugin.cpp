@@ -22,6 +22,8 @@ MergePlugin::MergePlugin( OfxImageEffectHandle handle )
 	_clipSrcA      = fetchClip( kParamSourceA );
 	_clipSrcB      = fetchClip( kParamSourceB );
 	_clipDst       = fetchClip( kOfxImageEffectOutputClipName );
+	for( unsigned int i = 1; i < kMaxNbLayers; ++i )
+		_clipSrcLayers.push_back( fetchClip( getLayerClipName( i ) ) );
 
 	_paramMerge = fetchChoiceParam( kParamFunction );
 	_paramOffsetA = fetchInt2DParam( kParamOffsetA );
@@ -62,11 +64,21 @@ bool MergePlugin::getRegionOfDefinition( const OFX::RegionOfDefinitionArguments&
 		case eParamRodIntersect:
 		{
 			rod = rectanglesIntersection( srcRodA, srcRodB );
+			for( std::vector<OFX::Clip*>::const_iterator it = _clipSrcLayers.begin(); it != _clipSrcLayers.end(); ++it )
+			{
+				if( ( *it )->isConnected() )
+					rod = rectanglesIntersection( rod, translateRegion( ( *it )->getCanonicalRod( args.time ), params._offsetA ) );
+			}
 			return true;
 		}
 		case eParamRodUnion:
 		{
 			rod = rectanglesBoundingBox( srcRodA, srcRodB );
+			for( std::vector<OFX::Clip*>::const_iterator it = _clipSrcLayers.begin(); it != _clipSrcLayers.end(); ++it )
+			{
+				if( ( *it )->isConnected() )
+					rod = rectanglesBoundingBox( rod, translateRegion( ( *it )->getCanonicalRod( args.time ), params._offsetA ) );
+			}
 			return true;
 		}
 		case eParamRodA:
@@ -6,6 +6,8 @@
 #include <boost/gil/color_convert.hpp> // included first, to use the hack version
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
 
+#include <vector>
+
 namespace tuttle {
 namespace plugin {
 namespace merge {
@@ -60,6 +62,7 @@ private:
 public:
 	OFX::Clip* _clipSrcA;               ///< Source image clip A
 	OFX::Clip* _clipSrcB;               ///< Source image clip B
+	std::vector<OFX::Clip*> _clipSrcLayers; ///< Optional layers A2, A3...
 	OFX::Clip* _clipDst;                ///< Destination image clip
 
 	OFX::ChoiceParam* _paramMerge;   ///< Functor structure
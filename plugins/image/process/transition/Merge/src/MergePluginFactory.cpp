@@ -23,7 +23,11 @@ void MergePluginFactory::describe( OFX::ImageEffectDescriptor& desc )
 	desc.setPluginGrouping( "tuttle/image/process/transition" );
 
 	desc.setDescription( "Clip merging\n"
-	                     "Plugin is used to merge two clips A and B." );
+	                     "Plugin is used to merge two clips A and B.\n"
+	                     "The optional layers A2 to A8 are merged in the same pass "
+	                     "with the same function, each one onto the result of the "
+	                     "previous ones: A3 op ( A2 op ( A op B ) ).\n"
+	                     "The layers are moved with the A offset." );
 
 	// add the supported contexts
 	desc.addSupportedContext( OFX::eContextGeneral );
@@ -60,6 +64,16 @@ void MergePluginFactory::describeInContext( OFX::ImageEffectDescriptor& desc,
 	srcClipA->setSupportsTiles( kSupportTiles );
 	srcClipA->setOptional( false );
 
+	for( unsigned int i = 1; i < kMaxNbLayers; ++i )
+	{
+		OFX::ClipDescriptor* srcClipLayer = desc.defineClip( getLayerClipName( i ) );
+		srcClipLayer->addSupportedComponent( OFX::ePixelComponentRGBA );
+		srcClipLayer->addSupportedComponent( OFX::ePixelComponentRGB );
+		srcClipLayer->addSupportedComponent( OFX::ePixelComponentAlpha );
+		srcClipLayer->setSupportsTiles( kSupportTiles );
+		srcClipLayer->setOptional( true );
+	}
+
 	// Create the mandated output clip
 	OFX::ClipDescriptor* dstClip = desc.defineClip( kOfxImageEffectOutputClipName );
 	dstClip->addSupportedComponent( OFX::ePixelComponentRGBA );
@@ -5,8 +5,11 @@
 #include <tuttle/plugin/exceptions.hpp>
 
 #include <boost/gil/gil_all.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
 #include <boost/scoped_ptr.hpp>
 
+#include <vector>
+
 namespace tuttle {
 namespace plugin {
 namespace merge {
@@ -19,6 +22,9 @@ class MergeProcess : public ImageGilProcessor<View>
 {
 public:
 	typedef typename View::value_type Pixel;
+
+	/// rows merged with all the layers before moving to the next rows
+	static const int kLayerStripHeight = 16;
 	
 protected:
 	MergePlugin& _plugin; ///< Rendering plugin
@@ -32,6 +38,10 @@ protected:
 	OfxRectI _srcPixelRodA;
 	OfxRectI _srcPixelRodB;
 
+	boost::ptr_vector<OFX::Image> _srcLayers; ///< Connected optional layers
+	std::vector<View> _srcViewLayers;
+	std::vector<OfxRectI> _srcPixelRodLayers;
+
 public:
 	MergeProcess( MergePlugin& instance );
 
@@ -15,6 +15,8 @@
 #include <boost/gil/extension/color/hsl.hpp>
 #include <boost/gil/gil_all.hpp>
 
+#include <algorithm>
+
 namespace tuttle {
 namespace plugin {
 namespace merge {
@@ -60,6 +62,27 @@ void MergeProcess<View, Functor>::setup( const OFX::RenderArguments& args )
 		BOOST_THROW_EXCEPTION( exception::BitDepthMismatch() );
 	}
 
+	// optional layers
+	for( std::vector<OFX::Clip*>::const_iterator it = _plugin._clipSrcLayers.begin(); it != _plugin._clipSrcLayers.end(); ++it )
+	{
+		if( ! ( *it )->isConnected() )
+			continue;
+		OFX::Image* layer = ( *it )->fetchImage( args.time );
+		if( ! layer )
+			BOOST_THROW_EXCEPTION( exception::ImageNotReady() );
+		_srcLayers.push_back( layer );
+		if( layer->getRowDistanceBytes() == 0 )
+			BOOST_THROW_EXCEPTION( exception::WrongRowBytes() );
+		if( layer->getPixelDepth() != this->_dst->getPixelDepth() ||
+		    layer->getPixelComponents() != this->_dst->getPixelComponents() )
+		{
+			BOOST_THROW_EXCEPTION( exception::BitDepthMismatch() );
+		}
+		const OfxRectI layerPixelRod = ( *it )->getPixelRod( args.time, args.renderScale );
+		_srcViewLayers.push_back( this->getView( layer, layerPixelRod ) );
+		_srcPixelRodLayers.push_back( layerPixelRod );
+	}
+
 	_params = _plugin.getProcessParams( args.renderScale );
 }
 
@@ -287,7 +310,51 @@ void MergeProcess<View, Functor>::multiThreadProcessImages( const OfxRectI& proc
 						procIntersectSize.x,
 						procIntersectSize.y );
 
-	merge_views( srcViewA_inter, srcViewB_inter, dstView_inter, Functor() );
+	if( _srcViewLayers.empty() )
+	{
+		merge_views( srcViewA_inter, srcViewB_inter, dstView_inter, Functor() );
+		return;
+	}
+
+	// Merge the layers onto the result in place, by strips of rows,
+	// so each strip stays in cache while all the layers are merged.
+	for( int y = procWindowRoW.y1; y < procWindowRoW.y2; y += kLayerStripHeight )
+	{
+		const OfxRectI strip = { procWindowRoW.x1, y, procWindowRoW.x2, std::min( y + kLayerStripHeight, procWindowRoW.y2 ) };
+		const OfxRectI stripIntersect = rectanglesIntersection( strip, procIntersect );
+		if( stripIntersect.y2 > stripIntersect.y1 && stripIntersect.x2 > stripIntersect.x1 )
+		{
+			const int yInter = stripIntersect.y1 - procIntersect.y1;
+			const int heightInter = stripIntersect.y2 - stripIntersect.y1;
+			merge_views( subimage_view( srcViewA_inter, 0, yInter, procIntersectSize.x, heightInter ),
+			             subimage_view( srcViewB_inter, 0, yInter, procIntersectSize.x, heightInter ),
+			             subimage_view( dstView_inter, 0, yInter, procIntersectSize.x, heightInter ),
+			             Functor() );
+		}
+		for( std::size_t i = 0; i < _srcViewLayers.size(); ++i )
+		{
+			// the layers are moved with A
+			const OfxRectI srcRodLayer = translateRegion( _srcPixelRodLayers[i], _params._offsetA );
+			const OfxRectI layerRegion = rectanglesIntersection( strip, srcRodLayer );
+			if( layerRegion.y2 <= layerRegion.y1 || layerRegion.x2 <= layerRegion.x1 )
+				continue;
+			const OfxPointI layerRegionSize = {
+				layerRegion.x2 - layerRegion.x1,
+				layerRegion.y2 - layerRegion.y1
+			};
+			View dstLayer = subimage_view( this->_dstView,
+			                               layerRegion.x1 - this->_dstPixelRod.x1,
+			                               layerRegion.y1 - this->_dstPixelRod.y1,
+			                               layerRegionSize.x, layerRegionSize.y );
+			merge_views( subimage_view( _srcViewLayers[i],
+			                            layerRegion.x1 - srcRodLayer.x1,
+			                            layerRegion.y1 - srcRodLayer.y1,
+			                            layerRegionSize.x, layerRegionSize.y ),
+			             dstLayer, dstLayer, Functor() );
+		}
+		if( this->progressForward( ( strip.y2 - strip.y1 ) * ( strip.x2 - strip.x1 ) ) )
+			return;
+	}
 }
 
 }
@@ -124,6 +124,10 @@ void ImageStatisticsPlugin::render( const OFX::RenderArguments& args )
 
 void ImageStatisticsPlugin::changedParam( const OFX::InstanceChangedArgs& args, const std::string& paramName )
 {
+	// the output parameters are set by the render
+	if( args.reason != OFX::eChangePluginEdit )
+		_analysisCache.clear();
+
 	if( paramName == kParamCoordinateSystem )
 	{
 		OfxPointD projectSize = this->getProjectSize();
@@ -151,6 +155,16 @@ void ImageStatisticsPlugin::changedParam( const OFX::InstanceChangedArgs& args,
 	}
 }
 
+void ImageStatisticsPlugin::changedClip( const OFX::InstanceChangedArgs& args, const std::string& clipName )
+{
+	_analysisCache.clear();
+}
+
+void ImageStatisticsPlugin::beginSequenceRender( const OFX::BeginSequenceRenderArguments& args )
+{
+	_analysisCache.clear();
+}
+
 }
 }
 }
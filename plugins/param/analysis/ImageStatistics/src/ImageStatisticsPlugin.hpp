@@ -3,6 +3,7 @@
 
 #include "ImageStatisticsDefinitions.hpp"
 #include <tuttle/plugin/ImageEffectGilPlugin.hpp>
+#include <tuttle/plugin/AnalysisCache.hpp>
 
 namespace tuttle {
 namespace plugin {
@@ -25,6 +26,8 @@ public:
 public:
 	void render( const OFX::RenderArguments& args );
 	void changedParam( const OFX::InstanceChangedArgs& args, const std::string& paramName );
+	void changedClip( const OFX::InstanceChangedArgs& args, const std::string& clipName );
+	void beginSequenceRender( const OFX::BeginSequenceRenderArguments& args );
 
 	void getRegionsOfInterest( const OFX::RegionsOfInterestArguments& args, OFX::RegionOfInterestSetter& rois );
 
@@ -52,6 +55,8 @@ public:
 	OFX::Double3DParam* _paramOutputLuminosityMaxHSL;
 	OFX::Double3DParam* _paramOutputKurtosisHSL;
 	OFX::Double3DParam* _paramOutputSkewnessHSL;
+
+	AnalysisCache _analysisCache; ///< statistics of the rendered frames
 };
 
 }
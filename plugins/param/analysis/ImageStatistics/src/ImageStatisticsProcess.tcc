@@ -13,9 +13,12 @@
 #include <terry/numeric/init.hpp>
 #include <terry/numeric/pow.hpp>
 #include <terry/numeric/sqrt.hpp>
+#include <terry/numeric/statistics.hpp>
 #include <boost/gil/extension/color/hsl.hpp>
 
-#include <boost/units/pow.hpp>
+#include <tuttle/plugin/ParallelReduction.hpp>
+
+#include <boost/functional/hash.hpp>
 #include <boost/mpl/vector.hpp>
 #include <boost/mpl/erase.hpp>
 #include <boost/mpl/find.hpp>
@@ -95,79 +98,6 @@ namespace tuttle {
 namespace plugin {
 namespace imageStatistics {
 
-template<typename T>
-T standard_deviation( const T v_sum, const T v_sum_p2, const std::size_t nb )
-{
-	using namespace boost::units;
-	return std::sqrt( v_sum_p2 / nb - pow<2>( v_sum / nb ) );
-}
-
-template<typename Pixel>
-Pixel pixel_standard_deviation( const Pixel& v_sum, const Pixel& v_sum_p2, const std::size_t nb )
-{
-	using namespace boost::gil;
-	Pixel res;
-	for( int i = 0; i < num_channels<Pixel>::type::value; ++i )
-	{
-		res[i] = standard_deviation( v_sum[i], v_sum_p2[i], nb );
-	}
-	return res;
-}
-
-/**
- * @brief In probability theory and statistics, kurtosis is a measure of the
- * "peakedness" of the probability distribution of a real-valued random variable.
- *
- * Higher kurtosis means more of the variance is the result of infrequent extreme deviations,
- * as opposed to frequent modestly sized deviations.
- */
-template<typename T>
-T kurtosis( const T v_mean, const T v_standard_deviation, const T v_sum, const T v_sum_p2, const T v_sum_p3, const T v_sum_p4, const std::size_t nb )
-{
-	using namespace boost::units;
-	return ( ( v_sum_p4 - 4.0 * v_mean * v_sum_p3 + 6.0 * pow<2>( v_mean ) * v_sum_p2 ) / nb - 3.0 * pow<4>( v_mean ) ) /
-	       ( pow<4>( v_standard_deviation ) ) - 3.0;
-}
-
-template<typename Pixel>
-Pixel pixel_kurtosis( const Pixel& v_mean, const Pixel& v_standard_deviation, const Pixel& v_sum, const Pixel& v_sum_p2, const Pixel& v_sum_p3, const Pixel& v_sum_p4, const std::size_t nb )
-{
-	using namespace boost::gil;
-	Pixel res;
-	for( int i = 0; i < num_channels<Pixel>::type::value; ++i )
-	{
-		res[i] = kurtosis( v_mean[i], v_standard_deviation[i], v_sum[i], v_sum_p2[i], v_sum_p3[i], v_sum_p4[i], nb );
-	}
-	return res;
-}
-
-/**
- * @brief In probability theory and statistics, skewness is a measure of the
- * asymmetry of the probability distribution of a real-valued random variable.
- *
- * A zero value indicates that the values are relatively evenly distributed
- * on both sides of the mean, typically but not necessarily implying
- * a symmetric distribution.
- */
-template<typename T>
-T skewness( const T v_mean, const T v_standard_deviation, const T v_sum, const T v_sum_p2, const T v_sum_p3, const std::size_t nb )
-{
-	using namespace boost::units;
-	return ( ( v_sum_p3 - 3.0 * v_mean * v_sum_p2 ) / nb + 2.0 * pow<3>( v_mean ) ) / pow<3>( v_standard_deviation );
-}
-
-template<typename Pixel>
-Pixel pixel_skewness( const Pixel& v_mean, const Pixel& v_standard_deviation, const Pixel& v_sum, const Pixel& v_sum_p2, const Pixel& v_sum_p3, const std::size_t nb )
-{
-	using namespace boost::gil;
-	Pixel res;
-	for( int i = 0; i < num_channels<Pixel>::type::value; ++i )
-	{
-		res[i] = skewness( v_mean[i], v_standard_deviation[i], v_sum[i], v_sum_p2[i], v_sum_p3[i], nb );
-	}
-	return res;
-}
-
 template<class Pixel>
 struct OutputParams
 {
@@ -194,132 +124,65 @@ struct OutputParams
 	Pixel _skewness;
 };
 
-template<class View, typename CType = boost::gil::bits64f>
-struct ComputeOutputParams
+/**
+ * @brief Statistics of an image and of its HSL conversion, in a single pass.
+ */
+template<class Pixel>
+struct RGBAAndHSLStatistics
 {
+	typedef boost::gil::pixel<typename boost::gil::channel_type<Pixel>::type, boost::gil::layout<boost::gil::hsl_t> > HSLPixel;
+
+	terry::numeric::pixel_statistics_t<Pixel> _rgba;
+	terry::numeric::pixel_statistics_t<HSLPixel> _hsl;
 
-	typedef typename View::value_type Pixel;
-	typedef typename boost::gil::color_space_type<View>::type Colorspace;
-	typedef boost::gil::pixel<typename boost::gil::channel_type<View>::type, boost::gil::layout<boost::gil::gray_t> > PixelGray; // grayscale pixel type (using the input channel_type)
+	GIL_FORCEINLINE
+	void operator()( const Pixel& p )
+	{
+		_rgba( p );
+		HSLPixel hsl;
+		color_convert( p, hsl );
+		_hsl( hsl );
+	}
+
+	void merge( const RGBAAndHSLStatistics& other )
+	{
+		_rgba.merge( other._rgba );
+		_hsl.merge( other._hsl );
+	}
+};
+
+template<class Pixel, typename CType = boost::gil::bits64f>
+struct ComputeOutputParams
+{
+	typedef typename boost::gil::color_space_type<Pixel>::type Colorspace;
 	typedef boost::gil::pixel<CType, boost::gil::layout<Colorspace> > CPixel; // the pixel type use for computation (using input colorspace)
 
 	typedef OutputParams<CPixel> Output;
 
-	Output operator()( const View& image, ImageStatisticsPlugin& plugin )
+	Output operator()( const terry::numeric::pixel_statistics_t<Pixel>& stats ) const
 	{
 		using namespace terry::numeric;
-		OutputParams<CPixel> output;
-
-		const std::size_t nbPixels = image.width() * image.height();
-
-		// declare values and init
-		Pixel firstPixel = *image.begin(); // for initialization only
-		PixelGray firstPixelGray;
-		color_convert( firstPixel, firstPixelGray );
-
-		Pixel channelMin            = firstPixel;
-		Pixel channelMax            = firstPixel;
-		Pixel luminosityMin         = firstPixel;
-		PixelGray luminosityMinGray = firstPixelGray;
-		Pixel luminosityMax         = firstPixel;
-		PixelGray luminosityMaxGray = firstPixelGray;
-
-		CPixel sum;
-		CPixel varianceSum;
-		CPixel sum_p2;
-		CPixel sum_p3;
-		CPixel sum_p4;
-		pixel_zeros_t<CPixel>( )( sum );
-		pixel_zeros_t<CPixel>( )( varianceSum );
-		pixel_zeros_t<CPixel>( )( sum_p2 );
-		pixel_zeros_t<CPixel>( )( sum_p3 );
-		pixel_zeros_t<CPixel>( )( sum_p4 );
-
-		for( int y = 0; y < image.height(); ++y )
-		{
-			typename View::x_iterator src_it = image.x_at( 0, y );
-			CPixel lineAverage;
-			pixel_zeros_t<CPixel>( )( lineAverage );
-
-			for( int x = 0; x < image.width(); ++x, ++src_it )
-			{
-				CPixel pix;
-				pixel_assigns_t<Pixel, CPixel>( )( * src_it, pix ); // pix = src_it;
-
-				CPixel pix_p2;
-				CPixel pix_p3;
-				CPixel pix_p4;
-
-				pixel_assigns_t<CPixel, CPixel>( )( pixel_pow_t<CPixel, 2>( )( pix ), pix_p2 ); // pix_p2 = pow<2>( pix );
-				pixel_assigns_t<CPixel, CPixel>( )( pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix, pix_p2 ), pix_p3 ); // pix_p3 = pix * pix_p2;
-				pixel_assigns_t<CPixel, CPixel>( )( pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix_p2, pix_p2 ), pix_p4 ); // pix_p4 = pix_p2 * pix_p2;
-
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix, sum ); // sum += pix;
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix_p2, sum_p2 ); // sum_p2 += pix_p2;
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix_p3, sum_p3 ); // sum_p3 += pix_p3;
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix_p4, sum_p4 ); // sum_p4 += pix_p4;
-
-				// search min for each channel
-				pixel_assign_min_t<Pixel, Pixel>( )( * src_it, channelMin );
-				// search max for each channel
-				pixel_assign_max_t<Pixel, Pixel>( )( * src_it, channelMax );
-
-				PixelGray grayCurrentPixel; // current pixel in gray colorspace
-				color_convert( * src_it, grayCurrentPixel );
-
-				// search min luminosity
-				if( get_color( grayCurrentPixel, gray_color_t() ) < get_color( luminosityMinGray, gray_color_t() ) )
-				{
-					luminosityMin     = *src_it;
-					luminosityMinGray = grayCurrentPixel;
-				}
-				// search max luminosity
-				if( get_color( grayCurrentPixel, gray_color_t() ) > get_color( luminosityMaxGray, gray_color_t() ) )
-				{
-					luminosityMax     = *src_it;
-					luminosityMaxGray = grayCurrentPixel;
-				}
-			}
-		}
+		Output output;
+		if( stats.empty )
+			return output;
 
-		output._channelMin    = channelMin;
-		output._channelMax    = channelMax;
-		output._luminosityMin = luminosityMin;
-		output._luminosityMax = luminosityMax;
+		pixel_assigns_t<Pixel, CPixel>()( stats.channelMin, output._channelMin );
+		pixel_assigns_t<Pixel, CPixel>()( stats.channelMax, output._channelMax );
+		pixel_assigns_t<Pixel, CPixel>()( stats.luminosityMin, output._luminosityMin );
+		pixel_assigns_t<Pixel, CPixel>()( stats.luminosityMax, output._luminosityMax );
 
-		CPixel stdDeriv = pixel_standard_deviation( sum, sum_p2, nbPixels );
-		output._average  = pixel_divides_scalar_t<CPixel, double>() ( sum, nbPixels );
-		
-		for( int y = 0; y < image.height(); ++y )
+		for( int i = 0; i < boost::gil::num_channels<Pixel>::value; ++i )
 		{
-			typename View::x_iterator src_it = image.x_at( 0, y );
-			
-			for( int x = 0; x < image.width(); ++x, ++src_it )
-			{
-				CPixel pix;
-				pixel_assigns_t<Pixel, CPixel>( )( * src_it, pix ); // pix = src_it;
-
-				CPixel pix_diff = pix;
-				CPixel pix_diff2;
-
-				pix_diff = pixel_minus_t<CPixel, CPixel, CPixel>( )( pix, output._average ); // pix_diff = (pix - mean)
-				pix_diff2 = pixel_multiplies_t<CPixel, CPixel, CPixel>( )( pix_diff, pix_diff ); // pix_diff2 = (x - mean)*(x - mean)
-				
-				pixel_plus_assign_t<CPixel, CPixel>( )( pix_diff2, varianceSum ); // varianceSum += pix_diff2;
-			}
+			const moments_accumulator_t& moments = stats.moments[i];
+			output._average[i]  = moments.mean;
+			output._variance[i] = moments.standard_deviation();
+			output._kurtosis[i] = moments.kurtosis();
+			output._skewness[i] = moments.skewness();
 		}
-		
-		CPixel varianceSquare = pixel_divides_scalar_t<CPixel, double>() ( varianceSum, nbPixels );
-		output._variance = pixel_sqrt_t<CPixel, Pixel>()( varianceSquare );
-		output._kurtosis = pixel_kurtosis( output._average, stdDeriv, sum, sum_p2, sum_p3, sum_p4, nbPixels );
-		output._skewness = pixel_skewness( output._average, stdDeriv, sum, sum_p2, sum_p3, nbPixels );
-
 		return output;
 	}
-
 };
 
-
 template <typename OutputParamsRGBA, typename OutputParamsHSL>
 void setOutputParams( const OutputParamsRGBA& outputParamsRGBA, const OutputParamsHSL& outputParamsHSL, const OfxTime time, ImageStatisticsPlugin& plugin )
 {
@@ -367,13 +230,30 @@ void ImageStatisticsProcess<View>::setup( const OFX::RenderArguments& args )
 	                            _processParams._rect.x2 - _processParams._rect.x1,
 	                            _processParams._rect.y2 - _processParams._rect.y1 );
 
-	typedef ComputeOutputParams<View, boost::gil::bits64f> ComputeRGBA;
-	typename ComputeRGBA::Output outputRGBA = ComputeRGBA() ( image, this->_plugin );
-
-	typedef pixel<typename channel_type<View>::type, layout<hsl_t> > HSLPixel;
-	typedef color_converted_view_type<View, HSLPixel> HSLConverter;
-	typedef ComputeOutputParams<typename HSLConverter::type, boost::gil::bits64f> ComputeHSL;
-	typename ComputeHSL::Output outputHSL = ComputeHSL() ( color_converted_view<HSLPixel>( image ), this->_plugin );
+	typedef ComputeOutputParams<Pixel, boost::gil::bits64f> ComputeRGBA;
+	typedef RGBAAndHSLStatistics<Pixel> Statistics;
+	typedef ComputeOutputParams<typename Statistics::HSLPixel, boost::gil::bits64f> ComputeHSL;
+	typedef std::pair<typename ComputeRGBA::Output, typename ComputeHSL::Output> Outputs;
+
+	std::size_t analysisHash = 0;
+	boost::hash_combine( analysisHash, _processParams._rect.x1 );
+	boost::hash_combine( analysisHash, _processParams._rect.y1 );
+	boost::hash_combine( analysisHash, _processParams._rect.x2 );
+	boost::hash_combine( analysisHash, _processParams._rect.y2 );
+	boost::hash_combine( analysisHash, args.renderScale.x );
+	boost::hash_combine( analysisHash, args.renderScale.y );
+
+	Outputs outputs;
+	if( ! _plugin._analysisCache.get( args.time, analysisHash, outputs ) )
+	{
+		Statistics statistics;
+		reducePixelsParallel( image, statistics );
+		outputs.first  = ComputeRGBA()( statistics._rgba );
+		outputs.second = ComputeHSL()( statistics._hsl );
+		_plugin._analysisCache.set( args.time, analysisHash, outputs );
+	}
+	const typename ComputeRGBA::Output& outputRGBA = outputs.first;
+	const typename ComputeHSL::Output& outputHSL   = outputs.second;
 
 	setOutputParams( outputRGBA, outputHSL, args.time, this->_plugin );
 